@@ -0,0 +1,182 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ocs2_core/Types.h"
+
+namespace ocs2 {
+
+/** Fixed-size vector type. */
+template <int N>
+using fixed_vector_t = Eigen::Matrix<scalar_t, N, 1>;
+
+/** Fixed-size matrix type. */
+template <int Rows, int Cols>
+using fixed_matrix_t = Eigen::Matrix<scalar_t, Rows, Cols>;
+
+/** Trajectory type of fixed-size Eigen objects. The aligned allocator is required for the vectorizable sizes. */
+template <typename T>
+using fixed_array_t = std::vector<T, Eigen::aligned_allocator<T>>;
+
+/**
+ * Fixed-size counterpart of VectorFunctionLinearApproximation for systems whose dimensions are known at compile time:
+ * f(x,u) = dfdx dx + dfdu du + f
+ *
+ * @tparam NX : State dimension.
+ * @tparam NU : Input dimension.
+ * @tparam NF : Dimension of the function, the state dimension for the dynamics.
+ */
+template <int NX, int NU, int NF = NX>
+struct FixedSizeVectorFunctionLinearApproximation {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  static constexpr int stateDim = NX;
+  static constexpr int inputDim = NU;
+  static constexpr int functionDim = NF;
+
+  /** Derivative w.r.t state */
+  fixed_matrix_t<NF, NX> dfdx;
+  /** Derivative w.r.t input */
+  fixed_matrix_t<NF, NU> dfdu;
+  /** Constant term */
+  fixed_vector_t<NF> f;
+
+  /** Sets all coefficients to zero. */
+  FixedSizeVectorFunctionLinearApproximation& setZero() {
+    dfdx.setZero();
+    dfdu.setZero();
+    f.setZero();
+    return *this;
+  }
+
+  /** Copies a dynamic-size approximation. An empty dfdu, as for the event nodes, is copied as zero. Throws if the sizes do not match. */
+  FixedSizeVectorFunctionLinearApproximation& assign(const VectorFunctionLinearApproximation& rhs) {
+    const std::string error = checkSize(NF, NX, (rhs.dfdu.size() == 0) ? 0 : NU, rhs, "rhs");
+    if (!error.empty()) {
+      throw std::runtime_error("[FixedSizeVectorFunctionLinearApproximation::assign] " + error);
+    }
+    dfdx = rhs.dfdx;
+    if (rhs.dfdu.size() == 0) {
+      dfdu.setZero();
+    } else {
+      dfdu = rhs.dfdu;
+    }
+    f = rhs.f;
+    return *this;
+  }
+
+  /** Copy in the dynamic-size type */
+  VectorFunctionLinearApproximation toDynamic() const {
+    VectorFunctionLinearApproximation approximation;
+    approximation.dfdx = dfdx;
+    approximation.dfdu = dfdu;
+    approximation.f = f;
+    return approximation;
+  }
+};
+
+/**
+ * Fixed-size counterpart of ScalarFunctionQuadraticApproximation for systems whose dimensions are known at compile time:
+ * f(x,u) = 1/2 dx' dfdxx dx + du' dfdux dx + 1/2 du' dfduu du + dfdx' dx + dfdu' du + f
+ *
+ * @tparam NX : State dimension.
+ * @tparam NU : Input dimension.
+ */
+template <int NX, int NU>
+struct FixedSizeScalarFunctionQuadraticApproximation {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  static constexpr int stateDim = NX;
+  static constexpr int inputDim = NU;
+
+  /** Second derivative w.r.t state */
+  fixed_matrix_t<NX, NX> dfdxx;
+  /** Second derivative w.r.t input (lhs) and state (rhs) */
+  fixed_matrix_t<NU, NX> dfdux;
+  /** Second derivative w.r.t input */
+  fixed_matrix_t<NU, NU> dfduu;
+  /** First derivative w.r.t state */
+  fixed_vector_t<NX> dfdx;
+  /** First derivative w.r.t input */
+  fixed_vector_t<NU> dfdu;
+  /** Constant term */
+  scalar_t f = 0.;
+
+  /** Sets all coefficients to zero. */
+  FixedSizeScalarFunctionQuadraticApproximation& setZero() {
+    dfdxx.setZero();
+    dfdux.setZero();
+    dfduu.setZero();
+    dfdx.setZero();
+    dfdu.setZero();
+    f = 0.0;
+    return *this;
+  }
+
+  /** Copies a dynamic-size approximation. Empty input terms, as for the final node, are copied as zero. Throws if the sizes do not match. */
+  FixedSizeScalarFunctionQuadraticApproximation& assign(const ScalarFunctionQuadraticApproximation& rhs) {
+    const bool hasInputs = rhs.dfdu.size() > 0;
+    const std::string error = checkSize(NX, hasInputs ? NU : 0, rhs, "rhs");
+    if (!error.empty()) {
+      throw std::runtime_error("[FixedSizeScalarFunctionQuadraticApproximation::assign] " + error);
+    }
+    dfdxx = rhs.dfdxx;
+    dfdx = rhs.dfdx;
+    if (hasInputs) {
+      dfdux = rhs.dfdux;
+      dfduu = rhs.dfduu;
+      dfdu = rhs.dfdu;
+    } else {
+      dfdux.setZero();
+      dfduu.setZero();
+      dfdu.setZero();
+    }
+    f = rhs.f;
+    return *this;
+  }
+
+  /** Copy in the dynamic-size type */
+  ScalarFunctionQuadraticApproximation toDynamic() const {
+    ScalarFunctionQuadraticApproximation approximation;
+    approximation.dfdxx = dfdxx;
+    approximation.dfdux = dfdux;
+    approximation.dfduu = dfduu;
+    approximation.dfdx = dfdx;
+    approximation.dfdu = dfdu;
+    approximation.f = f;
+    return approximation;
+  }
+};
+
+}  // namespace ocs2
@@ -0,0 +1,100 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/automatic_differentiation/CppAdInterface.h>
+
+namespace ocs2 {
+
+/**
+ * Loads or generates the libraries of several CppAdInterfaces at once.
+ *
+ * The functions are taped one after the other, since the CppAD tape is not thread safe. A model whose library on disk was generated
+ * with the same cache key (see CppAdInterface::loadModelsIfAvailable) is loaded. The remaining models are compiled in parallel.
+ *
+ * Usage:
+ *    CppAdCodeGenerator codeGenerator(numThreads);
+ *    codeGenerator.addModel(positionInterface, CppAdInterface::ApproximationOrder::First);
+ *    codeGenerator.addModel(velocityInterface, CppAdInterface::ApproximationOrder::First);
+ *    const auto timings = codeGenerator.generate();
+ */
+class CppAdCodeGenerator {
+ public:
+  /** Timings of the code generation of one model in milliseconds */
+  struct ModelTiming {
+    std::string modelName;
+    bool isCached = false;       // the library was loaded from disk
+    scalar_t tapingTime = 0.0;   // taping and computation of the cache key
+    scalar_t codegenTime = 0.0;  // generation of the sources
+    scalar_t compileTime = 0.0;  // compilation or loading of the library
+  };
+
+  /**
+   * Constructor
+   * @param numThreads : Number of threads that compile in parallel, including the calling thread.
+   */
+  explicit CppAdCodeGenerator(size_t numThreads = std::max(std::thread::hardware_concurrency(), 1U));
+
+  /**
+   * Adds a model to be generated. The interface has to outlive the call to generate.
+   * @param adInterface : interface to load or generate the library for
+   * @param approximationOrder : Order of derivatives to generate
+   * @param recompile : Recompile the library even if a valid one is available on disk
+   */
+  void addModel(CppAdInterface& adInterface, CppAdInterface::ApproximationOrder approximationOrder, bool recompile = false);
+
+  /**
+   * Loads or generates the libraries of all added models. The list of models is cleared afterwards.
+   * @param verbose : Print out extra information and the timings
+   * @return timings per model in the order in which they were added
+   */
+  std::vector<ModelTiming> generate(bool verbose = true);
+
+ private:
+  struct Model {
+    CppAdInterface* adInterface;
+    CppAdInterface::ApproximationOrder approximationOrder;
+    bool recompile;
+  };
+
+  size_t numThreads_;
+  std::vector<Model> models_;
+};
+
+std::ostream& operator<<(std::ostream& stream, const CppAdCodeGenerator::ModelTiming& timing);
+
+}  // namespace ocs2
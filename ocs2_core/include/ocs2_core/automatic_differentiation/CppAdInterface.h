@@ -31,8 +31,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Eigen
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
 // STL
+#include <memory>
 #include <string>
 
 // CppAD
@@ -55,6 +57,20 @@ class CppAdInterface {
   using ad_function_t = std::function<void(const ad_vector_t&, ad_vector_t&)>;
   using ad_parameterized_function_t = std::function<void(const ad_vector_t&, const ad_vector_t&, ad_vector_t&)>;
   using ad_fun_t = CppAD::ADFun<ad_base_t>;
+  /** Compressed row-major storage, which matches the order in which the generated model returns the nonzeros. */
+  using sparse_matrix_t = Eigen::SparseMatrix<scalar_t, Eigen::RowMajor>;
+
+  /**
+   * Buffers of the evaluation of the generated model. They grow on the first call and are reused afterwards, such that the
+   * ...Into methods do not allocate. A workspace must not be shared between threads, every thread (e.g. every clone of a cost
+   * term) keeps its own.
+   */
+  struct Workspace {
+    vector_t xp;             // concatenated variables and parameters
+    vector_t sparseValues;   // nonzeros of a Jacobian or Hessian
+    vector_t weights;        // output weights of a Hessian
+    vector_t functionValue;  // function value of the Gauss-Newton approximation
+  };
 
   /**
    * Constructor for parameterized functions
@@ -108,13 +124,20 @@ class CppAdInterface {
   void createModels(ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
 
   /**
-   * Load models if they are available on disk. Creates a new library otherwise.
+   * Load models if they are available on disk and were generated from the same function. Creates a new library otherwise.
+   *
+   * The function is taped and a cache key is computed from the taped operation sequence, the dimensions, the approximation order,
+   * and the compile flags. A library on disk is only reused if it was generated with the same key, such that a stale library is
+   * rebuilt automatically after a change of the model.
    *
    * @param approximationOrder : Order of derivatives to generate
    * @param verbose : Print out extra information
    */
   void loadModelsIfAvailable(ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
 
+  /** Name of the model library */
+  const std::string& getModelName() const { return modelName_; }
+
   /**
    * @param x : input vector of size variableDim
    * @param p : parameter vector of size parameterDim
@@ -165,7 +188,152 @@ class CppAdInterface {
    */
   matrix_t getHessian(const vector_t& w, const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * Jacobian in compressed sparse format. Only the structural nonzeros are evaluated and stored, their values are written directly
+   * into the compressed storage without scattering through a dense matrix.
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @return d/dx( f(x,p) ) with the sparsity pattern of getJacobianSparsityPattern()
+   */
+  sparse_matrix_t getSparseJacobian(const vector_t& x, const vector_t& p = vector_t(0)) const;
+
+  /**
+   * Weighted hessian in compressed sparse format. Only the upper triangular part is stored.
+   *
+   * @param w: vector of weights of size rangeDim
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @return upper triangular part of dd/dxdx(sum_i  w_i*f_i(x,p) ) with the sparsity pattern of getHessianSparsityPattern()
+   */
+  sparse_matrix_t getSparseHessian(const vector_t& w, const vector_t& x, const vector_t& p = vector_t(0)) const;
+
+  /**
+   * Allocation free version of getFunctionValue.
+   * @param [out] y : f(x,p), has to be of size rangeDim
+   */
+  void getFunctionValueInto(const vector_t& x, const vector_t& p, Eigen::Ref<vector_t> y, Workspace& workspace) const;
+
+  /**
+   * Allocation free version of getJacobian.
+   * @param [out] jacobian : d/dx( f(x,p) ), has to be of size rangeDim x variableDim
+   */
+  void getJacobianInto(const vector_t& x, const vector_t& p, Eigen::Ref<matrix_t> jacobian, Workspace& workspace) const;
+
+  /**
+   * Allocation free version of getGaussNewtonApproximation. The members f, dfdx, and dfdxx are written, their memory is reused if
+   * they have the right size.
+   */
+  void getGaussNewtonApproximationInto(const vector_t& x, const vector_t& p, ScalarFunctionQuadraticApproximation& gnApproximation,
+                                       Workspace& workspace) const;
+
+  /**
+   * Allocation free version of getHessian for a single output.
+   * @param [out] hessian : dd/dxdx( f_i(x,p) ), has to be of size variableDim x variableDim
+   */
+  void getHessianInto(size_t outputIndex, const vector_t& x, const vector_t& p, Eigen::Ref<matrix_t> hessian, Workspace& workspace) const;
+
+  /**
+   * Allocation free version of the weighted getHessian.
+   * @param [out] hessian : dd/dxdx(sum_i  w_i*f_i(x,p) ), has to be of size variableDim x variableDim
+   */
+  void getHessianInto(const vector_t& w, const vector_t& x, const vector_t& p, Eigen::Ref<matrix_t> hessian, Workspace& workspace) const;
+
+  /**
+   * Allocation free version of getSparseJacobian. Only the values are written if the result already has the sparsity pattern of the
+   * model, e.g. from a previous call.
+   */
+  void getSparseJacobianInto(const vector_t& x, const vector_t& p, sparse_matrix_t& jacobian, Workspace& workspace) const;
+
+  /**
+   * Allocation free version of getSparseHessian for a single output. Only the values are written if the result already has the
+   * sparsity pattern of the model, e.g. from a previous call.
+   */
+  void getSparseHessianInto(size_t outputIndex, const vector_t& x, const vector_t& p, sparse_matrix_t& hessian,
+                            Workspace& workspace) const;
+
+  /**
+   * Allocation free version of getSparseHessian. Only the values are written if the result already has the sparsity pattern of the
+   * model, e.g. from a previous call.
+   */
+  void getSparseHessianInto(const vector_t& w, const vector_t& x, const vector_t& p, sparse_matrix_t& hessian,
+                            Workspace& workspace) const;
+
+  /** Number of outputs of the model. Available after the model is created or loaded. */
+  size_t getRangeDim() const { return rangeDim_; }
+
+  /** Sparsity pattern of the generated Jacobian w.r.t. the variables. One set of nonzero columns per output. */
+  const cppad_sparsity::SparsityPattern& getJacobianSparsityPattern() const { return jacobianSparsity_; }
+
+  /** Upper triangular sparsity pattern of the generated Hessian w.r.t. the variables. One set of nonzero columns per variable. */
+  const cppad_sparsity::SparsityPattern& getHessianSparsityPattern() const { return hessianSparsity_; }
+
+  /** Number of structural nonzeros of the Jacobian */
+  size_t getNumberOfJacobianNonZeros() const { return nnzJacobian_; }
+
+  /** Number of structural nonzeros of the upper triangular Hessian */
+  size_t getNumberOfHessianNonZeros() const { return nnzHessian_; }
+
+  /**
+   * Checks whether a block of the Jacobian is structurally zero, such that consumers can skip it.
+   * The block is defined as in Eigen's block(startRow, startCol, numRows, numCols).
+   */
+  bool isJacobianBlockZero(size_t startRow, size_t startCol, size_t numRows, size_t numCols) const {
+    return cppad_sparsity::isBlockZero(jacobianSparsity_, startRow, startCol, numRows, numCols);
+  }
+
+  /**
+   * Checks whether a block of the upper triangular Hessian is structurally zero, such that consumers can skip it.
+   * The block is defined as in Eigen's block(startRow, startCol, numRows, numCols) and has to lie in the upper triangular part.
+   */
+  bool isHessianBlockZero(size_t startRow, size_t startCol, size_t numRows, size_t numCols) const {
+    return cppad_sparsity::isBlockZero(hessianSparsity_, startRow, startCol, numRows, numCols);
+  }
+
  private:
+  friend class CppAdCodeGenerator;
+
+  /** Intermediate state of the code generation of a model */
+  struct ModelGeneration {
+    std::unique_ptr<ad_fun_t> fun;
+    std::unique_ptr<CppAD::cg::ModelCSourceGen<scalar_t>> sourceGen;
+    std::string cacheKey;
+  };
+
+  /**
+   * Tapes the function and computes the cache key. Uses the CppAD tape, hence it is not thread safe.
+   * @param approximationOrder : Order of derivatives to generate
+   * @return taped function with its cache key
+   */
+  ModelGeneration tapeModel(ApproximationOrder approximationOrder);
+
+  /**
+   * Generates the sources of all requested derivatives. Uses the CppAD tape, hence it is not thread safe.
+   * @param approximationOrder : Order of derivatives to generate
+   * @param modelGeneration : taped function, the sources are added to it
+   */
+  void generateSources(ApproximationOrder approximationOrder, ModelGeneration& modelGeneration) const;
+
+  /**
+   * Compiles the generated sources, loads the library and stores the cache key next to it.
+   * Different models can be compiled in parallel.
+   * @param modelGeneration : taped function with generated sources
+   * @param verbose : Print out extra information
+   */
+  void compileModels(ModelGeneration& modelGeneration, bool verbose);
+
+  /**
+   * Checks if a library generated with the given cache key is available on disk.
+   * @param cacheKey : key of the taped function
+   * @return isCacheValid
+   */
+  bool isCacheValid(const std::string& cacheKey) const;
+
+  /**
+   * Writes the concatenated variables and parameters into the workspace
+   */
+  void setInput(const vector_t& x, const vector_t& p, Workspace& workspace) const;
+
   /**
    * Defines library folder names
    */
@@ -203,7 +371,7 @@ class CppAdInterface {
   void setApproximationOrder(ApproximationOrder approximationOrder, CppAD::cg::ModelCSourceGen<scalar_t>& sourceGen, ad_fun_t& fun) const;
 
   /**
-   * Stores the sparisty nonzeros
+   * Stores the sparsity patterns, the number of nonzeros, and the compressed structure of the sparse results
    */
   void setSparsityNonzeros();
 
@@ -233,6 +401,12 @@ class CppAdInterface {
   size_t nnzJacobian_ = 0;
   size_t nnzHessian_ = 0;
 
+  // Sparsity
+  cppad_sparsity::SparsityPattern jacobianSparsity_;
+  cppad_sparsity::SparsityPattern hessianSparsity_;
+  sparse_matrix_t jacobianStructure_;  // nonzeros of the Jacobian with zero values
+  sparse_matrix_t hessianStructure_;   // nonzeros of the upper triangular Hessian with zero values
+
   // Names
   std::string modelName_;
   std::string folderName_;
@@ -240,6 +414,7 @@ class CppAdInterface {
   std::string tmpName_;
   std::string tmpFolder_;
   std::string libraryName_;
+  std::string cacheKeyFileName_;
 };
 
 }  // namespace ocs2
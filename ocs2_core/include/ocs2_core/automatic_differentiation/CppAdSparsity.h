@@ -98,5 +98,17 @@ SparsityPattern getHessianVariableSparsity(int variableDim, int parameterDim);
  */
 size_t getNumberOfNonZeros(const SparsityPattern& sparsityPattern);
 
+/**
+ * Checks if a block of the sparsity pattern has no entries. Rows beyond the size of the pattern are treated as empty.
+ *
+ * @param sparsityPattern
+ * @param startRow : first row of the block.
+ * @param startCol : first column of the block.
+ * @param numRows : number of rows of the block.
+ * @param numCols : number of columns of the block.
+ * @return true if the block is structurally zero.
+ */
+bool isBlockZero(const SparsityPattern& sparsityPattern, size_t startRow, size_t startCol, size_t numRows, size_t numCols);
+
 }  // namespace cppad_sparsity
 }  // namespace ocs2
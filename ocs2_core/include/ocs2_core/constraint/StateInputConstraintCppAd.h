@@ -75,6 +75,12 @@ class StateInputConstraintCppAd : public StateInputConstraint {
 
  private:
   std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+
+  /** Buffers of the evaluation, every thread works on its own clone */
+  mutable CppAdInterface::Workspace workspace_;
+  mutable vector_t tapedTimeStateInput_;
+  mutable matrix_t jacobian_;
+  mutable matrix_t hessian_;
 };
 
 }  // namespace ocs2
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/ControllerType.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
 
 namespace ocs2 {
 
@@ -54,6 +55,20 @@ class ControllerBase {
    */
   virtual vector_t computeInput(scalar_t t, const vector_t& x) = 0;
 
+  /**
+   * @brief Computes the control command at a given time and state into a preallocated input.
+   * The cursor keeps the time segment of the previous call, such that consecutive calls with increasing time do not search the
+   * whole time array. The default implementation calls computeInput(t, x).
+   *
+   * @param [in] t: Current time.
+   * @param [in] x: Current state.
+   * @param [in, out] cursor: The time segment cursor of the caller.
+   * @param [out] u: Current input. Does not allocate if u already has the input dimension.
+   */
+  virtual void computeInput(scalar_t t, const vector_t& x, LinearInterpolation::TimeSegmentCursor& cursor, vector_t& u) {
+    u = computeInput(t, x);
+  }
+
   /**
    * @brief Merges this controller with another controller that comes active later in time
    * This method is typically used to merge controllers from multiple time partitions.
@@ -85,6 +85,8 @@ class FeedforwardController final : public ControllerBase {
 
   vector_t computeInput(scalar_t t, const vector_t& x) override;
 
+  void computeInput(scalar_t t, const vector_t& x, LinearInterpolation::TimeSegmentCursor& cursor, vector_t& u) override;
+
   void concatenate(const ControllerBase* nextController, int index, int length) override;
 
   int size() const override;
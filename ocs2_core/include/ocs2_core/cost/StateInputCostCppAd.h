@@ -78,6 +78,13 @@ class StateInputCostCppAd : public StateInputCost {
 
  private:
   std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+
+  /** Buffers of the evaluation, every thread works on its own clone */
+  mutable CppAdInterface::Workspace workspace_;
+  mutable vector_t tapedTimeStateInput_;
+  mutable vector_t value_;
+  mutable matrix_t jacobian_;
+  mutable CppAdInterface::sparse_matrix_t hessian_;
 };
 
 }  // namespace ocs2
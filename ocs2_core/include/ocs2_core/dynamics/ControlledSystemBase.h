@@ -64,7 +64,10 @@ class ControlledSystemBase : public OdeBase {
   /**
    * Sets the control policy using the controller class.
    */
-  void setController(ControllerBase* controllerPtr) { controllerPtr_ = controllerPtr; };
+  void setController(ControllerBase* controllerPtr) {
+    controllerPtr_ = controllerPtr;
+    controllerCursor_.reset();
+  };
 
   /**
    * Returns the controller pointer.
@@ -137,6 +140,8 @@ class ControlledSystemBase : public OdeBase {
 
  private:
   ControllerBase* controllerPtr_ = nullptr;  //! pointer to controller
+  LinearInterpolation::TimeSegmentCursor controllerCursor_;  //! time segment of the last controller evaluation
+  vector_t input_;                                           //! buffer for the controller input
 };
 
 }  // namespace ocs2
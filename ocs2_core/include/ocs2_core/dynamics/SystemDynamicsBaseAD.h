@@ -174,6 +174,7 @@ class SystemDynamicsBaseAD : public SystemDynamicsBase {
 
   vector_t tapedTimeStateInput_;
   vector_t tapedTimeState_;
+  CppAdInterface::Workspace workspace_;
 
   /** Cached jacobians for time derivative */
   matrix_t flowJacobian_;
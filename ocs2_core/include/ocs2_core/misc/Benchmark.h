@@ -66,9 +66,14 @@ class RepeatedTimer {
   /**
    * Stop timing of an interval
    */
-  void endTimer() {
+  void endTimer() { endTimer(startTime_); }
+
+  /**
+   * Stop timing of an interval that started at the given time point, e.g., a time point taken in another thread
+   */
+  void endTimer(std::chrono::steady_clock::time_point startTime) {
     auto endTime = std::chrono::steady_clock::now();
-    lastIntervalTime_ = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime_);
+    lastIntervalTime_ = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime);
     maxIntervalTime_ = std::max(maxIntervalTime_, lastIntervalTime_);
     totalTime_ += lastIntervalTime_;
     numTimedIntervals_++;
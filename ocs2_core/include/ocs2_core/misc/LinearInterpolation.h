@@ -53,6 +53,38 @@ using remove_cvref_t = typename std::remove_cv<typename std::remove_reference<T>
  */
 index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray);
 
+/**
+ * Caches the position of the previous query in a time array. Consecutive queries with nondecreasing times, as in a control loop
+ * or a rollout, find their interval in O(1) instead of a binary search over the whole array. Other queries fall back to a binary
+ * search. The result is always identical to timeSegment(enquiryTime, timeArray).
+ *
+ * A cursor is not thread-safe, each caller keeps its own. It stays valid if the time array changes (e.g., after a policy update),
+ * but the first query on the new array may need a binary search.
+ */
+class TimeSegmentCursor {
+ public:
+  /**
+   * Get the interval index and interpolation coefficient alpha, see timeSegment(enquiryTime, timeArray).
+   *
+   * @param [in] enquiryTime: The enquiry time for interpolation.
+   * @param [in] timeArray: interpolation time array.
+   * @return {index, alpha}
+   */
+  index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray);
+
+  /** Forgets the cached position. */
+  void reset() { position_ = 0; }
+
+ private:
+  /** Same as lookup::findIndexInTimeArray, starting from the cached position. */
+  int findIndex(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray);
+
+  /** Number of samples the cursor walks forward before falling back to a binary search */
+  static constexpr size_t maxForwardSteps = 4;
+
+  size_t position_ = 0;  // index of the first time that is not smaller than the previous enquiry time
+};
+
 /**
  * Directly uses the index and interpolation coefficient provided by the user
  * @note If sizes in data array are not equal, the interpolation will snap to the data
@@ -92,6 +124,20 @@ Data interpolate(index_alpha_t indexAlpha, const std::vector<Data, Alloc>& dataA
 template <typename Data, class Alloc>
 Data interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, const std::vector<Data, Alloc>& dataArray);
 
+/**
+ * Same as interpolate(indexAlpha, dataArray), but writes the result into the given object. Does not allocate if the result
+ * already has the size of the data.
+ *
+ * @param [in] indexAlpha : index and interpolation coefficient (alpha) pair
+ * @param [in] dataArray: vector of data
+ * @param [out] result: The interpolation result
+ *
+ * @tparam Data: Data type
+ * @tparam Alloc: Specialized allocation class
+ */
+template <typename Data, class Alloc>
+void interpolate(index_alpha_t indexAlpha, const std::vector<Data, Alloc>& dataArray, Data& result);
+
 /**
  * Directly uses the index and interpolation coefficient provided by the user
  * @note If sizes in data array are not equal, the interpolation will snap to the data
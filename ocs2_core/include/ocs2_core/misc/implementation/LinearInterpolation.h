@@ -66,13 +66,10 @@ const Data& stdAccessFun(const std::vector<Data, Alloc>& vec, size_t ind) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
-  // corner cases (no time set OR single time element)
-  if (timeArray.size() <= 1) {
-    return {0, scalar_t(1.0)};
-  }
-
-  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+/**
+ * Helper to compute the interpolation coefficient of the interval found by lookup::findIntervalInTimeArray.
+ */
+inline index_alpha_t timeSegmentInInterval(int index, scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
   const auto lastInterval = static_cast<int>(timeArray.size() - 1);
   if (index >= 0) {
     if (index < lastInterval) {
@@ -104,6 +101,58 @@ inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+
+  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+  return timeSegmentInInterval(index, enquiryTime, timeArray);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t TimeSegmentCursor::timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+
+  const int index = findIndex(enquiryTime, timeArray) - 1;
+  return timeSegmentInInterval(index, enquiryTime, timeArray);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline int TimeSegmentCursor::findIndex(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
+  // invariant of the result p: (p == 0 or timeArray[p - 1] < enquiryTime) and (p == size or enquiryTime <= timeArray[p])
+  const auto begin = timeArray.cbegin();
+  const size_t size = timeArray.size();
+  size_t p = std::min(position_, size);
+
+  if (p > 0 && !(timeArray[p - 1] < enquiryTime)) {
+    // moved backwards: the result is in [0, p - 1]
+    p = static_cast<size_t>(std::lower_bound(begin, begin + (p - 1), enquiryTime) - begin);
+  } else {
+    // moved forwards: the result is in [p, size]. Walk a few samples before falling back to a binary search.
+    for (size_t i = 0; i < maxForwardSteps && p < size && timeArray[p] < enquiryTime; ++i) {
+      ++p;
+    }
+    if (p < size && timeArray[p] < enquiryTime) {
+      p = static_cast<size_t>(std::lower_bound(begin + p, timeArray.cend(), enquiryTime) - begin);
+    }
+  }
+
+  position_ = p;
+  return static_cast<int>(p);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -120,6 +169,29 @@ Data interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, c
   return interpolate(enquiryTime, timeArray, dataArray, stdAccessFun<Data, Alloc>);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Data, class Alloc>
+void interpolate(index_alpha_t indexAlpha, const std::vector<Data, Alloc>& dataArray, Data& result) {
+  assert(dataArray.size() > 0);
+  if (dataArray.size() > 1) {
+    // Normal interpolation case
+    int index = indexAlpha.first;
+    scalar_t alpha = indexAlpha.second;
+    const auto& lhs = dataArray[index];
+    const auto& rhs = dataArray[index + 1];
+    if (areSameSize(rhs, lhs)) {
+      result = alpha * lhs + (scalar_t(1.0) - alpha) * rhs;
+    } else {
+      result = (alpha > 0.5) ? lhs : rhs;
+    }
+  } else {  // dataArray.size() == 1
+    // Time vector has only 1 element -> Constant function
+    result = dataArray[0];
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
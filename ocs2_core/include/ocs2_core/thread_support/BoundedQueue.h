@@ -0,0 +1,147 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+
+namespace ocs2 {
+
+/**
+ * Thread-safe first-in-first-out queue with a fixed capacity, meant to connect the stages of a pipeline.
+ *
+ * Pushing never blocks: if the queue is full, its oldest value is dropped to make room. This suits data that is superseded by newer
+ * data, e.g., observations or policies, where a slow consumer should receive the newest values instead of stalling the producer.
+ * Popping blocks until a value is available or the queue is closed.
+ *
+ * @tparam T : stored type, has to be movable.
+ */
+template <typename T>
+class BoundedQueue {
+ public:
+  /**
+   * Constructor
+   * @param [in] capacity : The maximum number of values in the queue, at least one.
+   */
+  explicit BoundedQueue(size_t capacity) : capacity_(capacity) {
+    if (capacity_ == 0) {
+      throw std::invalid_argument("[BoundedQueue] The capacity must be at least one.");
+    }
+  }
+
+  /**
+   * Adds a value at the end of the queue. If the queue is full, the value at its front is dropped.
+   * @return true if a value was dropped.
+   */
+  bool push(T value) {
+    bool dropped = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (queue_.size() >= capacity_) {
+        queue_.pop_front();
+        dropped = true;
+      }
+      queue_.push_back(std::move(value));
+    }
+    valueAdded_.notify_one();
+    return dropped;
+  }
+
+  /**
+   * Waits until the queue is not empty or closed and removes the value at its front.
+   * After close(), the remaining values can still be popped without waiting.
+   * @return false if the queue is closed and empty, in which case value is not modified.
+   */
+  bool pop(T& value) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    valueAdded_.wait(lock, [this] { return !queue_.empty() || closed_; });
+    if (queue_.empty()) {
+      return false;
+    }
+    value = std::move(queue_.front());
+    queue_.pop_front();
+    return true;
+  }
+
+  /**
+   * Removes the value at the front of the queue if there is one. Does not wait.
+   * @return false if the queue is empty, in which case value is not modified.
+   */
+  bool tryPop(T& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.empty()) {
+      return false;
+    }
+    value = std::move(queue_.front());
+    queue_.pop_front();
+    return true;
+  }
+
+  /** Closes the queue: waiting and future pop() calls return once the queue is empty. Pushing is still possible. */
+  void close() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+    }
+    valueAdded_.notify_all();
+  }
+
+  /** Reopens a closed queue such that pop() waits for values again. Keeps the values in the queue. */
+  void reopen() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = false;
+  }
+
+  /** Removes all values. */
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.clear();
+  }
+
+  /** Number of values in the queue */
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+  }
+
+  /** Maximum number of values in the queue */
+  size_t capacity() const { return capacity_; }
+
+ private:
+  const size_t capacity_;
+  std::deque<T> queue_;
+  bool closed_ = false;
+  mutable std::mutex mutex_;
+  std::condition_variable valueAdded_;
+};
+
+}  // namespace ocs2
@@ -30,8 +30,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <pthread.h>
+#include <sched.h>
 #include <iostream>
 #include <thread>
+#include <vector>
 
 namespace ocs2 {
 
@@ -39,7 +41,7 @@ namespace ocs2 {
  * Sets the priority of the input thread.
  *
  * @param priority: The priority of the thread from 0 (lowest) to 99 (highest)
- * @param thread: A reference to the tread.
+ * @param thread: A reference to the thread.
  */
 inline void setThreadPriority(int priority, pthread_t thread) {
   sched_param sched{};
@@ -58,7 +60,7 @@ inline void setThreadPriority(int priority, pthread_t thread) {
  * Sets the priority of the input thread.
  *
  * @param priority: The priority of the thread from 0 (lowest) to 99 (highest)
- * @param thread: A reference to the tread.
+ * @param thread: A reference to the thread.
  */
 inline void setThreadPriority(int priority, std::thread& thread) {
   setThreadPriority(priority, thread.native_handle());
@@ -73,4 +75,46 @@ inline void setThisThreadPriority(int priority) {
   setThreadPriority(priority, pthread_self());
 }
 
+/**
+ * Sets the CPU affinity of the input thread.
+ *
+ * @param cpus: The CPU cores the thread is allowed to run on. If empty, the affinity is not changed.
+ * @param thread: A reference to the thread.
+ */
+inline void setThreadAffinity(const std::vector<int>& cpus, pthread_t thread) {
+  if (cpus.empty()) {
+    return;
+  }
+
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (const auto cpu : cpus) {
+    CPU_SET(cpu, &cpuSet);
+  }
+
+  if (pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuSet) != 0) {
+    std::cerr << "WARNING: Failed to set threads affinity (one possible reason could be that the requested CPU cores are not available.)"
+              << std::endl;
+  }
+}
+
+/**
+ * Sets the CPU affinity of the input thread.
+ *
+ * @param cpus: The CPU cores the thread is allowed to run on. If empty, the affinity is not changed.
+ * @param thread: A reference to the thread.
+ */
+inline void setThreadAffinity(const std::vector<int>& cpus, std::thread& thread) {
+  setThreadAffinity(cpus, thread.native_handle());
+}
+
+/**
+ * Sets the CPU affinity of the thread this function is called from.
+ *
+ * @param cpus: The CPU cores the thread is allowed to run on. If empty, the affinity is not changed.
+ */
+inline void setThisThreadAffinity(const std::vector<int>& cpus) {
+  setThreadAffinity(cpus, pthread_self());
+}
+
 }  // namespace ocs2
@@ -29,7 +29,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <exception>
+#include <functional>
 #include <future>
 #include <mutex>
 #include <queue>
@@ -48,8 +52,10 @@ class ThreadPool {
    *
    * @param [in] nThreads: Number of threads to launch in the pool
    * @param [in] priority: The worker thread priority
+   * @param [in] cpuAffinity: The CPU cores the workers are pinned to. Worker i is pinned to core cpuAffinity[i % cpuAffinity.size()].
+   *                          If empty, the workers are not pinned.
    */
-  explicit ThreadPool(size_t nThreads = 1, int priority = 0);
+  explicit ThreadPool(size_t nThreads = 1, int priority = 0, std::vector<int> cpuAffinity = {});
 
   /**
    * Destructor
@@ -80,15 +86,61 @@ class ThreadPool {
    */
   void runParallel(std::function<void(int)> taskFunction, int N);
 
+  /**
+   * Helper function to call a function for every index in [begin, end) with the help of the pool. The range is split into chunks of
+   * size grain which are dynamically claimed by the calling thread and the workers. This method does not allocate memory.
+   *
+   * @note This is a blocking operation, returns when all indices are processed.
+   *
+   * @param [in] begin: The first index of the range.
+   * @param [in] end: The end (exclusive) of the range.
+   * @param [in] grain: The number of consecutive indices that are processed by one worker at once.
+   * @param [in] function: The function to call as function(workerIndex, index). The workerIndex is in [0, nThreads].
+   */
+  template <typename Functor>
+  void parallelFor(size_t begin, size_t end, size_t grain, Functor&& function);
+
   /** Get the number of threads. */
   size_t numThreads() const { return workerThreads_.size(); }
 
+  /**
+   * Enables or disables the hot mode. In the hot mode, the idle workers busy-spin instead of sleeping on a condition variable such that
+   * the dispatch latency of runParallel and parallelFor is minimal. This keeps all workers at 100% CPU load and should only be enabled
+   * for short periods of time, e.g., while a solver iterates.
+   *
+   * @param [in] enable: If true, the workers busy-spin while idle. Otherwise, they sleep.
+   */
+  void setHotMode(bool enable);
+
+  /** Whether the hot mode is enabled. */
+  bool isHotMode() const { return hotMode_; }
+
+  class HotModeScope;
+
  private:
   struct TaskBase;
 
   template <typename Functor>
   struct Task;
 
+  struct ParallelJob;
+
+  /**
+   * Runs a parallel job: The calling thread executes the job (with ID = nThreads) and the workers join in to execute the remaining
+   * instances. Blocks until all instances are completed and rethrows the first exception thrown by any instance.
+   *
+   * @param [in] job: The parallel job which lives on the stack of the calling thread.
+   */
+  void runParallelJob(ParallelJob& job);
+
+  /**
+   * Executes the instances of the job until no more instances are left to claim.
+   *
+   * @param [in] job: The parallel job.
+   * @param [in] workerIndex: The index of the executing thread.
+   */
+  void executeParallelJob(ParallelJob& job, int workerIndex);
+
   /**
    * Thread worker loop
    *
@@ -103,12 +155,24 @@ class ThreadPool {
    */
   void runTask(std::unique_ptr<TaskBase> taskPtr);
 
+  /** Whether there is a queued task, an unclaimed parallel job or a stop request. Requires taskQueueLock_ to be held. */
+  bool hasWork() const;
+
+  /** Refreshes workAvailable_ from the protected state. Requires taskQueueLock_ to be held. */
+  void updateWorkAvailable() { workAvailable_.store(hasWork(), std::memory_order_release); }
+
   bool stop_{false};  //!< flag telling all threads to stop, protected by taskQueueLock_
 
   std::queue<std::unique_ptr<TaskBase>> taskQueue_;  // protected by taskQueueLock_
   std::condition_variable taskQueueCondition_;
   std::mutex taskQueueLock_;
 
+  ParallelJob* parallelJobPtr_{nullptr};  // protected by taskQueueLock_
+  std::condition_variable parallelJobCondition_;
+
+  std::atomic_bool hotMode_{false};
+  std::atomic_bool workAvailable_{false};  //!< lock-free hint for the hot-mode spin, only written under taskQueueLock_
+
   std::vector<std::thread> workerThreads_;
 };
 
@@ -136,6 +200,50 @@ struct ThreadPool::Task final : public ThreadPool::TaskBase {
   std::packaged_task<ReturnType(int)> packagedTask;
 };
 
+/**
+ * A parallel job which is shared by the calling thread and the workers. The callable is referenced through a plain function pointer such
+ * that dispatching a job does not allocate memory.
+ */
+struct ThreadPool::ParallelJob {
+  ParallelJob(void (*invokeFunction)(const void*, int), const void* callablePtr, int numInstances)
+      : invoke(invokeFunction), callable(callablePtr), numUnclaimed(numInstances) {}
+
+  /** Claims one instance of the job. Returns false if all instances are claimed. */
+  bool claim() { return numUnclaimed.load(std::memory_order_relaxed) > 0 && numUnclaimed.fetch_sub(1, std::memory_order_acq_rel) > 0; }
+
+  void (*invoke)(const void*, int);
+  const void* callable;
+  std::atomic_int numUnclaimed;
+  std::atomic_int numAttachedWorkers{0};  // modified under taskQueueLock_
+  std::exception_ptr exception;           // protected by taskQueueLock_
+};
+
+/**
+ * Enables the hot mode of a thread pool for the lifetime of this object, and restores the previous mode on destruction.
+ */
+class ThreadPool::HotModeScope {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] threadPool: The thread pool.
+   * @param [in] enable: If false, the mode of the thread pool is not changed.
+   */
+  HotModeScope(ThreadPool& threadPool, bool enable) : threadPool_(threadPool), previousMode_(threadPool.isHotMode()) {
+    if (enable) {
+      threadPool_.setHotMode(true);
+    }
+  }
+  ~HotModeScope() { threadPool_.setHotMode(previousMode_); }
+
+  HotModeScope(const HotModeScope&) = delete;
+  HotModeScope& operator=(const HotModeScope&) = delete;
+
+ private:
+  ThreadPool& threadPool_;
+  const bool previousMode_;
+};
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
@@ -154,4 +262,34 @@ std::future<typename std::result_of<Functor(int)>::type> ThreadPool::run(Functor
   return future;
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename Functor>
+void ThreadPool::parallelFor(size_t begin, size_t end, size_t grain, Functor&& function) {
+  if (begin >= end) {
+    return;
+  }
+  grain = std::max(grain, size_t(1));
+  const size_t numChunks = (end - begin + grain - 1) / grain;
+
+  std::atomic<size_t> nextChunkBegin{begin};
+  auto chunkTask = [&](int workerIndex) {
+    size_t chunkBegin = nextChunkBegin.fetch_add(grain);
+    while (chunkBegin < end) {
+      const size_t chunkEnd = std::min(chunkBegin + grain, end);
+      for (size_t i = chunkBegin; i < chunkEnd; ++i) {
+        function(workerIndex, i);
+      }
+      chunkBegin = nextChunkBegin.fetch_add(grain);
+    }
+  };
+  using ChunkTask = decltype(chunkTask);
+
+  const auto numInstances = static_cast<int>(std::min(numChunks, numThreads() + 1));
+  ParallelJob job([](const void* callable, int workerIndex) { (*static_cast<const ChunkTask*>(callable))(workerIndex); }, &chunkTask,
+                  numInstances);
+  runParallelJob(job);
+}
+
 }  // namespace ocs2
@@ -0,0 +1,119 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/automatic_differentiation/CppAdCodeGenerator.h>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdCodeGenerator::CppAdCodeGenerator(size_t numThreads) : numThreads_(std::max<size_t>(numThreads, 1)) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdCodeGenerator::addModel(CppAdInterface& adInterface, CppAdInterface::ApproximationOrder approximationOrder, bool recompile) {
+  models_.push_back({&adInterface, approximationOrder, recompile});
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<CppAdCodeGenerator::ModelTiming> CppAdCodeGenerator::generate(bool verbose) {
+  const size_t numModels = models_.size();
+  std::vector<ModelTiming> timings(numModels);
+  std::vector<CppAdInterface::ModelGeneration> modelGenerations(numModels);
+  std::vector<size_t> modelsToCompile;
+  benchmark::RepeatedTimer timer;
+
+  // Taping and source generation use the CppAD tape and run sequentially
+  for (size_t i = 0; i < numModels; i++) {
+    auto& adInterface = *models_[i].adInterface;
+    timings[i].modelName = adInterface.getModelName();
+
+    timer.startTimer();
+    modelGenerations[i] = adInterface.tapeModel(models_[i].approximationOrder);
+    timer.endTimer();
+    timings[i].tapingTime = timer.getLastIntervalInMilliseconds();
+
+    if (!models_[i].recompile && adInterface.isCacheValid(modelGenerations[i].cacheKey)) {
+      timer.startTimer();
+      adInterface.loadModels(verbose);
+      timer.endTimer();
+      timings[i].isCached = true;
+      timings[i].compileTime = timer.getLastIntervalInMilliseconds();
+    } else {
+      timer.startTimer();
+      adInterface.generateSources(models_[i].approximationOrder, modelGenerations[i]);
+      timer.endTimer();
+      timings[i].codegenTime = timer.getLastIntervalInMilliseconds();
+      modelsToCompile.push_back(i);
+    }
+  }
+
+  // Each model is compiled by an independent compiler process
+  if (!modelsToCompile.empty()) {
+    ThreadPool threadPool(std::min(numThreads_, modelsToCompile.size()) - 1);
+    threadPool.parallelFor(0, modelsToCompile.size(), 1, [&](int workerIndex, size_t j) {
+      const size_t i = modelsToCompile[j];
+      benchmark::RepeatedTimer compileTimer;
+      compileTimer.startTimer();
+      models_[i].adInterface->compileModels(modelGenerations[i], verbose);
+      compileTimer.endTimer();
+      timings[i].compileTime = compileTimer.getLastIntervalInMilliseconds();
+    });
+  }
+
+  if (verbose) {
+    std::cerr << "[CppAdCodeGenerator] Generated " << numModels << " models, compiled " << modelsToCompile.size() << " of them on "
+              << std::min(numThreads_, std::max<size_t>(modelsToCompile.size(), 1)) << " threads.\n";
+    for (const auto& timing : timings) {
+      std::cerr << timing << "\n";
+    }
+  }
+
+  models_.clear();
+  return timings;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::ostream& operator<<(std::ostream& stream, const CppAdCodeGenerator::ModelTiming& timing) {
+  stream << timing.modelName << (timing.isCached ? " [cached]" : " [compiled]")
+         << " taping: " << timing.tapingTime << " [ms], codegen: " << timing.codegenTime << " [ms], compile: " << timing.compileTime
+         << " [ms]";
+  return stream;
+}
+
+}  // namespace ocs2
@@ -29,10 +29,46 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
 #include <boost/filesystem.hpp>
 
 namespace ocs2 {
 
+namespace {
+/** Gives access to the generated sources, such that they can be generated before and independently of the compilation. */
+class ModelCSourceGenWithSources : public CppAD::cg::ModelCSourceGen<scalar_t> {
+ public:
+  using CppAD::cg::ModelCSourceGen<scalar_t>::ModelCSourceGen;
+
+  const std::map<std::string, std::string>& getSources() {
+    return CppAD::cg::ModelCSourceGen<scalar_t>::getSources(CppAD::cg::MultiThreadingType::NONE, nullptr);
+  }
+};
+
+/** 64 bit FNV-1a hash, which, unlike std::hash, is stable across processes and compilers. */
+uint64_t hashCombine(uint64_t hash, const std::string& data) {
+  for (const unsigned char c : data) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/** Whether a compressed sparse matrix has exactly the given sparsity structure, in which case only its values need to be written. */
+bool hasSparsityStructure(const CppAdInterface::sparse_matrix_t& matrix, const CppAdInterface::sparse_matrix_t& structure) {
+  if (!matrix.isCompressed() || matrix.rows() != structure.rows() || matrix.cols() != structure.cols() ||
+      matrix.nonZeros() != structure.nonZeros()) {
+    return false;
+  }
+  return std::equal(structure.outerIndexPtr(), structure.outerIndexPtr() + structure.outerSize() + 1, matrix.outerIndexPtr()) &&
+         std::equal(structure.innerIndexPtr(), structure.innerIndexPtr() + structure.nonZeros(), matrix.innerIndexPtr());
+}
+}  // unnamed namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -69,8 +105,15 @@ CppAdInterface::CppAdInterface(const CppAdInterface& rhs)
 /******************************************************************************************************/
 /******************************************************************************************************/
 void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool verbose) {
-  createFolderStructure();
+  auto modelGeneration = tapeModel(approximationOrder);
+  generateSources(approximationOrder, modelGeneration);
+  compileModels(modelGeneration, verbose);
+}
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdInterface::ModelGeneration CppAdInterface::tapeModel(ApproximationOrder approximationOrder) {
   // set and declare independent variables and start tape recording
   ad_vector_t xp(variableDim_ + parameterDim_);
   xp.setOnes();  // Ones are better than zero, to prevent devision by zero in taping
@@ -85,16 +128,50 @@ void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool ve
   adFunction_(x, p, y);
   rangeDim_ = y.rows();
   // create f: xp -> y and stop tape recording
-  ad_fun_t fun(xp, y);
+  ModelGeneration modelGeneration;
+  modelGeneration.fun.reset(new ad_fun_t(xp, y));
   // Optimize the operation sequence
-  fun.optimize();
+  modelGeneration.fun->optimize();
+
+  // The source of the zero order model is a canonical representation of the taped operation sequence. The derivatives follow from it
+  // and the approximation order, so they do not need to be generated for the cache key.
+  ModelCSourceGenWithSources zeroOrderSourceGen(*modelGeneration.fun, modelName_);
+  uint64_t hash = 14695981039346656037ULL;
+  for (const auto& source : zeroOrderSourceGen.getSources()) {
+    hash = hashCombine(hash, source.first);
+    hash = hashCombine(hash, source.second);
+  }
+  hash = hashCombine(hash, std::to_string(variableDim_) + "," + std::to_string(parameterDim_) + "," + std::to_string(rangeDim_) + "," +
+                               std::to_string(static_cast<int>(approximationOrder)));
+  for (const auto& flag : compileFlags_) {
+    hash = hashCombine(hash, flag);
+  }
 
-  // generates source code
-  CppAD::cg::ModelCSourceGen<scalar_t> sourceGen(fun, modelName_);
-  setApproximationOrder(approximationOrder, sourceGen, fun);
+  std::ostringstream cacheKey;
+  cacheKey << std::hex << std::setw(16) << std::setfill('0') << hash;
+  modelGeneration.cacheKey = cacheKey.str();
+  return modelGeneration;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::generateSources(ApproximationOrder approximationOrder, ModelGeneration& modelGeneration) const {
+  std::unique_ptr<ModelCSourceGenWithSources> sourceGen(new ModelCSourceGenWithSources(*modelGeneration.fun, modelName_));
+  setApproximationOrder(approximationOrder, *sourceGen, *modelGeneration.fun);
+  // The sources are stored in the generator and reused by the compilation
+  sourceGen->getSources();
+  modelGeneration.sourceGen = std::move(sourceGen);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::compileModels(ModelGeneration& modelGeneration, bool verbose) {
+  createFolderStructure();
 
   // Compiler objects, compile to temporary shared library file to avoid interference between processes
-  CppAD::cg::ModelLibraryCSourceGen<scalar_t> libraryCSourceGen(sourceGen);
+  CppAD::cg::ModelLibraryCSourceGen<scalar_t> libraryCSourceGen(*modelGeneration.sourceGen);
   CppAD::cg::GccCompiler<scalar_t> gccCompiler;
   CppAD::cg::DynamicModelLibraryProcessor<scalar_t> libraryProcessor(libraryCSourceGen, libraryName_ + tmpName_);
   setCompilerOptions(gccCompiler);
@@ -117,6 +194,10 @@ void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool ve
   }
   boost::filesystem::rename(libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION,
                             libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
+
+  // Store the key of the library next to it
+  std::ofstream cacheKeyFile(cacheKeyFileName_);
+  cacheKeyFile << modelGeneration.cacheKey << std::endl;
 }
 
 /******************************************************************************************************/
@@ -138,10 +219,15 @@ void CppAdInterface::loadModels(bool verbose) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void CppAdInterface::loadModelsIfAvailable(ApproximationOrder approximationOrder, bool verbose) {
-  if (isLibraryAvailable()) {
+  auto modelGeneration = tapeModel(approximationOrder);
+  if (isCacheValid(modelGeneration.cacheKey)) {
     loadModels(verbose);
   } else {
-    createModels(approximationOrder, verbose);
+    if (verbose && isLibraryAvailable()) {
+      std::cerr << "[CppAdInterface] Library on disk was generated from a different model, it will be recompiled." << std::endl;
+    }
+    generateSources(approximationOrder, modelGeneration);
+    compileModels(modelGeneration, verbose);
   }
 }
 
@@ -149,13 +235,9 @@ void CppAdInterface::loadModelsIfAvailable(ApproximationOrder approximationOrder
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t CppAdInterface::getFunctionValue(const vector_t& x, const vector_t& p) const {
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-
-  vector_t functionValue(model_->Range());
-
-  model_->ForwardZero(xp, functionValue);
-  assert(functionValue.allFinite());
+  Workspace workspace;
+  vector_t functionValue(rangeDim_);
+  getFunctionValueInto(x, p, functionValue, workspace);
   return functionValue;
 }
 
@@ -163,13 +245,84 @@ vector_t CppAdInterface::getFunctionValue(const vector_t& x, const vector_t& p)
 /******************************************************************************************************/
 /******************************************************************************************************/
 matrix_t CppAdInterface::getJacobian(const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<scalar_t> xpArrayView(xp.data(), xp.size());
+  Workspace workspace;
+  matrix_t jacobian(rangeDim_, variableDim_);
+  getJacobianInto(x, p, jacobian, workspace);
+  return jacobian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation(const vector_t& x, const vector_t& p) const {
+  Workspace workspace;
+  ScalarFunctionQuadraticApproximation gnApprox;
+  getGaussNewtonApproximationInto(x, p, gnApprox, workspace);
+  return gnApprox;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t CppAdInterface::getHessian(size_t outputIndex, const vector_t& x, const vector_t& p) const {
+  Workspace workspace;
+  matrix_t hessian(variableDim_, variableDim_);
+  getHessianInto(outputIndex, x, p, hessian, workspace);
+  return hessian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const vector_t& p) const {
+  Workspace workspace;
+  matrix_t hessian(variableDim_, variableDim_);
+  getHessianInto(w, x, p, hessian, workspace);
+  return hessian;
+}
 
-  std::vector<scalar_t> sparseJacobian(nnzJacobian_);
-  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdInterface::sparse_matrix_t CppAdInterface::getSparseJacobian(const vector_t& x, const vector_t& p) const {
+  Workspace workspace;
+  sparse_matrix_t jacobian;
+  getSparseJacobianInto(x, p, jacobian, workspace);
+  return jacobian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+CppAdInterface::sparse_matrix_t CppAdInterface::getSparseHessian(const vector_t& w, const vector_t& x, const vector_t& p) const {
+  Workspace workspace;
+  sparse_matrix_t hessian;
+  getSparseHessianInto(w, x, p, hessian, workspace);
+  return hessian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getFunctionValueInto(const vector_t& x, const vector_t& p, Eigen::Ref<vector_t> y, Workspace& workspace) const {
+  assert(y.size() == rangeDim_);
+  setInput(x, p, workspace);
+
+  model_->ForwardZero(CppAD::cg::ArrayView<const scalar_t>(workspace.xp.data(), workspace.xp.size()),
+                      CppAD::cg::ArrayView<scalar_t>(y.data(), y.size()));
+  assert(y.allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getJacobianInto(const vector_t& x, const vector_t& p, Eigen::Ref<matrix_t> jacobian, Workspace& workspace) const {
+  assert(jacobian.rows() == rangeDim_ && jacobian.cols() == variableDim_);
+  setInput(x, p, workspace);
+  CppAD::cg::ArrayView<const scalar_t> xpArrayView(workspace.xp.data(), workspace.xp.size());
+
+  workspace.sparseValues.resize(nnzJacobian_);
+  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(workspace.sparseValues.data(), nnzJacobian_);
   size_t const* rows;
   size_t const* cols;
   // Call this particular SparseJacobian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
@@ -177,34 +330,32 @@ matrix_t CppAdInterface::getJacobian(const vector_t& x, const vector_t& p) const
 
   // Write sparse elements into Eigen type. Only jacobian w.r.t. variables was requested, so cols should not contain elements corresponding
   // to parameters.
-  matrix_t jacobian = matrix_t::Zero(model_->Range(), variableDim_);
+  jacobian.setZero();
   for (size_t i = 0; i < nnzJacobian_; i++) {
-    jacobian(rows[i], cols[i]) = sparseJacobian[i];
+    jacobian(rows[i], cols[i]) = workspace.sparseValues[i];
   }
 
   assert(jacobian.allFinite());
-  return jacobian;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation(const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<scalar_t> xpArrayView(xp.data(), xp.size());
-
-  ScalarFunctionQuadraticApproximation gnApprox;
+void CppAdInterface::getGaussNewtonApproximationInto(const vector_t& x, const vector_t& p,
+                                                     ScalarFunctionQuadraticApproximation& gnApprox, Workspace& workspace) const {
+  setInput(x, p, workspace);
+  CppAD::cg::ArrayView<const scalar_t> xpArrayView(workspace.xp.data(), workspace.xp.size());
 
   // Zero order
-  vector_t valueVector(model_->Range());
-  model_->ForwardZero(xp, valueVector);
+  auto& valueVector = workspace.functionValue;
+  valueVector.resize(rangeDim_);
+  model_->ForwardZero(xpArrayView, CppAD::cg::ArrayView<scalar_t>(valueVector.data(), rangeDim_));
   gnApprox.f = 0.5 * valueVector.squaredNorm();
 
   // Jacobian
-  std::vector<scalar_t> sparseJacobian(nnzJacobian_);
-  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
+  auto& sparseJacobian = workspace.sparseValues;
+  sparseJacobian.resize(nnzJacobian_);
+  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian.data(), nnzJacobian_);
   size_t const* rows;
   size_t const* cols;
   model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
@@ -230,7 +381,7 @@ ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation
     gnApprox.dfdxx(col_i, col_i) += v_i * v_i;
     // Process off-diagonals
     size_t j = i + 1;
-    while (rows[j] == row_i) {
+    while (j < nnzJacobian_ && rows[j] == row_i) {
       const size_t col_j = cols[j];
       gnApprox.dfdxx(col_j, col_i) += v_i * sparseJacobian[j];
       gnApprox.dfdxx(col_i, col_j) = gnApprox.dfdxx(col_j, col_i);  // Maintain symmetry as we go.
@@ -240,30 +391,30 @@ ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation
 
   assert(gnApprox.dfdx.allFinite());
   assert(gnApprox.dfdxx.allFinite());
-  return gnApprox;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-matrix_t CppAdInterface::getHessian(size_t outputIndex, const vector_t& x, const vector_t& p) const {
-  vector_t w = vector_t::Zero(rangeDim_);
-  w[outputIndex] = 1.0;
+void CppAdInterface::getHessianInto(size_t outputIndex, const vector_t& x, const vector_t& p, Eigen::Ref<matrix_t> hessian,
+                                    Workspace& workspace) const {
+  workspace.weights.setZero(rangeDim_);
+  workspace.weights[outputIndex] = 1.0;
 
-  return getHessian(w, x, p);
+  getHessianInto(workspace.weights, x, p, hessian, workspace);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<const scalar_t> xpArrayView(xp.data(), xp.size());
+void CppAdInterface::getHessianInto(const vector_t& w, const vector_t& x, const vector_t& p, Eigen::Ref<matrix_t> hessian,
+                                    Workspace& workspace) const {
+  assert(hessian.rows() == variableDim_ && hessian.cols() == variableDim_);
+  setInput(x, p, workspace);
+  CppAD::cg::ArrayView<const scalar_t> xpArrayView(workspace.xp.data(), workspace.xp.size());
 
-  std::vector<scalar_t> sparseHessian(nnzHessian_);
-  CppAD::cg::ArrayView<scalar_t> sparseHessianArrayView(sparseHessian);
+  workspace.sparseValues.resize(nnzHessian_);
+  CppAD::cg::ArrayView<scalar_t> sparseHessianArrayView(workspace.sparseValues.data(), nnzHessian_);
   size_t const* rows;
   size_t const* cols;
 
@@ -273,16 +424,75 @@ matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const
   model_->SparseHessian(xpArrayView, wArrayView, sparseHessianArrayView, &rows, &cols);
 
   // Fills upper triangular sparsity of hessian w.r.t variables.
-  matrix_t hessian = matrix_t::Zero(variableDim_, variableDim_);
+  hessian.setZero();
   for (size_t i = 0; i < nnzHessian_; i++) {
-    hessian(rows[i], cols[i]) = sparseHessian[i];
+    hessian(rows[i], cols[i]) = workspace.sparseValues[i];
   }
 
   // Copy upper triangular to lower triangular part
   hessian.template triangularView<Eigen::StrictlyLower>() = hessian.template triangularView<Eigen::StrictlyUpper>().transpose();
 
   assert(hessian.allFinite());
-  return hessian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getSparseJacobianInto(const vector_t& x, const vector_t& p, sparse_matrix_t& jacobian, Workspace& workspace) const {
+  setInput(x, p, workspace);
+  CppAD::cg::ArrayView<const scalar_t> xpArrayView(workspace.xp.data(), workspace.xp.size());
+
+  // The model returns the nonzeros ordered by row, then by column. This is the order of the compressed row-major storage.
+  if (!hasSparsityStructure(jacobian, jacobianStructure_)) {
+    jacobian = jacobianStructure_;
+  }
+  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(jacobian.valuePtr(), nnzJacobian_);
+  size_t const* rows;
+  size_t const* cols;
+  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+
+  assert(Eigen::Map<const vector_t>(jacobian.valuePtr(), nnzJacobian_).allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getSparseHessianInto(size_t outputIndex, const vector_t& x, const vector_t& p, sparse_matrix_t& hessian,
+                                          Workspace& workspace) const {
+  workspace.weights.setZero(rangeDim_);
+  workspace.weights[outputIndex] = 1.0;
+
+  getSparseHessianInto(workspace.weights, x, p, hessian, workspace);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getSparseHessianInto(const vector_t& w, const vector_t& x, const vector_t& p, sparse_matrix_t& hessian,
+                                          Workspace& workspace) const {
+  setInput(x, p, workspace);
+  CppAD::cg::ArrayView<const scalar_t> xpArrayView(workspace.xp.data(), workspace.xp.size());
+  CppAD::cg::ArrayView<const scalar_t> wArrayView(w.data(), w.size());
+
+  // Same ordering as the Jacobian, see getSparseJacobianInto.
+  if (!hasSparsityStructure(hessian, hessianStructure_)) {
+    hessian = hessianStructure_;
+  }
+  CppAD::cg::ArrayView<scalar_t> sparseHessianArrayView(hessian.valuePtr(), nnzHessian_);
+  size_t const* rows;
+  size_t const* cols;
+  model_->SparseHessian(xpArrayView, wArrayView, sparseHessianArrayView, &rows, &cols);
+
+  assert(Eigen::Map<const vector_t>(hessian.valuePtr(), nnzHessian_).allFinite());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::setInput(const vector_t& x, const vector_t& p, Workspace& workspace) const {
+  workspace.xp.resize(variableDim_ + parameterDim_);
+  workspace.xp.head(variableDim_) = x;
+  workspace.xp.tail(parameterDim_) = p;
 }
 
 /******************************************************************************************************/
@@ -297,6 +507,7 @@ void CppAdInterface::setFolderNames() {
   tmpName_ = getUniqueTemporaryName();
   tmpFolder_ = libraryFolder_ + "/" + tmpName_;
   libraryName_ = libraryFolder_ + "/" + modelName_ + "_lib";
+  cacheKeyFileName_ = libraryName_ + ".key";
 }
 
 /******************************************************************************************************/
@@ -306,6 +517,19 @@ bool CppAdInterface::isLibraryAvailable() const {
   return boost::filesystem::exists(libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool CppAdInterface::isCacheValid(const std::string& cacheKey) const {
+  if (!isLibraryAvailable()) {
+    return false;
+  }
+  std::ifstream cacheKeyFile(cacheKeyFileName_);
+  std::string storedCacheKey;
+  cacheKeyFile >> storedCacheKey;
+  return storedCacheKey == cacheKey;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -367,11 +591,30 @@ void CppAdInterface::setApproximationOrder(ApproximationOrder approximationOrder
 /******************************************************************************************************/
 /******************************************************************************************************/
 void CppAdInterface::setSparsityNonzeros() {
+  // Compressed structure with zero values of a sparsity pattern with numRows x variableDim entries
+  const auto getStructure = [this](const cppad_sparsity::SparsityPattern& sparsity, size_t numRows) {
+    std::vector<Eigen::Triplet<scalar_t>> triplets;
+    for (size_t row = 0; row < numRows; row++) {
+      for (const auto col : sparsity[row]) {
+        triplets.emplace_back(row, col, 0.0);
+      }
+    }
+    sparse_matrix_t structure(numRows, variableDim_);
+    structure.setFromTriplets(triplets.begin(), triplets.end());
+    structure.makeCompressed();
+    return structure;
+  };
+
   if (model_->isJacobianSparsityAvailable()) {
-    nnzJacobian_ = cppad_sparsity::getNumberOfNonZeros(model_->JacobianSparsitySet());
+    jacobianSparsity_ = model_->JacobianSparsitySet();
+    nnzJacobian_ = cppad_sparsity::getNumberOfNonZeros(jacobianSparsity_);
+    jacobianStructure_ = getStructure(jacobianSparsity_, jacobianSparsity_.size());
   }
   if (model_->isHessianSparsityAvailable()) {
-    nnzHessian_ = cppad_sparsity::getNumberOfNonZeros(model_->HessianSparsitySet());
+    // The pattern has rows for the parameters as well, which are empty.
+    hessianSparsity_ = model_->HessianSparsitySet();
+    nnzHessian_ = cppad_sparsity::getNumberOfNonZeros(hessianSparsity_);
+    hessianStructure_ = getStructure(hessianSparsity_, variableDim_);
   }
 }
 
@@ -86,5 +86,20 @@ size_t getNumberOfNonZeros(const SparsityPattern& sparsityPattern) {
   return nnz;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool isBlockZero(const SparsityPattern& sparsityPattern, size_t startRow, size_t startCol, size_t numRows, size_t numCols) {
+  const size_t endRow = std::min(startRow + numRows, sparsityPattern.size());
+  for (size_t row = startRow; row < endRow; row++) {
+    // First nonzero column at or after startCol
+    const auto firstCol = sparsityPattern[row].lower_bound(startCol);
+    if (firstCol != sparsityPattern[row].end() && *firstCol < startCol + numCols) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace cppad_sparsity
 }  // namespace ocs2
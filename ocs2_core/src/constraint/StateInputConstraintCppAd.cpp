@@ -70,9 +70,11 @@ StateInputConstraintCppAd::StateInputConstraintCppAd(const StateInputConstraintC
 /******************************************************************************************************/
 vector_t StateInputConstraintCppAd::getValue(scalar_t time, const vector_t& state, const vector_t& input,
                                              const PreComputation& preComputation) const {
-  vector_t tapedTimeStateInput(1 + state.rows() + input.rows());
-  tapedTimeStateInput << time, state, input;
-  return adInterfacePtr_->getFunctionValue(tapedTimeStateInput, getParameters(time, preComputation));
+  tapedTimeStateInput_.resize(1 + state.rows() + input.rows());
+  tapedTimeStateInput_ << time, state, input;
+  vector_t constraintValue(adInterfacePtr_->getRangeDim());
+  adInterfacePtr_->getFunctionValueInto(tapedTimeStateInput_, getParameters(time, preComputation), constraintValue, workspace_);
+  return constraintValue;
 }
 
 /******************************************************************************************************/
@@ -86,13 +88,16 @@ VectorFunctionLinearApproximation StateInputConstraintCppAd::getLinearApproximat
   const size_t stateDim = state.rows();
   const size_t inputDim = input.rows();
   const vector_t params = getParameters(time, preComputation);
-  vector_t tapedTimeStateInput(1 + stateDim + inputDim);
-  tapedTimeStateInput << time, state, input;
+  tapedTimeStateInput_.resize(1 + stateDim + inputDim);
+  tapedTimeStateInput_ << time, state, input;
 
-  constraint.f = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params);
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
-  constraint.dfdx = J.middleCols(1, stateDim);
-  constraint.dfdu = J.rightCols(inputDim);
+  const size_t numConstraints = adInterfacePtr_->getRangeDim();
+  constraint.f.resize(numConstraints);
+  adInterfacePtr_->getFunctionValueInto(tapedTimeStateInput_, params, constraint.f, workspace_);
+  jacobian_.resize(numConstraints, 1 + stateDim + inputDim);
+  adInterfacePtr_->getJacobianInto(tapedTimeStateInput_, params, jacobian_, workspace_);
+  constraint.dfdx = jacobian_.middleCols(1, stateDim);
+  constraint.dfdu = jacobian_.rightCols(inputDim);
 
   return constraint;
 }
@@ -112,23 +117,26 @@ VectorFunctionQuadraticApproximation StateInputConstraintCppAd::getQuadraticAppr
   const size_t stateDim = state.rows();
   const size_t inputDim = input.rows();
   const vector_t params = getParameters(time, preComputation);
-  vector_t tapedTimeStateInput(1 + stateDim + inputDim);
-  tapedTimeStateInput << time, state, input;
+  tapedTimeStateInput_.resize(1 + stateDim + inputDim);
+  tapedTimeStateInput_ << time, state, input;
 
-  constraint.f = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params);
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
-  constraint.dfdx = J.middleCols(1, stateDim);
-  constraint.dfdu = J.rightCols(inputDim);
+  const size_t numConstraints = adInterfacePtr_->getRangeDim();
+  constraint.f.resize(numConstraints);
+  adInterfacePtr_->getFunctionValueInto(tapedTimeStateInput_, params, constraint.f, workspace_);
+  jacobian_.resize(numConstraints, 1 + stateDim + inputDim);
+  adInterfacePtr_->getJacobianInto(tapedTimeStateInput_, params, jacobian_, workspace_);
+  constraint.dfdx = jacobian_.middleCols(1, stateDim);
+  constraint.dfdu = jacobian_.rightCols(inputDim);
 
-  const size_t numConstraints = constraint.f.rows();
   constraint.dfdxx.resize(numConstraints);
   constraint.dfdux.resize(numConstraints);
   constraint.dfduu.resize(numConstraints);
+  hessian_.resize(1 + stateDim + inputDim, 1 + stateDim + inputDim);
   for (int i = 0; i < numConstraints; i++) {
-    const matrix_t H = adInterfacePtr_->getHessian(i, tapedTimeStateInput, params);
-    constraint.dfdxx[i] = H.block(1, 1, stateDim, stateDim);
-    constraint.dfdux[i] = H.block(1 + stateDim, 1, inputDim, stateDim);
-    constraint.dfduu[i] = H.bottomRightCorner(inputDim, inputDim);
+    adInterfacePtr_->getHessianInto(i, tapedTimeStateInput_, params, hessian_, workspace_);
+    constraint.dfdxx[i] = hessian_.block(1, 1, stateDim, stateDim);
+    constraint.dfdux[i] = hessian_.block(1 + stateDim, 1, inputDim, stateDim);
+    constraint.dfduu[i] = hessian_.bottomRightCorner(inputDim, inputDim);
   }
 
   return constraint;
@@ -90,6 +90,13 @@ vector_t FeedforwardController::computeInput(scalar_t t, const vector_t& x) {
   return LinearInterpolation::interpolate(t, timeStamp_, uffArray_);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FeedforwardController::computeInput(scalar_t t, const vector_t& x, LinearInterpolation::TimeSegmentCursor& cursor, vector_t& u) {
+  LinearInterpolation::interpolate(cursor.timeSegment(t, timeStamp_), uffArray_, u);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
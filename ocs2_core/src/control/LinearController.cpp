@@ -77,13 +77,23 @@ void LinearController::setController(const scalar_array_t& controllerTime, const
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t LinearController::computeInput(scalar_t t, const vector_t& x) {
-  const auto indexAlpha = LinearInterpolation::timeSegment(t, timeStamp_);
+  LinearInterpolation::TimeSegmentCursor cursor;
+  vector_t u;
+  computeInput(t, x, cursor, u);
+  return u;
+}
 
-  vector_t uff = LinearInterpolation::interpolate(indexAlpha, biasArray_);
-  const matrix_t k = LinearInterpolation::interpolate(indexAlpha, gainArray_);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void LinearController::computeInput(scalar_t t, const vector_t& x, LinearInterpolation::TimeSegmentCursor& cursor, vector_t& u) {
+  const auto indexAlpha = cursor.timeSegment(t, timeStamp_);
+  LinearInterpolation::interpolate(indexAlpha, biasArray_, u);
 
-  uff.noalias() += k * x;
-  return uff;
+  // The gain buffer is per thread, since a controller can be evaluated concurrently. It only allocates if the dimensions change.
+  static thread_local matrix_t gain;
+  LinearInterpolation::interpolate(indexAlpha, gainArray_, gain);
+  u.noalias() += gain * x;
 }
 
 /******************************************************************************************************/
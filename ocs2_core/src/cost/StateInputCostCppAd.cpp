@@ -64,9 +64,11 @@ StateInputCostCppAd::StateInputCostCppAd(const StateInputCostCppAd& rhs)
 /******************************************************************************************************/
 scalar_t StateInputCostCppAd::getValue(scalar_t time, const vector_t& state, const vector_t& input,
                                        const TargetTrajectories& targetTrajectories, const PreComputation& preComputation) const {
-  vector_t tapedTimeStateInput(1 + state.rows() + input.rows());
-  tapedTimeStateInput << time, state, input;
-  return adInterfacePtr_->getFunctionValue(tapedTimeStateInput, getParameters(time, targetTrajectories, preComputation))(0);
+  tapedTimeStateInput_.resize(1 + state.rows() + input.rows());
+  tapedTimeStateInput_ << time, state, input;
+  value_.resize(1);
+  adInterfacePtr_->getFunctionValueInto(tapedTimeStateInput_, getParameters(time, targetTrajectories, preComputation), value_, workspace_);
+  return value_(0);
 }
 
 /******************************************************************************************************/
@@ -81,19 +83,37 @@ ScalarFunctionQuadraticApproximation StateInputCostCppAd::getQuadraticApproximat
   const size_t stateDim = state.rows();
   const size_t inputDim = input.rows();
   const vector_t params = getParameters(time, targetTrajectories, preComputation);
-  vector_t tapedTimeStateInput(1 + stateDim + inputDim);
-  tapedTimeStateInput << time, state, input;
-
-  cost.f = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params)(0);
-
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
-  cost.dfdx = J.middleCols(1, stateDim).transpose();
-  cost.dfdu = J.rightCols(inputDim).transpose();
-
-  const matrix_t H = adInterfacePtr_->getHessian(0, tapedTimeStateInput, params);
-  cost.dfdxx = H.block(1, 1, stateDim, stateDim);
-  cost.dfdux = H.block(1 + stateDim, 1, inputDim, stateDim);
-  cost.dfduu = H.bottomRightCorner(inputDim, inputDim);
+  tapedTimeStateInput_.resize(1 + stateDim + inputDim);
+  tapedTimeStateInput_ << time, state, input;
+
+  value_.resize(1);
+  adInterfacePtr_->getFunctionValueInto(tapedTimeStateInput_, params, value_, workspace_);
+  cost.f = value_(0);
+
+  jacobian_.resize(1, 1 + stateDim + inputDim);
+  adInterfacePtr_->getJacobianInto(tapedTimeStateInput_, params, jacobian_, workspace_);
+  cost.dfdx = jacobian_.middleCols(1, stateDim).transpose();
+  cost.dfdu = jacobian_.rightCols(inputDim).transpose();
+
+  // Scatter the structural nonzeros of the upper triangular Hessian into the blocks. The time row and column are skipped.
+  adInterfacePtr_->getSparseHessianInto(0, tapedTimeStateInput_, params, hessian_, workspace_);
+  const auto& H = hessian_;
+  cost.dfdxx.setZero(stateDim, stateDim);
+  cost.dfdux.setZero(inputDim, stateDim);
+  cost.dfduu.setZero(inputDim, inputDim);
+  const int nx = stateDim;
+  for (int row = 1; row < H.outerSize(); ++row) {
+    for (CppAdInterface::sparse_matrix_t::InnerIterator it(H, row); it; ++it) {
+      const int col = it.col();
+      if (row <= nx && col <= nx) {
+        cost.dfdxx(row - 1, col - 1) = cost.dfdxx(col - 1, row - 1) = it.value();
+      } else if (row <= nx) {
+        cost.dfdux(col - 1 - nx, row - 1) = it.value();
+      } else {
+        cost.dfduu(row - 1 - nx, col - 1 - nx) = cost.dfduu(col - 1 - nx, row - 1 - nx) = it.value();
+      }
+    }
+  }
 
   return cost;
 }
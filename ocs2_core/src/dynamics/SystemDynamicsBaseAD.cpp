@@ -99,7 +99,9 @@ void SystemDynamicsBaseAD::initialize(size_t stateDim, size_t inputDim, const st
 vector_t SystemDynamicsBaseAD::computeFlowMap(scalar_t t, const vector_t& x, const vector_t& u, const PreComputation& preComputation) {
   tapedTimeStateInput_ << t, x, u;
   const vector_t parameters = getFlowMapParameters(t, preComputation);
-  return flowMapADInterfacePtr_->getFunctionValue(tapedTimeStateInput_, parameters);
+  vector_t flowMap(flowMapADInterfacePtr_->getRangeDim());
+  flowMapADInterfacePtr_->getFunctionValueInto(tapedTimeStateInput_, parameters, flowMap, workspace_);
+  return flowMap;
 }
 
 /*******************q**********************************************************************************/
@@ -108,7 +110,9 @@ vector_t SystemDynamicsBaseAD::computeFlowMap(scalar_t t, const vector_t& x, con
 vector_t SystemDynamicsBaseAD::computeJumpMap(scalar_t t, const vector_t& x, const PreComputation& preComputation) {
   tapedTimeState_ << t, x;
   const vector_t parameters = getJumpMapParameters(t, preComputation);
-  return jumpMapADInterfacePtr_->getFunctionValue(tapedTimeState_, parameters);
+  vector_t jumpMap(jumpMapADInterfacePtr_->getRangeDim());
+  jumpMapADInterfacePtr_->getFunctionValueInto(tapedTimeState_, parameters, jumpMap, workspace_);
+  return jumpMap;
 }
 
 /******************************************************************************************************/
@@ -117,7 +121,9 @@ vector_t SystemDynamicsBaseAD::computeJumpMap(scalar_t t, const vector_t& x, con
 vector_t SystemDynamicsBaseAD::computeGuardSurfaces(scalar_t t, const vector_t& x) {
   tapedTimeState_ << t, x;
   const vector_t parameters = getGuardSurfacesParameters(t);
-  return guardSurfacesADInterfacePtr_->getFunctionValue(tapedTimeState_, parameters);
+  vector_t guardSurfaces(guardSurfacesADInterfacePtr_->getRangeDim());
+  guardSurfacesADInterfacePtr_->getFunctionValueInto(tapedTimeState_, parameters, guardSurfaces, workspace_);
+  return guardSurfaces;
 }
 
 /******************************************************************************************************/
@@ -127,12 +133,14 @@ VectorFunctionLinearApproximation SystemDynamicsBaseAD::linearApproximation(scal
                                                                             const PreComputation& preComputation) {
   tapedTimeStateInput_ << t, x, u;
   const vector_t parameters = getFlowMapParameters(t, preComputation);
-  flowJacobian_ = flowMapADInterfacePtr_->getJacobian(tapedTimeStateInput_, parameters);
+  flowJacobian_.resize(flowMapADInterfacePtr_->getRangeDim(), tapedTimeStateInput_.size());
+  flowMapADInterfacePtr_->getJacobianInto(tapedTimeStateInput_, parameters, flowJacobian_, workspace_);
 
   VectorFunctionLinearApproximation approximation;
   approximation.dfdx = flowJacobian_.middleCols(1, x.rows());
   approximation.dfdu = flowJacobian_.rightCols(u.rows());
-  approximation.f = flowMapADInterfacePtr_->getFunctionValue(tapedTimeStateInput_, parameters);
+  approximation.f.resize(flowJacobian_.rows());
+  flowMapADInterfacePtr_->getFunctionValueInto(tapedTimeStateInput_, parameters, approximation.f, workspace_);
   return approximation;
 }
 
@@ -143,12 +151,14 @@ VectorFunctionLinearApproximation SystemDynamicsBaseAD::jumpMapLinearApproximati
                                                                                    const PreComputation& preComputation) {
   tapedTimeState_ << t, x;
   const vector_t parameters = getJumpMapParameters(t, preComputation);
-  jumpJacobian_ = jumpMapADInterfacePtr_->getJacobian(tapedTimeState_, parameters);
+  jumpJacobian_.resize(jumpMapADInterfacePtr_->getRangeDim(), tapedTimeState_.size());
+  jumpMapADInterfacePtr_->getJacobianInto(tapedTimeState_, parameters, jumpJacobian_, workspace_);
 
   VectorFunctionLinearApproximation approximation;
   approximation.dfdx = jumpJacobian_.rightCols(x.rows());
   approximation.dfdu.setZero(jumpJacobian_.rows(), 0);
-  approximation.f = jumpMapADInterfacePtr_->getFunctionValue(tapedTimeState_, parameters);
+  approximation.f.resize(jumpJacobian_.rows());
+  jumpMapADInterfacePtr_->getFunctionValueInto(tapedTimeState_, parameters, approximation.f, workspace_);
   return approximation;
 }
 
@@ -158,12 +168,14 @@ VectorFunctionLinearApproximation SystemDynamicsBaseAD::jumpMapLinearApproximati
 VectorFunctionLinearApproximation SystemDynamicsBaseAD::guardSurfacesLinearApproximation(scalar_t t, const vector_t& x, const vector_t& u) {
   tapedTimeState_ << t, x;
   const vector_t parameters = getGuardSurfacesParameters(t);
-  guardJacobian_ = guardSurfacesADInterfacePtr_->getJacobian(tapedTimeState_, parameters);
+  guardJacobian_.resize(guardSurfacesADInterfacePtr_->getRangeDim(), tapedTimeState_.size());
+  guardSurfacesADInterfacePtr_->getJacobianInto(tapedTimeState_, parameters, guardJacobian_, workspace_);
 
   VectorFunctionLinearApproximation approximation;
   approximation.dfdx = guardJacobian_.rightCols(x.rows());
   approximation.dfdu = matrix_t::Zero(guardJacobian_.rows(), u.rows());  // not provided
-  approximation.f = guardSurfacesADInterfacePtr_->getFunctionValue(tapedTimeState_, parameters);
+  approximation.f.resize(guardJacobian_.rows());
+  guardSurfacesADInterfacePtr_->getFunctionValueInto(tapedTimeState_, parameters, approximation.f, workspace_);
   return approximation;
 }
 
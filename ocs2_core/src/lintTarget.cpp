@@ -71,6 +71,7 @@
 #include <ocs2_core/misc/randomMatrices.h>
 
 // thread_support
+#include <ocs2_core/thread_support/BoundedQueue.h>
 #include <ocs2_core/thread_support/BufferedValue.h>
 #include <ocs2_core/thread_support/SetThreadPriority.h>
 #include <ocs2_core/thread_support/Synchronized.h>
@@ -32,14 +32,30 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+/** Hints the processor that the calling thread is in a spin-wait loop. */
+inline void spinPause() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#else
+  std::this_thread::yield();
+#endif
+}
+}  // unnamed namespace
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
-ThreadPool::ThreadPool(size_t nThreads, int priority) {
+ThreadPool::ThreadPool(size_t nThreads, int priority, std::vector<int> cpuAffinity) {
   workerThreads_.reserve(nThreads);
   for (size_t i = 0; i < nThreads; i++) {
     workerThreads_.emplace_back(&ThreadPool::worker, this, i);
     setThreadPriority(priority, workerThreads_.back());
+    if (!cpuAffinity.empty()) {
+      setThreadAffinity({cpuAffinity[i % cpuAffinity.size()]}, workerThreads_.back());
+    }
   }
 }
 
@@ -50,6 +66,7 @@ ThreadPool::~ThreadPool() {
   {  // set exit flag, wake up threads and join
     std::lock_guard<std::mutex> lock(taskQueueLock_);
     stop_ = true;
+    workAvailable_ = true;
   }
   taskQueueCondition_.notify_all();
   for (auto& thread : workerThreads_) {
@@ -59,26 +76,54 @@ ThreadPool::~ThreadPool() {
   }
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+bool ThreadPool::hasWork() const {
+  return !taskQueue_.empty() || (parallelJobPtr_ != nullptr && parallelJobPtr_->numUnclaimed > 0) || stop_;
+}
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
 void ThreadPool::worker(int workerIndex) {
   while (true) {
+    // In the hot mode, spin on the atomic flag instead of sleeping on the condition variable and only take the lock once work is seen.
+    // The flag is refreshed under the lock whenever work is taken, such that every queued task is picked up even if several arrived while
+    // all workers were busy.
+    if (hotMode_ && !workAvailable_.load(std::memory_order_acquire)) {
+      spinPause();
+      continue;
+    }
+
     std::unique_ptr<ThreadPool::TaskBase> taskPtr;
+    ParallelJob* jobPtr = nullptr;
     {
       std::unique_lock<std::mutex> lock(taskQueueLock_);
-      taskQueueCondition_.wait(lock, [this] { return !taskQueue_.empty() || stop_; });
+      taskQueueCondition_.wait(lock, [&] { return hasWork() || hotMode_; });
 
       // exit condition
       if (stop_) {
         break;
       }
 
-      // pop the first task
-      if (!taskQueue_.empty()) {
+      // parallel jobs have precedence over the queued tasks since the calling thread is blocked on them
+      if (parallelJobPtr_ != nullptr && parallelJobPtr_->numUnclaimed > 0) {
+        jobPtr = parallelJobPtr_;
+        ++jobPtr->numAttachedWorkers;
+      } else if (!taskQueue_.empty()) {
         taskPtr = std::move(taskQueue_.front());
         taskQueue_.pop();
       }
+      updateWorkAvailable();
+    }
+
+    if (jobPtr != nullptr) {
+      executeParallelJob(*jobPtr, workerIndex);
+      std::lock_guard<std::mutex> lock(taskQueueLock_);
+      if (--jobPtr->numAttachedWorkers == 0) {
+        parallelJobCondition_.notify_all();
+      }
     }
 
     if (taskPtr) {
@@ -87,6 +132,22 @@ void ThreadPool::worker(int workerIndex) {
   }
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::executeParallelJob(ParallelJob& job, int workerIndex) {
+  while (job.claim()) {
+    try {
+      job.invoke(job.callable, workerIndex);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(taskQueueLock_);
+      if (!job.exception) {
+        job.exception = std::current_exception();
+      }
+    }
+  }
+}
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
@@ -94,6 +155,7 @@ void ThreadPool::runTask(std::unique_ptr<TaskBase> taskPtr) {
   {
     std::lock_guard<std::mutex> lock(taskQueueLock_);
     taskQueue_.push(std::move(taskPtr));
+    workAvailable_ = true;
   }
   taskQueueCondition_.notify_one();
 }
@@ -102,24 +164,67 @@ void ThreadPool::runTask(std::unique_ptr<TaskBase> taskPtr) {
 /**************************************************************************************************/
 /**************************************************************************************************/
 void ThreadPool::runParallel(std::function<void(int)> taskFunction, int N) {
-  // Launch tasks in helper threads
-  std::vector<std::future<void>> futures;
-  if (N > 1) {
-    const int numHelpers = N - 1;
-    futures.reserve(numHelpers);
-    for (int i = 0; i < numHelpers; ++i) {
-      futures.emplace_back(run(taskFunction));
+  ParallelJob job([](const void* callable, int workerIndex) { (*static_cast<const std::function<void(int)>*>(callable))(workerIndex); },
+                  &taskFunction, std::max(N, 1));
+  runParallelJob(job);
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::runParallelJob(ParallelJob& job) {
+  const auto workerId = static_cast<int>(numThreads());  // threadpool workers use ID 0 -> nThreads - 1
+
+  // Publish the job to the workers. Only one job can be shared at a time, a concurrent caller executes its job on its own.
+  const bool isHot = hotMode_;
+  bool isPublished = false;
+  if (!workerThreads_.empty() && job.numUnclaimed > 1) {
+    std::lock_guard<std::mutex> lock(taskQueueLock_);
+    if (parallelJobPtr_ == nullptr) {
+      parallelJobPtr_ = &job;
+      workAvailable_ = true;
+      isPublished = true;
     }
   }
+  if (isPublished && !isHot) {
+    taskQueueCondition_.notify_all();
+  }
 
-  // Execute one instance in this thread.
-  const auto workerId = static_cast<int>(numThreads());  // threadpool workers use ID 0 -> nThreads - 1
-  taskFunction(workerId);
+  // Execute in this thread until all instances are claimed.
+  executeParallelJob(job, workerId);
+
+  // Retract the job and wait for the workers to finish their claimed instances.
+  std::unique_lock<std::mutex> lock(taskQueueLock_);
+  if (isPublished) {
+    parallelJobPtr_ = nullptr;
+    updateWorkAvailable();
+    if (isHot) {
+      lock.unlock();
+      while (job.numAttachedWorkers != 0) {
+        spinPause();
+      }
+      lock.lock();
+    } else {
+      parallelJobCondition_.wait(lock, [&job] { return job.numAttachedWorkers == 0; });
+    }
+  }
+  const std::exception_ptr exception = job.exception;
+  lock.unlock();
 
-  // Wait for helpers to finish.
-  for (auto&& fut : futures) {
-    fut.get();
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::setHotMode(bool enable) {
+  {
+    std::lock_guard<std::mutex> lock(taskQueueLock_);
+    hotMode_ = enable;
   }
+  taskQueueCondition_.notify_all();
 }
 
 }  // namespace ocs2
@@ -24,3 +24,23 @@ TEST(testLinearController, testSerialization) {
     EXPECT_TRUE(controller.biasArray_[k].isApprox(controllerOut.biasArray_[k], 1e-6));
   }
 }
+
+TEST(testLinearController, testComputeInputWithCursor) {
+  scalar_array_t time = {0.0, 0.5, 0.5, 1.0};
+  vector_array_t bias = {vector_t::Random(2), vector_t::Random(2), vector_t::Random(2), vector_t::Random(2)};
+  matrix_array_t gain = {matrix_t::Random(2, 3), matrix_t::Random(2, 3), matrix_t::Random(2, 3), matrix_t::Random(2, 3)};
+  LinearController controller(time, bias, gain);
+
+  LinearInterpolation::TimeSegmentCursor cursor;
+  vector_t u;
+  for (const auto t : {-0.1, 0.0, 0.2, 0.5, 0.7, 1.0, 1.2, 0.3}) {
+    const vector_t x = vector_t::Random(3);
+    const auto indexAlpha = LinearInterpolation::timeSegment(t, time);
+    const vector_t expected =
+        LinearInterpolation::interpolate(indexAlpha, bias) + LinearInterpolation::interpolate(indexAlpha, gain) * x;
+
+    controller.computeInput(t, x, cursor, u);
+    EXPECT_TRUE(u.isApprox(expected)) << "time: " << t;
+    EXPECT_TRUE(controller.computeInput(t, x).isApprox(expected)) << "time: " << t;
+  }
+}
@@ -2,6 +2,8 @@
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/automatic_differentiation/CppAdCodeGenerator.h>
+
 #include "commonFixture.h"
 
 using namespace ocs2;
@@ -60,3 +62,196 @@ TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailable) {
   ASSERT_TRUE(gnApproximation.dfdx.isApprox(testJacobian(x, p).transpose() * testFun(x, p)));
   ASSERT_TRUE(gnApproximation.dfdxx.isApprox(testJacobian(x, p).transpose() * testJacobian(x, p)));
 }
+
+TEST(CppAdInterfaceSparsity, sparseResults) {
+  // Block structure: y(0:1) depends on x(0:1) only, y(2) depends on x(2:3) only.
+  auto sparseFun = [](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+    y.resize(3);
+    y(0) = x(0) * x(1) + p(0);
+    y(1) = x(1) * x(1);
+    y(2) = p(0) * sin(x(2)) * x(3);
+  };
+  const size_t variableDim = 4;
+  const size_t parameterDim = 1;
+  ocs2::CppAdInterface adInterface(sparseFun, variableDim, parameterDim, "testModelSparseResults");
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+
+  // Patterns
+  ASSERT_EQ(adInterface.getNumberOfJacobianNonZeros(), 5);
+  ASSERT_EQ(adInterface.getJacobianSparsityPattern().size(), 3);
+  ASSERT_EQ(adInterface.getJacobianSparsityPattern()[2], std::set<size_t>({2, 3}));
+  ASSERT_TRUE(adInterface.isJacobianBlockZero(0, 2, 2, 2));
+  ASSERT_TRUE(adInterface.isJacobianBlockZero(2, 0, 1, 2));
+  ASSERT_FALSE(adInterface.isJacobianBlockZero(0, 0, 3, 1));
+  ASSERT_TRUE(adInterface.isHessianBlockZero(0, 2, 2, 2));
+  ASSERT_FALSE(adInterface.isHessianBlockZero(2, 2, 2, 2));
+
+  for (int i = 0; i < 5; i++) {
+    const vector_t x = vector_t::Random(variableDim);
+    const vector_t p = vector_t::Random(parameterDim);
+    const vector_t w = vector_t::Random(3);
+
+    const auto sparseJacobian = adInterface.getSparseJacobian(x, p);
+    ASSERT_EQ(sparseJacobian.nonZeros(), adInterface.getNumberOfJacobianNonZeros());
+    ASSERT_TRUE(matrix_t(sparseJacobian).isApprox(adInterface.getJacobian(x, p)));
+
+    const auto sparseHessian = adInterface.getSparseHessian(w, x, p);
+    const matrix_t hessian = adInterface.getHessian(w, x, p);
+    ASSERT_EQ(sparseHessian.nonZeros(), adInterface.getNumberOfHessianNonZeros());
+    ASSERT_TRUE(matrix_t(sparseHessian.triangularView<Eigen::Upper>()).isApprox(matrix_t(hessian.triangularView<Eigen::Upper>())));
+  }
+}
+
+TEST(CppAdInterfaceWorkspace, intoResults) {
+  auto fun = [](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+    y.resize(3);
+    y(0) = x(0) * x(1) + p(0);
+    y(1) = x(1) * x(1);
+    y(2) = p(0) * sin(x(2)) * x(3);
+  };
+  const size_t variableDim = 4;
+  const size_t parameterDim = 1;
+  ocs2::CppAdInterface adInterface(fun, variableDim, parameterDim, "testModelWorkspace");
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+  ASSERT_EQ(adInterface.getRangeDim(), 3);
+
+  ocs2::CppAdInterface::Workspace workspace;
+  vector_t y(3);
+  matrix_t jacobianBlock = matrix_t::Zero(5, 2 + variableDim);  // the jacobian is written into a block of a larger matrix
+  matrix_t hessian(variableDim, variableDim);
+  ocs2::CppAdInterface::sparse_matrix_t sparseJacobian;
+  ocs2::CppAdInterface::sparse_matrix_t sparseHessian;
+  ScalarFunctionQuadraticApproximation gaussNewton;
+
+  for (int i = 0; i < 5; i++) {
+    const vector_t x = vector_t::Random(variableDim);
+    const vector_t p = vector_t::Random(parameterDim);
+    const vector_t w = vector_t::Random(3);
+
+    adInterface.getFunctionValueInto(x, p, y, workspace);
+    ASSERT_TRUE(y.isApprox(adInterface.getFunctionValue(x, p)));
+
+    adInterface.getJacobianInto(x, p, jacobianBlock.block(1, 2, 3, variableDim), workspace);
+    ASSERT_TRUE(jacobianBlock.block(1, 2, 3, variableDim).isApprox(adInterface.getJacobian(x, p)));
+    ASSERT_TRUE(jacobianBlock.leftCols(2).isZero());
+
+    adInterface.getHessianInto(w, x, p, hessian, workspace);
+    ASSERT_TRUE(hessian.isApprox(adInterface.getHessian(w, x, p)));
+    adInterface.getHessianInto(2, x, p, hessian, workspace);
+    ASSERT_TRUE(hessian.isApprox(adInterface.getHessian(2, x, p)));
+
+    adInterface.getSparseJacobianInto(x, p, sparseJacobian, workspace);
+    ASSERT_TRUE(matrix_t(sparseJacobian).isApprox(matrix_t(adInterface.getSparseJacobian(x, p))));
+    adInterface.getSparseHessianInto(w, x, p, sparseHessian, workspace);
+    ASSERT_TRUE(matrix_t(sparseHessian).isApprox(matrix_t(adInterface.getSparseHessian(w, x, p))));
+
+    adInterface.getGaussNewtonApproximationInto(x, p, gaussNewton, workspace);
+    const auto gaussNewtonReference = adInterface.getGaussNewtonApproximation(x, p);
+    ASSERT_DOUBLE_EQ(gaussNewton.f, gaussNewtonReference.f);
+    ASSERT_TRUE(gaussNewton.dfdx.isApprox(gaussNewtonReference.dfdx));
+    ASSERT_TRUE(gaussNewton.dfdxx.isApprox(gaussNewtonReference.dfdxx));
+  }
+}
+
+TEST(CppAdInterfaceWorkspace, mismatchedSparsity) {
+  auto fun = [](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+    y.resize(3);
+    y(0) = x(0) * x(1) + p(0);
+    y(1) = x(1) * x(1);
+    y(2) = p(0) * sin(x(2)) * x(3);
+  };
+  const size_t variableDim = 4;
+  const size_t parameterDim = 1;
+  ocs2::CppAdInterface adInterface(fun, variableDim, parameterDim, "testModelWorkspace");
+  adInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+
+  const vector_t x = vector_t::Random(variableDim);
+  const vector_t p = vector_t::Random(parameterDim);
+  const vector_t w = vector_t::Random(3);
+  ocs2::CppAdInterface::Workspace workspace;
+
+  // Same size and number of nonzeros as the Jacobian (5), but a different pattern
+  ocs2::CppAdInterface::sparse_matrix_t sparseJacobian(3, variableDim);
+  sparseJacobian.insert(0, 2) = 1.0;
+  sparseJacobian.insert(0, 3) = 1.0;
+  sparseJacobian.insert(1, 0) = 1.0;
+  sparseJacobian.insert(2, 0) = 1.0;
+  sparseJacobian.insert(2, 1) = 1.0;
+  sparseJacobian.makeCompressed();
+  ASSERT_EQ(sparseJacobian.nonZeros(), adInterface.getNumberOfJacobianNonZeros());
+  adInterface.getSparseJacobianInto(x, p, sparseJacobian, workspace);
+  ASSERT_TRUE(matrix_t(sparseJacobian).isApprox(adInterface.getJacobian(x, p)));
+
+  // Same number of rows and nonzeros as the Hessian, but a different number of columns
+  const size_t hessianNonZeros = adInterface.getNumberOfHessianNonZeros();
+  ocs2::CppAdInterface::sparse_matrix_t sparseHessian(variableDim, hessianNonZeros + 1);
+  for (size_t i = 0; i < hessianNonZeros; i++) {
+    sparseHessian.insert(0, i) = 1.0;
+  }
+  sparseHessian.makeCompressed();
+  adInterface.getSparseHessianInto(w, x, p, sparseHessian, workspace);
+  ASSERT_EQ(sparseHessian.cols(), variableDim);
+  ASSERT_TRUE(matrix_t(sparseHessian).isApprox(matrix_t(adInterface.getSparseHessian(w, x, p))));
+}
+
+TEST(CppAdInterfaceCache, rebuildOnModelChange) {
+  auto fun0 = [](const ad_vector_t& x, ad_vector_t& y) { y = x.array().square(); };
+  auto fun1 = [](const ad_vector_t& x, ad_vector_t& y) { y = x.array().sin(); };
+  const size_t variableDim = 3;
+  const vector_t x = vector_t::Random(variableDim);
+
+  ocs2::CppAdInterface adInterface0(fun0, variableDim, "testModelCacheRebuild");
+  adInterface0.createModels(ocs2::CppAdInterface::ApproximationOrder::First, false);
+  ASSERT_TRUE(adInterface0.getFunctionValue(x).isApprox(x.array().square().matrix()));
+
+  // Same name, different function: the library on disk is stale and has to be rebuilt
+  ocs2::CppAdInterface adInterface1(fun1, variableDim, "testModelCacheRebuild");
+  adInterface1.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::First, false);
+  ASSERT_TRUE(adInterface1.getFunctionValue(x).isApprox(x.array().sin().matrix()));
+  ASSERT_TRUE(adInterface1.getJacobian(x).isApprox(matrix_t(x.array().cos().matrix().asDiagonal())));
+
+  // Same function again: the library is reused
+  ocs2::CppAdInterface adInterface2(fun1, variableDim, "testModelCacheRebuild");
+  CppAdCodeGenerator codeGenerator(1);
+  codeGenerator.addModel(adInterface2, ocs2::CppAdInterface::ApproximationOrder::First);
+  const auto timings = codeGenerator.generate(false);
+  ASSERT_EQ(timings.size(), 1);
+  ASSERT_TRUE(timings.front().isCached);
+  ASSERT_TRUE(adInterface2.getFunctionValue(x).isApprox(x.array().sin().matrix()));
+}
+
+TEST(CppAdInterfaceCache, parallelCodeGeneration) {
+  const size_t numModels = 4;
+  const size_t variableDim = 5;
+  std::vector<std::unique_ptr<ocs2::CppAdInterface>> adInterfaces;
+  for (size_t i = 0; i < numModels; i++) {
+    auto fun = [i](const ad_vector_t& x, ad_vector_t& y) { y = ad_scalar_t(i + 1) * x.array().cube(); };
+    adInterfaces.emplace_back(new ocs2::CppAdInterface(fun, variableDim, "testModelParallel" + std::to_string(i)));
+  }
+
+  CppAdCodeGenerator codeGenerator(2);
+  for (auto& adInterface : adInterfaces) {
+    codeGenerator.addModel(*adInterface, ocs2::CppAdInterface::ApproximationOrder::Second, true);
+  }
+  const auto timings = codeGenerator.generate(true);
+
+  ASSERT_EQ(timings.size(), numModels);
+  const vector_t x = vector_t::Random(variableDim);
+  for (size_t i = 0; i < numModels; i++) {
+    EXPECT_EQ(timings[i].modelName, "testModelParallel" + std::to_string(i));
+    EXPECT_FALSE(timings[i].isCached);
+    EXPECT_GT(timings[i].compileTime, 0.0);
+    const vector_t y = static_cast<scalar_t>(i + 1) * x.array().cube();
+    const matrix_t dydx = static_cast<scalar_t>(3 * (i + 1)) * x.array().square().matrix().asDiagonal();
+    EXPECT_TRUE(adInterfaces[i]->getFunctionValue(x).isApprox(y));
+    EXPECT_TRUE(adInterfaces[i]->getJacobian(x).isApprox(dydx));
+  }
+
+  // All libraries are valid now
+  for (auto& adInterface : adInterfaces) {
+    codeGenerator.addModel(*adInterface, ocs2::CppAdInterface::ApproximationOrder::Second);
+  }
+  for (const auto& timing : codeGenerator.generate(false)) {
+    EXPECT_TRUE(timing.isCached);
+  }
+}
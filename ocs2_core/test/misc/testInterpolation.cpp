@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <iostream>
 
 #include <ocs2_core/misc/LinearInterpolation.h>
@@ -132,3 +133,55 @@ TEST(testLinearInterpolation, testDifferentEigenSizes) {
   result = ocs2::LinearInterpolation::interpolate(1.1, times, data);
   EXPECT_TRUE(result.isApprox(data[1]));
 }
+
+TEST(testLinearInterpolation, testTimeSegmentCursor) {
+  std::vector<double> times = {0.0, 0.1, 0.2, 0.2, 0.3, 0.5, 0.5, 0.5, 0.8, 1.0, 1.0 + 0.1 * ocs2::numeric_traits::weakEpsilon<double>(), 2.0};
+
+  const auto expectSameSegment = [&](ocs2::LinearInterpolation::TimeSegmentCursor& cursor, double time) {
+    const auto expected = ocs2::LinearInterpolation::timeSegment(time, times);
+    const auto actual = cursor.timeSegment(time, times);
+    EXPECT_EQ(actual.first, expected.first) << "time: " << time;
+    EXPECT_EQ(actual.second, expected.second) << "time: " << time;
+  };
+
+  // Samples, midpoints and values outside the time array in increasing and decreasing order
+  std::vector<double> queries = {-1.0, 3.0};
+  for (size_t i = 0; i + 1 < times.size(); i++) {
+    queries.push_back(times[i]);
+    queries.push_back(0.5 * (times[i] + times[i + 1]));
+  }
+  queries.push_back(times.back());
+  std::sort(queries.begin(), queries.end());
+
+  ocs2::LinearInterpolation::TimeSegmentCursor cursor;
+  for (const auto time : queries) {
+    expectSameSegment(cursor, time);
+  }
+  for (auto it = queries.rbegin(); it != queries.rend(); ++it) {
+    expectSameSegment(cursor, *it);
+  }
+
+  // Random queries
+  for (int i = 0; i < 1000; i++) {
+    expectSameSegment(cursor, 2.2 * (0.5 * Eigen::Vector2d::Random()(0) + 0.5) - 0.1);
+  }
+
+  // Change of the time array, e.g., after a policy update
+  times = {0.5, 0.6};
+  expectSameSegment(cursor, 0.55);
+  times.clear();
+  expectSameSegment(cursor, 0.55);
+}
+
+TEST(testLinearInterpolation, testInterpolateInPlace) {
+  std::vector<double> times = {0.0, 1.0, 2.0};
+  ocs2::vector_array_t data = {ocs2::vector_t::Random(3), ocs2::vector_t::Random(3), ocs2::vector_t::Random(3)};
+
+  ocs2::vector_t result(3);
+  const auto* resultData = result.data();
+  for (const auto time : {-1.0, 0.0, 0.3, 1.0, 1.7, 2.0, 3.0}) {
+    ocs2::LinearInterpolation::interpolate(ocs2::LinearInterpolation::timeSegment(time, times), data, result);
+    EXPECT_TRUE(result.isApprox(ocs2::LinearInterpolation::interpolate(time, times, data))) << "time: " << time;
+  }
+  EXPECT_EQ(result.data(), resultData);
+}
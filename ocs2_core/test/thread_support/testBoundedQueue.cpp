@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+
+#include <ocs2_core/thread_support/BoundedQueue.h>
+
+TEST(testBoundedQueue, dropsOldest) {
+  ocs2::BoundedQueue<int> queue(2);
+  EXPECT_THROW(ocs2::BoundedQueue<int>(0), std::invalid_argument);
+  EXPECT_EQ(queue.capacity(), 2);
+
+  EXPECT_FALSE(queue.push(1));
+  EXPECT_FALSE(queue.push(2));
+  EXPECT_TRUE(queue.push(3));
+  EXPECT_EQ(queue.size(), 2);
+
+  int value = 0;
+  ASSERT_TRUE(queue.pop(value));
+  EXPECT_EQ(value, 2);
+  ASSERT_TRUE(queue.tryPop(value));
+  EXPECT_EQ(value, 3);
+  EXPECT_FALSE(queue.tryPop(value));
+  EXPECT_EQ(value, 3);
+}
+
+TEST(testBoundedQueue, close) {
+  ocs2::BoundedQueue<std::unique_ptr<int>> queue(1);
+  queue.push(std::make_unique<int>(1));
+  queue.close();
+
+  // remaining values are popped after closing
+  std::unique_ptr<int> value;
+  ASSERT_TRUE(queue.pop(value));
+  EXPECT_EQ(*value, 1);
+  EXPECT_FALSE(queue.pop(value));
+
+  queue.reopen();
+  queue.push(std::make_unique<int>(2));
+  ASSERT_TRUE(queue.pop(value));
+  EXPECT_EQ(*value, 2);
+
+  queue.push(std::make_unique<int>(3));
+  queue.clear();
+  EXPECT_EQ(queue.size(), 0);
+}
+
+TEST(testBoundedQueue, producerConsumer) {
+  constexpr int numValues = 10000;
+  ocs2::BoundedQueue<int> queue(4);
+
+  std::thread consumer([&] {
+    int previous = -1;
+    int value;
+    while (queue.pop(value)) {
+      // values arrive in order, some may be dropped
+      EXPECT_GT(value, previous);
+      previous = value;
+    }
+    EXPECT_EQ(previous, numValues - 1);
+  });
+
+  for (int i = 0; i < numValues; i++) {
+    queue.push(i);
+  }
+  queue.close();
+  consumer.join();
+}
+
+TEST(testBoundedQueue, closeWakesUpConsumer) {
+  ocs2::BoundedQueue<int> queue(1);
+  std::thread consumer([&] {
+    int value;
+    EXPECT_FALSE(queue.pop(value));
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  queue.close();
+  consumer.join();
+}
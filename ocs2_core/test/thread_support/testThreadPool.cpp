@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+
+#include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 using namespace ocs2;
@@ -121,3 +123,191 @@ TEST(testThreadPool, testMoveOnlyTask) {
 
   EXPECT_EQ(result.get(), 3.14);
 }
+
+TEST(testThreadPool, testRunParallelPropagateException) {
+  ThreadPool pool(2);
+  std::atomic_int counter;
+  counter = 0;
+
+  auto task = [&](int) {
+    if (counter++ == 3) {
+      throw std::runtime_error("exception");
+    }
+  };
+
+  EXPECT_THROW(pool.runParallel(task, 8), std::runtime_error);
+  EXPECT_EQ(counter, 8);
+
+  // the pool is still usable afterwards
+  counter = 0;
+  pool.runParallel([&](int) { counter++; }, 8);
+  EXPECT_EQ(counter, 8);
+}
+
+TEST(testThreadPool, testParallelFor) {
+  constexpr size_t numThreads = 3;
+  ThreadPool pool(numThreads);
+
+  for (const size_t grain : {1, 3, 7, 100}) {
+    std::vector<int> visited(50, 0);
+    std::atomic_bool validWorkerIndex{true};
+    pool.parallelFor(0, visited.size(), grain, [&](int workerIndex, size_t i) {
+      if (workerIndex < 0 || workerIndex > static_cast<int>(numThreads)) {
+        validWorkerIndex = false;
+      }
+      visited[i]++;
+    });
+
+    EXPECT_TRUE(validWorkerIndex);
+    EXPECT_TRUE(std::all_of(visited.cbegin(), visited.cend(), [](int v) { return v == 1; }));
+  }
+}
+
+TEST(testThreadPool, testParallelForNoThreads) {
+  ThreadPool pool(0);
+  size_t sum = 0;
+
+  pool.parallelFor(10, 20, 4, [&](int workerIndex, size_t i) {
+    EXPECT_EQ(workerIndex, 0);
+    sum += i;
+  });
+  pool.parallelFor(5, 5, 4, [&](int, size_t) { sum += 1000; });
+
+  EXPECT_EQ(sum, 145);
+}
+
+TEST(testThreadPool, testNestedRunParallel) {
+  ThreadPool pool(2);
+  std::atomic_int counter;
+  counter = 0;
+
+  pool.runParallel([&](int) { pool.runParallel([&](int) { counter++; }, 3); }, 3);
+
+  EXPECT_EQ(counter, 9);
+}
+
+TEST(testThreadPool, testCpuAffinity) {
+  ThreadPool pool(2, 0, {0});
+  std::atomic_int counter;
+  counter = 0;
+
+  pool.runParallel([&](int) { counter++; }, 42);
+
+  EXPECT_EQ(counter, 42);
+}
+
+TEST(testThreadPool, benchmarkDispatch) {
+  constexpr size_t numThreads = 3;
+  constexpr int numDispatches = 1000;
+  constexpr size_t N = 100;
+  ThreadPool pool(numThreads);
+  std::vector<double> data(N, 0.0);
+  benchmark::RepeatedTimer timer;
+
+  // run() with one future per task
+  timer.startTimer();
+  for (int k = 0; k < numDispatches; k++) {
+    std::atomic_size_t index{0};
+    auto task = [&](int) {
+      size_t i = index++;
+      while (i < N) {
+        data[i] += 1.0;
+        i = index++;
+      }
+    };
+    std::vector<std::future<void>> futures;
+    for (size_t t = 0; t < numThreads; t++) {
+      futures.emplace_back(pool.run(task));
+    }
+    task(numThreads);
+    for (auto& future : futures) {
+      future.get();
+    }
+  }
+  timer.endTimer();
+  std::cout << "run + futures: " << timer.getLastIntervalInMilliseconds() / numDispatches << " ms per dispatch\n";
+
+  // runParallel()
+  timer.startTimer();
+  for (int k = 0; k < numDispatches; k++) {
+    std::atomic_size_t index{0};
+    pool.runParallel(
+        [&](int) {
+          size_t i = index++;
+          while (i < N) {
+            data[i] += 1.0;
+            i = index++;
+          }
+        },
+        numThreads + 1);
+  }
+  timer.endTimer();
+  std::cout << "runParallel: " << timer.getLastIntervalInMilliseconds() / numDispatches << " ms per dispatch\n";
+
+  // parallelFor()
+  timer.startTimer();
+  for (int k = 0; k < numDispatches; k++) {
+    pool.parallelFor(0, N, 4, [&](int, size_t i) { data[i] += 1.0; });
+  }
+  timer.endTimer();
+  std::cout << "parallelFor: " << timer.getLastIntervalInMilliseconds() / numDispatches << " ms per dispatch\n";
+
+  // runParallel() in hot mode
+  {
+    ThreadPool::HotModeScope hotModeScope(pool, true);
+    timer.startTimer();
+    for (int k = 0; k < numDispatches; k++) {
+      pool.parallelFor(0, N, 4, [&](int, size_t i) { data[i] += 1.0; });
+    }
+    timer.endTimer();
+  }
+  std::cout << "parallelFor (hot mode): " << timer.getLastIntervalInMilliseconds() / numDispatches << " ms per dispatch\n";
+
+  EXPECT_TRUE(std::all_of(data.cbegin(), data.cend(), [](double v) { return v == 4.0 * numDispatches; }));
+}
+
+TEST(testThreadPool, testHotMode) {
+  ThreadPool pool(3);
+  std::atomic_int counter;
+  counter = 0;
+
+  {
+    ThreadPool::HotModeScope hotModeScope(pool, true);
+    EXPECT_TRUE(pool.isHotMode());
+    for (int k = 0; k < 100; k++) {
+      pool.runParallel([&](int) { counter++; }, 4);
+      pool.parallelFor(0, 10, 1, [&](int, size_t) { counter++; });
+    }
+    EXPECT_EQ(pool.run([](int) { return 42; }).get(), 42);
+  }
+  EXPECT_FALSE(pool.isHotMode());
+  EXPECT_EQ(counter, 1400);
+
+  // back to sleeping workers
+  pool.runParallel([&](int) { counter++; }, 4);
+  EXPECT_EQ(counter, 1404);
+}
+
+TEST(testThreadPool, testHotModeMoreTasksThanWorkers) {
+  ThreadPool pool(1);
+  ThreadPool::HotModeScope hotModeScope(pool, true);
+
+  // all tasks are queued while the only worker is busy with the first one
+  std::atomic_bool release{false};
+  std::vector<std::future<int>> futures;
+  futures.push_back(pool.run([&](int) {
+    while (!release) {
+      std::this_thread::yield();
+    }
+    return 0;
+  }));
+  for (int i = 1; i < 5; i++) {
+    futures.push_back(pool.run([i](int) { return i; }));
+  }
+  release = true;
+
+  for (size_t i = 0; i < futures.size(); i++) {
+    ASSERT_EQ(futures[i].wait_for(std::chrono::seconds(5)), std::future_status::ready) << "Task " << i << " is stuck.";
+    EXPECT_EQ(futures[i].get(), static_cast<int>(i));
+  }
+}
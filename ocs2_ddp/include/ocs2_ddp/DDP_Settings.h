@@ -68,6 +68,9 @@ struct Settings {
   size_t nThreads_ = 1;
   /** Priority of threads used in the multi-threading scheme. */
   int threadPriority_ = 99;
+  /** If true, the idle worker threads keep spinning while the solver runs instead of sleeping. This lowers the dispatch latency of
+   * the parallel tasks at the cost of a 100% CPU load of the workers during the solve. */
+  bool threadHotMode_ = false;
 
   /** Maximum number of iterations of DDP. */
   size_t maxNumIterations_ = 15;
@@ -69,6 +69,7 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
 
   loadData::loadPtreeValue(pt, settings.nThreads_, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority_, fieldName + ".threadPriority", verbose);
+  loadData::loadPtreeValue(pt, settings.threadHotMode_, fieldName + ".threadHotMode", verbose);
 
   loadData::loadPtreeValue(pt, settings.maxNumIterations_, fieldName + ".maxNumIterations", verbose);
   loadData::loadPtreeValue(pt, settings.minRelCost_, fieldName + ".minRelCost", verbose);
@@ -986,6 +986,9 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
     std::cerr << getReferenceManager().getModeSchedule();
   }
 
+  // keep the workers spinning while the solver runs
+  const ThreadPool::HotModeScope hotModeScope(threadPool_, ddpSettings_.threadHotMode_);
+
   // set cost desired trajectories
   for (auto& ocp : optimalControlProblemStock_) {
     ocp.targetTrajectoriesPtr = &this->getReferenceManager().getTargetTrajectories();
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_oc/lq_solver/LqSolverInterface.h>
 
 #include <hpipm_catkin/HpipmInterfaceSettings.h>
 
@@ -61,9 +62,19 @@ struct Settings {
 
   // QP subproblem solver settings
   hpipm_interface::Settings hpipmSettings = hpipm_interface::Settings();
+  LqSolverType lqSolverType = LqSolverType::HPIPM;  // QP solver backend. The QPs of the IPM are unconstrained, so every backend applies.
+                                                   // RICCATI runs the serial recursion, PARALLEL_RICCATI the time-parallel one on nThreads
+                                                   // threads. If the package is built with OCS2_FIXED_SIZE_STATE_DIM/INPUT_DIM, matching
+                                                   // QPs of the Riccati backends use the fixed-size solver.
 
   // Discretization method
-  scalar_t dt = 0.01;  // user-defined time discretization
+  scalar_t dt = 0.01;                                // user-defined time discretization
+  scalar_t dtGrowthRate = 1.0;                       // ratio of consecutive time steps, 1.0 results in a uniform discretization
+  scalar_t dtMax = 0.1;                              // maximum time step of the growing discretization
+  scalar_t dynamicsDefectRefinementTolerance = 0.0;  // halves the intervals with a larger dynamics defect in the last solution, 0: off.
+                                                     // Not applied together with move blocking.
+  size_t moveBlockingLength = 1;                     // number of dt intervals over which the input is held constant, 1: off
+  scalar_t moveBlockingStartTime = 0.0;              // time after the start of the horizon from which on the input is blocked
   SensitivityIntegratorType integratorType = SensitivityIntegratorType::RK2;
 
   // Barrier strategy of the primal-dual interior point method. Conventions follows Ipopt.
@@ -95,6 +106,7 @@ struct Settings {
   // Threading
   size_t nThreads = 4;
   int threadPriority = 50;
+  bool threadHotMode = false;  // Keep the idle worker threads spinning while the solver runs, trading CPU load for dispatch latency
 };
 
 /**
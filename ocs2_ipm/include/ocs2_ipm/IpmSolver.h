@@ -34,6 +34,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
+#include <ocs2_oc/lq_solver/FixedSizeRiccatiSolverInterface.h>
+#include <ocs2_oc/lq_solver/ParallelRiccatiSolver.h>
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
 #include <ocs2_oc/multiple_shooting/Transcription.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
@@ -159,6 +161,9 @@ class IpmSolver : public SolverBase {
                                        const vector_array_t& dualStateIneq, const vector_array_t& slackStateInputIneq,
                                        const vector_array_t& dualStateInputIneq);
 
+  /** Solves the QP with the Riccati solver, the fixed-size one if it matches the problem */
+  bool solveRiccati(const vector_t& delta_x0, vector_array_t& deltaXSol, vector_array_t& deltaUSol);
+
   /** Extract the value function based on the last solved QP */
   void extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x, const vector_array_t& lmd,
                             const vector_array_t& deltaXSol);
@@ -194,6 +199,11 @@ class IpmSolver : public SolverBase {
 
   // Solver interface
   HpipmInterface hpipmInterface_;
+  ParallelRiccatiSolver riccatiSolver_;
+  // Selected at compile time with OCS2_FIXED_SIZE_STATE_DIM and OCS2_FIXED_SIZE_INPUT_DIM, nullptr otherwise. Replaces riccatiSolver_
+  // for matching QPs.
+  std::unique_ptr<FixedSizeRiccatiSolverInterface> fixedSizeRiccatiSolverPtr_;
+  bool qpSolvedByFixedSizeRiccati_ = false;  // true if the QP of the current iteration is solved by fixedSizeRiccatiSolverPtr_
 
   // Threading
   ThreadPool threadPool_;
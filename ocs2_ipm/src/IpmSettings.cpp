@@ -59,7 +59,15 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.g_min, fieldName + ".g_min", verbose);
   loadData::loadPtreeValue(pt, settings.armijoFactor, fieldName + ".armijoFactor", verbose);
   loadData::loadPtreeValue(pt, settings.costTol, fieldName + ".costTol", verbose);
+  auto lqSolverName = lq_solver::toString(settings.lqSolverType);
+  loadData::loadPtreeValue(pt, lqSolverName, fieldName + ".lqSolverType", verbose);
+  settings.lqSolverType = lq_solver::fromString(lqSolverName);
   loadData::loadPtreeValue(pt, settings.dt, fieldName + ".dt", verbose);
+  loadData::loadPtreeValue(pt, settings.dtGrowthRate, fieldName + ".dtGrowthRate", verbose);
+  loadData::loadPtreeValue(pt, settings.dtMax, fieldName + ".dtMax", verbose);
+  loadData::loadPtreeValue(pt, settings.dynamicsDefectRefinementTolerance, fieldName + ".dynamicsDefectRefinementTolerance", verbose);
+  loadData::loadPtreeValue(pt, settings.moveBlockingLength, fieldName + ".moveBlockingLength", verbose);
+  loadData::loadPtreeValue(pt, settings.moveBlockingStartTime, fieldName + ".moveBlockingStartTime", verbose);
   loadData::loadPtreeValue(pt, settings.useFeedbackPolicy, fieldName + ".useFeedbackPolicy", verbose);
   loadData::loadPtreeValue(pt, settings.createValueFunction, fieldName + ".createValueFunction", verbose);
   loadData::loadPtreeValue(pt, settings.computeLagrangeMultipliers, fieldName + ".computeLagrangeMultipliers", verbose);
@@ -83,6 +91,7 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.printLinesearch, fieldName + ".printLinesearch", verbose);
   loadData::loadPtreeValue(pt, settings.nThreads, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority, fieldName + ".threadPriority", verbose);
+  loadData::loadPtreeValue(pt, settings.threadHotMode, fieldName + ".threadHotMode", verbose);
 
   if (settings.initialSlackLowerBound <= 0.0) {
     throw std::runtime_error("[MultipleShootingIpmSettings] initialSlackLowerBound must be positive!");
@@ -34,10 +34,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <numeric>
 
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
+#include <ocs2_oc/lq_solver/FixedSizeRiccatiSolver.h>
 #include <ocs2_oc/multiple_shooting/Helpers.h>
 #include <ocs2_oc/multiple_shooting/Initialization.h>
 #include <ocs2_oc/multiple_shooting/LagrangianEvaluation.h>
 #include <ocs2_oc/multiple_shooting/MetricsComputation.h>
+#include <ocs2_oc/multiple_shooting/MoveBlocking.h>
 #include <ocs2_oc/multiple_shooting/PerformanceIndexComputation.h>
 #include <ocs2_oc/oc_problem/OcpSize.h>
 #include <ocs2_oc/trajectory_adjustment/TrajectorySpreadingHelperFunctions.h>
@@ -71,8 +73,14 @@ IpmSolver::IpmSolver(ipm::Settings settings, const OptimalControlProblem& optima
   Eigen::initParallel();
 
   // Dynamics discretization
-  discretizer_ = selectDynamicsDiscretization(settings_.integratorType);
-  sensitivityDiscretizer_ = selectDynamicsSensitivityDiscretization(settings_.integratorType);
+  if (settings_.moveBlockingLength > 1) {
+    // The blocks are integrated with steps of dt
+    discretizer_ = multiple_shooting::selectSubsteppedDynamicsDiscretization(settings_.integratorType, settings_.dt);
+    sensitivityDiscretizer_ = multiple_shooting::selectSubsteppedDynamicsSensitivityDiscretization(settings_.integratorType, settings_.dt);
+  } else {
+    discretizer_ = selectDynamicsDiscretization(settings_.integratorType);
+    sensitivityDiscretizer_ = selectDynamicsSensitivityDiscretization(settings_.integratorType);
+  }
 
   // Clone objects to have one for each worker
   for (int w = 0; w < settings_.nThreads; w++) {
@@ -87,6 +95,10 @@ IpmSolver::IpmSolver(ipm::Settings settings, const OptimalControlProblem& optima
   filterLinesearch_.g_min = settings_.g_min;
   filterLinesearch_.gamma_c = settings_.gamma_c;
   filterLinesearch_.armijoFactor = settings_.armijoFactor;
+
+#ifdef OCS2_FIXED_SIZE_STATE_DIM
+  fixedSizeRiccatiSolverPtr_ = std::make_unique<FixedSizeRiccatiSolverAdapter<OCS2_FIXED_SIZE_STATE_DIM, OCS2_FIXED_SIZE_INPUT_DIM>>();
+#endif
 }
 
 IpmSolver::~IpmSolver() {
@@ -207,9 +219,24 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
   }
 
+  // Keep the workers spinning while the solver runs
+  const ThreadPool::HotModeScope hotModeScope(threadPool_, settings_.threadHotMode);
+
   // Determine time discretization, taking into account event times.
   const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
-  const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
+  auto timeDiscretization = geometricTimeDiscretizationWithEvents(initTime, finalTime, settings_.dt, settings_.dtGrowthRate,
+                                                                   settings_.dtMax, eventTimes);
+  // Under move blocking, the metrics of the last solution belong to the blocks, while its primal solution is expanded to the dt grid.
+  // The defects can not be assigned to intervals of the new discretization, so the refinement is skipped.
+  const bool moveBlocking = settings_.moveBlockingLength > 1;
+  if (settings_.dynamicsDefectRefinementTolerance > 0.0 && !moveBlocking) {
+    timeDiscretization = multiple_shooting::refineTimeDiscretization(timeDiscretization, primalSolution_, problemMetrics_,
+                                                                     settings_.dynamicsDefectRefinementTolerance);
+  }
+  if (moveBlocking) {
+    timeDiscretization = multiple_shooting::blockTimeDiscretization(timeDiscretization, initTime + settings_.moveBlockingStartTime,
+                                                                    settings_.moveBlockingLength);
+  }
 
   // Initialize references
   for (auto& ocpDefinition : ocpDefinitions_) {
@@ -475,12 +502,18 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
   OcpSubproblemSolution solution;
   auto& deltaXSol = solution.deltaXSol;
   auto& deltaUSol = solution.deltaUSol;
-  hpipm_status status;
-  hpipmInterface_.resize(extractSizesFromProblem(dynamics_, lagrangian_, nullptr));
-  status = hpipmInterface_.solve(delta_x0, dynamics_, lagrangian_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
-
-  if (status != hpipm_status::SUCCESS) {
-    throw std::runtime_error("[IpmSolver] Failed to solve QP");
+  // The QP has no constraints: the equality constraints are projected and the inequality constraints are condensed into the Lagrangian
+  qpSolvedByFixedSizeRiccati_ = false;
+  if (settings_.lqSolverType != LqSolverType::HPIPM) {
+    if (!solveRiccati(delta_x0, deltaXSol, deltaUSol)) {
+      throw std::runtime_error("[IpmSolver] Failed to solve QP");
+    }
+  } else {
+    hpipmInterface_.resize(extractSizesFromProblem(dynamics_, lagrangian_, nullptr));
+    const auto status = hpipmInterface_.solve(delta_x0, dynamics_, lagrangian_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+    if (status != hpipm_status::SUCCESS) {
+      throw std::runtime_error("[IpmSolver] Failed to solve QP");
+    }
   }
 
   // to determine if the solution is a descent direction for the cost: compute gradient(cost)' * [dx; du]
@@ -488,7 +521,12 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
 
   // Extract value function
   if (settings_.createValueFunction) {
-    valueFunction_ = hpipmInterface_.getRiccatiCostToGo(dynamics_[0], lagrangian_[0]);
+    if (qpSolvedByFixedSizeRiccati_) {
+      valueFunction_ = fixedSizeRiccatiSolverPtr_->getRiccatiCostToGo();
+    } else {
+      valueFunction_ = (settings_.lqSolverType != LqSolverType::HPIPM) ? riccatiSolver_.getRiccatiCostToGo()
+                                                                        : hpipmInterface_.getRiccatiCostToGo(dynamics_[0], lagrangian_[0]);
+    }
   }
 
   // Problem horizon
@@ -590,15 +628,41 @@ void IpmSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, con
   }
 }
 
+bool IpmSolver::solveRiccati(const vector_t& delta_x0, vector_array_t& deltaXSol, vector_array_t& deltaUSol) {
+  qpSolvedByFixedSizeRiccati_ = fixedSizeRiccatiSolverPtr_ != nullptr && fixedSizeRiccatiSolverPtr_->isCompatible(dynamics_, lagrangian_);
+  if (qpSolvedByFixedSizeRiccati_) {
+    return fixedSizeRiccatiSolverPtr_->solve(delta_x0, dynamics_, lagrangian_, deltaXSol, deltaUSol);
+  }
+  // With a single thread, the parallel Riccati solver runs the serial recursion
+  const int numThreads = (settings_.lqSolverType == LqSolverType::PARALLEL_RICCATI) ? settings_.nThreads : 1;
+  return riccatiSolver_.solve(delta_x0, dynamics_, lagrangian_, threadPool_, numThreads, deltaXSol, deltaUSol);
+}
+
 PrimalSolution IpmSolver::toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u) {
   if (settings_.useFeedbackPolicy) {
     ModeSchedule modeSchedule = this->getReferenceManager().getModeSchedule();
-    matrix_array_t KMatrices = hpipmInterface_.getRiccatiFeedback(dynamics_[0], lagrangian_[0]);
+    matrix_array_t KMatrices;
+    if (qpSolvedByFixedSizeRiccati_) {
+      KMatrices = fixedSizeRiccatiSolverPtr_->getRiccatiFeedback();
+    } else {
+      KMatrices = (settings_.lqSolverType != LqSolverType::HPIPM) ? riccatiSolver_.getRiccatiFeedback()
+                                                                   : hpipmInterface_.getRiccatiFeedback(dynamics_[0], lagrangian_[0]);
+    }
     multiple_shooting::remapProjectedGain(constraintsProjection_, KMatrices);
+    if (settings_.moveBlockingLength > 1) {
+      const auto expandedTime = multiple_shooting::expandBlockedSolution(*ocpDefinitions_.front().dynamicsPtr, settings_.integratorType,
+                                                                         settings_.dt, time, x, u, &KMatrices);
+      return multiple_shooting::toPrimalSolution(expandedTime, std::move(modeSchedule), std::move(x), std::move(u), std::move(KMatrices));
+    }
     return multiple_shooting::toPrimalSolution(time, std::move(modeSchedule), std::move(x), std::move(u), std::move(KMatrices));
 
   } else {
     ModeSchedule modeSchedule = this->getReferenceManager().getModeSchedule();
+    if (settings_.moveBlockingLength > 1) {
+      const auto expandedTime = multiple_shooting::expandBlockedSolution(*ocpDefinitions_.front().dynamicsPtr, settings_.integratorType,
+                                                                         settings_.dt, time, x, u);
+      return multiple_shooting::toPrimalSolution(expandedTime, std::move(modeSchedule), std::move(x), std::move(u));
+    }
     return multiple_shooting::toPrimalSolution(time, std::move(modeSchedule), std::move(x), std::move(u));
   }
 }
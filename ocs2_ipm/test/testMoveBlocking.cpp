@@ -0,0 +1,96 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_ipm/IpmSolver.h"
+
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_oc/test/EXP1.h>
+
+namespace ocs2 {
+namespace {
+
+ocs2::ipm::Settings getSettings(size_t moveBlockingLength) {
+  ocs2::ipm::Settings settings;
+  settings.dt = 0.01;
+  settings.ipmIteration = 20;
+  settings.useFeedbackPolicy = true;
+  settings.nThreads = 1;
+  settings.moveBlockingLength = moveBlockingLength;
+  settings.moveBlockingStartTime = 0.05;
+  return settings;
+}
+
+PrimalSolution solveExp1(const ocs2::ipm::Settings& settings, size_t numRuns = 1) {
+  const scalar_array_t initEventTimes{0.2262, 1.0176};
+  const size_array_t modeSequence{0, 1, 2};
+  auto referenceManagerPtr = getExp1ReferenceManager(initEventTimes, modeSequence);
+  const auto problem = createExp1Problem(referenceManagerPtr);
+  DefaultInitializer zeroInitializer(1);
+
+  IpmSolver solver(settings, problem, zeroInitializer);
+  solver.setReferenceManager(referenceManagerPtr);
+  for (size_t i = 0; i < numRuns; i++) {
+    solver.run(0.0, (vector_t(2) << 2.0, 3.0).finished(), 3.0);
+  }
+  return solver.primalSolution(3.0);
+}
+
+}  // namespace
+}  // namespace ocs2
+
+TEST(test_move_blocking, blockedMatchesUnblocked) {
+  const auto unblockedSolution = ocs2::solveExp1(ocs2::getSettings(1));
+  const auto blockedSolution = ocs2::solveExp1(ocs2::getSettings(5));
+
+  // The input is not blocked before moveBlockingStartTime. Restricting the later inputs only slightly changes the first one.
+  EXPECT_TRUE(blockedSolution.inputTrajectory_.front().isApprox(unblockedSolution.inputTrajectory_.front(), 1e-1));
+
+  // The blocked solution is expanded to the full horizon with steps of at most dt
+  const auto& time = blockedSolution.timeTrajectory_;
+  ASSERT_EQ(blockedSolution.stateTrajectory_.size(), time.size());
+  ASSERT_EQ(blockedSolution.inputTrajectory_.size(), time.size());
+  EXPECT_DOUBLE_EQ(time.front(), 0.0);
+  EXPECT_DOUBLE_EQ(time.back(), 3.0);
+  for (size_t i = 0; i + 1 < time.size(); i++) {
+    EXPECT_LE(time[i + 1] - time[i], 0.01 + 1e-9) << "i = " << i;
+  }
+  EXPECT_GE(time.size(), unblockedSolution.timeTrajectory_.size());
+}
+
+TEST(test_move_blocking, noRefinement) {
+  // The defects of a blocked solution do not refine the next discretization
+  auto settings = ocs2::getSettings(5);
+  settings.ipmIteration = 1;
+  settings.dynamicsDefectRefinementTolerance = 1e-6;
+  const auto firstSolution = ocs2::solveExp1(settings, 1);
+  const auto secondSolution = ocs2::solveExp1(settings, 2);
+  EXPECT_EQ(secondSolution.timeTrajectory_.size(), firstSolution.timeTrajectory_.size());
+}
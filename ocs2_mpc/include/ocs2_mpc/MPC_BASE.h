@@ -67,6 +67,15 @@ class MPC_BASE {
    */
   virtual bool run(scalar_t currentTime, const vector_t& currentState);
 
+  /**
+   * Preparation phase of a real-time iteration. Does the part of the next MPC iteration that does not depend on the next state, such
+   * that the following run() only has to complete the feedback phase. MPCs without real-time iteration support do nothing here.
+   *
+   * @param [in] expectedTime: The expected time of the next run() call.
+   * @return true if the next MPC iteration was prepared.
+   */
+  bool prepare(scalar_t expectedTime);
+
   /** Gets a pointer to the underlying solver used in the MPC. */
   virtual SolverBase* getSolverPtr() = 0;
 
@@ -89,6 +98,15 @@ class MPC_BASE {
    */
   virtual void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) = 0;
 
+  /**
+   * Prepares the next calculateController() call for the given time period, before its initial state is known.
+   *
+   * @param [in] initTime: Expected initial time.
+   * @param [in] finalTime: Final time.
+   * @return true if the next call was prepared. The default implementation does not support preparation.
+   */
+  virtual bool prepareController(scalar_t initTime, scalar_t finalTime) { return false; }
+
   /** Whether this is the first iteration of MPC or not. */
   bool isFirstMpcRun() const { return initRun_; }
 
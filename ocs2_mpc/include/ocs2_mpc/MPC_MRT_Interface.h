@@ -69,10 +69,21 @@ class MPC_MRT_Interface final : public MRT_BASE {
 
   /**
    * Advance the mpc module for one iteration. The evaluation methods can be called while this method is running. They will evaluate the
-   * control law that was up-to-date at the last updatePolicy() call.
+   * control law that was up-to-date at the last updatePolicy() call. If the iteration was prepared with prepareMpc(), only the feedback
+   * phase is run.
    */
   void advanceMpc();
 
+  /**
+   * Preparation phase of a real-time iteration MPC. Prepares the next advanceMpc() call for an observation at the expected time, such that
+   * advanceMpc() only runs the feedback phase and the latency from the observation to the policy drops to the one of a single QP solve.
+   * Has no effect if the MPC does not support real-time iterations.
+   *
+   * @param [in] expectedTime: The expected time of the observation for the next advanceMpc() call.
+   * @return true if the next MPC iteration was prepared.
+   */
+  bool prepareMpc(scalar_t expectedTime);
+
   /**
    * @brief Retrieves the gain matrix from solver capable of optimizing over LinearController type.
    *
@@ -0,0 +1,172 @@
+/******************************************************************************
+Copyright (c) 2017, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/thread_support/BoundedQueue.h>
+#include <ocs2_oc/oc_data/PerformanceIndex.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+
+#include "ocs2_mpc/CommandData.h"
+#include "ocs2_mpc/MPC_BASE.h"
+#include "ocs2_mpc/SystemObservation.h"
+
+namespace ocs2 {
+
+/**
+ * Runs an MPC asynchronously in a pipeline of stages, each in its own thread:
+ *    1. observation intake : setCurrentObservation() only replaces the latest observation, it never waits for the solver.
+ *    2. solve              : runs the MPC on the newest observation and copies the primal solution out of the solver.
+ *    3. post-processing    : serializes the policy into its binary transport format (see PolicySerialization.h).
+ *    4. publication        : hands the policy to the publish callback.
+ *
+ * The stages are connected by bounded queues which drop their oldest entry when full, since an older policy is superseded by a newer
+ * one. Hence, the solver starts on the newest observation as soon as it finishes the previous iteration, while the previous policy is
+ * still post-processed and published. The latency of every stage is measured, see getStatistics().
+ */
+class MPC_Pipeline {
+ public:
+  /** A policy flowing through the pipeline */
+  struct Policy {
+    std::unique_ptr<CommandData> commandPtr;
+    std::unique_ptr<PrimalSolution> primalSolutionPtr;
+    std::unique_ptr<PerformanceIndex> performanceIndicesPtr;
+    std::vector<uint8_t> serializedPolicy;  // empty if serialization is disabled
+    std::chrono::steady_clock::time_point intakeTime;  // intake time of the observation the policy was solved for
+  };
+
+  /** Latency statistics of the stages */
+  struct Statistics {
+    benchmark::RepeatedTimer intake;          // from the observation intake until the solver starts on it
+    benchmark::RepeatedTimer solve;           // MPC iteration
+    benchmark::RepeatedTimer extraction;      // copying the primal solution out of the solver
+    benchmark::RepeatedTimer postProcessing;  // serialization
+    benchmark::RepeatedTimer publication;     // publish callback
+    benchmark::RepeatedTimer total;           // from the observation intake until the end of the publication
+    size_t numDroppedObservations = 0;        // observations replaced before the solver started on them
+    size_t numDroppedPolicies = 0;            // policies replaced in a full queue before their publication
+  };
+
+  /**
+   * Publish callback. The policy can be moved from, e.g., into MRT_BASE::moveToBuffer().
+   * It is called from the publication thread.
+   */
+  using PublishCallback = std::function<void(Policy&)>;
+
+  /**
+   * Constructor
+   *
+   * @param [in] mpc: The underlying MPC class to be used. It is only accessed by the solve stage while the pipeline runs.
+   * @param [in] publishCallback: Called for every policy which reaches the publication stage.
+   * @param [in] queueCapacity: Capacity of the queues between the solve, post-processing, and publication stages.
+   * @param [in] serializePolicy: Whether the post-processing stage serializes the policy.
+   */
+  MPC_Pipeline(MPC_BASE& mpc, PublishCallback publishCallback, size_t queueCapacity = 2, bool serializePolicy = true);
+
+  /** Destructor, stops the pipeline. */
+  ~MPC_Pipeline();
+
+  MPC_Pipeline(const MPC_Pipeline&) = delete;
+  MPC_Pipeline& operator=(const MPC_Pipeline&) = delete;
+
+  /** Starts the stage threads. An observation set before start() is solved first. */
+  void start();
+
+  /**
+   * Stops the pipeline. The solver finishes its current iteration, and the policies in flight are still published.
+   * Rethrows the first exception thrown in one of the stages, after which the pipeline is stopped.
+   */
+  void stop();
+
+  /** Whether the pipeline is running. */
+  bool isRunning() const { return isRunning_; }
+
+  /**
+   * Resets the MPC and sets the initial target trajectories.
+   * @note Throws if the pipeline is running.
+   */
+  void resetMpcNode(const TargetTrajectories& initTargetTrajectories);
+
+  /** Observation intake, replaces the newest observation if the solver did not start on it yet. Does not block. */
+  void setCurrentObservation(const SystemObservation& currentObservation);
+
+  /** Copy of the latency statistics. */
+  Statistics getStatistics() const;
+
+  /** Resets the latency statistics. */
+  void resetStatistics();
+
+ private:
+  struct Observation {
+    SystemObservation observation;
+    std::chrono::steady_clock::time_point intakeTime;
+  };
+
+  void solveWorker();
+  void postProcessingWorker();
+  void publicationWorker();
+
+  /**
+   * Runs a stage and closes its output queue when the stage returns. Stores an exception of the stage and closes the observation
+   * intake, such that the remaining stages drain.
+   */
+  void runStage(void (MPC_Pipeline::*stage)(), BoundedQueue<Policy>* outputQueuePtr);
+
+  MPC_BASE& mpc_;
+  PublishCallback publishCallback_;
+  const bool serializePolicy_;
+
+  BoundedQueue<Observation> observationQueue_;
+  BoundedQueue<Policy> solutionQueue_;
+  BoundedQueue<Policy> publicationQueue_;
+
+  std::atomic_bool isRunning_{false};
+  std::thread solveThread_;
+  std::thread postProcessingThread_;
+  std::thread publicationThread_;
+
+  mutable std::mutex statisticsMutex_;
+  Statistics statistics_;
+
+  std::mutex exceptionMutex_;
+  std::exception_ptr exceptionPtr_;
+};
+
+}  // namespace ocs2
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <Eigen/Dense>
 
+#include <array>
 #include <atomic>
 #include <cstddef>
 #include <memory>
@@ -54,6 +55,11 @@ namespace ocs2 {
 /**
  * This class implements core MRT (Model Reference Tracking) functionality.
  * The responsibility of filling the buffer variables is left to the deriving classes.
+ *
+ * The installed policies are published RCU-style: updatePolicy() fills a free slot out of three and publishes it with an atomic
+ * store, while evaluatePolicy() and rolloutPolicy() pin the active slot with a reader count for the duration of the call. Hence,
+ * policies can be evaluated in a control thread without locks while updatePolicy() is called from another thread. A slot is only
+ * reused once no reader holds it.
  */
 class MRT_BASE {
  public:
@@ -62,7 +68,7 @@ class MRT_BASE {
   virtual ~MRT_BASE() = default;
 
   /**
-   * Resets the class to its instantiated state.
+   * Resets the class to its instantiated state. Must not be called concurrently with the evaluation of the policy.
    */
   void reset();
 
@@ -86,7 +92,8 @@ class MRT_BASE {
 
   /**
    * Gets a reference to the command data corresponding to the current policy.
-   * @warning access to the returned reference is not threadsafe. Read access and calls to updatePolicy() must be synced by the user.
+   * @warning access to the returned reference is not threadsafe. The referenced policy can be reused by the second call to
+   * updatePolicy() after this call. Read access and calls to updatePolicy() must be synced by the user.
    *
    * @return a constant reference to command data.
    */
@@ -94,7 +101,8 @@ class MRT_BASE {
 
   /**
    * Gets a reference to the performance indices data corresponding to the current policy.
-   * @warning access to the returned reference is not threadsafe. Read access and calls to updatePolicy() must be synced by the user.
+   * @warning access to the returned reference is not threadsafe. The referenced policy can be reused by the second call to
+   * updatePolicy() after this call. Read access and calls to updatePolicy() must be synced by the user.
    *
    * @return a constant reference to performance indices data.
    */
@@ -102,7 +110,8 @@ class MRT_BASE {
 
   /**
    * Gets a reference to current optimized policy.
-   * @warning access to the returned reference is not threadsafe. Read access and calls to updatePolicy() must be synced by the user.
+   * @warning access to the returned reference is not threadsafe. The referenced policy can be reused by the second call to
+   * updatePolicy() after this call. Read access and calls to updatePolicy() must be synced by the user.
    *
    * @return constant reference to the policy data.
    */
@@ -115,7 +124,7 @@ class MRT_BASE {
   void initRollout(const RolloutBase* rolloutPtr);
 
   /**
-   * @brief Evaluates the controller
+   * @brief Evaluates the controller. Does not block, can be called concurrently with updatePolicy().
    *
    * @param [in] currentTime: the query time.
    * @param [in] currentState: the query state.
@@ -127,6 +136,7 @@ class MRT_BASE {
 
   /**
    * @brief Rolls out the control policy from the current time and state to get the next state and input using the MPC policy.
+   * Does not block, can be called concurrently with updatePolicy().
    *
    * @param [in] currentTime: start time of the rollout.
    * @param [in] currentState: state to start rollout from.
@@ -142,6 +152,7 @@ class MRT_BASE {
    * Checks the data buffer for an update of the MPC policy. If a new policy
    * is available on the buffer this method will load it to the in-use policy.
    * This method also calls the modifyActiveSolution() method.
+   * It does not block: if the buffer is being written or all free slots are held by readers, it returns false.
    *
    * @return True if the policy is updated.
    */
@@ -163,6 +174,34 @@ class MRT_BASE {
                     std::unique_ptr<PerformanceIndex> performanceIndicesPtr);
 
  private:
+  /** An installed policy */
+  struct PolicySlot {
+    std::unique_ptr<CommandData> commandPtr;
+    std::unique_ptr<PrimalSolution> primalSolutionPtr;
+    std::unique_ptr<PerformanceIndex> performanceIndicesPtr;
+    mutable std::atomic<size_t> numReaders{0};
+  };
+
+  static constexpr size_t numPolicySlots = 3;  // the active slot, one held by a reader of the previous policy and a free one
+  static constexpr size_t noPolicy = numPolicySlots;
+
+  /** Holds the active policy for reading. The policy is not reused before the reference is destroyed. */
+  class PolicyReference {
+   public:
+    explicit PolicyReference(const MRT_BASE& mrt);
+    ~PolicyReference();
+    PolicyReference(const PolicyReference&) = delete;
+    PolicyReference& operator=(const PolicyReference&) = delete;
+
+    /** Whether a policy is installed */
+    bool valid() const { return slot_ != nullptr; }
+    /** Non-const since the rollout takes the mode schedule by reference */
+    PrimalSolution& primalSolution() const { return *slot_->primalSolutionPtr; }
+
+   private:
+    const PolicySlot* slot_ = nullptr;
+  };
+
   /** Calls modifyActiveSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
   void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution);
 
@@ -174,11 +213,10 @@ class MRT_BASE {
   bool newPolicyInBuffer_;  // whether a new policy is waiting to be swapped in
 
   // variables related to the MPC output
-  std::unique_ptr<CommandData> activeCommandPtr_;
+  std::array<PolicySlot, numPolicySlots> policySlots_;
+  std::atomic<size_t> activePolicySlot_;  // index of the active policy or noPolicy
   std::unique_ptr<CommandData> bufferCommandPtr_;
-  std::unique_ptr<PrimalSolution> activePrimalSolutionPtr_;
   std::unique_ptr<PrimalSolution> bufferPrimalSolutionPtr_;
-  std::unique_ptr<PerformanceIndex> activePerformanceIndicesPtr_;
   std::unique_ptr<PerformanceIndex> bufferPerformanceIndicesPtr_;
 
   // thread safety
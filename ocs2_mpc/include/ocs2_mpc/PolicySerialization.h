@@ -0,0 +1,179 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_oc/oc_data/PerformanceIndex.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+
+#include "ocs2_mpc/CommandData.h"
+
+namespace ocs2 {
+namespace policy_serialization {
+
+/**
+ * Contiguous binary format of an MPC policy, i.e., the primal solution, the command data and the performance indices.
+ *
+ * The buffer starts with a header holding a magic number, the format version, the controller type and a table of sections. Every
+ * section is an array of 8-byte values (scalar_t or int64_t) starting at an 8-byte aligned offset. The node dimensions are stored
+ * as offsets into the data sections (size N+1), such that every node can be accessed in O(1) without reading the others. The
+ * values are stored in the byte order of the host, the format is meant for the exchange between processes on the same machine.
+ */
+constexpr uint32_t magic = 0x3253434f;  // "OCS2"
+constexpr uint32_t version = 1;
+
+/** The sections of the buffer */
+enum class Section : uint32_t {
+  Time,                    // scalar_t[N]
+  StateOffsets,            // int64_t[N+1]
+  States,                  // scalar_t[StateOffsets[N]]
+  InputOffsets,            // int64_t[N+1]
+  Inputs,                  // scalar_t[InputOffsets[N]]
+  PostEventIndices,        // int64_t[]
+  EventTimes,              // scalar_t[]
+  ModeSequence,            // int64_t[]
+  ControllerTime,          // scalar_t[M]
+  ControllerBiasOffsets,   // int64_t[M+1]
+  ControllerBias,          // scalar_t[ControllerBiasOffsets[M]], the feedforward input of a feedforward controller
+  ControllerGainOffsets,   // int64_t[M+1], empty for a feedforward controller
+  ControllerGains,         // scalar_t[ControllerGainOffsets[M]], column-major with as many rows as the bias
+  Observation,             // scalar_t[], time, state, input
+  ObservationDims,         // int64_t[3], mode, state dimension, input dimension
+  TargetTime,              // scalar_t[T]
+  TargetStateOffsets,      // int64_t[T+1]
+  TargetStates,            // scalar_t[TargetStateOffsets[T]]
+  TargetInputOffsets,      // int64_t[T+1]
+  TargetInputs,            // scalar_t[TargetInputOffsets[T]]
+  PerformanceIndices,      // scalar_t[8], in the order of the members of PerformanceIndex
+  NumSections
+};
+
+/** Number of bytes of the serialized policy. */
+size_t serializedSize(const PrimalSolution& primalSolution, const CommandData& commandData);
+
+/**
+ * Serializes a policy into a contiguous buffer. The buffer is resized, its capacity is reused over calls.
+ * Supports the feedforward and the linear controller.
+ *
+ * @param [in] primalSolution : The primal solution with its controller.
+ * @param [in] commandData : The command data of the MPC.
+ * @param [in] performanceIndices : The performance indices of the solver.
+ * @param [out] buffer : The serialized policy.
+ */
+void serialize(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndices,
+               std::vector<uint8_t>& buffer);
+
+/**
+ * Serializes a policy into preallocated memory, e.g., a shared memory segment. The memory has to be 8-byte aligned.
+ * Throws a std::runtime_error if the policy does not fit.
+ *
+ * @param [in] primalSolution : The primal solution with its controller.
+ * @param [in] commandData : The command data of the MPC.
+ * @param [in] performanceIndices : The performance indices of the solver.
+ * @param [out] data : The memory of the serialized policy.
+ * @param [in] capacity : The number of bytes available at data.
+ * @return The number of bytes written.
+ */
+size_t serialize(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndices,
+                 uint8_t* data, size_t capacity);
+
+/**
+ * Read-only view on a serialized policy. It does not copy the buffer, which has to outlive the view. The constructor checks the
+ * header and the bounds of all sections and throws a std::runtime_error if the buffer is not a valid policy.
+ */
+class PolicyView {
+ public:
+  using const_vector_map_t = Eigen::Map<const vector_t>;
+  using const_matrix_map_t = Eigen::Map<const matrix_t>;
+
+  PolicyView(const uint8_t* data, size_t size);
+
+  ControllerType controllerType() const { return controllerType_; }
+
+  /** Primal solution */
+  size_t numNodes() const { return count(Section::Time); }
+  const_vector_map_t time() const { return {scalars(Section::Time), static_cast<Eigen::Index>(numNodes())}; }
+  const_vector_map_t state(size_t k) const { return segment(Section::StateOffsets, Section::States, k); }
+  const_vector_map_t input(size_t k) const { return segment(Section::InputOffsets, Section::Inputs, k); }
+  size_t numPostEventIndices() const { return count(Section::PostEventIndices); }
+  size_t postEventIndex(size_t i) const { return static_cast<size_t>(integers(Section::PostEventIndices)[i]); }
+  ModeSchedule modeSchedule() const;
+
+  /** Controller */
+  size_t numControllerNodes() const { return count(Section::ControllerTime); }
+  const_vector_map_t controllerTime() const {
+    return {scalars(Section::ControllerTime), static_cast<Eigen::Index>(numControllerNodes())};
+  }
+  const_vector_map_t controllerBias(size_t k) const { return segment(Section::ControllerBiasOffsets, Section::ControllerBias, k); }
+  const_matrix_map_t controllerGain(size_t k) const;
+
+  /** Command data */
+  SystemObservation observation() const;
+  size_t numTargetNodes() const { return count(Section::TargetTime); }
+  const_vector_map_t targetTime() const { return {scalars(Section::TargetTime), static_cast<Eigen::Index>(numTargetNodes())}; }
+  const_vector_map_t targetState(size_t k) const { return segment(Section::TargetStateOffsets, Section::TargetStates, k); }
+  const_vector_map_t targetInput(size_t k) const { return segment(Section::TargetInputOffsets, Section::TargetInputs, k); }
+
+  /** Performance indices */
+  PerformanceIndex performanceIndices() const;
+
+ private:
+  const scalar_t* scalars(Section section) const { return reinterpret_cast<const scalar_t*>(data_ + offset(section)); }
+  const int64_t* integers(Section section) const { return reinterpret_cast<const int64_t*>(data_ + offset(section)); }
+  size_t offset(Section section) const { return sectionOffsets_[static_cast<size_t>(section)]; }
+  size_t count(Section section) const { return sectionCounts_[static_cast<size_t>(section)]; }
+  const_vector_map_t segment(Section offsets, Section values, size_t k) const {
+    const auto* o = integers(offsets);
+    return {scalars(values) + o[k], static_cast<Eigen::Index>(o[k + 1] - o[k])};
+  }
+  void checkOffsets(Section offsets, Section values, size_t numNodes) const;
+
+  const uint8_t* data_;
+  ControllerType controllerType_;
+  size_t sectionOffsets_[static_cast<size_t>(Section::NumSections)];
+  size_t sectionCounts_[static_cast<size_t>(Section::NumSections)];
+};
+
+/**
+ * Deserializes a policy. The outputs are overwritten, their memory is reused if the dimensions did not change. The controller of
+ * the primal solution is reused if it has the type of the serialized one.
+ *
+ * @param [in] view : The view on the serialized policy.
+ * @param [out] commandData : The command data of the MPC.
+ * @param [out] primalSolution : The primal solution with its controller.
+ * @param [out] performanceIndices : The performance indices of the solver.
+ */
+void deserialize(const PolicyView& view, CommandData& commandData, PrimalSolution& primalSolution, PerformanceIndex& performanceIndices);
+
+}  // namespace policy_serialization
+}  // namespace ocs2
@@ -0,0 +1,119 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <ocs2_oc/oc_data/PerformanceIndex.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+
+#include "ocs2_mpc/CommandData.h"
+
+namespace ocs2 {
+
+/**
+ * Lock-free exchange of MPC policies between one writer (MPC) and one reader (MRT) on the same machine through a POSIX shared
+ * memory segment. The policies are stored in the binary format of PolicySerialization.h.
+ *
+ * The segment holds three slots (triple buffer). The writer serializes into its own slot and publishes it by atomically exchanging
+ * it with the shared middle slot. The reader takes the middle slot in exchange for its own slot only if a new policy was published.
+ * Neither side ever waits for the other, and the reader always gets the latest policy.
+ *
+ * The writer creates the segment and removes it on destruction. A reader can be constructed before the writer exists: read()
+ * connects to the segment once it is available and reconnects if the writer is restarted.
+ */
+class SharedMemoryPolicyChannel {
+ public:
+  enum class Role { Writer, Reader };
+
+  /** Default number of bytes of a slot. The memory is only committed by the system when it is written. */
+  static constexpr size_t defaultSlotCapacity = 8 * 1024 * 1024;
+
+  /**
+   * Constructor.
+   *
+   * @param [in] name : Name of the segment, e.g., the topic of the policy. Slashes are replaced by underscores.
+   * @param [in] role : Writer or reader. There should be only one of each per segment.
+   * @param [in] slotCapacity : The maximum size of a serialized policy in bytes. Only used by the writer.
+   */
+  SharedMemoryPolicyChannel(const std::string& name, Role role, size_t slotCapacity = defaultSlotCapacity);
+
+  /** Destructor. The writer marks the segment as closed and removes it. */
+  ~SharedMemoryPolicyChannel();
+
+  SharedMemoryPolicyChannel(const SharedMemoryPolicyChannel&) = delete;
+  SharedMemoryPolicyChannel& operator=(const SharedMemoryPolicyChannel&) = delete;
+
+  /**
+   * Serializes a policy into the slot of the writer and publishes it. Does not allocate.
+   * Throws a std::runtime_error if the policy does not fit into a slot.
+   */
+  void write(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndices);
+
+  /**
+   * Reads the latest policy if a new one was published since the last call. The outputs are only modified if a new policy is read.
+   *
+   * @param [out] commandData : The command data of the MPC.
+   * @param [out] primalSolution : The primal solution with its controller.
+   * @param [out] performanceIndices : The performance indices of the solver.
+   * @return True if a new policy is read.
+   */
+  bool read(CommandData& commandData, PrimalSolution& primalSolution, PerformanceIndex& performanceIndices);
+
+  /** Whether the segment of the writer is mapped. */
+  bool isConnected() const { return controlBlock_ != nullptr; }
+
+  const std::string& name() const { return name_; }
+
+ private:
+  struct ControlBlock;
+
+  /** Creates a new segment and initializes it. Marks an existing segment of the same name as closed. */
+  void create(size_t slotCapacity);
+
+  /** Maps the segment of the writer if it exists and is initialized. */
+  bool connect();
+
+  void unmap();
+
+  /** Number of bytes of a segment with the given slot capacity */
+  static size_t segmentSize(size_t slotCapacity);
+
+  uint8_t* slot(uint32_t index) const;
+
+  std::string name_;
+  Role role_;
+  ControlBlock* controlBlock_ = nullptr;
+  size_t mappedSize_ = 0;
+};
+
+}  // namespace ocs2
@@ -89,4 +89,15 @@ bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
   return true;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MPC_BASE::prepare(scalar_t expectedTime) {
+  // There is no solution to prepare from before the first run
+  if (initRun_) {
+    return false;
+  }
+  return prepareController(expectedTime, expectedTime + mpcSettings_.timeHorizon_);
+}
+
 }  // namespace ocs2
@@ -112,6 +112,13 @@ void MPC_MRT_Interface::advanceMpc() {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool MPC_MRT_Interface::prepareMpc(scalar_t expectedTime) {
+  return mpc_.prepare(expectedTime);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -0,0 +1,266 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/MPC_Pipeline.h"
+
+#include <iostream>
+
+#include "ocs2_mpc/PolicySerialization.h"
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MPC_Pipeline::MPC_Pipeline(MPC_BASE& mpc, PublishCallback publishCallback, size_t queueCapacity, bool serializePolicy)
+    : mpc_(mpc),
+      publishCallback_(std::move(publishCallback)),
+      serializePolicy_(serializePolicy),
+      observationQueue_(1),
+      solutionQueue_(queueCapacity),
+      publicationQueue_(queueCapacity) {
+  if (!publishCallback_) {
+    throw std::runtime_error("[MPC_Pipeline] The publish callback is empty!");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MPC_Pipeline::~MPC_Pipeline() {
+  try {
+    stop();
+  } catch (const std::exception& e) {
+    std::cerr << "[MPC_Pipeline] A stage failed: " << e.what() << "\n";
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_Pipeline::start() {
+  if (isRunning_) {
+    return;
+  }
+
+  solutionQueue_.clear();
+  publicationQueue_.clear();
+  observationQueue_.reopen();
+  solutionQueue_.reopen();
+  publicationQueue_.reopen();
+
+  isRunning_ = true;
+  solveThread_ = std::thread([this] { runStage(&MPC_Pipeline::solveWorker, &solutionQueue_); });
+  postProcessingThread_ = std::thread([this] { runStage(&MPC_Pipeline::postProcessingWorker, &publicationQueue_); });
+  publicationThread_ = std::thread([this] { runStage(&MPC_Pipeline::publicationWorker, nullptr); });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_Pipeline::stop() {
+  if (!isRunning_) {
+    return;
+  }
+
+  // The stages stop in order, each one closes the input queue of the next one when it returns.
+  isRunning_ = false;
+  observationQueue_.close();
+  solveThread_.join();
+  postProcessingThread_.join();
+  publicationThread_.join();
+
+  std::exception_ptr exceptionPtr;
+  {
+    std::lock_guard<std::mutex> lock(exceptionMutex_);
+    std::swap(exceptionPtr, exceptionPtr_);
+  }
+  if (exceptionPtr != nullptr) {
+    std::rethrow_exception(exceptionPtr);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_Pipeline::resetMpcNode(const TargetTrajectories& initTargetTrajectories) {
+  if (isRunning_) {
+    throw std::runtime_error("[MPC_Pipeline::resetMpcNode] The pipeline has to be stopped before resetting the MPC!");
+  }
+  mpc_.reset();
+  mpc_.getSolverPtr()->getReferenceManager().setTargetTrajectories(initTargetTrajectories);
+  observationQueue_.clear();
+  resetStatistics();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_Pipeline::setCurrentObservation(const SystemObservation& currentObservation) {
+  const bool dropped = observationQueue_.push({currentObservation, std::chrono::steady_clock::now()});
+  if (dropped) {
+    std::lock_guard<std::mutex> lock(statisticsMutex_);
+    statistics_.numDroppedObservations++;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MPC_Pipeline::Statistics MPC_Pipeline::getStatistics() const {
+  std::lock_guard<std::mutex> lock(statisticsMutex_);
+  return statistics_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_Pipeline::resetStatistics() {
+  std::lock_guard<std::mutex> lock(statisticsMutex_);
+  statistics_ = Statistics();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_Pipeline::runStage(void (MPC_Pipeline::*stage)(), BoundedQueue<Policy>* outputQueuePtr) {
+  try {
+    (this->*stage)();
+  } catch (...) {
+    {
+      std::lock_guard<std::mutex> lock(exceptionMutex_);
+      if (exceptionPtr_ == nullptr) {
+        exceptionPtr_ = std::current_exception();
+      }
+    }
+    observationQueue_.close();
+  }
+
+  if (outputQueuePtr != nullptr) {
+    outputQueuePtr->close();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_Pipeline::solveWorker() {
+  Observation observation;
+  while (observationQueue_.pop(observation)) {
+    if (!isRunning_) {
+      break;
+    }
+    {
+      std::lock_guard<std::mutex> lock(statisticsMutex_);
+      statistics_.intake.endTimer(observation.intakeTime);
+    }
+
+    const auto solveStartTime = std::chrono::steady_clock::now();
+    const auto& initObservation = observation.observation;
+    const bool controllerIsUpdated = mpc_.run(initObservation.time, initObservation.state);
+    if (!controllerIsUpdated) {
+      continue;
+    }
+    const auto extractionStartTime = std::chrono::steady_clock::now();
+    {
+      std::lock_guard<std::mutex> lock(statisticsMutex_);
+      statistics_.solve.endTimer(solveStartTime);
+    }
+
+    // The solution is copied before the next iteration modifies the solver
+    const auto* solverPtr = mpc_.getSolverPtr();
+    Policy policy;
+    policy.intakeTime = observation.intakeTime;
+    policy.primalSolutionPtr = std::make_unique<PrimalSolution>();
+    const scalar_t finalTime = (mpc_.settings().solutionTimeWindow_ < 0) ? solverPtr->getFinalTime()
+                                                                          : initObservation.time + mpc_.settings().solutionTimeWindow_;
+    solverPtr->getPrimalSolution(finalTime, policy.primalSolutionPtr.get());
+
+    policy.commandPtr = std::make_unique<CommandData>();
+    policy.commandPtr->mpcInitObservation_ = std::move(observation.observation);
+    policy.commandPtr->mpcTargetTrajectories_ = solverPtr->getReferenceManager().getTargetTrajectories();
+
+    policy.performanceIndicesPtr = std::make_unique<PerformanceIndex>(solverPtr->getPerformanceIndeces());
+
+    {
+      std::lock_guard<std::mutex> lock(statisticsMutex_);
+      statistics_.extraction.endTimer(extractionStartTime);
+    }
+
+    const bool dropped = solutionQueue_.push(std::move(policy));
+    if (dropped) {
+      std::lock_guard<std::mutex> lock(statisticsMutex_);
+      statistics_.numDroppedPolicies++;
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_Pipeline::postProcessingWorker() {
+  Policy policy;
+  while (solutionQueue_.pop(policy)) {
+    const auto startTime = std::chrono::steady_clock::now();
+    if (serializePolicy_) {
+      policy_serialization::serialize(*policy.primalSolutionPtr, *policy.commandPtr, *policy.performanceIndicesPtr,
+                                      policy.serializedPolicy);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(statisticsMutex_);
+      statistics_.postProcessing.endTimer(startTime);
+    }
+
+    const bool dropped = publicationQueue_.push(std::move(policy));
+    if (dropped) {
+      std::lock_guard<std::mutex> lock(statisticsMutex_);
+      statistics_.numDroppedPolicies++;
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_Pipeline::publicationWorker() {
+  Policy policy;
+  while (publicationQueue_.pop(policy)) {
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto intakeTime = policy.intakeTime;
+    publishCallback_(policy);
+    {
+      std::lock_guard<std::mutex> lock(statisticsMutex_);
+      statistics_.publication.endTimer(startTime);
+      statistics_.total.endTimer(intakeTime);
+    }
+  }
+}
+
+}  // namespace ocs2
@@ -50,20 +50,52 @@ void MRT_BASE::reset() {
   newPolicyInBuffer_ = false;
   mrtTrylockWarningCount_ = 0;
 
-  activeCommandPtr_.reset();
+  activePolicySlot_ = noPolicy;
+  for (auto& policy : policySlots_) {
+    policy.commandPtr.reset();
+    policy.primalSolutionPtr.reset();
+    policy.performanceIndicesPtr.reset();
+  }
   bufferCommandPtr_.reset();
-  activePrimalSolutionPtr_.reset();
   bufferPrimalSolutionPtr_.reset();
-  activePerformanceIndicesPtr_.reset();
   bufferPerformanceIndicesPtr_.reset();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MRT_BASE::PolicyReference::PolicyReference(const MRT_BASE& mrt) {
+  // Pin the active slot. If a new policy was published in the meantime, the pinned slot might be reused: retry with the new one.
+  auto slot = mrt.activePolicySlot_.load();
+  while (slot != noPolicy) {
+    const auto& policy = mrt.policySlots_[slot];
+    policy.numReaders.fetch_add(1);
+    const auto activeSlot = mrt.activePolicySlot_.load();
+    if (activeSlot == slot) {
+      slot_ = &policy;
+      break;
+    }
+    policy.numReaders.fetch_sub(1);
+    slot = activeSlot;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+MRT_BASE::PolicyReference::~PolicyReference() {
+  if (slot_ != nullptr) {
+    slot_->numReaders.fetch_sub(1);
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 const CommandData& MRT_BASE::getCommand() const {
-  if (activeCommandPtr_ != nullptr) {
-    return *activeCommandPtr_;
+  const auto slot = activePolicySlot_.load();
+  if (slot != noPolicy) {
+    return *policySlots_[slot].commandPtr;
   } else {
     throw std::runtime_error("[MRT_BASE::getCommand] updatePolicy() should be called first!");
   }
@@ -73,8 +105,9 @@ const CommandData& MRT_BASE::getCommand() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 const PrimalSolution& MRT_BASE::getPolicy() const {
-  if (activePrimalSolutionPtr_ != nullptr) {
-    return *activePrimalSolutionPtr_;
+  const auto slot = activePolicySlot_.load();
+  if (slot != noPolicy) {
+    return *policySlots_[slot].primalSolutionPtr;
   } else {
     throw std::runtime_error("[MRT_BASE::getPolicy] updatePolicy() should be called first!");
   }
@@ -84,8 +117,9 @@ const PrimalSolution& MRT_BASE::getPolicy() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 const PerformanceIndex& MRT_BASE::getPerformanceIndices() const {
-  if (activePerformanceIndicesPtr_ != nullptr) {
-    return *activePerformanceIndicesPtr_;
+  const auto slot = activePolicySlot_.load();
+  if (slot != noPolicy) {
+    return *policySlots_[slot].performanceIndicesPtr;
   } else {
     throw std::runtime_error("[MRT_BASE::getPerformanceIndices] updatePolicy() should be called first!");
   }
@@ -102,20 +136,25 @@ void MRT_BASE::initRollout(const RolloutBase* rolloutPtr) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_BASE::evaluatePolicy(scalar_t currentTime, const vector_t& currentState, vector_t& mpcState, vector_t& mpcInput, size_t& mode) {
-  if (activePrimalSolutionPtr_ == nullptr) {
+  const PolicyReference policy(*this);
+  if (!policy.valid()) {
     throw std::runtime_error("[MRT_BASE::evaluatePolicy] updatePolicy() should be called first!");
   }
+  const auto& primalSolution = policy.primalSolution();
 
-  if (currentTime > activePrimalSolutionPtr_->timeTrajectory_.back()) {
+  if (currentTime > primalSolution.timeTrajectory_.back()) {
     std::cerr << "The requested currentTime is greater than the received plan: " << std::to_string(currentTime) << ">"
-              << std::to_string(activePrimalSolutionPtr_->timeTrajectory_.back()) << "\n";
+              << std::to_string(primalSolution.timeTrajectory_.back()) << "\n";
   }
 
-  mpcInput = activePrimalSolutionPtr_->controllerPtr_->computeInput(currentTime, currentState);
-  mpcState =
-      LinearInterpolation::interpolate(currentTime, activePrimalSolutionPtr_->timeTrajectory_, activePrimalSolutionPtr_->stateTrajectory_);
+  // One cursor per control thread, consecutive calls advance in time and find their segment without a search
+  static thread_local LinearInterpolation::TimeSegmentCursor controllerCursor;
+  static thread_local LinearInterpolation::TimeSegmentCursor stateCursor;
+  primalSolution.controllerPtr_->computeInput(currentTime, currentState, controllerCursor, mpcInput);
+  LinearInterpolation::interpolate(stateCursor.timeSegment(currentTime, primalSolution.timeTrajectory_), primalSolution.stateTrajectory_,
+                                   mpcState);
 
-  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(currentTime);
+  mode = primalSolution.modeSchedule_.modeAtTime(currentTime);
 }
 
 /******************************************************************************************************/
@@ -127,13 +166,15 @@ void MRT_BASE::rolloutPolicy(scalar_t currentTime, const vector_t& currentState,
     throw std::runtime_error("[MRT_BASE::rolloutPolicy] rollout class is not set! Use initRollout() to initialize it!");
   }
 
-  if (activePrimalSolutionPtr_ == nullptr) {
+  const PolicyReference policy(*this);
+  if (!policy.valid()) {
     throw std::runtime_error("[MRT_BASE::rolloutPolicy] updatePolicy() should be called first!");
   }
+  auto& primalSolution = policy.primalSolution();
 
-  if (currentTime > activePrimalSolutionPtr_->timeTrajectory_.back()) {
+  if (currentTime > primalSolution.timeTrajectory_.back()) {
     std::cerr << "The requested currentTime is greater than the received plan: " << std::to_string(currentTime) << ">"
-              << std::to_string(activePrimalSolutionPtr_->timeTrajectory_.back()) << "\n";
+              << std::to_string(primalSolution.timeTrajectory_.back()) << "\n";
   }
 
   // perform a rollout
@@ -141,13 +182,13 @@ void MRT_BASE::rolloutPolicy(scalar_t currentTime, const vector_t& currentState,
   size_array_t postEventIndicesStock;
   vector_array_t stateTrajectory, inputTrajectory;
   const scalar_t finalTime = currentTime + timeStep;
-  rolloutPtr_->run(currentTime, currentState, finalTime, activePrimalSolutionPtr_->controllerPtr_.get(),
-                   activePrimalSolutionPtr_->modeSchedule_, timeTrajectory, postEventIndicesStock, stateTrajectory, inputTrajectory);
+  rolloutPtr_->run(currentTime, currentState, finalTime, primalSolution.controllerPtr_.get(), primalSolution.modeSchedule_,
+                   timeTrajectory, postEventIndicesStock, stateTrajectory, inputTrajectory);
 
   mpcState = stateTrajectory.back();
   mpcInput = inputTrajectory.back();
 
-  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(finalTime);
+  mode = primalSolution.modeSchedule_.modeAtTime(finalTime);
 }
 
 /******************************************************************************************************/
@@ -158,13 +199,30 @@ bool MRT_BASE::updatePolicy() {
   if (lock.owns_lock()) {
     mrtTrylockWarningCount_ = 0;
     if (newPolicyInBuffer_) {
-      // update the active solution from buffer
-      activeCommandPtr_.swap(bufferCommandPtr_);
-      activePrimalSolutionPtr_.swap(bufferPrimalSolutionPtr_);
-      activePerformanceIndicesPtr_.swap(bufferPerformanceIndicesPtr_);
+      // find a slot which is neither active nor held by a reader
+      const auto activeSlot = activePolicySlot_.load();
+      size_t freeSlot = noPolicy;
+      for (size_t i = 0; i < numPolicySlots; ++i) {
+        if (i != activeSlot && policySlots_[i].numReaders.load() == 0) {
+          freeSlot = i;
+          break;
+        }
+      }
+      if (freeSlot == noPolicy) {
+        return false;  // No policy update: all slots are held by readers.
+      }
+
+      // move the buffer to the free slot, the old policy of the slot is recycled as the buffer
+      auto& policy = policySlots_[freeSlot];
+      policy.commandPtr.swap(bufferCommandPtr_);
+      policy.primalSolutionPtr.swap(bufferPrimalSolutionPtr_);
+      policy.performanceIndicesPtr.swap(bufferPerformanceIndicesPtr_);
       newPolicyInBuffer_ = false;  // make sure we don't swap in the old policy again
 
-      modifyActiveSolution(*activeCommandPtr_, *activePrimalSolutionPtr_);
+      modifyActiveSolution(*policy.commandPtr, *policy.primalSolutionPtr);
+
+      // publish
+      activePolicySlot_.store(freeSlot);
       return true;
     } else {
       return false;  // No policy update: the buffer contains nothing new.
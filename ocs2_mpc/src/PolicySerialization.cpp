@@ -0,0 +1,481 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/PolicySerialization.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+
+namespace ocs2 {
+namespace policy_serialization {
+
+namespace {
+
+constexpr size_t numSections = static_cast<size_t>(Section::NumSections);
+constexpr size_t numPerformanceIndices = 8;
+
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t controllerType;
+  uint32_t sectionCount;
+  uint64_t size;
+  uint64_t offsets[numSections];
+  uint64_t counts[numSections];
+};
+
+static_assert(sizeof(scalar_t) == 8, "The policy format stores 8-byte scalars.");
+static_assert(sizeof(Header) % 8 == 0, "The sections need to be 8-byte aligned.");
+
+/** Sizes of the sections and the controller of a policy */
+struct Layout {
+  size_t counts[numSections] = {};
+  ControllerType controllerType = ControllerType::UNKNOWN;
+  const LinearController* linearController = nullptr;
+  const FeedforwardController* feedforwardController = nullptr;
+
+  size_t& operator[](Section section) { return counts[static_cast<size_t>(section)]; }
+};
+
+template <typename Array>
+size_t totalSize(const Array& array) {
+  size_t size = 0;
+  for (const auto& a : array) {
+    size += a.size();
+  }
+  return size;
+}
+
+Layout getLayout(const PrimalSolution& primalSolution, const CommandData& commandData) {
+  Layout layout;
+  const size_t N = primalSolution.timeTrajectory_.size();
+  layout[Section::Time] = N;
+  layout[Section::StateOffsets] = N + 1;
+  layout[Section::States] = totalSize(primalSolution.stateTrajectory_);
+  layout[Section::InputOffsets] = N + 1;
+  layout[Section::Inputs] = totalSize(primalSolution.inputTrajectory_);
+  layout[Section::PostEventIndices] = primalSolution.postEventIndices_.size();
+  layout[Section::EventTimes] = primalSolution.modeSchedule_.eventTimes.size();
+  layout[Section::ModeSequence] = primalSolution.modeSchedule_.modeSequence.size();
+
+  if (primalSolution.controllerPtr_ != nullptr) {
+    layout.controllerType = primalSolution.controllerPtr_->getType();
+    switch (layout.controllerType) {
+      case ControllerType::FEEDFORWARD: {
+        layout.feedforwardController = static_cast<const FeedforwardController*>(primalSolution.controllerPtr_.get());
+        const size_t M = layout.feedforwardController->timeStamp_.size();
+        layout[Section::ControllerTime] = M;
+        layout[Section::ControllerBiasOffsets] = M + 1;
+        layout[Section::ControllerBias] = totalSize(layout.feedforwardController->uffArray_);
+        break;
+      }
+      case ControllerType::LINEAR: {
+        layout.linearController = static_cast<const LinearController*>(primalSolution.controllerPtr_.get());
+        const size_t M = layout.linearController->timeStamp_.size();
+        layout[Section::ControllerTime] = M;
+        layout[Section::ControllerBiasOffsets] = M + 1;
+        layout[Section::ControllerBias] = totalSize(layout.linearController->biasArray_);
+        layout[Section::ControllerGainOffsets] = M + 1;
+        layout[Section::ControllerGains] = totalSize(layout.linearController->gainArray_);
+        break;
+      }
+      default:
+        throw std::runtime_error("[policy_serialization::serialize] Only feedforward and linear controllers are supported.");
+    }
+  }
+
+  const auto& observation = commandData.mpcInitObservation_;
+  layout[Section::Observation] = 1 + observation.state.size() + observation.input.size();
+  layout[Section::ObservationDims] = 3;
+
+  const auto& targetTrajectories = commandData.mpcTargetTrajectories_;
+  const size_t T = targetTrajectories.timeTrajectory.size();
+  layout[Section::TargetTime] = T;
+  layout[Section::TargetStateOffsets] = T + 1;
+  layout[Section::TargetStates] = totalSize(targetTrajectories.stateTrajectory);
+  layout[Section::TargetInputOffsets] = T + 1;
+  layout[Section::TargetInputs] = totalSize(targetTrajectories.inputTrajectory);
+
+  layout[Section::PerformanceIndices] = numPerformanceIndices;
+  return layout;
+}
+
+/** Writes the sections of a policy into a buffer with the offsets of the header */
+class Writer {
+ public:
+  explicit Writer(uint8_t* data) : data_(data), header_(reinterpret_cast<Header*>(data)) {}
+
+  template <typename T>
+  T* get(Section section) {
+    return reinterpret_cast<T*>(data_ + header_->offsets[static_cast<size_t>(section)]);
+  }
+
+  /** Writes the concatenated arrays into the values section and their offsets into the offsets section */
+  template <typename Array>
+  void writeArrays(Section offsets, Section values, const Array& arrays) {
+    auto* o = get<int64_t>(offsets);
+    auto* v = get<scalar_t>(values);
+    o[0] = 0;
+    for (size_t k = 0; k < arrays.size(); ++k) {
+      std::memcpy(v + o[k], arrays[k].data(), arrays[k].size() * sizeof(scalar_t));
+      o[k + 1] = o[k] + arrays[k].size();
+    }
+  }
+
+  void writeScalars(Section section, const scalar_array_t& values) {
+    std::memcpy(get<scalar_t>(section), values.data(), values.size() * sizeof(scalar_t));
+  }
+
+  template <typename Integer>
+  void writeIntegers(Section section, const std::vector<Integer>& values) {
+    auto* v = get<int64_t>(section);
+    for (size_t i = 0; i < values.size(); ++i) {
+      v[i] = static_cast<int64_t>(values[i]);
+    }
+  }
+
+ private:
+  uint8_t* data_;
+  Header* header_;
+};
+
+/** Resizes an array of vectors and copies the segments of the view into it. Reuses the memory of the vectors. */
+template <typename Getter>
+void assignArray(size_t size, Getter getter, vector_array_t& array) {
+  array.resize(size);
+  for (size_t k = 0; k < size; ++k) {
+    array[k] = getter(k);
+  }
+}
+
+size_t totalBytes(const Layout& layout) {
+  size_t size = sizeof(Header);
+  for (size_t i = 0; i < numSections; ++i) {
+    size += layout.counts[i] * 8;
+  }
+  return size;
+}
+
+/** Writes the policy into data, which has to hold totalBytes(layout) bytes */
+void write(const Layout& layout, const PrimalSolution& primalSolution, const CommandData& commandData,
+           const PerformanceIndex& performanceIndices, uint8_t* data) {
+  // Header
+  Header header;
+  header.magic = magic;
+  header.version = version;
+  header.controllerType = static_cast<uint32_t>(layout.controllerType);
+  header.sectionCount = numSections;
+  size_t size = sizeof(Header);
+  for (size_t i = 0; i < numSections; ++i) {
+    header.offsets[i] = size;
+    header.counts[i] = layout.counts[i];
+    size += layout.counts[i] * 8;
+  }
+  header.size = size;
+  std::memcpy(data, &header, sizeof(Header));
+
+  // Primal solution
+  Writer writer(data);
+  writer.writeScalars(Section::Time, primalSolution.timeTrajectory_);
+  writer.writeArrays(Section::StateOffsets, Section::States, primalSolution.stateTrajectory_);
+  writer.writeArrays(Section::InputOffsets, Section::Inputs, primalSolution.inputTrajectory_);
+  writer.writeIntegers(Section::PostEventIndices, primalSolution.postEventIndices_);
+  writer.writeScalars(Section::EventTimes, primalSolution.modeSchedule_.eventTimes);
+  writer.writeIntegers(Section::ModeSequence, primalSolution.modeSchedule_.modeSequence);
+
+  // Controller
+  if (layout.feedforwardController != nullptr) {
+    writer.writeScalars(Section::ControllerTime, layout.feedforwardController->timeStamp_);
+    writer.writeArrays(Section::ControllerBiasOffsets, Section::ControllerBias, layout.feedforwardController->uffArray_);
+  } else if (layout.linearController != nullptr) {
+    writer.writeScalars(Section::ControllerTime, layout.linearController->timeStamp_);
+    writer.writeArrays(Section::ControllerBiasOffsets, Section::ControllerBias, layout.linearController->biasArray_);
+    writer.writeArrays(Section::ControllerGainOffsets, Section::ControllerGains, layout.linearController->gainArray_);
+  }
+
+  // Command data
+  const auto& observation = commandData.mpcInitObservation_;
+  auto* observationValues = writer.get<scalar_t>(Section::Observation);
+  observationValues[0] = observation.time;
+  std::memcpy(observationValues + 1, observation.state.data(), observation.state.size() * sizeof(scalar_t));
+  std::memcpy(observationValues + 1 + observation.state.size(), observation.input.data(), observation.input.size() * sizeof(scalar_t));
+  writer.writeIntegers(Section::ObservationDims, std::vector<size_t>{observation.mode, static_cast<size_t>(observation.state.size()),
+                                                                     static_cast<size_t>(observation.input.size())});
+
+  const auto& targetTrajectories = commandData.mpcTargetTrajectories_;
+  writer.writeScalars(Section::TargetTime, targetTrajectories.timeTrajectory);
+  writer.writeArrays(Section::TargetStateOffsets, Section::TargetStates, targetTrajectories.stateTrajectory);
+  writer.writeArrays(Section::TargetInputOffsets, Section::TargetInputs, targetTrajectories.inputTrajectory);
+
+  // Performance indices
+  writer.writeScalars(Section::PerformanceIndices,
+                      {performanceIndices.merit, performanceIndices.cost, performanceIndices.dualFeasibilitiesSSE,
+                       performanceIndices.dynamicsViolationSSE, performanceIndices.equalityConstraintsSSE,
+                       performanceIndices.inequalityConstraintsSSE, performanceIndices.equalityLagrangian,
+                       performanceIndices.inequalityLagrangian});
+}
+
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t serializedSize(const PrimalSolution& primalSolution, const CommandData& commandData) {
+  return totalBytes(getLayout(primalSolution, commandData));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void serialize(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndices,
+               std::vector<uint8_t>& buffer) {
+  const auto layout = getLayout(primalSolution, commandData);
+  buffer.resize(totalBytes(layout));
+  write(layout, primalSolution, commandData, performanceIndices, buffer.data());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t serialize(const PrimalSolution& primalSolution, const CommandData& commandData, const PerformanceIndex& performanceIndices,
+                 uint8_t* data, size_t capacity) {
+  const auto layout = getLayout(primalSolution, commandData);
+  const size_t size = totalBytes(layout);
+  if (size > capacity) {
+    throw std::runtime_error("[policy_serialization::serialize] The policy needs " + std::to_string(size) +
+                             " bytes, but the buffer only has " + std::to_string(capacity) + ".");
+  }
+  write(layout, primalSolution, commandData, performanceIndices, data);
+  return size;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PolicyView::PolicyView(const uint8_t* data, size_t size) : data_(data) {
+  if (data == nullptr || size < sizeof(Header)) {
+    throw std::runtime_error("[PolicyView] The buffer is too small for a policy.");
+  }
+  Header header;
+  std::memcpy(&header, data, sizeof(Header));
+  if (header.magic != magic) {
+    throw std::runtime_error("[PolicyView] The buffer is not a serialized policy.");
+  }
+  if (header.version != version) {
+    throw std::runtime_error("[PolicyView] Unsupported policy format version " + std::to_string(header.version) + ", expected " +
+                             std::to_string(version) + ".");
+  }
+  if (header.sectionCount != numSections || header.size != size) {
+    throw std::runtime_error("[PolicyView] The header does not match the buffer.");
+  }
+  if (header.controllerType > static_cast<uint32_t>(ControllerType::LINEAR)) {
+    throw std::runtime_error("[PolicyView] Unsupported controller type.");
+  }
+  controllerType_ = static_cast<ControllerType>(header.controllerType);
+
+  // Bounds of all sections
+  for (size_t i = 0; i < numSections; ++i) {
+    if (header.offsets[i] % 8 != 0 || header.offsets[i] < sizeof(Header) || header.counts[i] > (size - header.offsets[i]) / 8) {
+      throw std::runtime_error("[PolicyView] Section " + std::to_string(i) + " is out of the bounds of the buffer.");
+    }
+    sectionOffsets_[i] = header.offsets[i];
+    sectionCounts_[i] = header.counts[i];
+  }
+
+  // Consistency of the node dimensions
+  checkOffsets(Section::StateOffsets, Section::States, numNodes());
+  checkOffsets(Section::InputOffsets, Section::Inputs, numNodes());
+  checkOffsets(Section::TargetStateOffsets, Section::TargetStates, numTargetNodes());
+  checkOffsets(Section::TargetInputOffsets, Section::TargetInputs, numTargetNodes());
+  if (controllerType_ != ControllerType::UNKNOWN) {
+    checkOffsets(Section::ControllerBiasOffsets, Section::ControllerBias, numControllerNodes());
+  }
+  if (controllerType_ == ControllerType::LINEAR) {
+    checkOffsets(Section::ControllerGainOffsets, Section::ControllerGains, numControllerNodes());
+    for (size_t k = 0; k < numControllerNodes(); ++k) {
+      const auto rows = controllerBias(k).size();
+      const auto gainSize = integers(Section::ControllerGainOffsets)[k + 1] - integers(Section::ControllerGainOffsets)[k];
+      if ((rows == 0 && gainSize != 0) || (rows > 0 && gainSize % rows != 0)) {
+        throw std::runtime_error("[PolicyView] The feedback gain of node " + std::to_string(k) + " does not match its bias.");
+      }
+    }
+  }
+  const auto* observationDims = integers(Section::ObservationDims);
+  if (count(Section::ObservationDims) != 3 || observationDims[1] < 0 || observationDims[2] < 0 ||
+      count(Section::Observation) != static_cast<size_t>(1 + observationDims[1] + observationDims[2])) {
+    throw std::runtime_error("[PolicyView] The observation does not match its dimensions.");
+  }
+  if (count(Section::PerformanceIndices) != numPerformanceIndices) {
+    throw std::runtime_error("[PolicyView] The performance indices are incomplete.");
+  }
+  const auto* postEventIndices = integers(Section::PostEventIndices);
+  for (size_t i = 0; i < numPostEventIndices(); ++i) {
+    if (postEventIndices[i] < 0 || static_cast<size_t>(postEventIndices[i]) > numNodes()) {
+      throw std::runtime_error("[PolicyView] The post-event index " + std::to_string(postEventIndices[i]) + " is out of range.");
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PolicyView::checkOffsets(Section offsets, Section values, size_t numNodes) const {
+  const auto name = std::to_string(static_cast<size_t>(offsets));
+  if (count(offsets) != numNodes + 1) {
+    throw std::runtime_error("[PolicyView] Section " + name + " does not match the number of nodes.");
+  }
+  const auto* o = integers(offsets);
+  if (o[0] != 0 || static_cast<size_t>(o[numNodes]) != count(values)) {
+    throw std::runtime_error("[PolicyView] Section " + name + " does not match the data.");
+  }
+  for (size_t k = 0; k < numNodes; ++k) {
+    if (o[k + 1] < o[k]) {
+      throw std::runtime_error("[PolicyView] Section " + name + " is not monotonic.");
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ModeSchedule PolicyView::modeSchedule() const {
+  const auto* eventTimes = scalars(Section::EventTimes);
+  const auto* modeSequence = integers(Section::ModeSequence);
+  ModeSchedule modeSchedule;
+  modeSchedule.eventTimes.assign(eventTimes, eventTimes + count(Section::EventTimes));
+  modeSchedule.modeSequence.assign(modeSequence, modeSequence + count(Section::ModeSequence));
+  return modeSchedule;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PolicyView::const_matrix_map_t PolicyView::controllerGain(size_t k) const {
+  const auto* o = integers(Section::ControllerGainOffsets);
+  const auto rows = controllerBias(k).size();
+  const auto cols = (rows > 0) ? (o[k + 1] - o[k]) / rows : 0;
+  return {scalars(Section::ControllerGains) + o[k], rows, cols};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SystemObservation PolicyView::observation() const {
+  const auto* dims = integers(Section::ObservationDims);
+  const auto* values = scalars(Section::Observation);
+  SystemObservation observation;
+  observation.mode = static_cast<size_t>(dims[0]);
+  observation.time = values[0];
+  observation.state = const_vector_map_t(values + 1, dims[1]);
+  observation.input = const_vector_map_t(values + 1 + dims[1], dims[2]);
+  return observation;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+PerformanceIndex PolicyView::performanceIndices() const {
+  const auto* values = scalars(Section::PerformanceIndices);
+  PerformanceIndex performanceIndices;
+  performanceIndices.merit = values[0];
+  performanceIndices.cost = values[1];
+  performanceIndices.dualFeasibilitiesSSE = values[2];
+  performanceIndices.dynamicsViolationSSE = values[3];
+  performanceIndices.equalityConstraintsSSE = values[4];
+  performanceIndices.inequalityConstraintsSSE = values[5];
+  performanceIndices.equalityLagrangian = values[6];
+  performanceIndices.inequalityLagrangian = values[7];
+  return performanceIndices;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void deserialize(const PolicyView& view, CommandData& commandData, PrimalSolution& primalSolution, PerformanceIndex& performanceIndices) {
+  // Primal solution
+  const auto time = view.time();
+  primalSolution.timeTrajectory_.assign(time.data(), time.data() + time.size());
+  assignArray(view.numNodes(), [&](size_t k) { return view.state(k); }, primalSolution.stateTrajectory_);
+  assignArray(view.numNodes(), [&](size_t k) { return view.input(k); }, primalSolution.inputTrajectory_);
+  primalSolution.postEventIndices_.resize(view.numPostEventIndices());
+  for (size_t i = 0; i < view.numPostEventIndices(); ++i) {
+    primalSolution.postEventIndices_[i] = view.postEventIndex(i);
+  }
+  primalSolution.modeSchedule_ = view.modeSchedule();
+
+  // Controller, reused if it has the right type
+  const auto controllerTime = view.controllerTime();
+  const bool reuseController =
+      primalSolution.controllerPtr_ != nullptr && primalSolution.controllerPtr_->getType() == view.controllerType();
+  switch (view.controllerType()) {
+    case ControllerType::FEEDFORWARD: {
+      if (!reuseController) {
+        primalSolution.controllerPtr_.reset(new FeedforwardController());
+      }
+      auto& controller = static_cast<FeedforwardController&>(*primalSolution.controllerPtr_);
+      controller.timeStamp_.assign(controllerTime.data(), controllerTime.data() + controllerTime.size());
+      assignArray(view.numControllerNodes(), [&](size_t k) { return view.controllerBias(k); }, controller.uffArray_);
+      break;
+    }
+    case ControllerType::LINEAR: {
+      if (!reuseController) {
+        primalSolution.controllerPtr_.reset(new LinearController());
+      }
+      auto& controller = static_cast<LinearController&>(*primalSolution.controllerPtr_);
+      controller.timeStamp_.assign(controllerTime.data(), controllerTime.data() + controllerTime.size());
+      assignArray(view.numControllerNodes(), [&](size_t k) { return view.controllerBias(k); }, controller.biasArray_);
+      controller.gainArray_.resize(view.numControllerNodes());
+      for (size_t k = 0; k < view.numControllerNodes(); ++k) {
+        controller.gainArray_[k] = view.controllerGain(k);
+      }
+      controller.deltaBiasArray_.clear();
+      break;
+    }
+    default:
+      primalSolution.controllerPtr_.reset();
+  }
+
+  // Command data
+  commandData.mpcInitObservation_ = view.observation();
+  auto& targetTrajectories = commandData.mpcTargetTrajectories_;
+  const auto targetTime = view.targetTime();
+  targetTrajectories.timeTrajectory.assign(targetTime.data(), targetTime.data() + targetTime.size());
+  assignArray(view.numTargetNodes(), [&](size_t k) { return view.targetState(k); }, targetTrajectories.stateTrajectory);
+  assignArray(view.numTargetNodes(), [&](size_t k) { return view.targetInput(k); }, targetTrajectories.inputTrajectory);
+
+  // Performance indices
+  performanceIndices = view.performanceIndices();
+}
+
+}  // namespace policy_serialization
+}  // namespace ocs2
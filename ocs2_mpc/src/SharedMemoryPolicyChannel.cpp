@@ -0,0 +1,258 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpc/SharedMemoryPolicyChannel.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include "ocs2_mpc/PolicySerialization.h"
+
+namespace ocs2 {
+
+namespace {
+
+constexpr uint32_t numSlots = 3;
+constexpr uint32_t slotMask = 0x3;
+constexpr uint32_t newPolicyFlag = 0x4;  // set in the middle slot index if it holds a policy that was not read yet
+constexpr size_t cacheLine = 64;
+
+enum SegmentState : uint32_t { Uninitialized = 0, Open = 1, Closed = 2 };
+
+size_t roundUpToCacheLine(size_t size) {
+  return (size + cacheLine - 1) / cacheLine * cacheLine;
+}
+
+/** POSIX shared memory names start with a single '/' */
+std::string segmentName(const std::string& name) {
+  std::string segment = (!name.empty() && name.front() == '/') ? name.substr(1) : name;
+  std::replace(segment.begin(), segment.end(), '/', '_');
+  return "/" + segment;
+}
+
+}  // namespace
+
+/** Shared state at the beginning of the segment. The slots follow at the next cache line. */
+struct SharedMemoryPolicyChannel::ControlBlock {
+  std::atomic<uint32_t> state;   // SegmentState
+  std::atomic<uint32_t> middle;  // index of the shared slot, with newPolicyFlag if it was not read yet
+  uint32_t writerSlot;           // only accessed by the writer
+  uint32_t readerSlot;           // only accessed by the reader, kept in the segment such that a reader can reconnect
+  uint64_t slotCapacity;
+  uint64_t slotSizes[numSlots];  // bytes of the policy in each slot, written by the owner of the slot before publishing it
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "The shared memory channel requires address-free atomics.");
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemoryPolicyChannel::SharedMemoryPolicyChannel(const std::string& name, Role role, size_t slotCapacity)
+    : name_(segmentName(name)), role_(role) {
+  if (role_ == Role::Writer) {
+    create(roundUpToCacheLine(slotCapacity));
+  } else {
+    connect();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SharedMemoryPolicyChannel::~SharedMemoryPolicyChannel() {
+  if (role_ == Role::Writer && controlBlock_ != nullptr) {
+    controlBlock_->state.store(Closed, std::memory_order_release);
+    unmap();
+    shm_unlink(name_.c_str());
+  } else {
+    unmap();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SharedMemoryPolicyChannel::create(size_t slotCapacity) {
+  // Close the segment of a previous writer, e.g., after a crash, such that its readers reconnect to the new one.
+  int fd = shm_open(name_.c_str(), O_RDWR, 0);
+  if (fd >= 0) {
+    struct stat fileStatus;
+    if (fstat(fd, &fileStatus) == 0 && static_cast<size_t>(fileStatus.st_size) >= sizeof(ControlBlock)) {
+      void* ptr = mmap(nullptr, sizeof(ControlBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if (ptr != MAP_FAILED) {
+        static_cast<ControlBlock*>(ptr)->state.store(Closed, std::memory_order_release);
+        munmap(ptr, sizeof(ControlBlock));
+      }
+    }
+    close(fd);
+    shm_unlink(name_.c_str());
+  }
+
+  fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    throw std::runtime_error("[SharedMemoryPolicyChannel] Could not create " + name_ + ": " + std::strerror(errno));
+  }
+  const size_t size = segmentSize(slotCapacity);
+  if (ftruncate(fd, size) != 0) {
+    const std::string error = std::strerror(errno);
+    close(fd);
+    shm_unlink(name_.c_str());
+    throw std::runtime_error("[SharedMemoryPolicyChannel] Could not resize " + name_ + ": " + error);
+  }
+  void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    shm_unlink(name_.c_str());
+    throw std::runtime_error("[SharedMemoryPolicyChannel] Could not map " + name_ + ": " + std::strerror(errno));
+  }
+
+  // The new segment is zero initialized, i.e., Uninitialized until the control block is set up.
+  controlBlock_ = new (ptr) ControlBlock;
+  mappedSize_ = size;
+  controlBlock_->middle.store(0, std::memory_order_relaxed);
+  controlBlock_->writerSlot = 1;
+  controlBlock_->readerSlot = 2;
+  controlBlock_->slotCapacity = slotCapacity;
+  std::fill(std::begin(controlBlock_->slotSizes), std::end(controlBlock_->slotSizes), 0);
+  controlBlock_->state.store(Open, std::memory_order_release);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SharedMemoryPolicyChannel::connect() {
+  const int fd = shm_open(name_.c_str(), O_RDWR, 0);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat fileStatus;
+  if (fstat(fd, &fileStatus) != 0 || static_cast<size_t>(fileStatus.st_size) < sizeof(ControlBlock)) {
+    close(fd);
+    return false;
+  }
+  const size_t size = fileStatus.st_size;
+  void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    return false;
+  }
+
+  // The writer might not have finished the initialization yet
+  auto* controlBlock = static_cast<ControlBlock*>(ptr);
+  if (controlBlock->state.load(std::memory_order_acquire) != Open || segmentSize(controlBlock->slotCapacity) != size) {
+    munmap(ptr, size);
+    return false;
+  }
+  controlBlock_ = controlBlock;
+  mappedSize_ = size;
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SharedMemoryPolicyChannel::unmap() {
+  if (controlBlock_ != nullptr) {
+    munmap(controlBlock_, mappedSize_);
+    controlBlock_ = nullptr;
+    mappedSize_ = 0;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t SharedMemoryPolicyChannel::segmentSize(size_t slotCapacity) {
+  return roundUpToCacheLine(sizeof(ControlBlock)) + numSlots * slotCapacity;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+uint8_t* SharedMemoryPolicyChannel::slot(uint32_t index) const {
+  return reinterpret_cast<uint8_t*>(controlBlock_) + roundUpToCacheLine(sizeof(ControlBlock)) + index * controlBlock_->slotCapacity;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void SharedMemoryPolicyChannel::write(const PrimalSolution& primalSolution, const CommandData& commandData,
+                                      const PerformanceIndex& performanceIndices) {
+  if (role_ != Role::Writer) {
+    throw std::runtime_error("[SharedMemoryPolicyChannel::write] Only the writer can write a policy.");
+  }
+
+  const auto index = controlBlock_->writerSlot;
+  controlBlock_->slotSizes[index] =
+      policy_serialization::serialize(primalSolution, commandData, performanceIndices, slot(index), controlBlock_->slotCapacity);
+
+  // Publish the slot and take over the previous middle slot
+  const auto middle = controlBlock_->middle.exchange(index | newPolicyFlag, std::memory_order_acq_rel);
+  controlBlock_->writerSlot = middle & slotMask;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SharedMemoryPolicyChannel::read(CommandData& commandData, PrimalSolution& primalSolution, PerformanceIndex& performanceIndices) {
+  if (role_ != Role::Reader) {
+    throw std::runtime_error("[SharedMemoryPolicyChannel::read] Only the reader can read a policy.");
+  }
+
+  if (controlBlock_ == nullptr && !connect()) {
+    return false;
+  }
+  if (controlBlock_->state.load(std::memory_order_acquire) != Open) {
+    unmap();  // the writer is gone, reconnect to its successor
+    return false;
+  }
+  if ((controlBlock_->middle.load(std::memory_order_acquire) & newPolicyFlag) == 0) {
+    return false;
+  }
+
+  // Take the middle slot and hand over the slot of the reader
+  const auto middle = controlBlock_->middle.exchange(controlBlock_->readerSlot, std::memory_order_acq_rel);
+  const auto index = middle & slotMask;
+  controlBlock_->readerSlot = index;
+
+  const policy_serialization::PolicyView view(slot(index), controlBlock_->slotSizes[index]);
+  policy_serialization::deserialize(view, commandData, primalSolution, performanceIndices);
+  return true;
+}
+
+}  // namespace ocs2
@@ -1,7 +1,10 @@
 #include <ocs2_mpc/MPC_BASE.h>
 #include <ocs2_mpc/MPC_MRT_Interface.h>
+#include <ocs2_mpc/MPC_Pipeline.h>
 #include <ocs2_mpc/MPC_Settings.h>
 #include <ocs2_mpc/MRT_BASE.h>
+#include <ocs2_mpc/PolicySerialization.h>
+#include <ocs2_mpc/SharedMemoryPolicyChannel.h>
 
 #include <ocs2_mpc/CommandData.h>
 #include <ocs2_mpc/SystemObservation.h>
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_oc/oc_solver/SolverBase.h>
+
+#include "ocs2_mpc/MPC_Pipeline.h"
+#include "ocs2_mpc/PolicySerialization.h"
+
+using namespace ocs2;
+
+namespace {
+
+/** Solver which takes a fixed time and returns a constant trajectory at the initial state */
+class TestSolver : public SolverBase {
+ public:
+  explicit TestSolver(std::chrono::milliseconds solveDuration) : solveDuration_(solveDuration) {}
+
+  void reset() override {}
+  const OptimalControlProblem& getOptimalControlProblem() const override { return problem_; }
+  const PerformanceIndex& getPerformanceIndeces() const override { return performanceIndex_; }
+  size_t getNumIterations() const override { return 1; }
+  const std::vector<PerformanceIndex>& getIterationsLog() const override { return iterationsLog_; }
+  scalar_t getFinalTime() const override { return finalTime_; }
+  const ProblemMetrics& getSolutionMetrics() const override { return metrics_; }
+
+  void getPrimalSolution(scalar_t finalTime, PrimalSolution* primalSolutionPtr) const override {
+    constexpr size_t N = 10;
+    primalSolutionPtr->clear();
+    for (size_t k = 0; k <= N; ++k) {
+      primalSolutionPtr->timeTrajectory_.push_back(initTime_ + (finalTime - initTime_) * k / N);
+      primalSolutionPtr->stateTrajectory_.push_back(initState_);
+      primalSolutionPtr->inputTrajectory_.push_back(vector_t::Zero(1));
+    }
+    primalSolutionPtr->controllerPtr_.reset(
+        new FeedforwardController(primalSolutionPtr->timeTrajectory_, primalSolutionPtr->inputTrajectory_));
+  }
+
+  ScalarFunctionQuadraticApproximation getValueFunction(scalar_t time, const vector_t& state) const override { return {}; }
+  ScalarFunctionQuadraticApproximation getHamiltonian(scalar_t time, const vector_t& state, const vector_t& input) override { return {}; }
+  vector_t getStateInputEqualityConstraintLagrangian(scalar_t time, const vector_t& state) const override { return {}; }
+  MultiplierCollection getIntermediateDualSolution(scalar_t time) const override { return {}; }
+
+ private:
+  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override {
+    if (initState(0) < 0.0) {
+      throw std::runtime_error("[TestSolver] Negative state.");
+    }
+    std::this_thread::sleep_for(solveDuration_);
+    initTime_ = initTime;
+    initState_ = initState;
+    finalTime_ = finalTime;
+  }
+  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const ControllerBase* externalControllerPtr) override {
+    runImpl(initTime, initState, finalTime);
+  }
+  void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution) override {
+    runImpl(initTime, initState, finalTime);
+  }
+
+  const std::chrono::milliseconds solveDuration_;
+  scalar_t initTime_ = 0.0;
+  vector_t initState_;
+  scalar_t finalTime_ = 0.0;
+  OptimalControlProblem problem_;
+  PerformanceIndex performanceIndex_;
+  std::vector<PerformanceIndex> iterationsLog_;
+  ProblemMetrics metrics_;
+};
+
+class TestMpc : public MPC_BASE {
+ public:
+  explicit TestMpc(std::chrono::milliseconds solveDuration) : MPC_BASE(mpc::Settings()), solver_(solveDuration) {}
+  SolverBase* getSolverPtr() override { return &solver_; }
+  const SolverBase* getSolverPtr() const override { return &solver_; }
+
+ private:
+  void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override {
+    solver_.run(initTime, initState, finalTime);
+  }
+
+  TestSolver solver_;
+};
+
+SystemObservation getObservation(scalar_t time, scalar_t value) {
+  SystemObservation observation;
+  observation.time = time;
+  observation.state = vector_t::Constant(2, value);
+  observation.input = vector_t::Zero(1);
+  return observation;
+}
+
+}  // namespace
+
+TEST(testMpcPipeline, solvesNewestObservation) {
+  TestMpc mpc(std::chrono::milliseconds(5));
+
+  std::mutex publishedMutex;
+  scalar_array_t publishedTimes;
+  MPC_Pipeline pipeline(mpc, [&](MPC_Pipeline::Policy& policy) {
+    // the serialized policy matches the primal solution
+    const policy_serialization::PolicyView view(policy.serializedPolicy.data(), policy.serializedPolicy.size());
+    EXPECT_EQ(view.observation().time, policy.commandPtr->mpcInitObservation_.time);
+    EXPECT_TRUE(policy.primalSolutionPtr->stateTrajectory_.front().isApprox(policy.commandPtr->mpcInitObservation_.state));
+
+    std::lock_guard<std::mutex> lock(publishedMutex);
+    publishedTimes.push_back(policy.commandPtr->mpcInitObservation_.time);
+  });
+
+  constexpr int numObservations = 100;
+  pipeline.setCurrentObservation(getObservation(0.0, 0.0));
+  pipeline.start();
+  ASSERT_TRUE(pipeline.isRunning());
+  for (int i = 1; i < numObservations; i++) {
+    pipeline.setCurrentObservation(getObservation(0.001 * i, i));
+    std::this_thread::sleep_for(std::chrono::microseconds(500));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  pipeline.stop();
+  ASSERT_FALSE(pipeline.isRunning());
+
+  // Observations that arrived during a solve are replaced by newer ones, the published policies are in order
+  ASSERT_FALSE(publishedTimes.empty());
+  EXPECT_LT(publishedTimes.size(), numObservations);
+  for (size_t i = 1; i < publishedTimes.size(); i++) {
+    EXPECT_GT(publishedTimes[i], publishedTimes[i - 1]);
+  }
+  EXPECT_DOUBLE_EQ(publishedTimes.back(), 0.001 * (numObservations - 1));
+
+  const auto statistics = pipeline.getStatistics();
+  EXPECT_GT(statistics.numDroppedObservations, 0);
+  EXPECT_EQ(statistics.total.getNumTimedIntervals(), publishedTimes.size());
+  EXPECT_EQ(statistics.publication.getNumTimedIntervals(), publishedTimes.size());
+  EXPECT_EQ(statistics.solve.getNumTimedIntervals(), publishedTimes.size() + statistics.numDroppedPolicies);
+  EXPECT_GE(statistics.solve.getAverageInMilliseconds(), 5.0);
+  EXPECT_GE(statistics.total.getMaxIntervalInMilliseconds(), statistics.solve.getMaxIntervalInMilliseconds());
+}
+
+TEST(testMpcPipeline, stageException) {
+  TestMpc mpc(std::chrono::milliseconds(1));
+  size_t numPublished = 0;
+  MPC_Pipeline pipeline(mpc, [&](MPC_Pipeline::Policy& policy) { numPublished++; });
+
+  pipeline.start();
+  pipeline.setCurrentObservation(getObservation(0.0, -1.0));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_THROW(pipeline.stop(), std::runtime_error);
+  EXPECT_EQ(numPublished, 0);
+
+  // The pipeline can be reset and restarted
+  EXPECT_NO_THROW(pipeline.resetMpcNode(TargetTrajectories()));
+  pipeline.start();
+  EXPECT_THROW(pipeline.resetMpcNode(TargetTrajectories()), std::runtime_error);
+  pipeline.setCurrentObservation(getObservation(0.0, 1.0));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  pipeline.stop();
+  EXPECT_EQ(numPublished, 1);
+}
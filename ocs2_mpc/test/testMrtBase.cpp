@@ -0,0 +1,132 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include <ocs2_core/control/FeedforwardController.h>
+
+#include "ocs2_mpc/MRT_BASE.h"
+
+using namespace ocs2;
+
+namespace {
+
+/** MRT which receives the policies from the test */
+class TestMrt : public MRT_BASE {
+ public:
+  void resetMpcNode(const TargetTrajectories& initTargetTrajectories) override {}
+  void setCurrentObservation(const SystemObservation& observation) override {}
+
+  /** Buffers a policy in which all values are equal to the given value */
+  void receivePolicy(scalar_t value) {
+    constexpr size_t N = 20;
+    auto primalSolutionPtr = std::make_unique<PrimalSolution>();
+    for (size_t k = 0; k < N; ++k) {
+      primalSolutionPtr->timeTrajectory_.push_back(0.1 * k);
+      primalSolutionPtr->stateTrajectory_.push_back(vector_t::Constant(4, value));
+      primalSolutionPtr->inputTrajectory_.push_back(vector_t::Constant(2, value));
+    }
+    primalSolutionPtr->controllerPtr_.reset(
+        new FeedforwardController(primalSolutionPtr->timeTrajectory_, primalSolutionPtr->inputTrajectory_));
+    moveToBuffer(std::make_unique<CommandData>(), std::move(primalSolutionPtr), std::make_unique<PerformanceIndex>());
+  }
+};
+
+}  // namespace
+
+TEST(testMrtBase, noPolicy) {
+  TestMrt mrt;
+  vector_t state, input;
+  size_t mode;
+  EXPECT_FALSE(mrt.updatePolicy());
+  EXPECT_THROW(mrt.evaluatePolicy(0.0, vector_t::Zero(4), state, input, mode), std::runtime_error);
+  EXPECT_THROW(mrt.getPolicy(), std::runtime_error);
+
+  mrt.receivePolicy(1.0);
+  EXPECT_TRUE(mrt.initialPolicyReceived());
+  EXPECT_THROW(mrt.getPolicy(), std::runtime_error);
+  ASSERT_TRUE(mrt.updatePolicy());
+  EXPECT_FALSE(mrt.updatePolicy());
+  mrt.evaluatePolicy(0.5, vector_t::Zero(4), state, input, mode);
+  EXPECT_TRUE(state.isApprox(vector_t::Constant(4, 1.0)));
+  EXPECT_TRUE(input.isApprox(vector_t::Constant(2, 1.0)));
+
+  mrt.reset();
+  EXPECT_THROW(mrt.evaluatePolicy(0.0, vector_t::Zero(4), state, input, mode), std::runtime_error);
+}
+
+/** Evaluates the policy at a high rate while policies are received and installed in other threads */
+TEST(testMrtBase, concurrentEvaluation) {
+  constexpr size_t numPolicies = 500;
+  TestMrt mrt;
+  mrt.receivePolicy(0.0);
+  ASSERT_TRUE(mrt.updatePolicy());
+
+  std::atomic_bool receiverDone{false};
+  std::atomic_bool updaterDone{false};
+  std::thread receiver([&]() {
+    for (size_t i = 1; i <= numPolicies; ++i) {
+      mrt.receivePolicy(i);
+      std::this_thread::yield();
+    }
+    receiverDone = true;
+  });
+  std::thread updater([&]() {
+    // Install the remaining policy after the receiver is done
+    while (!receiverDone || mrt.updatePolicy()) {
+      mrt.updatePolicy();
+    }
+    updaterDone = true;
+  });
+
+  vector_t state, input;
+  size_t mode;
+  scalar_t lastValue = 0.0;
+  size_t numEvaluations = 0;
+  while (!updaterDone) {
+    mrt.evaluatePolicy(0.05 * (numEvaluations % 20), vector_t::Zero(4), state, input, mode);
+    ++numEvaluations;
+
+    // The evaluated policy is one consistent policy, and it is not older than the previous one
+    const scalar_t value = state(0);
+    ASSERT_TRUE((state.array() == value).all());
+    ASSERT_TRUE((input.array() == value).all());
+    ASSERT_GE(value, lastValue);
+    lastValue = value;
+  }
+  receiver.join();
+  updater.join();
+
+  mrt.evaluatePolicy(0.0, vector_t::Zero(4), state, input, mode);
+  EXPECT_EQ(state(0), numPolicies);
+  EXPECT_GT(numEvaluations, 0);
+}
@@ -0,0 +1,258 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+#include <iostream>
+
+#include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
+#include <ocs2_core/misc/Benchmark.h>
+
+#include "ocs2_mpc/PolicySerialization.h"
+
+using namespace ocs2;
+
+namespace {
+
+struct Policy {
+  PrimalSolution primalSolution;
+  CommandData commandData;
+  PerformanceIndex performanceIndices;
+};
+
+Policy getRandomPolicy(size_t N, size_t nx, size_t nu, bool linearController) {
+  Policy policy;
+  auto& primalSolution = policy.primalSolution;
+  for (size_t k = 0; k < N; ++k) {
+    primalSolution.timeTrajectory_.push_back(0.01 * k);
+    primalSolution.stateTrajectory_.push_back(vector_t::Random(nx));
+    primalSolution.inputTrajectory_.push_back(vector_t::Random(nu));
+  }
+  primalSolution.postEventIndices_ = {N / 2};
+  primalSolution.modeSchedule_ = ModeSchedule({primalSolution.timeTrajectory_[N / 2]}, {3, 5});
+
+  if (linearController) {
+    matrix_array_t gains;
+    for (size_t k = 0; k < N; ++k) {
+      gains.push_back(matrix_t::Random(nu, nx));
+    }
+    primalSolution.controllerPtr_.reset(
+        new LinearController(primalSolution.timeTrajectory_, primalSolution.inputTrajectory_, std::move(gains)));
+  } else {
+    primalSolution.controllerPtr_.reset(new FeedforwardController(primalSolution.timeTrajectory_, primalSolution.inputTrajectory_));
+  }
+
+  auto& observation = policy.commandData.mpcInitObservation_;
+  observation.mode = 3;
+  observation.time = 0.5;
+  observation.state = vector_t::Random(nx);
+  observation.input = vector_t::Random(nu);
+  policy.commandData.mpcTargetTrajectories_ = TargetTrajectories({0.0, 1.0}, {vector_t::Random(nx), vector_t::Random(nx)},
+                                                                 {vector_t::Random(nu), vector_t::Random(nu)});
+
+  policy.performanceIndices.merit = 1.0;
+  policy.performanceIndices.cost = 2.0;
+  policy.performanceIndices.inequalityLagrangian = 8.0;
+  return policy;
+}
+
+void expectEqual(const Policy& expected, const Policy& actual) {
+  const auto& x = expected.primalSolution;
+  const auto& y = actual.primalSolution;
+  EXPECT_EQ(x.timeTrajectory_, y.timeTrajectory_);
+  ASSERT_EQ(x.stateTrajectory_.size(), y.stateTrajectory_.size());
+  ASSERT_EQ(x.inputTrajectory_.size(), y.inputTrajectory_.size());
+  for (size_t k = 0; k < x.stateTrajectory_.size(); ++k) {
+    EXPECT_EQ(x.stateTrajectory_[k], y.stateTrajectory_[k]);
+    EXPECT_EQ(x.inputTrajectory_[k], y.inputTrajectory_[k]);
+  }
+  EXPECT_EQ(x.postEventIndices_, y.postEventIndices_);
+  EXPECT_EQ(x.modeSchedule_.eventTimes, y.modeSchedule_.eventTimes);
+  EXPECT_EQ(x.modeSchedule_.modeSequence, y.modeSchedule_.modeSequence);
+
+  ASSERT_NE(y.controllerPtr_, nullptr);
+  ASSERT_EQ(x.controllerPtr_->getType(), y.controllerPtr_->getType());
+  for (const auto t : {0.0, 0.123, 0.5, 10.0}) {
+    EXPECT_TRUE(x.controllerPtr_->computeInput(t, x.stateTrajectory_.front()) ==
+                y.controllerPtr_->computeInput(t, x.stateTrajectory_.front()));
+  }
+
+  const auto& observation = expected.commandData.mpcInitObservation_;
+  EXPECT_EQ(observation.mode, actual.commandData.mpcInitObservation_.mode);
+  EXPECT_EQ(observation.time, actual.commandData.mpcInitObservation_.time);
+  EXPECT_TRUE(observation.state == actual.commandData.mpcInitObservation_.state);
+  EXPECT_TRUE(observation.input == actual.commandData.mpcInitObservation_.input);
+  auto targetTrajectories = expected.commandData.mpcTargetTrajectories_;
+  EXPECT_TRUE(targetTrajectories == actual.commandData.mpcTargetTrajectories_);
+  EXPECT_EQ(expected.performanceIndices.merit, actual.performanceIndices.merit);
+  EXPECT_EQ(expected.performanceIndices.cost, actual.performanceIndices.cost);
+  EXPECT_EQ(expected.performanceIndices.inequalityLagrangian, actual.performanceIndices.inequalityLagrangian);
+}
+
+}  // namespace
+
+TEST(testPolicySerialization, linearController) {
+  const auto policy = getRandomPolicy(20, 4, 2, true);
+  std::vector<uint8_t> buffer;
+  policy_serialization::serialize(policy.primalSolution, policy.commandData, policy.performanceIndices, buffer);
+  EXPECT_EQ(buffer.size(), policy_serialization::serializedSize(policy.primalSolution, policy.commandData));
+
+  Policy result;
+  policy_serialization::deserialize(policy_serialization::PolicyView(buffer.data(), buffer.size()), result.commandData,
+                                    result.primalSolution, result.performanceIndices);
+  expectEqual(policy, result);
+
+  // Reuse of the outputs
+  const auto* controllerPtr = result.primalSolution.controllerPtr_.get();
+  policy_serialization::deserialize(policy_serialization::PolicyView(buffer.data(), buffer.size()), result.commandData,
+                                    result.primalSolution, result.performanceIndices);
+  EXPECT_EQ(controllerPtr, result.primalSolution.controllerPtr_.get());
+  expectEqual(policy, result);
+}
+
+TEST(testPolicySerialization, feedforwardController) {
+  const auto policy = getRandomPolicy(20, 4, 2, false);
+  std::vector<uint8_t> buffer;
+  policy_serialization::serialize(policy.primalSolution, policy.commandData, policy.performanceIndices, buffer);
+
+  // Deserialize into a policy with a linear controller
+  auto result = getRandomPolicy(5, 3, 1, true);
+  policy_serialization::deserialize(policy_serialization::PolicyView(buffer.data(), buffer.size()), result.commandData,
+                                    result.primalSolution, result.performanceIndices);
+  expectEqual(policy, result);
+}
+
+TEST(testPolicySerialization, view) {
+  const auto policy = getRandomPolicy(10, 3, 2, true);
+  std::vector<uint8_t> buffer;
+  policy_serialization::serialize(policy.primalSolution, policy.commandData, policy.performanceIndices, buffer);
+
+  const policy_serialization::PolicyView view(buffer.data(), buffer.size());
+  const auto& linearController = static_cast<const LinearController&>(*policy.primalSolution.controllerPtr_);
+  EXPECT_EQ(view.controllerType(), ControllerType::LINEAR);
+  ASSERT_EQ(view.numNodes(), 10);
+  ASSERT_EQ(view.numControllerNodes(), 10);
+  for (size_t k = 0; k < view.numNodes(); ++k) {
+    EXPECT_EQ(view.time()(k), policy.primalSolution.timeTrajectory_[k]);
+    EXPECT_TRUE(view.state(k) == policy.primalSolution.stateTrajectory_[k]);
+    EXPECT_TRUE(view.input(k) == policy.primalSolution.inputTrajectory_[k]);
+    EXPECT_TRUE(view.controllerBias(k) == linearController.biasArray_[k]);
+    EXPECT_TRUE(view.controllerGain(k) == linearController.gainArray_[k]);
+  }
+  // The view points into the buffer
+  const auto* stateData = reinterpret_cast<const uint8_t*>(view.state(3).data());
+  EXPECT_TRUE(stateData > buffer.data() && stateData < buffer.data() + buffer.size());
+}
+
+TEST(testPolicySerialization, invalidBuffer) {
+  const auto policy = getRandomPolicy(10, 3, 2, true);
+  std::vector<uint8_t> buffer;
+  policy_serialization::serialize(policy.primalSolution, policy.commandData, policy.performanceIndices, buffer);
+
+  // Truncated
+  EXPECT_THROW(policy_serialization::PolicyView(buffer.data(), buffer.size() - 8), std::runtime_error);
+  EXPECT_THROW(policy_serialization::PolicyView(buffer.data(), 16), std::runtime_error);
+
+  // Wrong version
+  auto wrongVersion = buffer;
+  wrongVersion[4] += 1;
+  EXPECT_THROW(policy_serialization::PolicyView(wrongVersion.data(), wrongVersion.size()), std::runtime_error);
+
+  // Not a policy
+  std::vector<uint8_t> zeros(buffer.size(), 0);
+  EXPECT_THROW(policy_serialization::PolicyView(zeros.data(), zeros.size()), std::runtime_error);
+}
+
+/** Compares the binary format with the conversion of the flattened controller message, i.e., a float vector per node */
+TEST(testPolicySerialization, benchmark) {
+  constexpr size_t N = 100;
+  constexpr size_t nx = 24;
+  constexpr size_t nu = 24;
+  constexpr int numRepetitions = 20;
+  const auto policy = getRandomPolicy(N, nx, nu, true);
+  const auto& timeTrajectory = policy.primalSolution.timeTrajectory_;
+
+  benchmark::RepeatedTimer flatEncode, flatDecode, binaryEncode, binaryDecode;
+  for (int i = 0; i < numRepetitions; ++i) {
+    // Flattened controller
+    flatEncode.startTimer();
+    std::vector<std::vector<float>> states(N), inputs(N), data(N);
+    for (size_t k = 0; k < N; ++k) {
+      const auto& x = policy.primalSolution.stateTrajectory_[k];
+      const auto& u = policy.primalSolution.inputTrajectory_[k];
+      states[k].assign(x.data(), x.data() + x.size());
+      inputs[k].assign(u.data(), u.data() + u.size());
+    }
+    std::vector<std::vector<float>*> dataPtrs(N);
+    for (size_t k = 0; k < N; ++k) {
+      dataPtrs[k] = &data[k];
+    }
+    policy.primalSolution.controllerPtr_->flatten(timeTrajectory, dataPtrs);
+    flatEncode.endTimer();
+
+    flatDecode.startTimer();
+    PrimalSolution flatSolution;
+    size_array_t stateDim(N), inputDim(N);
+    std::vector<std::vector<float> const*> constDataPtrs(N);
+    for (size_t k = 0; k < N; ++k) {
+      stateDim[k] = states[k].size();
+      inputDim[k] = inputs[k].size();
+      flatSolution.timeTrajectory_.push_back(timeTrajectory[k]);
+      flatSolution.stateTrajectory_.emplace_back(Eigen::Map<const Eigen::VectorXf>(states[k].data(), stateDim[k]).cast<scalar_t>());
+      flatSolution.inputTrajectory_.emplace_back(Eigen::Map<const Eigen::VectorXf>(inputs[k].data(), inputDim[k]).cast<scalar_t>());
+      constDataPtrs[k] = &data[k];
+    }
+    flatSolution.controllerPtr_.reset(
+        new LinearController(LinearController::unFlatten(stateDim, inputDim, flatSolution.timeTrajectory_, constDataPtrs)));
+    flatDecode.endTimer();
+  }
+
+  std::vector<uint8_t> buffer;
+  Policy result;
+  for (int i = 0; i < numRepetitions; ++i) {
+    binaryEncode.startTimer();
+    policy_serialization::serialize(policy.primalSolution, policy.commandData, policy.performanceIndices, buffer);
+    binaryEncode.endTimer();
+
+    binaryDecode.startTimer();
+    policy_serialization::deserialize(policy_serialization::PolicyView(buffer.data(), buffer.size()), result.commandData,
+                                      result.primalSolution, result.performanceIndices);
+    binaryDecode.endTimer();
+  }
+  expectEqual(policy, result);
+
+  std::cerr << "\n#### Policy transport benchmark: N = " << N << ", nx = " << nx << ", nu = " << nu << ", " << buffer.size()
+            << " bytes\n";
+  std::cerr << std::setw(20) << "flattened encode : " << std::setw(10) << flatEncode.getAverageInMilliseconds() << " [ms]\n";
+  std::cerr << std::setw(20) << "flattened decode : " << std::setw(10) << flatDecode.getAverageInMilliseconds() << " [ms]\n";
+  std::cerr << std::setw(20) << "binary encode : " << std::setw(10) << binaryEncode.getAverageInMilliseconds() << " [ms]\n";
+  std::cerr << std::setw(20) << "binary decode : " << std::setw(10) << binaryDecode.getAverageInMilliseconds() << " [ms]\n";
+}
@@ -0,0 +1,189 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include <ocs2_core/control/FeedforwardController.h>
+
+#include "ocs2_mpc/SharedMemoryPolicyChannel.h"
+
+using namespace ocs2;
+
+namespace {
+
+std::string getSegmentName(const std::string& testName) {
+  return "ocs2_test_" + testName + "_" + std::to_string(getpid());
+}
+
+/** A policy in which all values are equal to the given value */
+void setPolicy(scalar_t value, size_t N, size_t nx, size_t nu, PrimalSolution& primalSolution, CommandData& commandData) {
+  primalSolution.clear();
+  for (size_t k = 0; k < N; ++k) {
+    primalSolution.timeTrajectory_.push_back(value + k);
+    primalSolution.stateTrajectory_.push_back(vector_t::Constant(nx, value));
+    primalSolution.inputTrajectory_.push_back(vector_t::Constant(nu, value));
+  }
+  primalSolution.controllerPtr_.reset(new FeedforwardController(primalSolution.timeTrajectory_, primalSolution.inputTrajectory_));
+  commandData.mpcInitObservation_.time = value;
+  commandData.mpcInitObservation_.state = vector_t::Constant(nx, value);
+  commandData.mpcInitObservation_.input = vector_t::Constant(nu, value);
+}
+
+/** Checks that the policy is the one of setPolicy, i.e., that it was not torn by a concurrent write */
+void checkPolicy(size_t N, const PrimalSolution& primalSolution, const CommandData& commandData) {
+  const scalar_t value = commandData.mpcInitObservation_.time;
+  ASSERT_EQ(primalSolution.timeTrajectory_.size(), N);
+  for (size_t k = 0; k < N; ++k) {
+    ASSERT_EQ(primalSolution.timeTrajectory_[k], value + k);
+    ASSERT_TRUE((primalSolution.stateTrajectory_[k].array() == value).all());
+    ASSERT_TRUE((primalSolution.inputTrajectory_[k].array() == value).all());
+  }
+  ASSERT_TRUE((commandData.mpcInitObservation_.state.array() == value).all());
+}
+
+}  // namespace
+
+TEST(testSharedMemoryPolicyChannel, readWrite) {
+  SharedMemoryPolicyChannel writer(getSegmentName("readWrite"), SharedMemoryPolicyChannel::Role::Writer);
+  SharedMemoryPolicyChannel reader(getSegmentName("readWrite"), SharedMemoryPolicyChannel::Role::Reader);
+  ASSERT_TRUE(reader.isConnected());
+
+  PrimalSolution primalSolution;
+  CommandData commandData;
+  PerformanceIndex performanceIndices;
+  EXPECT_FALSE(reader.read(commandData, primalSolution, performanceIndices));
+
+  // Only the latest policy is read
+  for (const scalar_t value : {1.0, 2.0, 3.0}) {
+    setPolicy(value, 10, 4, 2, primalSolution, commandData);
+    performanceIndices.cost = value;
+    writer.write(primalSolution, commandData, performanceIndices);
+  }
+  PrimalSolution readPrimalSolution;
+  CommandData readCommandData;
+  PerformanceIndex readPerformanceIndices;
+  ASSERT_TRUE(reader.read(readCommandData, readPrimalSolution, readPerformanceIndices));
+  checkPolicy(10, readPrimalSolution, readCommandData);
+  EXPECT_EQ(readCommandData.mpcInitObservation_.time, 3.0);
+  EXPECT_EQ(readPerformanceIndices.cost, 3.0);
+
+  // Nothing new
+  EXPECT_FALSE(reader.read(readCommandData, readPrimalSolution, readPerformanceIndices));
+  EXPECT_EQ(readCommandData.mpcInitObservation_.time, 3.0);
+
+  setPolicy(4.0, 5, 4, 2, primalSolution, commandData);
+  writer.write(primalSolution, commandData, performanceIndices);
+  ASSERT_TRUE(reader.read(readCommandData, readPrimalSolution, readPerformanceIndices));
+  checkPolicy(5, readPrimalSolution, readCommandData);
+  EXPECT_EQ(readCommandData.mpcInitObservation_.time, 4.0);
+}
+
+TEST(testSharedMemoryPolicyChannel, reconnect) {
+  const auto name = getSegmentName("reconnect");
+  SharedMemoryPolicyChannel reader(name, SharedMemoryPolicyChannel::Role::Reader);
+  EXPECT_FALSE(reader.isConnected());
+
+  PrimalSolution primalSolution;
+  CommandData commandData;
+  PerformanceIndex performanceIndices;
+  EXPECT_FALSE(reader.read(commandData, primalSolution, performanceIndices));
+
+  // Reader before writer
+  {
+    SharedMemoryPolicyChannel writer(name, SharedMemoryPolicyChannel::Role::Writer);
+    setPolicy(1.0, 10, 4, 2, primalSolution, commandData);
+    writer.write(primalSolution, commandData, performanceIndices);
+    ASSERT_TRUE(reader.read(commandData, primalSolution, performanceIndices));
+    EXPECT_EQ(commandData.mpcInitObservation_.time, 1.0);
+  }
+
+  // Restarted writer: the first read detects the closed segment, the second one connects to the new segment
+  SharedMemoryPolicyChannel writer(name, SharedMemoryPolicyChannel::Role::Writer);
+  setPolicy(2.0, 10, 4, 2, primalSolution, commandData);
+  writer.write(primalSolution, commandData, performanceIndices);
+  EXPECT_FALSE(reader.read(commandData, primalSolution, performanceIndices));
+  ASSERT_TRUE(reader.read(commandData, primalSolution, performanceIndices));
+  EXPECT_EQ(commandData.mpcInitObservation_.time, 2.0);
+}
+
+TEST(testSharedMemoryPolicyChannel, capacity) {
+  SharedMemoryPolicyChannel writer(getSegmentName("capacity"), SharedMemoryPolicyChannel::Role::Writer, 1024);
+  PrimalSolution primalSolution;
+  CommandData commandData;
+  setPolicy(1.0, 100, 4, 2, primalSolution, commandData);
+  EXPECT_THROW(writer.write(primalSolution, commandData, PerformanceIndex()), std::runtime_error);
+}
+
+TEST(testSharedMemoryPolicyChannel, concurrentReadWrite) {
+  constexpr size_t N = 20;
+  constexpr size_t numPolicies = 5000;
+  const auto name = getSegmentName("concurrentReadWrite");
+  SharedMemoryPolicyChannel writer(name, SharedMemoryPolicyChannel::Role::Writer);
+  SharedMemoryPolicyChannel reader(name, SharedMemoryPolicyChannel::Role::Reader);
+
+  std::atomic_bool writerDone{false};
+  std::thread writerThread([&]() {
+    PrimalSolution primalSolution;
+    CommandData commandData;
+    for (size_t i = 1; i <= numPolicies; ++i) {
+      setPolicy(i, N, 6, 3, primalSolution, commandData);
+      writer.write(primalSolution, commandData, PerformanceIndex());
+    }
+    writerDone = true;
+  });
+
+  PrimalSolution primalSolution;
+  CommandData commandData;
+  PerformanceIndex performanceIndices;
+  scalar_t lastValue = 0.0;
+  size_t numReads = 0;
+  auto readAndCheck = [&]() {
+    if (reader.read(commandData, primalSolution, performanceIndices)) {
+      checkPolicy(N, primalSolution, commandData);
+      EXPECT_GT(commandData.mpcInitObservation_.time, lastValue);
+      lastValue = commandData.mpcInitObservation_.time;
+      ++numReads;
+    }
+  };
+  while (!writerDone) {
+    readAndCheck();
+  }
+  writerThread.join();
+
+  // The last policy might have been written after the last read
+  readAndCheck();
+  EXPECT_EQ(lastValue, numPolicies);
+  EXPECT_GT(numReads, 1);
+}
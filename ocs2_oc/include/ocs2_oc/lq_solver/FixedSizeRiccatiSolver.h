@@ -0,0 +1,192 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <ocs2_core/FixedSizeTypes.h>
+#include <ocs2_core/Types.h>
+
+#include "ocs2_oc/lq_solver/FixedSizeRiccatiSolverInterface.h"
+#include "ocs2_oc/oc_problem/OcpLqArena.h"
+
+namespace ocs2 {
+
+/**
+ * Serial Riccati solver for unconstrained linear-quadratic optimal control problems whose state and input dimensions are known at
+ * compile time. All blocks are fixed-size Eigen objects, such that the recursion runs without heap allocations and with unrolled
+ * kernels. It targets small systems (nx <= 12, nu <= 4), for which the overhead of the dynamic-size path is significant.
+ *
+ * Every node must have NX states and either NU or no inputs. The latter are the event nodes of the multiple-shooting transcription.
+ * Use isCompatible() to decide whether a problem can be solved by this solver.
+ *
+ * Conventions are the ones of the multiple-shooting transcription:
+ *    dynamics : dx[k+1] = A[k] dx[k] + B[k] du[k] + b[k]
+ *    cost     : q[k]' dx[k] + r[k]' du[k] + 0.5 dx[k]' Q[k] dx[k] + 0.5 du[k]' R[k] du[k] + du[k]' S[k] dx[k]
+ * The Riccati Hessians R[k] + B[k]' P[k+1] B[k] must be positive definite.
+ *
+ * @tparam NX : State dimension.
+ * @tparam NU : Input dimension.
+ */
+template <int NX, int NU>
+class FixedSizeRiccatiSolver {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  using state_vector_t = fixed_vector_t<NX>;
+  using input_vector_t = fixed_vector_t<NU>;
+  using state_matrix_t = fixed_matrix_t<NX, NX>;
+  using feedback_matrix_t = fixed_matrix_t<NU, NX>;
+  using dynamics_t = FixedSizeVectorFunctionLinearApproximation<NX, NU>;
+  using cost_t = FixedSizeScalarFunctionQuadraticApproximation<NX, NU>;
+
+  FixedSizeRiccatiSolver() = default;
+
+  /** Whether all nodes of a problem have NX states and NU or no inputs, such that it can be solved by this solver. */
+  static bool isCompatible(const OcpSize& ocpSize);
+
+  /** Whether all nodes of a problem have NX states and NU or no inputs, such that it can be solved by this solver. */
+  static bool isCompatible(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                           const std::vector<ScalarFunctionQuadraticApproximation>& cost);
+
+  /**
+   * Solves the LQ problem stored in the arena. The state-input equality constraints of the arena have to be empty and the problem has
+   * to be compatible. The outputs are only resized if their size changes.
+   *
+   * @param [in] x0 : Initial state deviation.
+   * @param [in] lq : The LQ approximation.
+   * @param [out] deltaXSol : State trajectory of the solution, deltaXSol[0] = x0.
+   * @param [out] deltaUSol : Input trajectory of the solution.
+   * @return true if the problem was solved, false if a Riccati Hessian is not positive definite.
+   */
+  bool solve(const vector_t& x0, const OcpLqArena& lq, vector_array_t& deltaXSol, vector_array_t& deltaUSol);
+
+  /**
+   * Solves the LQ problem given as arrays of dynamic-size approximations. The problem has to be compatible.
+   *
+   * @param [in] x0 : Initial state deviation.
+   * @param [in] dynamics : Dynamics of the N stages.
+   * @param [in] cost : Cost of the N + 1 nodes.
+   * @param [out] deltaXSol : State trajectory of the solution, deltaXSol[0] = x0.
+   * @param [out] deltaUSol : Input trajectory of the solution.
+   * @return true if the problem was solved, false if a Riccati Hessian is not positive definite.
+   */
+  bool solve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+             const std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& deltaXSol, vector_array_t& deltaUSol);
+
+  /**
+   * Solves the LQ problem given as arrays of fixed-size approximations. All stages have NU inputs. This is the allocation-free path
+   * for controllers that keep their whole problem in fixed-size types.
+   *
+   * @param [in] x0 : Initial state deviation.
+   * @param [in] dynamics : Dynamics of the N stages.
+   * @param [in] cost : Cost of the N + 1 nodes. The input terms of the final node are ignored.
+   * @param [out] deltaXSol : State trajectory of the solution, deltaXSol[0] = x0.
+   * @param [out] deltaUSol : Input trajectory of the solution.
+   * @return true if the problem was solved, false if a Riccati Hessian is not positive definite.
+   */
+  bool solve(const state_vector_t& x0, const fixed_array_t<dynamics_t>& dynamics, const fixed_array_t<cost_t>& cost,
+             fixed_array_t<state_vector_t>& deltaXSol, fixed_array_t<input_vector_t>& deltaUSol);
+
+  /** Cost-to-go 0.5 dx' P dx + p' dx of the last solved problem, at all N + 1 nodes. The constant term is not computed. */
+  std::vector<ScalarFunctionQuadraticApproximation> getRiccatiCostToGo() const;
+
+  /** Feedback gains du = K dx + k of the last solved problem, at all N stages. Event stages have gains with zero rows. */
+  matrix_array_t getRiccatiFeedback() const;
+
+  /** Fixed-size cost-to-go Hessians of the last solved problem */
+  const fixed_array_t<state_matrix_t>& getCostToGoHessians() const { return P_; }
+
+  /** Fixed-size feedback gains of the last solved problem. The gains of event stages are zero. */
+  const fixed_array_t<feedback_matrix_t>& getFeedbackGains() const { return K_; }
+
+ private:
+  /** Backward recursion. Problem provides the accessors of ArenaLqProblem. */
+  template <typename Problem>
+  bool backwardPass(const Problem& problem);
+
+  /** Rollout of the affine policy into dynamic-size outputs */
+  template <typename Problem>
+  void forwardPass(const vector_t& x0, const Problem& problem, vector_array_t& deltaXSol, vector_array_t& deltaUSol) const;
+
+  fixed_array_t<state_matrix_t> P_;
+  fixed_array_t<state_vector_t> p_;
+  fixed_array_t<feedback_matrix_t> K_;
+  fixed_array_t<input_vector_t> k_;
+  std::vector<char> hasInputs_;
+};
+
+/**
+ * FixedSizeRiccatiSolver behind the FixedSizeRiccatiSolverInterface, e.g.
+ *    std::unique_ptr<FixedSizeRiccatiSolverInterface> solverPtr(new FixedSizeRiccatiSolverAdapter<4, 1>());
+ *
+ * @tparam NX : State dimension.
+ * @tparam NU : Input dimension.
+ */
+template <int NX, int NU>
+class FixedSizeRiccatiSolverAdapter final : public FixedSizeRiccatiSolverInterface {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  ~FixedSizeRiccatiSolverAdapter() override = default;
+
+  int getNumStates() const override { return NX; }
+  int getNumInputs() const override { return NU; }
+
+  bool isCompatible(const OcpSize& ocpSize) const override { return FixedSizeRiccatiSolver<NX, NU>::isCompatible(ocpSize); }
+
+  bool isCompatible(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                    const std::vector<ScalarFunctionQuadraticApproximation>& cost) const override {
+    return FixedSizeRiccatiSolver<NX, NU>::isCompatible(dynamics, cost);
+  }
+
+  bool solve(const vector_t& x0, const OcpLqArena& lq, vector_array_t& deltaXSol, vector_array_t& deltaUSol) override {
+    return solver_.solve(x0, lq, deltaXSol, deltaUSol);
+  }
+
+  bool solve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+             const std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& deltaXSol, vector_array_t& deltaUSol) override {
+    return solver_.solve(x0, dynamics, cost, deltaXSol, deltaUSol);
+  }
+
+  std::vector<ScalarFunctionQuadraticApproximation> getRiccatiCostToGo() const override { return solver_.getRiccatiCostToGo(); }
+
+  matrix_array_t getRiccatiFeedback() const override { return solver_.getRiccatiFeedback(); }
+
+  /** The wrapped solver */
+  const FixedSizeRiccatiSolver<NX, NU>& getSolver() const { return solver_; }
+
+ private:
+  FixedSizeRiccatiSolver<NX, NU> solver_;
+};
+
+}  // namespace ocs2
+
+#include "implementation/FixedSizeRiccatiSolver.h"
@@ -0,0 +1,75 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+#include "ocs2_oc/oc_problem/OcpLqArena.h"
+
+namespace ocs2 {
+
+/**
+ * Interface of the FixedSizeRiccatiSolver, independent of its dimensions. Solvers that select the dimensions at compile time hold an
+ * implementation through this interface, such that their headers do not depend on the selected dimensions.
+ * See FixedSizeRiccatiSolver for the conventions.
+ */
+class FixedSizeRiccatiSolverInterface {
+ public:
+  virtual ~FixedSizeRiccatiSolverInterface() = default;
+
+  /** Dimensions of the solver */
+  virtual int getNumStates() const = 0;
+  virtual int getNumInputs() const = 0;
+
+  /** Whether all nodes of a problem have the states and inputs of the solver and no constraints. */
+  virtual bool isCompatible(const OcpSize& ocpSize) const = 0;
+
+  /** Whether all nodes of a problem given as arrays have the states and inputs of the solver. */
+  virtual bool isCompatible(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                            const std::vector<ScalarFunctionQuadraticApproximation>& cost) const = 0;
+
+  /** Solves the LQ problem stored in the arena, see FixedSizeRiccatiSolver::solve. */
+  virtual bool solve(const vector_t& x0, const OcpLqArena& lq, vector_array_t& deltaXSol, vector_array_t& deltaUSol) = 0;
+
+  /** Solves the LQ problem given as arrays of dynamic-size approximations, see FixedSizeRiccatiSolver::solve. */
+  virtual bool solve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                     const std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& deltaXSol,
+                     vector_array_t& deltaUSol) = 0;
+
+  /** Cost-to-go 0.5 dx' P dx + p' dx of the last solved problem, at all N + 1 nodes. The constant term is not computed. */
+  virtual std::vector<ScalarFunctionQuadraticApproximation> getRiccatiCostToGo() const = 0;
+
+  /** Feedback gains du = K dx + k of the last solved problem, at all N stages. Event stages have gains with zero rows. */
+  virtual matrix_array_t getRiccatiFeedback() const = 0;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,78 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+#include "ocs2_oc/oc_problem/OcpLqArena.h"
+
+namespace ocs2 {
+
+/**
+ * Read access to the LQ data stored in an arena. Together with ArrayLqProblem, it allows writing the structured LQ solvers once for
+ * both storages.
+ */
+struct ArenaLqProblem {
+  const OcpLqArena& lq;
+
+  int numStages() const { return lq.numStages(); }
+  int numStates(int k) const { return lq.size().numStates[k]; }
+  int numInputs(int k) const { return lq.size().numInputs[k]; }
+  OcpLqArena::const_matrix_map_t A(int k) const { return lq.A(k); }
+  OcpLqArena::const_matrix_map_t B(int k) const { return lq.B(k); }
+  OcpLqArena::const_vector_map_t b(int k) const { return lq.b(k); }
+  OcpLqArena::const_matrix_map_t Q(int k) const { return lq.Q(k); }
+  OcpLqArena::const_matrix_map_t S(int k) const { return lq.S(k); }
+  OcpLqArena::const_matrix_map_t R(int k) const { return lq.R(k); }
+  OcpLqArena::const_vector_map_t q(int k) const { return lq.q(k); }
+  OcpLqArena::const_vector_map_t r(int k) const { return lq.r(k); }
+};
+
+/** Access to the LQ data stored as arrays of approximations */
+struct ArrayLqProblem {
+  const std::vector<VectorFunctionLinearApproximation>& dynamics;
+  const std::vector<ScalarFunctionQuadraticApproximation>& cost;
+
+  int numStages() const { return static_cast<int>(dynamics.size()); }
+  int numStates(int k) const { return static_cast<int>(cost[k].dfdx.size()); }
+  int numInputs(int k) const { return static_cast<int>(dynamics[k].dfdu.cols()); }
+  const matrix_t& A(int k) const { return dynamics[k].dfdx; }
+  const matrix_t& B(int k) const { return dynamics[k].dfdu; }
+  const vector_t& b(int k) const { return dynamics[k].f; }
+  const matrix_t& Q(int k) const { return cost[k].dfdxx; }
+  const matrix_t& S(int k) const { return cost[k].dfdux; }
+  const matrix_t& R(int k) const { return cost[k].dfduu; }
+  const vector_t& q(int k) const { return cost[k].dfdx; }
+  const vector_t& r(int k) const { return cost[k].dfdu; }
+};
+
+}  // namespace ocs2
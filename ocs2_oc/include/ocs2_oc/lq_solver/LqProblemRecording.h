@@ -0,0 +1,61 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <string>
+
+#include <ocs2_core/Types.h>
+
+#include "ocs2_oc/oc_problem/OcpLqArena.h"
+
+namespace ocs2 {
+namespace lq_solver {
+
+/**
+ * Writes an LQ problem to a binary file, to replay it later with different LQ solvers. The file holds the initial state, the node
+ * dimensions, and the dynamics, cost and state-input equality constraints of all nodes. Throws if the file cannot be written.
+ *
+ * @param [in] filePath : Path of the file.
+ * @param [in] x0 : Initial state deviation.
+ * @param [in] lq : The LQ approximation.
+ */
+void saveLqProblem(const std::string& filePath, const vector_t& x0, const OcpLqArena& lq);
+
+/**
+ * Reads an LQ problem written by saveLqProblem. Throws if the file cannot be read or is not an LQ problem.
+ *
+ * @param [in] filePath : Path of the file.
+ * @param [out] lq : The LQ approximation. It is reserved for the problem.
+ * @return The initial state deviation.
+ */
+vector_t loadLqProblem(const std::string& filePath, OcpLqArena& lq);
+
+}  // namespace lq_solver
+}  // namespace ocs2
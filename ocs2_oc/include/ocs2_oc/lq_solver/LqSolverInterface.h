@@ -0,0 +1,95 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+#include "ocs2_oc/oc_problem/OcpLqArena.h"
+#include "ocs2_oc/oc_problem/OcpSize.h"
+
+namespace ocs2 {
+
+/** The available backends for the LQ subproblems of the multiple-shooting solvers */
+enum class LqSolverType {
+  HPIPM,             // HpipmLqSolver of hpipm_catkin: interior point method, handles all constraints
+  RICCATI,           // RiccatiLqSolver: serial Riccati recursion, eliminates the state-input equality constraints per stage
+  PARALLEL_RICCATI,  // ParallelRiccatiLqSolver: time-parallel Riccati recursion for unconstrained problems
+};
+
+namespace lq_solver {
+/** Name of the backend type, as used in the settings files */
+std::string toString(LqSolverType type);
+
+/** Backend type from its name. Throws if the name is unknown. */
+LqSolverType fromString(const std::string& name);
+}  // namespace lq_solver
+
+/**
+ * Interface of the solvers for the LQ subproblems of the multiple-shooting solvers. The problem is read from an OcpLqArena, its state-
+ * input equality constraints are C dx + D du + e = 0. Backends that do not support them only accept unconstrained problems.
+ */
+class LqSolverInterface {
+ public:
+  virtual ~LqSolverInterface() = default;
+
+  /** Name of the backend */
+  virtual std::string getName() const = 0;
+
+  /** Whether the backend handles the state-input equality constraints of the arena */
+  virtual bool supportsEqualityConstraints() const = 0;
+
+  /** Prepares the backend for problems of the given size. Does not allocate if the size did not change. */
+  virtual void resize(const OcpSize& ocpSize) = 0;
+
+  /**
+   * Solves the LQ problem stored in the arena. The backend has to be resized to lq.size() before.
+   *
+   * @param [in] x0 : Initial state deviation.
+   * @param [in] lq : The LQ approximation. Not modified, non-const for backends that read it in place.
+   * @param [out] deltaXSol : State trajectory of the solution, deltaXSol[0] = x0.
+   * @param [out] deltaUSol : Input trajectory of the solution.
+   * @return true if the problem was solved.
+   */
+  virtual bool solve(const vector_t& x0, OcpLqArena& lq, vector_array_t& deltaXSol, vector_array_t& deltaUSol) = 0;
+
+  /** Cost-to-go 0.5 dx' P dx + p' dx of the last solved problem, at all N + 1 nodes. lq is the problem of the last solve. */
+  virtual std::vector<ScalarFunctionQuadraticApproximation> getRiccatiCostToGo(const OcpLqArena& lq) = 0;
+
+  /** Feedback gains of the last solved problem, at all N stages. lq is the problem of the last solve. */
+  virtual matrix_array_t getRiccatiFeedback(const OcpLqArena& lq) = 0;
+
+  /** Number of iterations of the last solve. The direct backends take one. */
+  virtual int getNumIterations() const { return 1; }
+};
+
+}  // namespace ocs2
@@ -0,0 +1,74 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_oc/lq_solver/LqSolverInterface.h"
+#include "ocs2_oc/lq_solver/ParallelRiccatiSolver.h"
+
+namespace ocs2 {
+
+/** LqSolverInterface backend of the ParallelRiccatiSolver. Only solves problems without state-input equality constraints. */
+class ParallelRiccatiLqSolver final : public LqSolverInterface {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] threadPool : The thread pool of the segments. It has to outlive this object.
+   * @param [in] numThreads : The number of threads to use, including the calling thread.
+   */
+  ParallelRiccatiLqSolver(ThreadPool& threadPool, int numThreads) : threadPool_(threadPool), numThreads_(numThreads) {}
+  ~ParallelRiccatiLqSolver() override = default;
+
+  std::string getName() const override { return "PARALLEL_RICCATI"; }
+
+  bool supportsEqualityConstraints() const override { return false; }
+
+  void resize(const OcpSize& ocpSize) override {}
+
+  bool solve(const vector_t& x0, OcpLqArena& lq, vector_array_t& deltaXSol, vector_array_t& deltaUSol) override;
+
+  std::vector<ScalarFunctionQuadraticApproximation> getRiccatiCostToGo(const OcpLqArena& lq) override {
+    return solver_.getRiccatiCostToGo();
+  }
+
+  matrix_array_t getRiccatiFeedback(const OcpLqArena& lq) override { return solver_.getRiccatiFeedback(); }
+
+  /** The wrapped solver */
+  const ParallelRiccatiSolver& getSolver() const { return solver_; }
+
+ private:
+  ThreadPool& threadPool_;
+  const int numThreads_;
+  ParallelRiccatiSolver solver_;
+};
+
+}  // namespace ocs2
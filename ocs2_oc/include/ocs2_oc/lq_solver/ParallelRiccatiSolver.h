@@ -0,0 +1,148 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_oc/oc_problem/OcpLqArena.h"
+
+namespace ocs2 {
+
+/**
+ * Riccati solver for unconstrained linear-quadratic optimal control problems that is parallel in time.
+ *
+ * The horizon is split into one segment per thread. The backward recursion is done in three phases:
+ *    1. In parallel, every segment except the last one combines its stages into one element of the associative formulation of the
+ *       LQ problem (Sarkka and Garcia-Fernandez, "Temporal parallelization of dynamic programming and linear quadratic control", 2023).
+ *       At the same time, the last segment runs the regular Riccati recursion from the terminal cost.
+ *    2. Serially, the cost-to-go at the segment boundaries is obtained by applying the segment elements to the cost-to-go of the next
+ *       boundary.
+ *    3. In parallel, every remaining segment runs the regular Riccati recursion from the cost-to-go at its end.
+ * The forward pass is a serial rollout of the affine policy. It is cheap compared to the backward recursion.
+ *
+ * With a single thread, or for short horizons, the solver runs the regular serial Riccati recursion.
+ *
+ * Conventions are the ones of the multiple-shooting transcription:
+ *    dynamics : dx[k+1] = A[k] dx[k] + B[k] du[k] + b[k]
+ *    cost     : q[k]' dx[k] + r[k]' du[k] + 0.5 dx[k]' Q[k] dx[k] + 0.5 du[k]' R[k] du[k] + du[k]' S[k] dx[k]
+ * The input Hessians R[k] and the Riccati Hessians R[k] + B[k]' P[k+1] B[k] must be positive definite.
+ */
+class ParallelRiccatiSolver {
+ public:
+  ParallelRiccatiSolver() = default;
+
+  /**
+   * Solves the LQ problem stored in the arena. The state-input equality constraints of the arena have to be empty.
+   *
+   * @param [in] x0 : Initial state deviation.
+   * @param [in] lq : The LQ approximation.
+   * @param [in] threadPool : The thread pool. The number of segments is at most the number of pool threads plus the calling thread.
+   * @param [in] numThreads : The number of threads to use, including the calling thread.
+   * @param [out] deltaXSol : State trajectory of the solution, deltaXSol[0] = x0.
+   * @param [out] deltaUSol : Input trajectory of the solution.
+   * @return true if the problem was solved, false if a Riccati Hessian is not positive definite.
+   */
+  bool solve(const vector_t& x0, const OcpLqArena& lq, ThreadPool& threadPool, int numThreads, vector_array_t& deltaXSol,
+             vector_array_t& deltaUSol);
+
+  /**
+   * Solves the LQ problem given as arrays of approximations.
+   *
+   * @param [in] x0 : Initial state deviation.
+   * @param [in] dynamics : Dynamics of the N stages.
+   * @param [in] cost : Cost of the N + 1 nodes.
+   * @param [in] threadPool : The thread pool. The number of segments is at most the number of pool threads plus the calling thread.
+   * @param [in] numThreads : The number of threads to use, including the calling thread.
+   * @param [out] deltaXSol : State trajectory of the solution, deltaXSol[0] = x0.
+   * @param [out] deltaUSol : Input trajectory of the solution.
+   * @return true if the problem was solved, false if a Riccati Hessian is not positive definite.
+   */
+  bool solve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+             const std::vector<ScalarFunctionQuadraticApproximation>& cost, ThreadPool& threadPool, int numThreads,
+             vector_array_t& deltaXSol, vector_array_t& deltaUSol);
+
+  /** Cost-to-go 0.5 dx' P dx + p' dx of the last solved problem, at all N + 1 nodes. The constant term is not computed. */
+  std::vector<ScalarFunctionQuadraticApproximation> getRiccatiCostToGo() const;
+
+  /** Feedback gains du = K dx + k of the last solved problem, at all N stages */
+  const matrix_array_t& getRiccatiFeedback() const { return K_; }
+
+  /** Feedforward terms du = K dx + k of the last solved problem, at all N stages */
+  const vector_array_t& getRiccatiFeedforward() const { return k_; }
+
+  /** Number of segments of the last solve */
+  int getNumSegments() const { return numSegments_; }
+
+  /** Minimum number of nodes of a segment. Shorter horizons are solved with fewer segments. */
+  static constexpr int minSegmentLength = 4;
+
+ private:
+  /** Element of the associative formulation: conditional cost from the state at the start to the state after the end of a segment */
+  struct Element {
+    matrix_t A;  // state transition
+    vector_t b;  // state offset
+    matrix_t C;  // input-weighted reachability Gramian
+    matrix_t J;  // state Hessian at the start
+    vector_t q;  // state gradient at the start
+  };
+
+  template <typename Problem>
+  bool solveImpl(const vector_t& x0, const Problem& problem, ThreadPool& threadPool, int numThreads, vector_array_t& deltaXSol,
+                 vector_array_t& deltaUSol);
+
+  template <typename Problem>
+  bool riccatiStep(const Problem& problem, int k, const matrix_t& nextP, const vector_t& nextp);
+
+  template <typename Problem>
+  bool initializeElement(const Problem& problem, int k, Element& element) const;
+
+  /** element <- element (x) right, where element is the earlier segment */
+  static bool combineElements(Element& element, const Element& right);
+
+  /** Applies an element to the cost-to-go after its end: computes the cost-to-go at its start */
+  static bool applyElement(const Element& element, const matrix_t& nextP, const vector_t& nextp, matrix_t& P, vector_t& p);
+
+  int numSegments_ = 1;
+  std::vector<int> segmentStarts_;  // segment s covers the nodes [segmentStarts_[s], segmentStarts_[s + 1])
+  std::vector<Element> segmentElements_;
+  matrix_array_t boundaryP_;  // cost-to-go Hessian at the start of every segment
+  vector_array_t boundaryp_;  // cost-to-go gradient at the start of every segment
+  std::vector<char> segmentSuccess_;
+
+  matrix_array_t P_;
+  vector_array_t p_;
+  matrix_array_t K_;
+  vector_array_t k_;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,100 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+#include "ocs2_oc/lq_solver/LqSolverInterface.h"
+
+namespace ocs2 {
+
+/**
+ * Structured Riccati solver for LQ problems with state-input equality constraints, written with Eigen for small and medium dimensions.
+ *
+ * The equality constraints C dx + D du + e = 0 of a stage are eliminated before its Riccati step: with the QR decomposition of D',
+ * the input is parametrized as du = Px dx + pe + Z v, where Z spans the null space of D. The Riccati step then runs on the reduced
+ * input v, and the resulting policy is mapped back to du = K dx + k. This requires D to have full row rank at every constrained
+ * stage, i.e. pure state constraints are not supported.
+ *
+ * All intermediate matrices are kept in per-stage buffers, such that solving problems of the same size does not allocate.
+ */
+class RiccatiLqSolver final : public LqSolverInterface {
+ public:
+  RiccatiLqSolver() = default;
+  ~RiccatiLqSolver() override = default;
+
+  std::string getName() const override { return "RICCATI"; }
+
+  bool supportsEqualityConstraints() const override { return true; }
+
+  void resize(const OcpSize& ocpSize) override;
+
+  /** Returns false if a Riccati Hessian is not positive definite or the constraints of a stage are not full rank in the input. */
+  bool solve(const vector_t& x0, OcpLqArena& lq, vector_array_t& deltaXSol, vector_array_t& deltaUSol) override;
+
+  std::vector<ScalarFunctionQuadraticApproximation> getRiccatiCostToGo(const OcpLqArena& lq) override;
+
+  matrix_array_t getRiccatiFeedback(const OcpLqArena& lq) override { return K_; }
+
+  /** Feedforward terms du = K dx + k of the last solved problem, at all N stages */
+  const vector_array_t& getRiccatiFeedforward() const { return k_; }
+
+ private:
+  /** Riccati step of stage k, from the cost-to-go of node k + 1. Writes P_[k], p_[k] and the policy of the given input. */
+  bool riccatiStep(int k, const Eigen::Ref<const matrix_t>& A, const Eigen::Ref<const matrix_t>& B, const Eigen::Ref<const vector_t>& b,
+                   const Eigen::Ref<const matrix_t>& Q, const Eigen::Ref<const matrix_t>& S, const Eigen::Ref<const matrix_t>& R,
+                   const Eigen::Ref<const vector_t>& q, const Eigen::Ref<const vector_t>& r, matrix_t& K, vector_t& kff);
+
+  /** Computes Px_, pe_ and Z_ of stage k from its constraints. Returns false if D is not full row rank. */
+  bool eliminateConstraints(const OcpLqArena& lq, int k);
+
+  // Solution
+  matrix_array_t P_;
+  vector_array_t p_;
+  matrix_array_t K_;
+  vector_array_t k_;
+
+  // Buffers of the Riccati step
+  matrix_t PA_, PB_, H_, G_;
+  vector_t Pbp_, g_;
+  Eigen::LLT<matrix_t> llt_;
+
+  // Buffers of the constraint elimination: du = Px dx + pe + Z v, and the reduced stage
+  Eigen::ColPivHouseholderQR<matrix_t> qr_;
+  matrix_t Q_, Px_, Z_, RPx_, Kv_;
+  vector_t pe_, Rpe_, kv_;
+  matrix_t reducedA_, reducedB_, reducedQ_, reducedS_, reducedR_;
+  vector_t reducedb_, reducedq_, reducedr_;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,276 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "ocs2_oc/lq_solver/LqProblemAccess.h"
+
+namespace ocs2 {
+namespace fixed_size_riccati {
+
+/** Access to the LQ data stored as arrays of fixed-size approximations */
+template <int NX, int NU>
+struct FixedArrayLqProblem {
+  const fixed_array_t<FixedSizeVectorFunctionLinearApproximation<NX, NU>>& dynamics;
+  const fixed_array_t<FixedSizeScalarFunctionQuadraticApproximation<NX, NU>>& cost;
+
+  int numStages() const { return static_cast<int>(dynamics.size()); }
+  int numInputs(int k) const { return NU; }
+  const fixed_matrix_t<NX, NX>& A(int k) const { return dynamics[k].dfdx; }
+  const fixed_matrix_t<NX, NU>& B(int k) const { return dynamics[k].dfdu; }
+  const fixed_vector_t<NX>& b(int k) const { return dynamics[k].f; }
+  const fixed_matrix_t<NX, NX>& Q(int k) const { return cost[k].dfdxx; }
+  const fixed_matrix_t<NU, NX>& S(int k) const { return cost[k].dfdux; }
+  const fixed_matrix_t<NU, NU>& R(int k) const { return cost[k].dfduu; }
+  const fixed_vector_t<NX>& q(int k) const { return cost[k].dfdx; }
+  const fixed_vector_t<NU>& r(int k) const { return cost[k].dfdu; }
+};
+
+}  // namespace fixed_size_riccati
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <int NX, int NU>
+bool FixedSizeRiccatiSolver<NX, NU>::isCompatible(const OcpSize& ocpSize) {
+  const int N = ocpSize.numStages;
+  if (static_cast<int>(ocpSize.numStates.size()) != N + 1 || static_cast<int>(ocpSize.numInputs.size()) < N) {
+    return false;
+  }
+  const auto hasFixedStates = [](int nx) { return nx == NX; };
+  const auto hasFixedInputs = [](int nu) { return nu == NU || nu == 0; };
+  const auto isUnconstrained = [](int nc) { return nc == 0; };
+  return std::all_of(ocpSize.numStates.cbegin(), ocpSize.numStates.cend(), hasFixedStates) &&
+         std::all_of(ocpSize.numInputs.cbegin(), ocpSize.numInputs.cbegin() + N, hasFixedInputs) &&
+         std::all_of(ocpSize.numIneqConstraints.cbegin(), ocpSize.numIneqConstraints.cend(), isUnconstrained) &&
+         std::all_of(ocpSize.numEqConstraints.cbegin(), ocpSize.numEqConstraints.cend(), isUnconstrained);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <int NX, int NU>
+bool FixedSizeRiccatiSolver<NX, NU>::isCompatible(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                                  const std::vector<ScalarFunctionQuadraticApproximation>& cost) {
+  if (cost.size() != dynamics.size() + 1) {
+    return false;
+  }
+  const auto isFixedDynamics = [](const VectorFunctionLinearApproximation& d) {
+    return d.dfdx.rows() == NX && d.dfdx.cols() == NX && (d.dfdu.cols() == NU || d.dfdu.cols() == 0);
+  };
+  const auto isFixedCost = [](const ScalarFunctionQuadraticApproximation& c) { return c.dfdx.size() == NX; };
+  return std::all_of(dynamics.cbegin(), dynamics.cend(), isFixedDynamics) && std::all_of(cost.cbegin(), cost.cend(), isFixedCost);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <int NX, int NU>
+bool FixedSizeRiccatiSolver<NX, NU>::solve(const vector_t& x0, const OcpLqArena& lq, vector_array_t& deltaXSol,
+                                           vector_array_t& deltaUSol) {
+  if (!isCompatible(lq.size())) {
+    throw std::runtime_error("[FixedSizeRiccatiSolver::solve] The problem dimensions do not match the solver.");
+  }
+  const ArenaLqProblem problem{lq};
+  if (!backwardPass(problem)) {
+    return false;
+  }
+  forwardPass(x0, problem, deltaXSol, deltaUSol);
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <int NX, int NU>
+bool FixedSizeRiccatiSolver<NX, NU>::solve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                           const std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& deltaXSol,
+                                           vector_array_t& deltaUSol) {
+  if (!isCompatible(dynamics, cost)) {
+    throw std::runtime_error("[FixedSizeRiccatiSolver::solve] The problem dimensions do not match the solver.");
+  }
+  const ArrayLqProblem problem{dynamics, cost};
+  if (!backwardPass(problem)) {
+    return false;
+  }
+  forwardPass(x0, problem, deltaXSol, deltaUSol);
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <int NX, int NU>
+bool FixedSizeRiccatiSolver<NX, NU>::solve(const state_vector_t& x0, const fixed_array_t<dynamics_t>& dynamics,
+                                           const fixed_array_t<cost_t>& cost, fixed_array_t<state_vector_t>& deltaXSol,
+                                           fixed_array_t<input_vector_t>& deltaUSol) {
+  if (cost.size() != dynamics.size() + 1) {
+    throw std::runtime_error("[FixedSizeRiccatiSolver::solve] The cost has to be given for N + 1 nodes.");
+  }
+  if (!backwardPass(fixed_size_riccati::FixedArrayLqProblem<NX, NU>{dynamics, cost})) {
+    return false;
+  }
+
+  const int N = static_cast<int>(dynamics.size());
+  deltaXSol.resize(N + 1);
+  deltaUSol.resize(N);
+  deltaXSol[0] = x0;
+  for (int k = 0; k < N; ++k) {
+    deltaUSol[k] = k_[k];
+    deltaUSol[k].noalias() += K_[k] * deltaXSol[k];
+    deltaXSol[k + 1] = dynamics[k].f;
+    deltaXSol[k + 1].noalias() += dynamics[k].dfdx * deltaXSol[k];
+    deltaXSol[k + 1].noalias() += dynamics[k].dfdu * deltaUSol[k];
+  }
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <int NX, int NU>
+std::vector<ScalarFunctionQuadraticApproximation> FixedSizeRiccatiSolver<NX, NU>::getRiccatiCostToGo() const {
+  std::vector<ScalarFunctionQuadraticApproximation> costToGo(P_.size());
+  for (size_t k = 0; k < P_.size(); ++k) {
+    costToGo[k].f = 0.0;
+    costToGo[k].dfdxx = P_[k];
+    costToGo[k].dfdx = p_[k];
+  }
+  return costToGo;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <int NX, int NU>
+matrix_array_t FixedSizeRiccatiSolver<NX, NU>::getRiccatiFeedback() const {
+  matrix_array_t feedback(K_.size());
+  for (size_t k = 0; k < K_.size(); ++k) {
+    if (hasInputs_[k] != 0) {
+      feedback[k] = K_[k];
+    } else {
+      feedback[k].setZero(0, NX);
+    }
+  }
+  return feedback;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <int NX, int NU>
+template <typename Problem>
+bool FixedSizeRiccatiSolver<NX, NU>::backwardPass(const Problem& problem) {
+  const int N = problem.numStages();
+  P_.resize(N + 1);
+  p_.resize(N + 1);
+  K_.resize(N);
+  k_.resize(N);
+  hasInputs_.resize(N);
+
+  P_[N] = problem.Q(N);
+  P_[N] = 0.5 * (P_[N] + P_[N].transpose()).eval();
+  p_[N] = problem.q(N);
+
+  for (int k = N - 1; k >= 0; --k) {
+    const state_matrix_t A = problem.A(k);
+    const state_vector_t b = problem.b(k);
+    const state_matrix_t& nextP = P_[k + 1];
+
+    // Cost-to-go of the next node as a function of the current state and input
+    const state_matrix_t PA = nextP * A;
+    state_vector_t Pbp = p_[k + 1];
+    Pbp.noalias() += nextP * b;
+
+    state_matrix_t& P = P_[k];
+    state_vector_t& p = p_[k];
+    P = problem.Q(k);
+    P.noalias() += A.transpose() * PA;
+    p = problem.q(k);
+    p.noalias() += A.transpose() * Pbp;
+
+    hasInputs_[k] = (problem.numInputs(k) > 0) ? 1 : 0;
+    if (hasInputs_[k] != 0) {
+      const fixed_matrix_t<NX, NU> B = problem.B(k);
+      const fixed_matrix_t<NX, NU> PB = nextP * B;
+      fixed_matrix_t<NU, NU> H = problem.R(k);
+      H.noalias() += B.transpose() * PB;
+      feedback_matrix_t G = problem.S(k);
+      G.noalias() += B.transpose() * PA;
+      input_vector_t g = problem.r(k);
+      g.noalias() += B.transpose() * Pbp;
+
+      const Eigen::LLT<fixed_matrix_t<NU, NU>> llt(H);
+      if (llt.info() != Eigen::Success) {
+        return false;
+      }
+      K_[k] = -llt.solve(G);
+      k_[k] = -llt.solve(g);
+      P.noalias() += G.transpose() * K_[k];
+      p.noalias() += G.transpose() * k_[k];
+    } else {
+      K_[k].setZero();
+      k_[k].setZero();
+    }
+    P = 0.5 * (P + P.transpose()).eval();
+  }
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <int NX, int NU>
+template <typename Problem>
+void FixedSizeRiccatiSolver<NX, NU>::forwardPass(const vector_t& x0, const Problem& problem, vector_array_t& deltaXSol,
+                                                 vector_array_t& deltaUSol) const {
+  const int N = problem.numStages();
+  deltaXSol.resize(N + 1);
+  deltaUSol.resize(N);
+
+  state_vector_t x = x0;
+  deltaXSol[0] = x;
+  for (int k = 0; k < N; ++k) {
+    state_vector_t nextX = problem.b(k);
+    nextX.noalias() += fixed_matrix_t<NX, NX>(problem.A(k)) * x;
+    if (hasInputs_[k] != 0) {
+      input_vector_t u = k_[k];
+      u.noalias() += K_[k] * x;
+      nextX.noalias() += fixed_matrix_t<NX, NU>(problem.B(k)) * u;
+      deltaUSol[k] = u;
+    } else {
+      deltaUSol[k].resize(0);
+    }
+    x = nextX;
+    deltaXSol[k + 1] = x;
+  }
+}
+
+}  // namespace ocs2
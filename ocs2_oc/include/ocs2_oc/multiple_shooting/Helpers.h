@@ -111,5 +111,19 @@ PrimalSolution toPrimalSolution(const std::vector<AnnotatedTime>& time, ModeSche
  */
 ProblemMetrics toProblemMetrics(const std::vector<AnnotatedTime>& time, std::vector<Metrics>&& metrics);
 
+/**
+ * Refines the time discretization where the dynamics defects of a previous solution are large, see refineTimeDiscretization. The norm
+ * of the dynamics defect of an interval serves as the estimate of its discretization error. The time discretization is returned as it
+ * is if the metrics do not match the primal solution.
+ *
+ * @param [in] time : The annotated time trajectory to refine.
+ * @param [in] primalSolution: A previous solution, only the time trajectory and the post-event indices are used.
+ * @param [in] problemMetrics: The metrics of the previous solution.
+ * @param [in] tolerance: Intervals with a larger dynamics defect are split in halves.
+ * @return The refined annotated time trajectory.
+ */
+std::vector<AnnotatedTime> refineTimeDiscretization(const std::vector<AnnotatedTime>& time, const PrimalSolution& primalSolution,
+                                                    const ProblemMetrics& problemMetrics, scalar_t tolerance);
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
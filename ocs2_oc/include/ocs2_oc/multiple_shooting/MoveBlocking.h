@@ -0,0 +1,96 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/dynamics/SystemDynamicsBase.h>
+#include <ocs2_core/integration/SensitivityIntegrator.h>
+
+#include "ocs2_oc/oc_data/TimeDiscretization.h"
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+/**
+ * Move blocking holds the input constant over blocks of several intervals of the time discretization. Each block becomes a single
+ * shooting interval, such that the number of nodes, and with it the number of states and inputs of the QP subproblem, shrinks. The
+ * dynamics of a block are integrated with the steps of the original discretization while its cost is approximated at the start of
+ * the block, as for any other interval. The constraints are imposed on the nodes of the blocked discretization.
+ */
+
+/** Number of equal sub-steps of an interval of duration dt, such that each sub-step is at most maxStepSize. */
+size_t numSubsteps(scalar_t dt, scalar_t maxStepSize);
+
+/**
+ * Discretization of the dynamics that integrates an interval with numSubsteps(dt, maxStepSize) steps of the given integrator, while
+ * holding the input constant.
+ */
+DynamicsDiscretizer selectSubsteppedDynamicsDiscretization(SensitivityIntegratorType integratorType, scalar_t maxStepSize);
+
+/**
+ * Discretization of the dynamics and its sensitivities that integrates an interval with numSubsteps(dt, maxStepSize) steps of the
+ * given integrator, while holding the input constant. The sensitivities are the ones of the composed map.
+ */
+DynamicsSensitivityDiscretizer selectSubsteppedDynamicsSensitivityDiscretization(SensitivityIntegratorType integratorType,
+                                                                                 scalar_t maxStepSize);
+
+/**
+ * Merges the intervals of a time discretization into blocks over which the input is held constant. The nodes up to blockingStartTime
+ * are kept, afterwards only every blockLength-th node is kept. The event nodes and the final node are always kept, i.e., the blocks
+ * end at the events.
+ *
+ * @param [in] time : The annotated time trajectory.
+ * @param [in] blockingStartTime : Time after which the input is blocked.
+ * @param [in] blockLength : Number of intervals in a block. A length of 1 keeps the time discretization.
+ * @return The blocked annotated time trajectory.
+ */
+std::vector<AnnotatedTime> blockTimeDiscretization(const std::vector<AnnotatedTime>& time, scalar_t blockingStartTime,
+                                                   size_t blockLength);
+
+/**
+ * Maps a solution on a blocked time discretization back to a discretization with steps of at most maxStepSize. Each interval is
+ * divided in numSubsteps(dt, maxStepSize) equal sub-intervals, over which the input and the feedback gain of the interval are held.
+ * The states of the new nodes are forward simulated with the held input.
+ *
+ * @param [in] systemDynamics : The system dynamics.
+ * @param [in] integratorType : The integrator of a sub-interval.
+ * @param [in] maxStepSize : Maximum duration of a sub-interval.
+ * @param [in] time : The blocked annotated time trajectory.
+ * @param [in, out] x : The state trajectory.
+ * @param [in, out] u : The input trajectory.
+ * @param [in, out] KMatrices : The feedback gains of the intervals. Ignored if it is a nullptr.
+ * @return The expanded annotated time trajectory.
+ */
+std::vector<AnnotatedTime> expandBlockedSolution(SystemDynamicsBase& systemDynamics, SensitivityIntegratorType integratorType,
+                                                 scalar_t maxStepSize, const std::vector<AnnotatedTime>& time, vector_array_t& x,
+                                                 vector_array_t& u, matrix_array_t* KMatrices = nullptr);
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
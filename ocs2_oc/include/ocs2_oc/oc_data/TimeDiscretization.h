@@ -76,6 +76,42 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
                                                         const scalar_array_t& eventTimes,
                                                         scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
 
+/**
+ * Decides on a non-uniform time discretization along the horizon. The first step is dt and every following step grows by the factor
+ * growthRate until it reaches dtMax, i.e., the discretization is dense at the beginning of the horizon and coarse towards its end.
+ * Event times are part of the discretization as in timeDiscretizationWithEvents. A growthRate of 1.0 results in the uniform
+ * discretization of timeDiscretizationWithEvents.
+ *
+ * @param initTime : start time.
+ * @param finalTime : final time.
+ * @param dt : first discretization step.
+ * @param growthRate : ratio between two consecutive steps, needs to be at least 1.0.
+ * @param dtMax : maximum discretization step. It is never smaller than dt.
+ * @param eventTimes : Event times where a time discretization must be made.
+ * @param dt_min : minimum discretization step. Smaller intervals will be merged. Needs to be bigger than limitEpsilon to avoid
+ * interpolation problems
+ * @return vector of discrete time points
+ */
+std::vector<AnnotatedTime> geometricTimeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt, scalar_t growthRate,
+                                                                 scalar_t dtMax, const scalar_array_t& eventTimes,
+                                                                 scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
+
+/**
+ * Refines a time discretization based on an error estimate: every interval whose error exceeds the tolerance is split in halves.
+ * The error is given as a piecewise constant function of time and is evaluated at the middle of each interval, such that the
+ * estimate of a previous, shifted discretization can be used. Event nodes are kept as they are.
+ *
+ * @param time : time discretization to refine.
+ * @param errorTime : time grid of the error estimate.
+ * @param errors : error estimate, errors[i] holds on [errorTime[i], errorTime[i+1]). Its size is errorTime.size() - 1.
+ * @param tolerance : intervals with a larger error are refined.
+ * @param dt_min : minimum discretization step. Intervals shorter than 2 * dt_min are not split.
+ * @return refined vector of discrete time points
+ */
+std::vector<AnnotatedTime> refineTimeDiscretization(const std::vector<AnnotatedTime>& time, const scalar_array_t& errorTime,
+                                                    const scalar_array_t& errors, scalar_t tolerance,
+                                                    scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
+
 /**
  * Extracts the time trajectory from the annotated time trajectory.
  *
@@ -0,0 +1,89 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+#include "ocs2_oc/oc_problem/OcpSize.h"
+
+namespace ocs2 {
+
+/**
+ * Linearized inequality constraints h + dhdx * dx + dhdu * du >= 0 of a node of the QP, split into simple bounds on single
+ * decision variables and general constraints:
+ *    lbx <= dx[idxbx] <= ubx
+ *    lbu <= du[idxbu] <= ubu
+ *    lg  <= C * dx + D * du
+ *
+ * Simple bounds without a lower or upper limit have an infinite bound on that side.
+ */
+struct NodeInequalityConstraints {
+  std::vector<int> idxbx;  // indices of the bounded states
+  vector_t lbx;            // lower bounds of the bounded states
+  vector_t ubx;            // upper bounds of the bounded states
+  std::vector<int> idxbu;  // indices of the bounded inputs
+  vector_t lbu;            // lower bounds of the bounded inputs
+  vector_t ubu;            // upper bounds of the bounded inputs
+  matrix_t C;              // state jacobian of the general constraints
+  matrix_t D;              // input jacobian of the general constraints
+  vector_t lg;             // lower bounds of the general constraints
+
+  /** Number of general constraints */
+  int numGeneralConstraints() const { return static_cast<int>(lg.size()); }
+};
+
+/**
+ * Splits the linearized state and state-input inequality constraints of a node into simple bounds and general constraints.
+ * A constraint is a simple bound if its jacobian has a single nonzero entry. Several bounds on the same variable are merged
+ * into a single lower and upper bound. The memory of the output is reused.
+ *
+ * @param [in] numStates : Number of states of the node.
+ * @param [in] numInputs : Number of inputs of the node.
+ * @param [in] stateIneqConstraints : State-only constraints h(x) >= 0, can be empty.
+ * @param [in] stateInputIneqConstraints : State-input constraints h(x, u) >= 0, can be empty.
+ * @param [in] detectSimpleBounds : If false, all constraints are general constraints.
+ * @param [out] constraints : The resulting constraints of the node.
+ */
+void splitInequalityConstraints(int numStates, int numInputs, const VectorFunctionLinearApproximation& stateIneqConstraints,
+                                const VectorFunctionLinearApproximation& stateInputIneqConstraints, bool detectSimpleBounds,
+                                NodeInequalityConstraints& constraints);
+
+/**
+ * Sets the number of simple bounds and general inequality constraints of a problem size. The equality constraints counted in
+ * numEqConstraints are not changed.
+ *
+ * @param [in] constraints : Inequality constraints of all N+1 nodes.
+ * @param [in, out] ocpSize : Size of the problem.
+ */
+void addInequalityConstraintsSize(const std::vector<NodeInequalityConstraints>& constraints, OcpSize& ocpSize);
+
+}  // namespace ocs2
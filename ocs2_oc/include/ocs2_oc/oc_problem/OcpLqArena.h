@@ -0,0 +1,178 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+
+#include "ocs2_oc/oc_problem/OcpSize.h"
+
+namespace ocs2 {
+
+/**
+ * Preallocated storage for the linear-quadratic approximation of a multiple-shooting optimal control problem.
+ *
+ * All blocks of the same kind (A, B, b, Q, S, R, q, r, C, D, e) are stored next to each other in one contiguous buffer
+ * (structure of arrays). Every node reserves a slot of the maximum block size, such that the actual dimensions of a node can change
+ * without changing the layout. Each slot starts on a cache line and holds its block in column-major order with a leading dimension
+ * equal to the number of rows, which is the layout expected by HPIPM and Eigen.
+ *
+ * The buffer only grows: calling reserve with the same or smaller capacity reuses it. Different nodes can be written concurrently from
+ * different threads.
+ *
+ * Conventions are the ones of the multiple-shooting transcription:
+ *    dynamics    : dx[k+1] = A[k] dx[k] + B[k] du[k] + b[k]
+ *    cost        : c[k] + q[k]' dx[k] + r[k]' du[k] + 0.5 dx[k]' Q[k] dx[k] + 0.5 du[k]' R[k] du[k] + du[k]' S[k] dx[k]
+ *    constraints : C[k] dx[k] + D[k] du[k] + e[k] = 0
+ */
+class OcpLqArena {
+ public:
+  using matrix_map_t = Eigen::Map<matrix_t, Eigen::AlignedMax>;
+  using const_matrix_map_t = Eigen::Map<const matrix_t, Eigen::AlignedMax>;
+  using vector_map_t = Eigen::Map<vector_t, Eigen::AlignedMax>;
+  using const_vector_map_t = Eigen::Map<const vector_t, Eigen::AlignedMax>;
+
+  /** Alignment of every block in bytes */
+  static constexpr size_t alignment = 64;
+
+  OcpLqArena() = default;
+  ~OcpLqArena() = default;
+  OcpLqArena(const OcpLqArena&) = delete;
+  OcpLqArena& operator=(const OcpLqArena&) = delete;
+  OcpLqArena(OcpLqArena&&) = default;
+  OcpLqArena& operator=(OcpLqArena&&) = default;
+
+  /** Constructor with the capacity of a given problem size. */
+  explicit OcpLqArena(const OcpSize& ocpSize);
+
+  /**
+   * Prepares the arena for a problem with numStages stages. Resets the dimensions of all nodes to zero.
+   * Memory is only allocated if the required capacity exceeds the current one.
+   *
+   * @param [in] numStages : Number of stages (N). The arena holds N dynamics and N+1 cost and constraint blocks.
+   * @param [in] maxNumStates : Maximum number of states of any node.
+   * @param [in] maxNumInputs : Maximum number of inputs of any node.
+   * @param [in] maxNumConstraints : Maximum number of state-input equality constraints of any node.
+   */
+  void reserve(int numStages, int maxNumStates, int maxNumInputs, int maxNumConstraints);
+
+  /** Reserves the capacity of a given problem size. The equality constraints are read from ocpSize.numEqConstraints. */
+  void reserve(const OcpSize& ocpSize);
+
+  /** Number of stages */
+  int numStages() const { return size_.numStages; }
+
+  /** Dimensions of the data written so far. The state-input equality constraints are reported as numEqConstraints. */
+  const OcpSize& size() const { return size_; }
+
+  /** Number of scalars the arena can hold without reallocating */
+  size_t capacity() const { return capacity_; }
+
+  /** Copies the linearized dynamics of stage k < N. Sets the number of states and inputs of node k. */
+  void setDynamics(int k, const VectorFunctionLinearApproximation& dynamics);
+
+  /** Copies the quadratic cost of node k <= N. Sets the number of states and inputs of node k. Inputs are ignored for k = N. */
+  void setCost(int k, const ScalarFunctionQuadraticApproximation& cost);
+
+  /** Copies the linearized state-input equality constraints of node k <= N. Inputs are ignored for k = N. */
+  void setConstraints(int k, const VectorFunctionLinearApproximation& constraints);
+
+  /** Copy of the dynamics of stage k in the OCS2 approximation type. Allocates, not meant for the hot path. */
+  VectorFunctionLinearApproximation getDynamics(int k) const;
+
+  /** Copy of the cost of node k in the OCS2 approximation type. Allocates, not meant for the hot path. */
+  ScalarFunctionQuadraticApproximation getCost(int k) const;
+
+  /** Copy of the constraints of node k in the OCS2 approximation type. Allocates, not meant for the hot path. */
+  VectorFunctionLinearApproximation getConstraints(int k) const;
+
+  /**
+   * Views on the blocks of node k. The dynamics of stage k maps node k to node k+1, its number of rows is the one of the data
+   * written with setDynamics. Hence, the views of a node do not depend on other nodes and can be used while other nodes are written.
+   */
+  matrix_map_t A(int k) { return {block(Block::A, k), numNextStates_[k], size_.numStates[k]}; }
+  matrix_map_t B(int k) { return {block(Block::B, k), numNextStates_[k], size_.numInputs[k]}; }
+  vector_map_t b(int k) { return {block(Block::b, k), numNextStates_[k]}; }
+  matrix_map_t Q(int k) { return {block(Block::Q, k), size_.numStates[k], size_.numStates[k]}; }
+  matrix_map_t S(int k) { return {block(Block::S, k), size_.numInputs[k], size_.numStates[k]}; }
+  matrix_map_t R(int k) { return {block(Block::R, k), size_.numInputs[k], size_.numInputs[k]}; }
+  vector_map_t q(int k) { return {block(Block::q, k), size_.numStates[k]}; }
+  vector_map_t r(int k) { return {block(Block::r, k), size_.numInputs[k]}; }
+  scalar_t& c(int k) { return costConstants_[k]; }
+  matrix_map_t C(int k) { return {block(Block::C, k), size_.numEqConstraints[k], size_.numStates[k]}; }
+  matrix_map_t D(int k) { return {block(Block::D, k), size_.numEqConstraints[k], size_.numInputs[k]}; }
+  vector_map_t e(int k) { return {block(Block::e, k), size_.numEqConstraints[k]}; }
+
+  const_matrix_map_t A(int k) const { return {block(Block::A, k), numNextStates_[k], size_.numStates[k]}; }
+  const_matrix_map_t B(int k) const { return {block(Block::B, k), numNextStates_[k], size_.numInputs[k]}; }
+  const_vector_map_t b(int k) const { return {block(Block::b, k), numNextStates_[k]}; }
+  const_matrix_map_t Q(int k) const { return {block(Block::Q, k), size_.numStates[k], size_.numStates[k]}; }
+  const_matrix_map_t S(int k) const { return {block(Block::S, k), size_.numInputs[k], size_.numStates[k]}; }
+  const_matrix_map_t R(int k) const { return {block(Block::R, k), size_.numInputs[k], size_.numInputs[k]}; }
+  const_vector_map_t q(int k) const { return {block(Block::q, k), size_.numStates[k]}; }
+  const_vector_map_t r(int k) const { return {block(Block::r, k), size_.numInputs[k]}; }
+  scalar_t c(int k) const { return costConstants_[k]; }
+  const_matrix_map_t C(int k) const { return {block(Block::C, k), size_.numEqConstraints[k], size_.numStates[k]}; }
+  const_matrix_map_t D(int k) const { return {block(Block::D, k), size_.numEqConstraints[k], size_.numInputs[k]}; }
+  const_vector_map_t e(int k) const { return {block(Block::e, k), size_.numEqConstraints[k]}; }
+
+ private:
+  enum class Block : size_t { A, B, b, Q, S, R, q, r, C, D, e };
+  static constexpr size_t numBlocks = 11;
+
+  struct AlignedDeleter {
+    void operator()(scalar_t* ptr) const noexcept { std::free(ptr); }
+  };
+
+  scalar_t* block(Block type, int k) const {
+    const auto i = static_cast<size_t>(type);
+    return buffer_.get() + offsets_[i] + k * strides_[i];
+  }
+
+  void checkCapacity(int k, int numStates, int numInputs, int numConstraints, const char* caller) const;
+
+  OcpSize size_;
+  int maxNumStates_ = 0;
+  int maxNumInputs_ = 0;
+  int maxNumConstraints_ = 0;
+
+  size_t offsets_[numBlocks] = {};
+  size_t strides_[numBlocks] = {};
+  std::vector<int> numNextStates_;  // rows of the dynamics of each stage
+  std::vector<scalar_t> costConstants_;
+
+  size_t capacity_ = 0;
+  std::unique_ptr<scalar_t[], AlignedDeleter> buffer_;
+};
+
+}  // namespace ocs2
@@ -53,6 +53,7 @@ struct OcpSize {
   std::vector<int> numInputBoxConstraints;  // Number of input box inequality constraints
   std::vector<int> numStateBoxConstraints;  // Number of state box inequality constraints
   std::vector<int> numIneqConstraints;      // Number of general inequality constraints
+  std::vector<int> numEqConstraints;        // Number of general equality constraints
   std::vector<int> numInputBoxSlack;        // Number of slack variables for input box inequalities
   std::vector<int> numStateBoxSlack;        // Number of slack variables for state box inequalities
   std::vector<int> numIneqSlack;            // Number of slack variables for general inequalities
@@ -65,6 +66,7 @@ struct OcpSize {
         numInputBoxConstraints(N + 1, 0),
         numStateBoxConstraints(N + 1, 0),
         numIneqConstraints(N + 1, 0),
+        numEqConstraints(N + 1, 0),
         numInputBoxSlack(N + 1, 0),
         numStateBoxSlack(N + 1, 0),
         numIneqSlack(N + 1, 0) {
@@ -79,7 +81,7 @@ bool operator==(const OcpSize& lhs, const OcpSize& rhs) noexcept;
  *
  * @param dynamics : Linearized approximation of the discrete dynamics.
  * @param cost : Quadratic approximation of the cost.
- * @param constraints : Linearized approximation of constraints, all constraints are mapped to inequality constraints in HPIPM.
+ * @param constraints : Linearized approximation of the equality constraints, counted in numEqConstraints.
  * @return Derived sizes
  */
 OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
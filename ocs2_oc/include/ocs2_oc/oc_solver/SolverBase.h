@@ -252,6 +252,13 @@ class SolverBase {
    */
   void printString(const std::string& text) const;
 
+ protected:
+  /** Updates the reference manager and the synchronized modules before solving. Called by run(). */
+  void preRun(scalar_t initTime, const vector_t& initState, scalar_t finalTime);
+
+  /** Updates the synchronized modules and the observers with the new solution. Called by run(). */
+  void postRun();
+
  private:
   virtual void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) = 0;
 
@@ -259,10 +266,6 @@ class SolverBase {
 
   virtual void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution) = 0;
 
-  void preRun(scalar_t initTime, const vector_t& initState, scalar_t finalTime);
-
-  void postRun();
-
   /***********
    * Variables
    ***********/
@@ -94,6 +94,49 @@ void ocpDataInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const
                               std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& DOut, vector_array_t& EOut,
                               vector_array_t& scalingVectors, scalar_t& cOut);
 
+/**
+ * Warm-started version of ocpDataInPlaceInParallel. The data is first scaled with the initial factors DInit, EInit, and cInit, e.g.,
+ * the factors of the previous MPC call shifted to the current time discretization with shiftScalingFactors. Then, the given number of
+ * iterations of the modified Ruzi equilibration correct the scaling. Since the initial scaling is usually close to the equilibrated
+ * one, a single correcting iteration typically replaces several iterations from scratch.
+ *
+ * The output factors include the initial ones. A node whose initial factors do not match its size starts from the identity.
+ *
+ * @param [in] threadPool : The external thread pool.
+ * @param [in] x0 : The initial state.
+ * @param [in] ocpSize : The size of the oc problem.
+ * @param [in] iteration : Number of correcting iterations.
+ * @param [in] DInit : The initial matrix D decomposed for each time step.
+ * @param [in] EInit : The initial matrix E decomposed for each time step.
+ * @param [in] cInit : The initial scaling factor c.
+ * @param [in, out] dynamics : The dynamics array of all time points.
+ * @param [in, out] cost : The cost array of all time points.
+ * @param [out] DOut : The matrix D decomposed for each time step.
+ * @param [out] EOut : The matrix E decomposed for each time step.
+ * @param [out] scalingVectors : Vector representation for the identity parts of the dynamics constraints inside the constraint matrix.
+ * @param [out] cOut : Scaling factor c.
+ */
+void ocpDataInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const OcpSize& ocpSize, const int iteration,
+                              const vector_array_t& DInit, const vector_array_t& EInit, scalar_t cInit,
+                              std::vector<VectorFunctionLinearApproximation>& dynamics,
+                              std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& DOut, vector_array_t& EOut,
+                              vector_array_t& scalingVectors, scalar_t& cOut);
+
+/**
+ * Shifts the pre-conditioning factors D and E of a time discretization to another one, e.g., from the previous MPC call to the current
+ * one. Every stage of the new discretization takes the factors of the stage of the old discretization with the closest start time.
+ * Stages beyond the old horizon take the factors of the last old stage.
+ *
+ * @param [in] time : The time discretization of the factors (N + 1 nodes).
+ * @param [in] D : The matrix D decomposed for each time step (2N vectors).
+ * @param [in] E : The matrix E decomposed for each time step (N vectors).
+ * @param [in] newTime : The new time discretization (M + 1 nodes).
+ * @param [out] DShifted : The shifted matrix D (2M vectors).
+ * @param [out] EShifted : The shifted matrix E (M vectors).
+ */
+void shiftScalingFactors(const scalar_array_t& time, const vector_array_t& D, const vector_array_t& E, const scalar_array_t& newTime,
+                         vector_array_t& DShifted, vector_array_t& EShifted);
+
 /**
  * Calculates the pre-conditioning factors D, E, and c, and scale the input dynamics, and cost data in place in place.
  *
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_oc/oc_data/PerformanceIndex.h>
+#include <ocs2_oc/oc_problem/OcpLqArena.h>
 
 namespace ocs2 {
 
@@ -80,4 +81,7 @@ std::string toString(const FilterLinesearch::StepType& stepType);
 scalar_t armijoDescentMetric(const std::vector<ScalarFunctionQuadraticApproximation>& cost, const vector_array_t& deltaXSol,
                              const vector_array_t& deltaUSol);
 
+/** Computes the Armijo descent metric with the cost gradients stored in an OcpLqArena. */
+scalar_t armijoDescentMetric(const OcpLqArena& lq, const vector_array_t& deltaXSol, const vector_array_t& deltaUSol);
+
 }  // namespace ocs2
@@ -0,0 +1,182 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/lq_solver/LqProblemRecording.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+
+namespace ocs2 {
+namespace lq_solver {
+
+namespace {
+constexpr char fileTag[8] = {'O', 'C', 'S', '2', 'L', 'Q', '0', '1'};
+
+void write(std::ofstream& file, int32_t value) {
+  file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void write(std::ofstream& file, scalar_t value) {
+  file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename Derived>
+void write(std::ofstream& file, const Eigen::MatrixBase<Derived>& m) {
+  const matrix_t columnMajor = m;
+  file.write(reinterpret_cast<const char*>(columnMajor.data()), columnMajor.size() * sizeof(scalar_t));
+}
+
+template <typename T>
+T read(std::ifstream& file) {
+  T value;
+  file.read(reinterpret_cast<char*>(&value), sizeof(value));
+  return value;
+}
+
+matrix_t readMatrix(std::ifstream& file, int rows, int cols) {
+  matrix_t m(rows, cols);
+  file.read(reinterpret_cast<char*>(m.data()), m.size() * sizeof(scalar_t));
+  return m;
+}
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void saveLqProblem(const std::string& filePath, const vector_t& x0, const OcpLqArena& lq) {
+  std::ofstream file(filePath, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("[lq_solver::saveLqProblem] Could not open " + filePath);
+  }
+
+  const int N = lq.numStages();
+  const auto& size = lq.size();
+  file.write(fileTag, sizeof(fileTag));
+  write(file, static_cast<int32_t>(N));
+  write(file, static_cast<int32_t>(x0.size()));
+  write(file, x0);
+  for (int k = 0; k <= N; ++k) {
+    write(file, static_cast<int32_t>(size.numStates[k]));
+    write(file, static_cast<int32_t>(size.numInputs[k]));
+    write(file, static_cast<int32_t>(size.numEqConstraints[k]));
+    write(file, static_cast<int32_t>((k < N) ? lq.A(k).rows() : 0));
+  }
+  for (int k = 0; k <= N; ++k) {
+    if (k < N) {
+      write(file, lq.A(k));
+      write(file, lq.B(k));
+      write(file, lq.b(k));
+    }
+    write(file, lq.c(k));
+    write(file, lq.Q(k));
+    write(file, lq.S(k));
+    write(file, lq.R(k));
+    write(file, lq.q(k));
+    write(file, lq.r(k));
+    write(file, lq.C(k));
+    write(file, lq.D(k));
+    write(file, lq.e(k));
+  }
+
+  if (!file) {
+    throw std::runtime_error("[lq_solver::saveLqProblem] Could not write " + filePath);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t loadLqProblem(const std::string& filePath, OcpLqArena& lq) {
+  std::ifstream file(filePath, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("[lq_solver::loadLqProblem] Could not open " + filePath);
+  }
+
+  char tag[sizeof(fileTag)];
+  file.read(tag, sizeof(tag));
+  if (!file || !std::equal(tag, tag + sizeof(tag), fileTag)) {
+    throw std::runtime_error("[lq_solver::loadLqProblem] " + filePath + " is not an LQ problem.");
+  }
+
+  const int N = read<int32_t>(file);
+  const int nx0 = read<int32_t>(file);
+  if (!file || N < 0 || nx0 < 0) {
+    throw std::runtime_error("[lq_solver::loadLqProblem] " + filePath + " has an invalid header.");
+  }
+  const vector_t x0 = readMatrix(file, nx0, 1);
+  std::vector<int> nx(N + 1), nu(N + 1), nc(N + 1), nxNext(N + 1);
+  for (int k = 0; k <= N; ++k) {
+    nx[k] = read<int32_t>(file);
+    nu[k] = read<int32_t>(file);
+    nc[k] = read<int32_t>(file);
+    nxNext[k] = read<int32_t>(file);
+  }
+  if (!file) {
+    throw std::runtime_error("[lq_solver::loadLqProblem] " + filePath + " is truncated.");
+  }
+
+  const auto maxOf = [](const std::vector<int>& v) { return *std::max_element(v.cbegin(), v.cend()); };
+  lq.reserve(N, std::max(maxOf(nx), maxOf(nxNext)), maxOf(nu), maxOf(nc));
+  for (int k = 0; k <= N; ++k) {
+    if (k < N) {
+      VectorFunctionLinearApproximation dynamics;
+      dynamics.dfdx = readMatrix(file, nxNext[k], nx[k]);
+      dynamics.dfdu = readMatrix(file, nxNext[k], nu[k]);
+      dynamics.f = readMatrix(file, nxNext[k], 1);
+      lq.setDynamics(k, dynamics);
+    }
+
+    ScalarFunctionQuadraticApproximation cost;
+    cost.f = read<scalar_t>(file);
+    cost.dfdxx = readMatrix(file, nx[k], nx[k]);
+    cost.dfdux = readMatrix(file, nu[k], nx[k]);
+    cost.dfduu = readMatrix(file, nu[k], nu[k]);
+    cost.dfdx = readMatrix(file, nx[k], 1);
+    cost.dfdu = readMatrix(file, nu[k], 1);
+    lq.setCost(k, cost);
+
+    VectorFunctionLinearApproximation constraints;
+    constraints.dfdx = readMatrix(file, nc[k], nx[k]);
+    constraints.dfdu = readMatrix(file, nc[k], nu[k]);
+    constraints.f = readMatrix(file, nc[k], 1);
+    if (nc[k] > 0) {
+      lq.setConstraints(k, constraints);
+    }
+  }
+
+  if (!file) {
+    throw std::runtime_error("[lq_solver::loadLqProblem] " + filePath + " is truncated.");
+  }
+  return x0;
+}
+
+}  // namespace lq_solver
+}  // namespace ocs2
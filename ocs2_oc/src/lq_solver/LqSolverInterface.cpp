@@ -0,0 +1,63 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/lq_solver/LqSolverInterface.h"
+
+#include <stdexcept>
+#include <unordered_map>
+
+namespace ocs2 {
+namespace lq_solver {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string toString(LqSolverType type) {
+  static const std::unordered_map<LqSolverType, std::string> typeMap = {
+      {LqSolverType::HPIPM, "HPIPM"}, {LqSolverType::RICCATI, "RICCATI"}, {LqSolverType::PARALLEL_RICCATI, "PARALLEL_RICCATI"}};
+
+  return typeMap.at(type);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+LqSolverType fromString(const std::string& name) {
+  static const std::unordered_map<std::string, LqSolverType> typeMap = {
+      {"HPIPM", LqSolverType::HPIPM}, {"RICCATI", LqSolverType::RICCATI}, {"PARALLEL_RICCATI", LqSolverType::PARALLEL_RICCATI}};
+
+  const auto it = typeMap.find(name);
+  if (it == typeMap.end()) {
+    throw std::runtime_error("[lq_solver::fromString] Unknown LQ solver type: " + name);
+  }
+  return it->second;
+}
+
+}  // namespace lq_solver
+}  // namespace ocs2
@@ -0,0 +1,323 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/lq_solver/ParallelRiccatiSolver.h"
+
+#include <algorithm>
+
+#include "ocs2_oc/lq_solver/LqProblemAccess.h"
+
+namespace ocs2 {
+
+namespace {
+void symmetrize(matrix_t& M) {
+  M = 0.5 * (M + M.transpose()).eval();
+}
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool ParallelRiccatiSolver::solve(const vector_t& x0, const OcpLqArena& lq, ThreadPool& threadPool, int numThreads,
+                                  vector_array_t& deltaXSol, vector_array_t& deltaUSol) {
+  const auto isPositive = [](int nc) { return nc > 0; };
+  const auto& size = lq.size();
+  if (std::any_of(size.numEqConstraints.cbegin(), size.numEqConstraints.cend(), isPositive) ||
+      std::any_of(size.numIneqConstraints.cbegin(), size.numIneqConstraints.cend(), isPositive)) {
+    throw std::runtime_error(
+        "[ParallelRiccatiSolver::solve] The problem has general (inequality or equality) constraints. Only unconstrained LQ problems are "
+        "supported.");
+  }
+  return solveImpl(x0, ArenaLqProblem{lq}, threadPool, numThreads, deltaXSol, deltaUSol);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool ParallelRiccatiSolver::solve(const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                  const std::vector<ScalarFunctionQuadraticApproximation>& cost, ThreadPool& threadPool, int numThreads,
+                                  vector_array_t& deltaXSol, vector_array_t& deltaUSol) {
+  if (cost.size() != dynamics.size() + 1) {
+    throw std::runtime_error("[ParallelRiccatiSolver::solve] The cost has to be given for N + 1 nodes.");
+  }
+  return solveImpl(x0, ArrayLqProblem{dynamics, cost}, threadPool, numThreads, deltaXSol, deltaUSol);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<ScalarFunctionQuadraticApproximation> ParallelRiccatiSolver::getRiccatiCostToGo() const {
+  std::vector<ScalarFunctionQuadraticApproximation> costToGo(P_.size());
+  for (size_t k = 0; k < P_.size(); ++k) {
+    costToGo[k].f = 0.0;
+    costToGo[k].dfdxx = P_[k];
+    costToGo[k].dfdx = p_[k];
+  }
+  return costToGo;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Problem>
+bool ParallelRiccatiSolver::solveImpl(const vector_t& x0, const Problem& problem, ThreadPool& threadPool, int numThreads,
+                                      vector_array_t& deltaXSol, vector_array_t& deltaUSol) {
+  const int N = problem.numStages();
+  P_.resize(N + 1);
+  p_.resize(N + 1);
+  K_.resize(N);
+  k_.resize(N);
+
+  // Split the N + 1 nodes into segments of equal length
+  const int maxNumThreads = static_cast<int>(threadPool.numThreads()) + 1;
+  numSegments_ = std::max(1, std::min({numThreads, maxNumThreads, (N + 1) / minSegmentLength}));
+  segmentStarts_.resize(numSegments_ + 1);
+  for (int s = 0; s <= numSegments_; ++s) {
+    segmentStarts_[s] = s * (N + 1) / numSegments_;
+  }
+  segmentElements_.resize(numSegments_);
+  boundaryP_.resize(numSegments_ + 1);
+  boundaryp_.resize(numSegments_ + 1);
+  segmentSuccess_.assign(numSegments_, 1);
+
+  // Riccati recursion over a segment, starting from the cost-to-go at its end
+  const int lastSegment = numSegments_ - 1;
+  const auto riccatiSegment = [&](int s) {
+    const int end = segmentStarts_[s + 1];
+    if (s == lastSegment) {
+      P_[N] = problem.Q(N);
+      p_[N] = problem.q(N);
+      symmetrize(P_[N]);
+    }
+    for (int k = std::min(end, N + 1) - 1; k >= segmentStarts_[s]; --k) {
+      if (k == N) {
+        continue;
+      }
+      const bool atEnd = (k + 1 == end);
+      if (!riccatiStep(problem, k, atEnd ? boundaryP_[s + 1] : P_[k + 1], atEnd ? boundaryp_[s + 1] : p_[k + 1])) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // Combination of all stages of a segment into one element
+  const auto combineSegment = [&](int s) {
+    Element& element = segmentElements_[s];
+    if (!initializeElement(problem, segmentStarts_[s], element)) {
+      return false;
+    }
+    Element stageElement;
+    for (int k = segmentStarts_[s] + 1; k < segmentStarts_[s + 1]; ++k) {
+      if (!initializeElement(problem, k, stageElement) || !combineElements(element, stageElement)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  if (numSegments_ == 1) {
+    segmentSuccess_[0] = riccatiSegment(0);
+  } else {
+    // Phase 1: elements of all segments in parallel with the Riccati recursion of the last segment
+    threadPool.parallelFor(0, numSegments_, 1, [&](int, size_t s) {
+      segmentSuccess_[s] = (s == lastSegment) ? riccatiSegment(s) : combineSegment(s);
+    });
+    if (std::all_of(segmentSuccess_.cbegin(), segmentSuccess_.cend(), [](char success) { return success != 0; })) {
+      // Phase 2: cost-to-go at the segment boundaries
+      boundaryP_[lastSegment] = P_[segmentStarts_[lastSegment]];
+      boundaryp_[lastSegment] = p_[segmentStarts_[lastSegment]];
+      bool boundariesFinite = true;
+      for (int s = lastSegment - 1; s > 0 && boundariesFinite; --s) {
+        boundariesFinite = applyElement(segmentElements_[s], boundaryP_[s + 1], boundaryp_[s + 1], boundaryP_[s], boundaryp_[s]);
+      }
+
+      // Phase 3: Riccati recursion of the remaining segments in parallel
+      if (boundariesFinite) {
+        threadPool.parallelFor(0, lastSegment, 1, [&](int, size_t s) { segmentSuccess_[s] = riccatiSegment(s); });
+      } else {
+        segmentSuccess_[0] = 0;
+      }
+    }
+  }
+  if (!std::all_of(segmentSuccess_.cbegin(), segmentSuccess_.cend(), [](char success) { return success != 0; })) {
+    return false;
+  }
+
+  // Forward pass
+  deltaXSol.resize(N + 1);
+  deltaUSol.resize(N);
+  deltaXSol[0] = x0;
+  for (int k = 0; k < N; ++k) {
+    deltaUSol[k] = k_[k];
+    deltaUSol[k].noalias() += K_[k] * deltaXSol[k];
+    deltaXSol[k + 1] = problem.b(k);
+    deltaXSol[k + 1].noalias() += problem.A(k) * deltaXSol[k];
+    if (problem.numInputs(k) > 0) {
+      deltaXSol[k + 1].noalias() += problem.B(k) * deltaUSol[k];
+    }
+  }
+
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Problem>
+bool ParallelRiccatiSolver::riccatiStep(const Problem& problem, int k, const matrix_t& nextP, const vector_t& nextp) {
+  const auto A = problem.A(k);
+  const auto b = problem.b(k);
+
+  // Cost-to-go of the next node as a function of the current state and input
+  const matrix_t PA = nextP * A;
+  vector_t Pbp = nextp;
+  Pbp.noalias() += nextP * b;
+
+  matrix_t& P = P_[k];
+  vector_t& p = p_[k];
+  P = problem.Q(k);
+  P.noalias() += A.transpose() * PA;
+  p = problem.q(k);
+  p.noalias() += A.transpose() * Pbp;
+
+  if (problem.numInputs(k) > 0) {
+    const auto B = problem.B(k);
+    const matrix_t PB = nextP * B;
+    matrix_t H = problem.R(k);
+    H.noalias() += B.transpose() * PB;
+    matrix_t G = problem.S(k);
+    G.noalias() += B.transpose() * PA;
+    vector_t g = problem.r(k);
+    g.noalias() += B.transpose() * Pbp;
+
+    const Eigen::LLT<matrix_t> llt(H);
+    if (llt.info() != Eigen::Success) {
+      return false;
+    }
+    K_[k] = -llt.solve(G);
+    k_[k] = -llt.solve(g);
+    P.noalias() += G.transpose() * K_[k];
+    p.noalias() += G.transpose() * k_[k];
+  } else {
+    K_[k].setZero(0, A.cols());
+    k_[k].resize(0);
+  }
+  symmetrize(P);
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Problem>
+bool ParallelRiccatiSolver::initializeElement(const Problem& problem, int k, Element& element) const {
+  // The cross term is eliminated with the change of input variables du = v - R^{-1} (S dx + r)
+  element.A = problem.A(k);
+  element.b = problem.b(k);
+  element.J = problem.Q(k);
+  element.q = problem.q(k);
+  if (problem.numInputs(k) > 0) {
+    const auto B = problem.B(k);
+    const auto S = problem.S(k);
+    const Eigen::LLT<matrix_t> llt(problem.R(k));
+    if (llt.info() != Eigen::Success) {
+      return false;
+    }
+    const matrix_t RinvS = llt.solve(S);
+    const vector_t Rinvr = llt.solve(problem.r(k));
+    element.A.noalias() -= B * RinvS;
+    element.b.noalias() -= B * Rinvr;
+    element.C.noalias() = B * llt.solve(B.transpose());
+    element.J.noalias() -= S.transpose() * RinvS;
+    element.q.noalias() -= S.transpose() * Rinvr;
+    symmetrize(element.C);
+  } else {
+    element.C.setZero(element.A.rows(), element.A.rows());
+  }
+  symmetrize(element.J);
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool ParallelRiccatiSolver::combineElements(Element& element, const Element& right) {
+  // With C and J positive semi-definite, I + C J and I + J C are invertible
+  const int n = element.A.rows();
+  matrix_t M = matrix_t::Identity(n, n);
+  M.noalias() += element.C * right.J;
+  const Eigen::PartialPivLU<matrix_t> lu(M);
+  M.setIdentity();
+  M.noalias() += right.J * element.C;
+  const Eigen::PartialPivLU<matrix_t> luTransposed(M);
+
+  // Quantities at the start of the segment
+  const matrix_t JA = right.J * element.A;
+  vector_t Jbq = right.q;
+  Jbq.noalias() += right.J * element.b;
+  element.J.noalias() += element.A.transpose() * luTransposed.solve(JA);
+  element.q.noalias() += element.A.transpose() * luTransposed.solve(Jbq);
+  symmetrize(element.J);
+
+  // Quantities at the end of the segment
+  vector_t bCq = element.b;
+  bCq.noalias() -= element.C * right.q;
+  const matrix_t MinvC = lu.solve(element.C);
+  element.b = right.b;
+  element.b.noalias() += right.A * lu.solve(bCq);
+  element.A = right.A * lu.solve(element.A);
+  element.C = right.C;
+  element.C.noalias() += right.A * MinvC * right.A.transpose();
+  symmetrize(element.C);
+
+  return element.J.allFinite() && element.A.allFinite() && element.C.allFinite();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool ParallelRiccatiSolver::applyElement(const Element& element, const matrix_t& nextP, const vector_t& nextp, matrix_t& P, vector_t& p) {
+  const int n = element.A.rows();
+  matrix_t M = matrix_t::Identity(n, n);
+  M.noalias() += nextP * element.C;
+  const Eigen::PartialPivLU<matrix_t> lu(M);
+
+  const matrix_t PA = nextP * element.A;
+  vector_t Pbp = nextp;
+  Pbp.noalias() += nextP * element.b;
+  P = element.J;
+  P.noalias() += element.A.transpose() * lu.solve(PA);
+  p = element.q;
+  p.noalias() += element.A.transpose() * lu.solve(Pbp);
+  symmetrize(P);
+  return P.allFinite();
+}
+
+}  // namespace ocs2
@@ -0,0 +1,237 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/lq_solver/RiccatiLqSolver.h"
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void RiccatiLqSolver::resize(const OcpSize& ocpSize) {
+  const int N = ocpSize.numStages;
+  P_.resize(N + 1);
+  p_.resize(N + 1);
+  K_.resize(N);
+  k_.resize(N);
+  for (int k = 0; k <= N; ++k) {
+    P_[k].resize(ocpSize.numStates[k], ocpSize.numStates[k]);
+    p_[k].resize(ocpSize.numStates[k]);
+    if (k < N) {
+      K_[k].resize(ocpSize.numInputs[k], ocpSize.numStates[k]);
+      k_[k].resize(ocpSize.numInputs[k]);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool RiccatiLqSolver::solve(const vector_t& x0, OcpLqArena& lq, vector_array_t& deltaXSol, vector_array_t& deltaUSol) {
+  const int N = lq.numStages();
+  const auto& numConstraints = lq.size().numEqConstraints;
+  if (numConstraints[N] > 0) {
+    return false;  // pure state constraints at the final node
+  }
+  P_.resize(N + 1);
+  p_.resize(N + 1);
+  K_.resize(N);
+  k_.resize(N);
+
+  // Backward pass
+  P_[N] = lq.Q(N);
+  p_[N] = lq.q(N);
+  for (int k = N - 1; k >= 0; --k) {
+    if (numConstraints[k] == 0) {
+      if (!riccatiStep(k, lq.A(k), lq.B(k), lq.b(k), lq.Q(k), lq.S(k), lq.R(k), lq.q(k), lq.r(k), K_[k], k_[k])) {
+        return false;
+      }
+    } else {
+      if (!eliminateConstraints(lq, k)) {
+        return false;
+      }
+      if (!riccatiStep(k, reducedA_, reducedB_, reducedb_, reducedQ_, reducedS_, reducedR_, reducedq_, reducedr_, Kv_, kv_)) {
+        return false;
+      }
+      // Policy in the original input: du = Px dx + pe + Z (Kv dx + kv)
+      K_[k] = Px_;
+      K_[k].noalias() += Z_ * Kv_;
+      k_[k] = pe_;
+      k_[k].noalias() += Z_ * kv_;
+    }
+  }
+
+  // Forward pass
+  deltaXSol.resize(N + 1);
+  deltaUSol.resize(N);
+  deltaXSol[0] = x0;
+  for (int k = 0; k < N; ++k) {
+    deltaUSol[k] = k_[k];
+    deltaUSol[k].noalias() += K_[k] * deltaXSol[k];
+    deltaXSol[k + 1] = lq.b(k);
+    deltaXSol[k + 1].noalias() += lq.A(k) * deltaXSol[k];
+    if (deltaUSol[k].size() > 0) {
+      deltaXSol[k + 1].noalias() += lq.B(k) * deltaUSol[k];
+    }
+  }
+
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<ScalarFunctionQuadraticApproximation> RiccatiLqSolver::getRiccatiCostToGo(const OcpLqArena& lq) {
+  std::vector<ScalarFunctionQuadraticApproximation> costToGo(P_.size());
+  for (size_t k = 0; k < P_.size(); ++k) {
+    costToGo[k].f = 0.0;
+    costToGo[k].dfdxx = P_[k];
+    costToGo[k].dfdx = p_[k];
+  }
+  return costToGo;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool RiccatiLqSolver::riccatiStep(int k, const Eigen::Ref<const matrix_t>& A, const Eigen::Ref<const matrix_t>& B,
+                                  const Eigen::Ref<const vector_t>& b, const Eigen::Ref<const matrix_t>& Q,
+                                  const Eigen::Ref<const matrix_t>& S, const Eigen::Ref<const matrix_t>& R,
+                                  const Eigen::Ref<const vector_t>& q, const Eigen::Ref<const vector_t>& r, matrix_t& K, vector_t& kff) {
+  const matrix_t& nextP = P_[k + 1];
+  const vector_t& nextp = p_[k + 1];
+
+  // Cost-to-go of the next node as a function of the current state and input
+  PA_.noalias() = nextP * A;
+  Pbp_ = nextp;
+  Pbp_.noalias() += nextP * b;
+
+  matrix_t& P = P_[k];
+  vector_t& p = p_[k];
+  P = Q;
+  P.noalias() += A.transpose() * PA_;
+  p = q;
+  p.noalias() += A.transpose() * Pbp_;
+
+  if (B.cols() > 0) {
+    PB_.noalias() = nextP * B;
+    H_ = R;
+    H_.noalias() += B.transpose() * PB_;
+    G_ = S;
+    G_.noalias() += B.transpose() * PA_;
+    g_ = r;
+    g_.noalias() += B.transpose() * Pbp_;
+
+    llt_.compute(H_);
+    if (llt_.info() != Eigen::Success) {
+      return false;
+    }
+    K = G_;
+    llt_.solveInPlace(K);
+    K = -K;
+    kff = g_;
+    llt_.solveInPlace(kff);
+    kff = -kff;
+    P.noalias() += G_.transpose() * K;
+    p.noalias() += G_.transpose() * kff;
+  } else {
+    K.setZero(0, A.cols());
+    kff.resize(0);
+  }
+
+  // Mirror the upper triangle to keep P exactly symmetric
+  P.triangularView<Eigen::StrictlyLower>() = P.transpose();
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool RiccatiLqSolver::eliminateConstraints(const OcpLqArena& lq, int k) {
+  const auto C = lq.C(k);
+  const auto D = lq.D(k);
+  const auto e = lq.e(k);
+  const int nc = D.rows();
+  const int nu = D.cols();
+  if (nc > nu) {
+    return false;
+  }
+
+  // D' Pi = [Q1 Q2] [R1; 0]. The constraints become R1' Q1' du = -Pi' (C dx + e), and Q2 spans the null space of D.
+  qr_.compute(D.transpose());
+  if (qr_.rank() < nc) {
+    return false;
+  }
+  Q_ = qr_.householderQ();
+  Z_ = Q_.rightCols(nu - nc);
+  const auto R1 = qr_.matrixR().topLeftCorner(nc, nc).triangularView<Eigen::Upper>();
+
+  // Particular solution: du = -Q1 R1^{-T} Pi' (C dx + e)
+  RPx_.noalias() = qr_.colsPermutation().transpose() * C;
+  R1.transpose().solveInPlace(RPx_);
+  Px_.noalias() = -Q_.leftCols(nc) * RPx_;
+  Rpe_.noalias() = qr_.colsPermutation().transpose() * e;
+  R1.transpose().solveInPlace(Rpe_);
+  pe_.noalias() = -Q_.leftCols(nc) * Rpe_;
+
+  // Dynamics in the reduced input
+  const auto A = lq.A(k);
+  const auto B = lq.B(k);
+  reducedA_ = A;
+  reducedA_.noalias() += B * Px_;
+  reducedb_ = lq.b(k);
+  reducedb_.noalias() += B * pe_;
+  reducedB_.noalias() = B * Z_;
+
+  // Cost in the reduced input
+  const auto Q = lq.Q(k);
+  const auto S = lq.S(k);
+  const auto R = lq.R(k);
+  const auto q = lq.q(k);
+  const auto r = lq.r(k);
+  RPx_.noalias() = R * Px_;
+  Rpe_.noalias() = R * pe_;
+  reducedQ_ = Q;
+  reducedQ_.noalias() += Px_.transpose() * RPx_;
+  reducedQ_.noalias() += Px_.transpose() * S;
+  reducedQ_.noalias() += S.transpose() * Px_;
+  reducedq_ = q;
+  reducedq_.noalias() += Px_.transpose() * r;
+  reducedq_.noalias() += Px_.transpose() * Rpe_;
+  reducedq_.noalias() += S.transpose() * pe_;
+  RPx_ += S;
+  reducedS_.noalias() = Z_.transpose() * RPx_;
+  reducedR_.noalias() = Z_.transpose() * R * Z_;
+  Rpe_ += r;
+  reducedr_.noalias() = Z_.transpose() * Rpe_;
+
+  return true;
+}
+
+}  // namespace ocs2
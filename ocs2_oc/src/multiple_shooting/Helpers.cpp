@@ -143,5 +143,30 @@ ProblemMetrics toProblemMetrics(const std::vector<AnnotatedTime>& time, std::vec
   return problemMetrics;
 }
 
+std::vector<AnnotatedTime> refineTimeDiscretization(const std::vector<AnnotatedTime>& time, const PrimalSolution& primalSolution,
+                                                    const ProblemMetrics& problemMetrics, scalar_t tolerance) {
+  const auto& timeTrajectory = primalSolution.timeTrajectory_;
+  const auto& postEventIndices = primalSolution.postEventIndices_;
+  if (timeTrajectory.size() < 2 || problemMetrics.intermediates.size() + postEventIndices.size() + 1 != timeTrajectory.size()) {
+    return time;
+  }
+
+  // The pre-event nodes hold the defects of the jump maps, the event intervals get zero error
+  const int N = static_cast<int>(timeTrajectory.size()) - 1;
+  scalar_array_t errors(N, 0.0);
+  auto postEventItr = postEventIndices.cbegin();
+  auto metricsItr = problemMetrics.intermediates.cbegin();
+  for (int i = 0; i < N; ++i) {
+    if (postEventItr != postEventIndices.cend() && *postEventItr == i + 1) {
+      ++postEventItr;
+    } else {
+      errors[i] = metricsItr->dynamicsViolation.norm();
+      ++metricsItr;
+    }
+  }
+
+  return ::ocs2::refineTimeDiscretization(time, timeTrajectory, errors, tolerance);
+}
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
@@ -0,0 +1,152 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/multiple_shooting/MoveBlocking.h"
+
+#include <cmath>
+
+#include <ocs2_core/NumericTraits.h>
+
+namespace ocs2 {
+namespace multiple_shooting {
+
+size_t numSubsteps(scalar_t dt, scalar_t maxStepSize) {
+  // The tolerance avoids an additional step for intervals that are a multiple of maxStepSize up to round-off
+  const auto n = std::ceil(dt / maxStepSize - numeric_traits::limitEpsilon<scalar_t>());
+  return std::max(static_cast<size_t>(n), size_t(1));
+}
+
+DynamicsDiscretizer selectSubsteppedDynamicsDiscretization(SensitivityIntegratorType integratorType, scalar_t maxStepSize) {
+  auto discretizer = selectDynamicsDiscretization(integratorType);
+  return [discretizer, maxStepSize](SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
+    const size_t n = numSubsteps(dt, maxStepSize);
+    const scalar_t h = dt / static_cast<scalar_t>(n);
+    vector_t xNext = discretizer(system, t, x, u, h);
+    for (size_t j = 1; j < n; ++j) {
+      xNext = discretizer(system, t + j * h, xNext, u, h);
+    }
+    return xNext;
+  };
+}
+
+DynamicsSensitivityDiscretizer selectSubsteppedDynamicsSensitivityDiscretization(SensitivityIntegratorType integratorType,
+                                                                                 scalar_t maxStepSize) {
+  auto discretizer = selectDynamicsSensitivityDiscretization(integratorType);
+  return [discretizer, maxStepSize](SystemDynamicsBase& system, scalar_t t, const vector_t& x, const vector_t& u, scalar_t dt) {
+    const size_t n = numSubsteps(dt, maxStepSize);
+    const scalar_t h = dt / static_cast<scalar_t>(n);
+    auto dynamics = discretizer(system, t, x, u, h);
+    matrix_t tmp;
+    for (size_t j = 1; j < n; ++j) {
+      // Chain rule: dx_{j+1} = A_j (A dx + B du) + B_j du
+      const auto step = discretizer(system, t + j * h, dynamics.f, u, h);
+      tmp.noalias() = step.dfdx * dynamics.dfdx;
+      dynamics.dfdx.swap(tmp);
+      tmp.noalias() = step.dfdx * dynamics.dfdu;
+      dynamics.dfdu = tmp + step.dfdu;
+      dynamics.f = step.f;
+    }
+    return dynamics;
+  };
+}
+
+std::vector<AnnotatedTime> blockTimeDiscretization(const std::vector<AnnotatedTime>& time, scalar_t blockingStartTime,
+                                                   size_t blockLength) {
+  if (blockLength < 2 || time.size() < 3) {
+    return time;
+  }
+
+  std::vector<AnnotatedTime> blockedTime;
+  blockedTime.reserve(time.size());
+  blockedTime.push_back(time.front());
+  size_t numIntervalsInBlock = 0;
+  for (size_t i = 1; i < time.size(); ++i) {
+    ++numIntervalsInBlock;
+    const bool isLast = i + 1 == time.size();
+    const bool isEvent = time[i].event != AnnotatedTime::Event::None;
+    const bool isBlocked = time[i].time > blockingStartTime + numeric_traits::limitEpsilon<scalar_t>();
+    if (isLast || isEvent || !isBlocked || numIntervalsInBlock == blockLength) {
+      blockedTime.push_back(time[i]);
+      numIntervalsInBlock = 0;
+    }
+  }
+  return blockedTime;
+}
+
+std::vector<AnnotatedTime> expandBlockedSolution(SystemDynamicsBase& systemDynamics, SensitivityIntegratorType integratorType,
+                                                 scalar_t maxStepSize, const std::vector<AnnotatedTime>& time, vector_array_t& x,
+                                                 vector_array_t& u, matrix_array_t* KMatrices) {
+  assert(time.size() == x.size());
+  const auto discretizer = selectDynamicsDiscretization(integratorType);
+  const int N = static_cast<int>(time.size()) - 1;
+
+  std::vector<AnnotatedTime> expandedTime;
+  vector_array_t expandedX, expandedU;
+  matrix_array_t expandedK;
+  expandedTime.reserve(time.size());
+  expandedX.reserve(x.size());
+  expandedU.reserve(u.size());
+  for (int i = 0; i < N; ++i) {
+    expandedTime.push_back(time[i]);
+    expandedX.push_back(std::move(x[i]));
+    expandedU.push_back(u[i]);
+    if (KMatrices != nullptr) {
+      expandedK.push_back((*KMatrices)[i]);
+    }
+
+    // Event intervals have no input and are not expanded
+    if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      continue;
+    }
+    const scalar_t start = getIntervalStart(time[i]);
+    const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
+    const size_t n = numSubsteps(dt, maxStepSize);
+    const scalar_t h = dt / static_cast<scalar_t>(n);
+    for (size_t j = 1; j < n; ++j) {
+      expandedTime.emplace_back(start + j * h, AnnotatedTime::Event::None);
+      expandedX.push_back(discretizer(systemDynamics, start + (j - 1) * h, expandedX.back(), u[i], h));
+      expandedU.push_back(u[i]);
+      if (KMatrices != nullptr) {
+        expandedK.push_back((*KMatrices)[i]);
+      }
+    }
+  }
+  expandedTime.push_back(time.back());
+  expandedX.push_back(std::move(x.back()));
+
+  x.swap(expandedX);
+  u.swap(expandedU);
+  if (KMatrices != nullptr) {
+    KMatrices->swap(expandedK);
+  }
+  return expandedTime;
+}
+
+}  // namespace multiple_shooting
+}  // namespace ocs2
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/oc_data/TimeDiscretization.h"
 
+#include <algorithm>
+
 #include <ocs2_core/misc/Lookup.h>
 
 namespace ocs2 {
@@ -59,19 +61,28 @@ scalar_t getIntervalDuration(const AnnotatedTime& start, const AnnotatedTime& en
 
 std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt,
                                                         const scalar_array_t& eventTimes, scalar_t dt_min) {
+  return geometricTimeDiscretizationWithEvents(initTime, finalTime, dt, 1.0, dt, eventTimes, dt_min);
+}
+
+std::vector<AnnotatedTime> geometricTimeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt, scalar_t growthRate,
+                                                                 scalar_t dtMax, const scalar_array_t& eventTimes, scalar_t dt_min) {
   assert(dt > 0);
+  assert(growthRate >= 1.0);
   assert(finalTime > initTime);
   std::vector<AnnotatedTime> timeDiscretization;
 
   // Initialize
   timeDiscretization.emplace_back(initTime, AnnotatedTime::Event::None);
   scalar_t nextEventIdx = lookup::findIndexInTimeArray(eventTimes, initTime);
+  dtMax = std::max(dt, dtMax);
+  scalar_t step = dt;
 
   // Fill iteratively with pre event, post events are added later
   AnnotatedTime nextNode = timeDiscretization.back();
   while (timeDiscretization.back().time < finalTime) {
-    nextNode.time = nextNode.time + dt;
+    nextNode.time = nextNode.time + step;
     nextNode.event = AnnotatedTime::Event::None;
+    step = std::min(growthRate * step, dtMax);
 
     // Check if an event has passed
     if (nextEventIdx < eventTimes.size() && nextNode.time >= eventTimes[nextEventIdx]) {
@@ -113,6 +124,34 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
   return timeDiscretizationWithDoubleEvents;
 }
 
+std::vector<AnnotatedTime> refineTimeDiscretization(const std::vector<AnnotatedTime>& time, const scalar_array_t& errorTime,
+                                                    const scalar_array_t& errors, scalar_t tolerance, scalar_t dt_min) {
+  assert(errors.size() + 1 == errorTime.size() || errors.empty());
+  if (time.empty() || errors.empty()) {
+    return time;
+  }
+
+  std::vector<AnnotatedTime> refinedTime;
+  refinedTime.reserve(2 * time.size());  // upper bound on size
+  refinedTime.push_back(time.front());
+  for (size_t i = 0; i + 1 < time.size(); i++) {
+    const scalar_t start = getIntervalStart(time[i]);
+    const scalar_t end = getIntervalEnd(time[i + 1]);
+    // Event intervals have zero duration and are never split
+    if (time[i].event != AnnotatedTime::Event::PreEvent && end - start > 2.0 * dt_min) {
+      const scalar_t midTime = 0.5 * (start + end);
+      const auto errorIndex = std::upper_bound(errorTime.cbegin(), errorTime.cend(), midTime) - errorTime.cbegin() - 1;
+      const auto clampedIndex = std::min(std::max<std::ptrdiff_t>(errorIndex, 0), static_cast<std::ptrdiff_t>(errors.size()) - 1);
+      if (errors[clampedIndex] > tolerance) {
+        refinedTime.emplace_back(0.5 * (time[i].time + time[i + 1].time), AnnotatedTime::Event::None);
+      }
+    }
+    refinedTime.push_back(time[i + 1]);
+  }
+
+  return refinedTime;
+}
+
 scalar_array_t toTime(const std::vector<AnnotatedTime>& annotatedTime) {
   scalar_array_t timeTrajectory;
   timeTrajectory.reserve(annotatedTime.size());
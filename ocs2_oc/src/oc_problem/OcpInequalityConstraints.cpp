@@ -0,0 +1,161 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/oc_problem/OcpInequalityConstraints.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ocs2 {
+
+namespace {
+constexpr scalar_t infinity = std::numeric_limits<scalar_t>::infinity();
+
+/** Returns the index of the only nonzero entry of a row, or -1 if the row has none or more than one. */
+template <typename Row>
+int singleNonZeroIndex(const Row& row) {
+  int index = -1;
+  for (int j = 0; j < row.size(); ++j) {
+    if (row(j) != 0.0) {
+      if (index >= 0) {
+        return -1;
+      }
+      index = j;
+    }
+  }
+  return index;
+}
+
+/**
+ * Intersects a bound a * d[index] + h >= 0 with the existing bounds on the variables. Appends a new bounded variable if needed.
+ * The bounds are collected in the first size entries of lb and ub, which are grown if required.
+ */
+void addBound(int index, scalar_t a, scalar_t h, std::vector<int>& idx, vector_t& lb, vector_t& ub) {
+  const auto it = std::find(idx.cbegin(), idx.cend(), index);
+  const int i = static_cast<int>(std::distance(idx.cbegin(), it));
+  if (it == idx.cend()) {
+    idx.push_back(index);
+    if (lb.size() < idx.size()) {
+      lb.conservativeResize(idx.size());
+      ub.conservativeResize(idx.size());
+    }
+    lb(i) = -infinity;
+    ub(i) = infinity;
+  }
+
+  const scalar_t bound = -h / a;
+  if (a > 0.0) {
+    lb(i) = std::max(lb(i), bound);
+  } else {
+    ub(i) = std::min(ub(i), bound);
+  }
+}
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void splitInequalityConstraints(int numStates, int numInputs, const VectorFunctionLinearApproximation& stateIneqConstraints,
+                                const VectorFunctionLinearApproximation& stateInputIneqConstraints, bool detectSimpleBounds,
+                                NodeInequalityConstraints& constraints) {
+  const int numStateIneq = stateIneqConstraints.f.size();
+  const int numStateInputIneq = stateInputIneqConstraints.f.size();
+  const bool hasInputs = numInputs > 0 && numStateInputIneq > 0;
+
+  constraints.idxbx.clear();
+  constraints.idxbu.clear();
+
+  // First pass: collect the simple bounds and mark the general constraints
+  std::vector<bool> isGeneral(numStateIneq + numStateInputIneq, true);
+  if (detectSimpleBounds) {
+    for (int i = 0; i < numStateIneq; ++i) {
+      const int j = singleNonZeroIndex(stateIneqConstraints.dfdx.row(i));
+      if (j >= 0) {
+        addBound(j, stateIneqConstraints.dfdx(i, j), stateIneqConstraints.f(i), constraints.idxbx, constraints.lbx, constraints.ubx);
+        isGeneral[i] = false;
+      }
+    }
+    for (int i = 0; i < numStateInputIneq; ++i) {
+      const int jx = singleNonZeroIndex(stateInputIneqConstraints.dfdx.row(i));
+      const int ju = hasInputs ? singleNonZeroIndex(stateInputIneqConstraints.dfdu.row(i)) : -1;
+      const bool noStates = jx < 0 && stateInputIneqConstraints.dfdx.row(i).isZero(0.0);
+      const bool noInputs = !hasInputs || (ju < 0 && stateInputIneqConstraints.dfdu.row(i).isZero(0.0));
+      if (jx >= 0 && noInputs) {
+        addBound(jx, stateInputIneqConstraints.dfdx(i, jx), stateInputIneqConstraints.f(i), constraints.idxbx, constraints.lbx,
+                 constraints.ubx);
+        isGeneral[numStateIneq + i] = false;
+      } else if (ju >= 0 && noStates) {
+        addBound(ju, stateInputIneqConstraints.dfdu(i, ju), stateInputIneqConstraints.f(i), constraints.idxbu, constraints.lbu,
+                 constraints.ubu);
+        isGeneral[numStateIneq + i] = false;
+      }
+    }
+  }
+  constraints.lbx.conservativeResize(constraints.idxbx.size());
+  constraints.ubx.conservativeResize(constraints.idxbx.size());
+  constraints.lbu.conservativeResize(constraints.idxbu.size());
+  constraints.ubu.conservativeResize(constraints.idxbu.size());
+
+  // Second pass: copy the general constraints, lg = -h
+  const int numGeneral = static_cast<int>(std::count(isGeneral.cbegin(), isGeneral.cend(), true));
+  constraints.C.setZero(numGeneral, numStates);
+  constraints.D.setZero(numGeneral, numInputs);
+  constraints.lg.resize(numGeneral);
+  int row = 0;
+  for (int i = 0; i < numStateIneq; ++i) {
+    if (isGeneral[i]) {
+      constraints.C.row(row) = stateIneqConstraints.dfdx.row(i);
+      constraints.lg(row) = -stateIneqConstraints.f(i);
+      ++row;
+    }
+  }
+  for (int i = 0; i < numStateInputIneq; ++i) {
+    if (isGeneral[numStateIneq + i]) {
+      constraints.C.row(row) = stateInputIneqConstraints.dfdx.row(i);
+      if (hasInputs) {
+        constraints.D.row(row) = stateInputIneqConstraints.dfdu.row(i);
+      }
+      constraints.lg(row) = -stateInputIneqConstraints.f(i);
+      ++row;
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void addInequalityConstraintsSize(const std::vector<NodeInequalityConstraints>& constraints, OcpSize& ocpSize) {
+  for (int k = 0; k <= ocpSize.numStages; ++k) {
+    ocpSize.numStateBoxConstraints[k] = static_cast<int>(constraints[k].idxbx.size());
+    ocpSize.numInputBoxConstraints[k] = static_cast<int>(constraints[k].idxbu.size());
+    ocpSize.numIneqConstraints[k] = constraints[k].numGeneralConstraints();
+  }
+}
+
+}  // namespace ocs2
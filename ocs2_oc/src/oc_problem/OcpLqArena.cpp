@@ -0,0 +1,220 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/oc_problem/OcpLqArena.h"
+
+#include <algorithm>
+#include <string>
+
+namespace ocs2 {
+
+namespace {
+/** Number of scalars in a slot of the given size, rounded up to a multiple of the alignment */
+size_t alignedSlotSize(int numScalars) {
+  constexpr size_t scalarsPerLine = OcpLqArena::alignment / sizeof(scalar_t);
+  return (static_cast<size_t>(numScalars) + scalarsPerLine - 1) / scalarsPerLine * scalarsPerLine;
+}
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+OcpLqArena::OcpLqArena(const OcpSize& ocpSize) {
+  reserve(ocpSize);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void OcpLqArena::reserve(const OcpSize& ocpSize) {
+  const auto maxOf = [](const std::vector<int>& v) { return v.empty() ? 0 : *std::max_element(v.cbegin(), v.cend()); };
+  reserve(ocpSize.numStages, maxOf(ocpSize.numStates), maxOf(ocpSize.numInputs), maxOf(ocpSize.numEqConstraints));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void OcpLqArena::reserve(int numStages, int maxNumStates, int maxNumInputs, int maxNumConstraints) {
+  const int nx = maxNumStates;
+  const int nu = maxNumInputs;
+  const int nc = maxNumConstraints;
+  const size_t numNodes = numStages + 1;
+
+  // Slot sizes per block kind
+  strides_[static_cast<size_t>(Block::A)] = alignedSlotSize(nx * nx);
+  strides_[static_cast<size_t>(Block::B)] = alignedSlotSize(nx * nu);
+  strides_[static_cast<size_t>(Block::b)] = alignedSlotSize(nx);
+  strides_[static_cast<size_t>(Block::Q)] = alignedSlotSize(nx * nx);
+  strides_[static_cast<size_t>(Block::S)] = alignedSlotSize(nu * nx);
+  strides_[static_cast<size_t>(Block::R)] = alignedSlotSize(nu * nu);
+  strides_[static_cast<size_t>(Block::q)] = alignedSlotSize(nx);
+  strides_[static_cast<size_t>(Block::r)] = alignedSlotSize(nu);
+  strides_[static_cast<size_t>(Block::C)] = alignedSlotSize(nc * nx);
+  strides_[static_cast<size_t>(Block::D)] = alignedSlotSize(nc * nu);
+  strides_[static_cast<size_t>(Block::e)] = alignedSlotSize(nc);
+
+  // All blocks of one kind are stored consecutively
+  size_t totalSize = 0;
+  for (size_t i = 0; i < numBlocks; ++i) {
+    offsets_[i] = totalSize;
+    totalSize += numNodes * strides_[i];
+  }
+
+  if (totalSize > capacity_) {
+    buffer_.reset(static_cast<scalar_t*>(std::aligned_alloc(alignment, totalSize * sizeof(scalar_t))));
+    if (buffer_ == nullptr) {
+      throw std::bad_alloc();
+    }
+    capacity_ = totalSize;
+  }
+
+  maxNumStates_ = nx;
+  maxNumInputs_ = nu;
+  maxNumConstraints_ = nc;
+
+  // Reset the node dimensions. Does not allocate if the number of stages did not grow.
+  size_.numStages = numStages;
+  for (auto* v : {&size_.numStates, &size_.numInputs, &size_.numInputBoxConstraints, &size_.numStateBoxConstraints,
+                  &size_.numIneqConstraints, &size_.numEqConstraints, &size_.numInputBoxSlack, &size_.numStateBoxSlack,
+                  &size_.numIneqSlack}) {
+    v->resize(numNodes);
+    std::fill(v->begin(), v->end(), 0);
+  }
+  numNextStates_.resize(numNodes);
+  std::fill(numNextStates_.begin(), numNextStates_.end(), 0);
+  costConstants_.resize(numNodes);
+  std::fill(costConstants_.begin(), costConstants_.end(), 0.0);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void OcpLqArena::checkCapacity(int k, int numStates, int numInputs, int numConstraints, const char* caller) const {
+  if (k < 0 || k > size_.numStages) {
+    throw std::runtime_error(std::string("[OcpLqArena::") + caller + "] Node " + std::to_string(k) + " is out of range.");
+  }
+  if (numStates > maxNumStates_ || numInputs > maxNumInputs_ || numConstraints > maxNumConstraints_) {
+    throw std::runtime_error(std::string("[OcpLqArena::") + caller + "] Node " + std::to_string(k) + " exceeds the reserved capacity.");
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void OcpLqArena::setDynamics(int k, const VectorFunctionLinearApproximation& dynamics) {
+  const int nx = dynamics.dfdx.cols();
+  const int nxNext = dynamics.dfdx.rows();
+  const int nu = dynamics.dfdu.cols();
+  checkCapacity(k, std::max(nx, nxNext), nu, 0, "setDynamics");
+  if (k == size_.numStages) {
+    throw std::runtime_error("[OcpLqArena::setDynamics] The terminal node has no dynamics.");
+  }
+
+  size_.numStates[k] = nx;
+  size_.numInputs[k] = nu;
+  numNextStates_[k] = nxNext;
+  A(k) = dynamics.dfdx;
+  B(k) = dynamics.dfdu;
+  b(k) = dynamics.f;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void OcpLqArena::setCost(int k, const ScalarFunctionQuadraticApproximation& cost) {
+  const int nx = cost.dfdx.size();
+  const int nu = (k < size_.numStages) ? cost.dfdu.size() : 0;
+  checkCapacity(k, nx, nu, 0, "setCost");
+
+  size_.numStates[k] = nx;
+  size_.numInputs[k] = nu;
+  costConstants_[k] = cost.f;
+  Q(k) = cost.dfdxx;
+  q(k) = cost.dfdx;
+  if (nu > 0) {
+    S(k) = cost.dfdux;
+    R(k) = cost.dfduu;
+    r(k) = cost.dfdu;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void OcpLqArena::setConstraints(int k, const VectorFunctionLinearApproximation& constraints) {
+  const int nx = constraints.dfdx.cols();
+  const int nu = (k < size_.numStages) ? constraints.dfdu.cols() : 0;
+  const int nc = constraints.f.size();
+  checkCapacity(k, nx, nu, nc, "setConstraints");
+
+  size_.numEqConstraints[k] = nc;
+  matrix_map_t(block(Block::C, k), nc, nx) = constraints.dfdx;
+  if (nu > 0) {
+    matrix_map_t(block(Block::D, k), nc, nu) = constraints.dfdu;
+  }
+  e(k) = constraints.f;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation OcpLqArena::getDynamics(int k) const {
+  VectorFunctionLinearApproximation dynamics;
+  dynamics.dfdx = A(k);
+  dynamics.dfdu = B(k);
+  dynamics.f = b(k);
+  return dynamics;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation OcpLqArena::getCost(int k) const {
+  ScalarFunctionQuadraticApproximation cost;
+  cost.f = c(k);
+  cost.dfdx = q(k);
+  cost.dfdxx = Q(k);
+  cost.dfdu = r(k);
+  cost.dfduu = R(k);
+  cost.dfdux = S(k);
+  return cost;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation OcpLqArena::getConstraints(int k) const {
+  VectorFunctionLinearApproximation constraints;
+  constraints.dfdx = C(k);
+  constraints.dfdu = D(k);
+  constraints.f = e(k);
+  return constraints;
+}
+
+}  // namespace ocs2
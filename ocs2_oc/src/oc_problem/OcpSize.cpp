@@ -38,6 +38,7 @@ bool operator==(const OcpSize& lhs, const OcpSize& rhs) noexcept {
   same = same && (lhs.numInputBoxConstraints == rhs.numInputBoxConstraints);
   same = same && (lhs.numStateBoxConstraints == rhs.numStateBoxConstraints);
   same = same && (lhs.numIneqConstraints == rhs.numIneqConstraints);
+  same = same && (lhs.numEqConstraints == rhs.numEqConstraints);
   same = same && (lhs.numInputBoxSlack == rhs.numInputBoxSlack);
   same = same && (lhs.numStateBoxSlack == rhs.numStateBoxSlack);
   same = same && (lhs.numIneqSlack == rhs.numIneqSlack);
@@ -62,7 +63,7 @@ OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximat
   // Constraints
   if (constraints != nullptr) {
     for (int k = 0; k < numStages + 1; k++) {
-      problemSize.numIneqConstraints[k] = (*constraints)[k].f.size();
+      problemSize.numEqConstraints[k] = (*constraints)[k].f.size();
     }
   }
 
@@ -44,7 +44,7 @@ int getNumDynamicsConstraints(const OcpSize& ocpSize) {
 }
 
 int getNumGeneralEqualityConstraints(const OcpSize& ocpSize) {
-  return std::accumulate(ocpSize.numIneqConstraints.begin(), ocpSize.numIneqConstraints.end(), (int)0);
+  return std::accumulate(ocpSize.numEqConstraints.begin(), ocpSize.numEqConstraints.end(), (int)0);
 }
 }  // namespace
 
@@ -118,7 +118,7 @@ void getConstraintMatrix(const OcpSize& ocpSize, const vector_t& x0, const std::
     // for ocs2 --> C*dx + D*du + e = 0
     // for pipg --> C*dx + D*du = -e
     // Initial general constraints
-    const int nc_0 = ocpSize.numIneqConstraints.front();
+    const int nc_0 = ocpSize.numEqConstraints.front();
     if (nc_0 > 0) {
       const auto& constraint_0 = (*constraintsPtr).front();
       G.block(currRow, 0, nc_0, nu_0) = constraint_0.dfdu;
@@ -128,7 +128,7 @@ void getConstraintMatrix(const OcpSize& ocpSize, const vector_t& x0, const std::
     }
 
     for (int k = 1; k < N; ++k) {
-      const int nc_k = ocpSize.numIneqConstraints[k];
+      const int nc_k = ocpSize.numEqConstraints[k];
       const int nu_k = ocpSize.numInputs[k];
       const int nx_k = ocpSize.numStates[k];
       if (nc_k > 0) {
@@ -145,7 +145,7 @@ void getConstraintMatrix(const OcpSize& ocpSize, const vector_t& x0, const std::
     }
 
     // Final general constraint
-    const int nc_N = ocpSize.numIneqConstraints[N];
+    const int nc_N = ocpSize.numEqConstraints[N];
     if (nc_N > 0) {
       const auto& constraints_N = (*constraintsPtr)[N];
       G.bottomRightCorner(nc_N, constraints_N.dfdx.cols()) = constraints_N.dfdx;
@@ -178,15 +178,15 @@ void getConstraintMatrixSparse(const OcpSize& ocpSize, const vector_t& x0, const
   }
 
   if (constraintsPtr != nullptr) {
-    const int nc_0 = ocpSize.numIneqConstraints[0];
+    const int nc_0 = ocpSize.numEqConstraints[0];
     nnz += nc_0 * nu_0;
     for (int k = 1; k < N; ++k) {
       const int nx_k = ocpSize.numStates[k];
       const int nu_k = ocpSize.numInputs[k];
-      const int nc_k = ocpSize.numIneqConstraints[k];
+      const int nc_k = ocpSize.numEqConstraints[k];
       nnz += nc_k * (nx_k + nu_k);
     }
-    const int nc_N = ocpSize.numIneqConstraints[N];
+    const int nc_N = ocpSize.numEqConstraints[N];
 
     nnz += nc_N * nx_N;
   }
@@ -259,7 +259,7 @@ void getConstraintMatrixSparse(const OcpSize& ocpSize, const vector_t& x0, const
     // for ocs2 --> C*dx + D*du + e = 0
     // for pipg --> C*dx + D*du = -e
     // Initial general constraints
-    const int nc_0 = ocpSize.numIneqConstraints.front();
+    const int nc_0 = ocpSize.numEqConstraints.front();
     if (nc_0 > 0) {
       const auto& constraint_0 = (*constraintsPtr).front();
       emplaceBackMatrix(currRow, 0, constraint_0.dfdu);
@@ -270,7 +270,7 @@ void getConstraintMatrixSparse(const OcpSize& ocpSize, const vector_t& x0, const
     }
 
     for (int k = 1; k < N; ++k) {
-      const int nc_k = ocpSize.numIneqConstraints[k];
+      const int nc_k = ocpSize.numEqConstraints[k];
       const int nu_k = ocpSize.numInputs[k];
       const int nx_k = ocpSize.numStates[k];
       if (nc_k > 0) {
@@ -288,7 +288,7 @@ void getConstraintMatrixSparse(const OcpSize& ocpSize, const vector_t& x0, const
     }
 
     // Final general constraint
-    const int nc_N = ocpSize.numIneqConstraints[N];
+    const int nc_N = ocpSize.numEqConstraints[N];
     if (nc_N > 0) {
       const auto& constraints_N = (*constraintsPtr)[N];
       emplaceBackMatrix(currRow, currCol, constraints_N.dfdx);
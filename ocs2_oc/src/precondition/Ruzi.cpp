@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/precondition/Ruzi.h"
 
+#include <algorithm>
 #include <atomic>
 #include <functional>
 #include <numeric>
@@ -205,29 +206,48 @@ void scaleMatrixInPlace(const vector_t& rowScale, const vector_t& colScale, Eige
   }
 }
 
-}  // anonymous namespace
-
-void ocpDataInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const OcpSize& ocpSize, const int iteration,
-                              std::vector<VectorFunctionLinearApproximation>& dynamics,
-                              std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& DOut, vector_array_t& EOut,
-                              vector_array_t& scalingVectors, scalar_t& cOut) {
+void ocpDataInPlaceInParallelImpl(ThreadPool& threadPool, const vector_t& x0, const OcpSize& ocpSize, const int iteration,
+                                  const vector_array_t* DInit, const vector_array_t* EInit, scalar_t cInit,
+                                  std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                  std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& DOut, vector_array_t& EOut,
+                                  vector_array_t& scalingVectors, scalar_t& cOut) {
   const int N = ocpSize.numStages;
   if (N < 1) {
     throw std::runtime_error("[precondition::ocpDataInPlaceInParallel] The number of stages cannot be less than 1.");
   }
 
   // Init output
+  const auto initFactor = [](const vector_array_t* init, size_t i, int size, vector_t& factor) {
+    if (init != nullptr && i < init->size() && (*init)[i].size() == size) {
+      factor = (*init)[i];
+    } else {
+      factor.setOnes(size);
+    }
+  };
   cOut = 1.0;
   DOut.resize(2 * N);
   EOut.resize(N);
   scalingVectors.resize(N);
   for (int i = 0; i < N; i++) {
-    DOut[2 * i].setOnes(ocpSize.numInputs[i]);
-    DOut[2 * i + 1].setOnes(ocpSize.numStates[i + 1]);
-    EOut[i].setOnes(ocpSize.numStates[i + 1]);
+    initFactor(DInit, 2 * i, ocpSize.numInputs[i], DOut[2 * i]);
+    initFactor(DInit, 2 * i + 1, ocpSize.numStates[i + 1], DOut[2 * i + 1]);
+    initFactor(EInit, i, ocpSize.numStates[i + 1], EOut[i]);
     scalingVectors[i].setOnes(ocpSize.numStates[i + 1]);
   }
 
+  // Apply the initial scaling
+  if (DInit != nullptr && EInit != nullptr) {
+    scaleDataOneStepInPlaceInParallel(threadPool, DOut, EOut, dynamics, cost, scalingVectors);
+    for (auto& costk : cost) {
+      costk.dfdxx *= cInit;
+      costk.dfduu *= cInit;
+      costk.dfdux *= cInit;
+      costk.dfdx *= cInit;
+      costk.dfdu *= cInit;
+    }
+    cOut = cInit;
+  }
+
   const auto numDecisionVariables = std::accumulate(ocpSize.numInputs.begin(), ocpSize.numInputs.end(), 0) +
                                     std::accumulate(std::next(ocpSize.numStates.begin()), ocpSize.numStates.end(), 0);
 
@@ -302,6 +322,51 @@ void ocpDataInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const
   }
 }
 
+}  // anonymous namespace
+
+void ocpDataInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const OcpSize& ocpSize, const int iteration,
+                              std::vector<VectorFunctionLinearApproximation>& dynamics,
+                              std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& DOut, vector_array_t& EOut,
+                              vector_array_t& scalingVectors, scalar_t& cOut) {
+  ocpDataInPlaceInParallelImpl(threadPool, x0, ocpSize, iteration, nullptr, nullptr, 1.0, dynamics, cost, DOut, EOut, scalingVectors, cOut);
+}
+
+void ocpDataInPlaceInParallel(ThreadPool& threadPool, const vector_t& x0, const OcpSize& ocpSize, const int iteration,
+                              const vector_array_t& DInit, const vector_array_t& EInit, scalar_t cInit,
+                              std::vector<VectorFunctionLinearApproximation>& dynamics,
+                              std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& DOut, vector_array_t& EOut,
+                              vector_array_t& scalingVectors, scalar_t& cOut) {
+  ocpDataInPlaceInParallelImpl(threadPool, x0, ocpSize, iteration, &DInit, &EInit, cInit, dynamics, cost, DOut, EOut, scalingVectors,
+                               cOut);
+}
+
+void shiftScalingFactors(const scalar_array_t& time, const vector_array_t& D, const vector_array_t& E, const scalar_array_t& newTime,
+                         vector_array_t& DShifted, vector_array_t& EShifted) {
+  const int N = static_cast<int>(E.size());
+  const int M = static_cast<int>(newTime.size()) - 1;
+  if (N < 1 || time.size() != N + 1 || D.size() != 2 * N) {
+    throw std::runtime_error("[precondition::shiftScalingFactors] Inconsistent sizes of the time discretization and the factors.");
+  }
+  if (M < 1) {
+    throw std::runtime_error("[precondition::shiftScalingFactors] The new number of stages cannot be less than 1.");
+  }
+
+  DShifted.resize(2 * M);
+  EShifted.resize(M);
+  for (int k = 0; k < M; k++) {
+    // The stage of the old discretization with the closest start time
+    const auto stageEnd = std::next(time.cbegin(), N);
+    const auto upper = std::lower_bound(time.cbegin(), stageEnd, newTime[k]);
+    int j = static_cast<int>(std::distance(time.cbegin(), upper));
+    if (j == N || (j > 0 && newTime[k] - time[j - 1] <= time[j] - newTime[k])) {
+      j = j - 1;
+    }
+    DShifted[2 * k] = D[2 * j];
+    DShifted[2 * k + 1] = D[2 * j + 1];
+    EShifted[k] = E[j];
+  }
+}
+
 void kktMatrixInPlace(int iteration, Eigen::SparseMatrix<scalar_t>& H, vector_t& h, Eigen::SparseMatrix<scalar_t>& G, vector_t& g,
                       vector_t& DOut, vector_t& EOut, scalar_t& cOut) {
   const int nz = H.rows();
@@ -99,6 +99,7 @@ vector_t StateTriggeredRollout::run(scalar_t initTime, const vector_t& initState
   int k_u = 0;                    // control input iterator
   int singleEventIterations = 0;  // iterations for a single event
   int numTotalIterations = 0;     // overall number of iterations
+  LinearInterpolation::TimeSegmentCursor inputCursor;
 
   while (true) {  // keeps looping until end time condition is fulfilled, after which the loop is broken
     bool triggered = false;
@@ -135,7 +136,8 @@ vector_t StateTriggeredRollout::run(scalar_t initTime, const vector_t& initState
     // compute control input trajectory and concatenate to inputTrajectory
     if (this->settings().reconstructInputTrajectory) {
       for (; k_u < timeTrajectory.size(); k_u++) {
-        inputTrajectory.emplace_back(systemDynamicsPtr_->controllerPtr()->computeInput(timeTrajectory[k_u], stateTrajectory[k_u]));
+        inputTrajectory.emplace_back();
+        systemDynamicsPtr_->controllerPtr()->computeInput(timeTrajectory[k_u], stateTrajectory[k_u], inputCursor, inputTrajectory.back());
       }  // end of k_u loop
     }
 
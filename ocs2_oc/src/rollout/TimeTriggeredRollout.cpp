@@ -82,6 +82,7 @@ vector_t TimeTriggeredRollout::run(scalar_t initTime, const vector_t& initState,
 
   vector_t beginState = initState;
   int k_u = 0;  // control input iterator
+  LinearInterpolation::TimeSegmentCursor inputCursor;
   for (int i = 0; i < numSubsystems; i++) {
     if (timeIntervalArray[i].first < timeIntervalArray[i].second) {
       Observer observer(&stateTrajectory, &timeTrajectory);  // concatenate trajectory
@@ -97,7 +98,8 @@ vector_t TimeTriggeredRollout::run(scalar_t initTime, const vector_t& initState,
     // compute control input trajectory and concatenate to inputTrajectory
     if (this->settings().reconstructInputTrajectory) {
       for (; k_u < timeTrajectory.size(); k_u++) {
-        inputTrajectory.emplace_back(systemDynamicsPtr_->controllerPtr()->computeInput(timeTrajectory[k_u], stateTrajectory[k_u]));
+        inputTrajectory.emplace_back();
+        systemDynamicsPtr_->controllerPtr()->computeInput(timeTrajectory[k_u], stateTrajectory[k_u], inputCursor, inputTrajectory.back());
       }  // end of k_u loop
     }
 
@@ -88,4 +88,18 @@ scalar_t armijoDescentMetric(const std::vector<ScalarFunctionQuadraticApproximat
   return metric;
 }
 
+scalar_t armijoDescentMetric(const OcpLqArena& lq, const vector_array_t& deltaXSol, const vector_array_t& deltaUSol) {
+  // To determine if the solution is a descent direction for the cost: compute gradient(cost)' * [dx; du]
+  scalar_t metric = 0.0;
+  for (int i = 0; i <= lq.numStages(); i++) {
+    if (lq.q(i).size() > 0) {
+      metric += lq.q(i).dot(deltaXSol[i]);
+    }
+    if (lq.r(i).size() > 0) {
+      metric += lq.r(i).dot(deltaUSol[i]);
+    }
+  }
+  return metric;
+}
+
 }  // namespace ocs2
@@ -0,0 +1,127 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_oc/lq_solver/FixedSizeRiccatiSolver.h"
+#include "ocs2_oc/lq_solver/ParallelRiccatiSolver.h"
+#include "ocs2_oc/multiple_shooting/Transcription.h"
+#include "ocs2_oc/oc_problem/OcpLqArena.h"
+#include "ocs2_oc/oc_problem/OptimalControlProblem.h"
+
+namespace ocs2 {
+
+/**
+ * Benchmarks the fixed-size Riccati solver against the dynamic-size one on the multiple-shooting LQ approximation of a problem,
+ * around a state with zero input, and checks that both give the same solution.
+ *
+ * @tparam NX : State dimension of the problem.
+ * @tparam NU : Input dimension of the problem.
+ * @param [in] name : Name of the benchmark in the printout.
+ * @param [in] ocp : The optimal control problem.
+ * @param [in] x0 : The state of the linearization.
+ * @param [in] targetState : The target state of the cost.
+ * @param [in] N : Number of stages.
+ * @param [in] dt : Time step.
+ * @param [in] numRepeats : Number of timed solves per solver.
+ */
+template <int NX, int NU>
+void benchmarkFixedSizeRiccati(const std::string& name, OptimalControlProblem ocp, const vector_t& x0, const vector_t& targetState,
+                               int N = 100, scalar_t dt = 0.01, int numRepeats = 1000) {
+  using fixed_size_solver_t = FixedSizeRiccatiSolver<NX, NU>;
+
+  const vector_t u0 = vector_t::Zero(NU);
+  const TargetTrajectories targetTrajectories({0.0}, {targetState}, {u0});
+  ocp.targetTrajectoriesPtr = &targetTrajectories;
+  auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+
+  // LQ approximation in the arena and as fixed-size arrays
+  OcpLqArena arena;
+  arena.reserve(N, NX, NU, 0);
+  fixed_array_t<typename fixed_size_solver_t::dynamics_t> dynamics(N);
+  fixed_array_t<typename fixed_size_solver_t::cost_t> cost(N + 1);
+  for (int k = 0; k < N; ++k) {
+    const auto result = multiple_shooting::setupIntermediateNode(ocp, sensitivityDiscretizer, k * dt, dt, x0, x0, u0);
+    arena.setDynamics(k, result.dynamics);
+    arena.setCost(k, result.cost);
+    dynamics[k].assign(result.dynamics);
+    cost[k].assign(result.cost);
+  }
+  const auto terminal = multiple_shooting::setupTerminalNode(ocp, N * dt, x0);
+  arena.setCost(N, terminal.cost);
+  cost[N].assign(terminal.cost);
+  ASSERT_TRUE(fixed_size_solver_t::isCompatible(arena.size()));
+
+  ThreadPool threadPool(0);
+  ParallelRiccatiSolver dynamicSolver;
+  fixed_size_solver_t fixedSolver;
+  const vector_t deltaX0 = vector_t::Ones(NX);
+  vector_array_t xDynamic, uDynamic, xFixed, uFixed;
+  fixed_array_t<typename fixed_size_solver_t::state_vector_t> xFixedArray;
+  fixed_array_t<typename fixed_size_solver_t::input_vector_t> uFixedArray;
+
+  benchmark::RepeatedTimer dynamicTimer;
+  benchmark::RepeatedTimer fixedTimer;
+  benchmark::RepeatedTimer fixedArrayTimer;
+  for (int i = 0; i < numRepeats; ++i) {
+    dynamicTimer.startTimer();
+    ASSERT_TRUE(dynamicSolver.solve(deltaX0, arena, threadPool, 1, xDynamic, uDynamic));
+    dynamicTimer.endTimer();
+
+    fixedTimer.startTimer();
+    ASSERT_TRUE(fixedSolver.solve(deltaX0, arena, xFixed, uFixed));
+    fixedTimer.endTimer();
+
+    fixedArrayTimer.startTimer();
+    ASSERT_TRUE(fixedSolver.solve(deltaX0, dynamics, cost, xFixedArray, uFixedArray));
+    fixedArrayTimer.endTimer();
+  }
+
+  for (int k = 0; k < N; ++k) {
+    EXPECT_TRUE(uFixed[k].isApprox(uDynamic[k], 1e-8)) << "k = " << k;
+    EXPECT_TRUE(xFixed[k + 1].isApprox(xDynamic[k + 1], 1e-8)) << "k = " << k;
+    EXPECT_TRUE(uFixedArray[k].isApprox(uDynamic[k], 1e-8)) << "k = " << k;
+  }
+
+  std::cerr << "\n[" << name << "] N = " << N << ", nx = " << NX << ", nu = " << NU << "\n";
+  std::cerr << "  dynamic size, arena average [ms]: " << dynamicTimer.getAverageInMilliseconds() << "\n";
+  std::cerr << "  fixed size, arena average [ms]: " << fixedTimer.getAverageInMilliseconds() << "\n";
+  std::cerr << "  fixed size, fixed arrays average [ms]: " << fixedArrayTimer.getAverageInMilliseconds() << "\n";
+}
+
+}  // namespace ocs2
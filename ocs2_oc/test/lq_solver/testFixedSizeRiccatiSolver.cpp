@@ -0,0 +1,211 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <memory>
+
+#include <ocs2_core/misc/Benchmark.h>
+
+#include "ocs2_oc/lq_solver/FixedSizeRiccatiSolver.h"
+#include "ocs2_oc/lq_solver/ParallelRiccatiSolver.h"
+#include "ocs2_oc/oc_problem/OcpToKkt.h"
+
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+namespace {
+
+constexpr int NX = 4;
+constexpr int NU = 2;
+
+struct LqProblem {
+  ocs2::vector_t x0;
+  std::vector<ocs2::VectorFunctionLinearApproximation> dynamics;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+};
+
+/** Random problem in which every eventPeriod-th stage is an event without inputs */
+LqProblem getRandomProblem(int N, int nx, int nu, int eventPeriod = 0) {
+  LqProblem problem;
+  problem.x0 = ocs2::vector_t::Random(nx);
+  for (int k = 0; k < N; ++k) {
+    const bool isEvent = eventPeriod > 0 && k % eventPeriod == eventPeriod - 1;
+    problem.dynamics.push_back(ocs2::getRandomDynamics(nx, isEvent ? 0 : nu));
+    problem.cost.push_back(ocs2::getRandomCost(nx, isEvent ? 0 : nu));
+  }
+  problem.cost.push_back(ocs2::getRandomCost(nx, 0));
+  return problem;
+}
+
+ocs2::OcpLqArena toArena(const LqProblem& problem) {
+  const auto ocpSize = ocs2::extractSizesFromProblem(problem.dynamics, problem.cost, nullptr);
+  ocs2::OcpLqArena arena(ocpSize);
+  for (int k = 0; k < ocpSize.numStages; ++k) {
+    arena.setDynamics(k, problem.dynamics[k]);
+    arena.setCost(k, problem.cost[k]);
+  }
+  arena.setCost(ocpSize.numStages, problem.cost.back());
+  return arena;
+}
+
+}  // namespace
+
+class FixedSizeRiccatiSolverTest : public testing::Test {
+ protected:
+  using solver_t = ocs2::FixedSizeRiccatiSolver<NX, NU>;
+
+  FixedSizeRiccatiSolverTest() : threadPool_(0) { srand(0); }
+
+  /** Compares with the dynamic-size Riccati recursion */
+  void expectSolution(const LqProblem& problem, const solver_t& solver, const ocs2::vector_array_t& x, const ocs2::vector_array_t& u) {
+    ocs2::ParallelRiccatiSolver referenceSolver;
+    ocs2::vector_array_t xRef, uRef;
+    ASSERT_TRUE(referenceSolver.solve(problem.x0, problem.dynamics, problem.cost, threadPool_, 1, xRef, uRef));
+    const auto costToGo = solver.getRiccatiCostToGo();
+    const auto costToGoRef = referenceSolver.getRiccatiCostToGo();
+    const auto feedback = solver.getRiccatiFeedback();
+    ASSERT_EQ(x.size(), xRef.size());
+    ASSERT_EQ(u.size(), uRef.size());
+    for (size_t k = 0; k < u.size(); ++k) {
+      ASSERT_EQ(u[k].size(), uRef[k].size()) << "k = " << k;
+      EXPECT_TRUE(u[k].isApprox(uRef[k], 1e-8)) << "k = " << k;
+      EXPECT_TRUE(x[k + 1].isApprox(xRef[k + 1], 1e-8)) << "k = " << k;
+      EXPECT_TRUE(feedback[k].isApprox(referenceSolver.getRiccatiFeedback()[k], 1e-8)) << "k = " << k;
+      EXPECT_TRUE(costToGo[k].dfdxx.isApprox(costToGoRef[k].dfdxx, 1e-8)) << "k = " << k;
+      EXPECT_TRUE(costToGo[k].dfdx.isApprox(costToGoRef[k].dfdx, 1e-8)) << "k = " << k;
+    }
+  }
+
+  ocs2::ThreadPool threadPool_;
+};
+
+TEST_F(FixedSizeRiccatiSolverTest, arrays) {
+  const auto problem = getRandomProblem(30, NX, NU, 7);
+  ASSERT_TRUE(solver_t::isCompatible(problem.dynamics, problem.cost));
+
+  solver_t solver;
+  ocs2::vector_array_t x, u;
+  ASSERT_TRUE(solver.solve(problem.x0, problem.dynamics, problem.cost, x, u));
+  expectSolution(problem, solver, x, u);
+}
+
+TEST_F(FixedSizeRiccatiSolverTest, arena) {
+  const auto problem = getRandomProblem(30, NX, NU, 7);
+  const auto arena = toArena(problem);
+  ASSERT_TRUE(solver_t::isCompatible(arena.size()));
+
+  solver_t solver;
+  ocs2::vector_array_t x, u;
+  ASSERT_TRUE(solver.solve(problem.x0, arena, x, u));
+  expectSolution(problem, solver, x, u);
+}
+
+TEST_F(FixedSizeRiccatiSolverTest, fixedSizeArrays) {
+  const auto problem = getRandomProblem(30, NX, NU);
+  ocs2::fixed_array_t<solver_t::dynamics_t> dynamics(problem.dynamics.size());
+  ocs2::fixed_array_t<solver_t::cost_t> cost(problem.cost.size());
+  for (size_t k = 0; k < problem.dynamics.size(); ++k) {
+    dynamics[k].assign(problem.dynamics[k]);
+    cost[k].assign(problem.cost[k]);
+  }
+  cost.back().assign(problem.cost.back());
+
+  solver_t solver;
+  ocs2::fixed_array_t<solver_t::state_vector_t> xFixed;
+  ocs2::fixed_array_t<solver_t::input_vector_t> uFixed;
+  ASSERT_TRUE(solver.solve(problem.x0, dynamics, cost, xFixed, uFixed));
+
+  ocs2::vector_array_t x(xFixed.cbegin(), xFixed.cend());
+  ocs2::vector_array_t u(uFixed.cbegin(), uFixed.cend());
+  expectSolution(problem, solver, x, u);
+}
+
+TEST_F(FixedSizeRiccatiSolverTest, compatibility) {
+  const auto wrongStates = getRandomProblem(10, NX + 1, NU);
+  const auto wrongInputs = getRandomProblem(10, NX, NU + 1);
+  EXPECT_FALSE(solver_t::isCompatible(wrongStates.dynamics, wrongStates.cost));
+  EXPECT_FALSE(solver_t::isCompatible(wrongInputs.dynamics, wrongInputs.cost));
+  EXPECT_FALSE(solver_t::isCompatible(toArena(wrongInputs).size()));
+
+  solver_t solver;
+  ocs2::vector_array_t x, u;
+  EXPECT_THROW(solver.solve(wrongStates.x0, wrongStates.dynamics, wrongStates.cost, x, u), std::runtime_error);
+}
+
+TEST_F(FixedSizeRiccatiSolverTest, interface) {
+  using adapter_t = ocs2::FixedSizeRiccatiSolverAdapter<NX, NU>;
+  const auto problem = getRandomProblem(30, NX, NU, 7);
+  const auto arena = toArena(problem);
+  const auto wrongInputs = getRandomProblem(10, NX, NU + 1);
+
+  std::unique_ptr<ocs2::FixedSizeRiccatiSolverInterface> solverPtr(new adapter_t());
+  EXPECT_EQ(solverPtr->getNumStates(), NX);
+  EXPECT_EQ(solverPtr->getNumInputs(), NU);
+  EXPECT_TRUE(solverPtr->isCompatible(arena.size()));
+  EXPECT_TRUE(solverPtr->isCompatible(problem.dynamics, problem.cost));
+  EXPECT_FALSE(solverPtr->isCompatible(toArena(wrongInputs).size()));
+  EXPECT_FALSE(solverPtr->isCompatible(wrongInputs.dynamics, wrongInputs.cost));
+
+  ocs2::vector_array_t x, u;
+  ASSERT_TRUE(solverPtr->solve(problem.x0, arena, x, u));
+  expectSolution(problem, static_cast<const adapter_t&>(*solverPtr).getSolver(), x, u);
+  ASSERT_TRUE(solverPtr->solve(problem.x0, problem.dynamics, problem.cost, x, u));
+  expectSolution(problem, static_cast<const adapter_t&>(*solverPtr).getSolver(), x, u);
+}
+
+TEST(FixedSizeRiccatiSolverBenchmark, fixedVersusDynamic) {
+  constexpr int N = 100;
+  constexpr int nx = 4;
+  constexpr int nu = 1;
+  constexpr int numRepeats = 1000;
+
+  srand(0);
+  const auto problem = getRandomProblem(N, nx, nu);
+  const auto arena = toArena(problem);
+  ocs2::ThreadPool threadPool(0);
+  ocs2::ParallelRiccatiSolver dynamicSolver;
+  ocs2::FixedSizeRiccatiSolver<nx, nu> fixedSolver;
+  ocs2::vector_array_t x, u;
+
+  ocs2::benchmark::RepeatedTimer dynamicTimer;
+  ocs2::benchmark::RepeatedTimer fixedTimer;
+  for (int i = 0; i < numRepeats; ++i) {
+    dynamicTimer.startTimer();
+    ASSERT_TRUE(dynamicSolver.solve(problem.x0, arena, threadPool, 1, x, u));
+    dynamicTimer.endTimer();
+
+    fixedTimer.startTimer();
+    ASSERT_TRUE(fixedSolver.solve(problem.x0, arena, x, u));
+    fixedTimer.endTimer();
+  }
+  std::cerr << "\n[FixedSizeRiccatiSolver] N = " << N << ", nx = " << nx << ", nu = " << nu << "\n";
+  std::cerr << "  dynamic size average [ms]: " << dynamicTimer.getAverageInMilliseconds() << "\n";
+  std::cerr << "  fixed size average [ms]:   " << fixedTimer.getAverageInMilliseconds() << "\n";
+}
@@ -0,0 +1,218 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+#include <ocs2_core/misc/Benchmark.h>
+
+#include "ocs2_oc/lq_solver/ParallelRiccatiSolver.h"
+#include "ocs2_oc/oc_problem/OcpSize.h"
+#include "ocs2_oc/oc_problem/OcpToKkt.h"
+
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+namespace {
+
+struct LqProblem {
+  ocs2::vector_t x0;
+  std::vector<ocs2::VectorFunctionLinearApproximation> dynamics;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+};
+
+LqProblem getRandomProblem(int N, int nx, int nu) {
+  LqProblem problem;
+  problem.x0 = ocs2::vector_t::Random(nx);
+  for (int k = 0; k < N; ++k) {
+    problem.dynamics.push_back(ocs2::getRandomDynamics(nx, nu));
+    problem.cost.push_back(ocs2::getRandomCost(nx, nu));
+  }
+  problem.cost.push_back(ocs2::getRandomCost(nx, 0));
+  return problem;
+}
+
+/** Solves the KKT system of the stacked problem as reference */
+void solveDense(const LqProblem& problem, ocs2::vector_array_t& x, ocs2::vector_array_t& u) {
+  const auto ocpSize = ocs2::extractSizesFromProblem(problem.dynamics, problem.cost, nullptr);
+  ocs2::ScalarFunctionQuadraticApproximation costApproximation;
+  ocs2::VectorFunctionLinearApproximation constraintsApproximation;
+  ocs2::getCostMatrix(ocpSize, problem.x0, problem.cost, costApproximation);
+  ocs2::getConstraintMatrix(ocpSize, problem.x0, problem.dynamics, nullptr, nullptr, constraintsApproximation);
+
+  const auto& H = costApproximation.dfdxx;
+  const auto& G = constraintsApproximation.dfdx;
+  const int nz = H.rows();
+  const int nc = G.rows();
+  ocs2::matrix_t kkt = ocs2::matrix_t::Zero(nz + nc, nz + nc);
+  kkt.topLeftCorner(nz, nz) = H;
+  kkt.topRightCorner(nz, nc) = G.transpose();
+  kkt.bottomLeftCorner(nc, nz) = G;
+  ocs2::vector_t rhs(nz + nc);
+  rhs << -costApproximation.dfdx, constraintsApproximation.f;
+  const ocs2::vector_t sol = kkt.lu().solve(rhs);
+  ocs2::toOcpSolution(ocpSize, sol.head(nz), problem.x0, x, u);
+}
+
+}  // namespace
+
+class ParallelRiccatiSolverTest : public testing::TestWithParam<int> {
+ protected:
+  ParallelRiccatiSolverTest() : threadPool_(15) { srand(0); }
+
+  void expectSolution(const LqProblem& problem, const ocs2::vector_array_t& x, const ocs2::vector_array_t& u) {
+    ocs2::vector_array_t xRef, uRef;
+    solveDense(problem, xRef, uRef);
+    ASSERT_EQ(x.size(), xRef.size());
+    ASSERT_EQ(u.size(), uRef.size());
+    for (size_t k = 0; k < u.size(); ++k) {
+      EXPECT_TRUE(u[k].isApprox(uRef[k], 1e-7)) << "k = " << k;
+      EXPECT_TRUE(x[k + 1].isApprox(xRef[k + 1], 1e-7)) << "k = " << k;
+    }
+  }
+
+  ocs2::ThreadPool threadPool_;
+  ocs2::ParallelRiccatiSolver solver_;
+};
+
+TEST_P(ParallelRiccatiSolverTest, compareToKkt) {
+  const int numThreads = GetParam();
+  const auto problem = getRandomProblem(40, 6, 3);
+
+  ocs2::vector_array_t x, u;
+  ASSERT_TRUE(solver_.solve(problem.x0, problem.dynamics, problem.cost, threadPool_, numThreads, x, u));
+  EXPECT_EQ(solver_.getNumSegments(), numThreads);
+  expectSolution(problem, x, u);
+}
+
+TEST_P(ParallelRiccatiSolverTest, eventNodesAndChangingStateDimension) {
+  const int numThreads = GetParam();
+  const int N = 40;
+  const int nu = 2;
+  const std::vector<int> nx{3, 4, 5};
+
+  // Every 7th stage is an event without inputs that changes the state dimension
+  LqProblem problem;
+  int stateIndex = 0;
+  problem.x0 = ocs2::vector_t::Random(nx[stateIndex]);
+  for (int k = 0; k < N; ++k) {
+    if (k % 7 == 6) {
+      const int nextStateIndex = (stateIndex + 1) % nx.size();
+      ocs2::VectorFunctionLinearApproximation jumpMap;
+      jumpMap.dfdx = ocs2::matrix_t::Random(nx[nextStateIndex], nx[stateIndex]);
+      jumpMap.dfdu.setZero(nx[nextStateIndex], 0);
+      jumpMap.f = ocs2::vector_t::Random(nx[nextStateIndex]);
+      problem.dynamics.push_back(jumpMap);
+      problem.cost.push_back(ocs2::getRandomCost(nx[stateIndex], 0));
+      stateIndex = nextStateIndex;
+    } else {
+      problem.dynamics.push_back(ocs2::getRandomDynamics(nx[stateIndex], nu));
+      problem.cost.push_back(ocs2::getRandomCost(nx[stateIndex], nu));
+    }
+  }
+  problem.cost.push_back(ocs2::getRandomCost(nx[stateIndex], 0));
+
+  ocs2::vector_array_t x, u;
+  ASSERT_TRUE(solver_.solve(problem.x0, problem.dynamics, problem.cost, threadPool_, numThreads, x, u));
+  expectSolution(problem, x, u);
+}
+
+TEST_P(ParallelRiccatiSolverTest, arenaMatchesArrays) {
+  const int numThreads = GetParam();
+  const auto problem = getRandomProblem(40, 5, 2);
+  const auto ocpSize = ocs2::extractSizesFromProblem(problem.dynamics, problem.cost, nullptr);
+
+  ocs2::OcpLqArena arena(ocpSize);
+  for (int k = 0; k < ocpSize.numStages; ++k) {
+    arena.setDynamics(k, problem.dynamics[k]);
+    arena.setCost(k, problem.cost[k]);
+  }
+  arena.setCost(ocpSize.numStages, problem.cost.back());
+
+  ocs2::vector_array_t x, u;
+  ASSERT_TRUE(solver_.solve(problem.x0, arena, threadPool_, numThreads, x, u));
+  const auto costToGo = solver_.getRiccatiCostToGo();
+  const auto feedback = solver_.getRiccatiFeedback();
+
+  ocs2::ParallelRiccatiSolver serialSolver;
+  ocs2::vector_array_t xSerial, uSerial;
+  ASSERT_TRUE(serialSolver.solve(problem.x0, problem.dynamics, problem.cost, threadPool_, 1, xSerial, uSerial));
+  const auto costToGoSerial = serialSolver.getRiccatiCostToGo();
+  for (int k = 0; k < ocpSize.numStages; ++k) {
+    EXPECT_TRUE(u[k].isApprox(uSerial[k], 1e-8)) << "k = " << k;
+    EXPECT_TRUE(feedback[k].isApprox(serialSolver.getRiccatiFeedback()[k], 1e-8)) << "k = " << k;
+    EXPECT_TRUE(costToGo[k].dfdxx.isApprox(costToGoSerial[k].dfdxx, 1e-8)) << "k = " << k;
+    EXPECT_TRUE(costToGo[k].dfdx.isApprox(costToGoSerial[k].dfdx, 1e-8)) << "k = " << k;
+  }
+}
+
+TEST_P(ParallelRiccatiSolverTest, arenaWithConstraintsThrows) {
+  const auto problem = getRandomProblem(10, 3, 2);
+  auto ocpSize = ocs2::extractSizesFromProblem(problem.dynamics, problem.cost, nullptr);
+  ocpSize.numEqConstraints[2] = 1;
+
+  ocs2::OcpLqArena arena(ocpSize);
+  for (int k = 0; k < ocpSize.numStages; ++k) {
+    arena.setDynamics(k, problem.dynamics[k]);
+    arena.setCost(k, problem.cost[k]);
+  }
+  arena.setCost(ocpSize.numStages, problem.cost.back());
+  arena.setConstraints(2, ocs2::getRandomConstraints(3, 2, 1));
+
+  ocs2::vector_array_t x, u;
+  EXPECT_THROW(solver_.solve(problem.x0, arena, threadPool_, GetParam(), x, u), std::runtime_error);
+}
+
+INSTANTIATE_TEST_CASE_P(ParallelRiccatiSolverTestCase, ParallelRiccatiSolverTest, testing::Values(1, 2, 3, 8),
+                        [](const testing::TestParamInfo<int>& info) { return "numThreads_" + std::to_string(info.param); });
+
+TEST(ParallelRiccatiSolverBenchmark, threadScaling) {
+  constexpr int N = 500;
+  constexpr int nx = 12;
+  constexpr int nu = 6;
+  constexpr int numRepeats = 20;
+
+  srand(0);
+  const auto problem = getRandomProblem(N, nx, nu);
+  ocs2::ThreadPool threadPool(15);
+  ocs2::ParallelRiccatiSolver solver;
+  ocs2::vector_array_t x, u;
+
+  std::cerr << "\n[ParallelRiccatiSolver] N = " << N << ", nx = " << nx << ", nu = " << nu << "\n";
+  for (const int numThreads : {1, 2, 4, 8, 16}) {
+    ocs2::benchmark::RepeatedTimer timer;
+    for (int i = 0; i < numRepeats; ++i) {
+      timer.startTimer();
+      ASSERT_TRUE(solver.solve(problem.x0, problem.dynamics, problem.cost, threadPool, numThreads, x, u));
+      timer.endTimer();
+    }
+    std::cerr << "  threads: " << numThreads << "\tsegments: " << solver.getNumSegments()
+              << "\taverage [ms]: " << timer.getAverageInMilliseconds() << "\tmax [ms]: " << timer.getMaxIntervalInMilliseconds() << "\n";
+  }
+}
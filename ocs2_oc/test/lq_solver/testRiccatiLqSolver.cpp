@@ -0,0 +1,203 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_oc/lq_solver/LqProblemRecording.h"
+#include "ocs2_oc/lq_solver/ParallelRiccatiLqSolver.h"
+#include "ocs2_oc/lq_solver/RiccatiLqSolver.h"
+#include "ocs2_oc/oc_problem/OcpToKkt.h"
+
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+namespace {
+
+struct LqProblem {
+  ocs2::vector_t x0;
+  std::vector<ocs2::VectorFunctionLinearApproximation> dynamics;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  std::vector<ocs2::VectorFunctionLinearApproximation> constraints;
+};
+
+/** Random problem where stage k has numConstraints(k) state-input equality constraints */
+template <typename NumConstraints>
+LqProblem getRandomProblem(int N, int nx, int nu, NumConstraints numConstraints) {
+  LqProblem problem;
+  problem.x0 = ocs2::vector_t::Random(nx);
+  for (int k = 0; k < N; ++k) {
+    problem.dynamics.push_back(ocs2::getRandomDynamics(nx, nu));
+    problem.cost.push_back(ocs2::getRandomCost(nx, nu));
+    problem.constraints.push_back(ocs2::getRandomConstraints(nx, nu, numConstraints(k)));
+  }
+  problem.cost.push_back(ocs2::getRandomCost(nx, 0));
+  problem.constraints.push_back(ocs2::getRandomConstraints(nx, 0, 0));
+  return problem;
+}
+
+ocs2::OcpLqArena toArena(const LqProblem& problem) {
+  const auto ocpSize = ocs2::extractSizesFromProblem(problem.dynamics, problem.cost, &problem.constraints);
+  ocs2::OcpLqArena arena(ocpSize);
+  for (int k = 0; k <= ocpSize.numStages; ++k) {
+    if (k < ocpSize.numStages) {
+      arena.setDynamics(k, problem.dynamics[k]);
+    }
+    arena.setCost(k, problem.cost[k]);
+    if (problem.constraints[k].f.size() > 0) {
+      arena.setConstraints(k, problem.constraints[k]);
+    }
+  }
+  return arena;
+}
+
+/** Solves the KKT system of the stacked problem as reference */
+void solveDense(const LqProblem& problem, ocs2::vector_array_t& x, ocs2::vector_array_t& u) {
+  const auto ocpSize = ocs2::extractSizesFromProblem(problem.dynamics, problem.cost, &problem.constraints);
+  ocs2::ScalarFunctionQuadraticApproximation costApproximation;
+  ocs2::VectorFunctionLinearApproximation constraintsApproximation;
+  ocs2::getCostMatrix(ocpSize, problem.x0, problem.cost, costApproximation);
+  ocs2::getConstraintMatrix(ocpSize, problem.x0, problem.dynamics, &problem.constraints, nullptr, constraintsApproximation);
+
+  const auto& H = costApproximation.dfdxx;
+  const auto& G = constraintsApproximation.dfdx;
+  const int nz = H.rows();
+  const int nc = G.rows();
+  ocs2::matrix_t kkt = ocs2::matrix_t::Zero(nz + nc, nz + nc);
+  kkt.topLeftCorner(nz, nz) = H;
+  kkt.topRightCorner(nz, nc) = G.transpose();
+  kkt.bottomLeftCorner(nc, nz) = G;
+  ocs2::vector_t rhs(nz + nc);
+  rhs << -costApproximation.dfdx, constraintsApproximation.f;
+  const ocs2::vector_t sol = kkt.lu().solve(rhs);
+  ocs2::toOcpSolution(ocpSize, sol.head(nz), problem.x0, x, u);
+}
+
+void expectSolution(const LqProblem& problem, const ocs2::vector_array_t& x, const ocs2::vector_array_t& u) {
+  ocs2::vector_array_t xRef, uRef;
+  solveDense(problem, xRef, uRef);
+  ASSERT_EQ(x.size(), xRef.size());
+  ASSERT_EQ(u.size(), uRef.size());
+  for (size_t k = 0; k < u.size(); ++k) {
+    EXPECT_TRUE(u[k].isApprox(uRef[k], 1e-7)) << "k = " << k;
+    EXPECT_TRUE(x[k + 1].isApprox(xRef[k + 1], 1e-7)) << "k = " << k;
+  }
+}
+
+}  // namespace
+
+TEST(RiccatiLqSolver, unconstrained) {
+  srand(0);
+  auto problem = getRandomProblem(30, 5, 3, [](int) { return 0; });
+  auto arena = toArena(problem);
+
+  ocs2::RiccatiLqSolver solver;
+  solver.resize(arena.size());
+  ocs2::vector_array_t x, u;
+  ASSERT_TRUE(solver.solve(problem.x0, arena, x, u));
+  expectSolution(problem, x, u);
+
+  // Same policy and cost-to-go as the parallel Riccati solver
+  ocs2::ThreadPool threadPool(0);
+  ocs2::ParallelRiccatiLqSolver parallelSolver(threadPool, 1);
+  ocs2::vector_array_t xParallel, uParallel;
+  ASSERT_TRUE(parallelSolver.solve(problem.x0, arena, xParallel, uParallel));
+  const auto feedback = solver.getRiccatiFeedback(arena);
+  const auto costToGo = solver.getRiccatiCostToGo(arena);
+  const auto costToGoParallel = parallelSolver.getRiccatiCostToGo(arena);
+  for (int k = 0; k < arena.numStages(); ++k) {
+    EXPECT_TRUE(feedback[k].isApprox(parallelSolver.getRiccatiFeedback(arena)[k], 1e-8)) << "k = " << k;
+    EXPECT_TRUE(costToGo[k].dfdxx.isApprox(costToGoParallel[k].dfdxx, 1e-8)) << "k = " << k;
+    EXPECT_TRUE(costToGo[k].dfdx.isApprox(costToGoParallel[k].dfdx, 1e-8)) << "k = " << k;
+  }
+}
+
+TEST(RiccatiLqSolver, equalityConstraints) {
+  srand(0);
+  const int nu = 3;
+  // Stages without constraints, partially constrained inputs, and fully determined inputs
+  auto problem = getRandomProblem(30, 4, nu, [](int k) { return k % 4; });
+  auto arena = toArena(problem);
+
+  ocs2::RiccatiLqSolver solver;
+  ocs2::vector_array_t x, u;
+  ASSERT_TRUE(solver.solve(problem.x0, arena, x, u));
+  expectSolution(problem, x, u);
+  for (int k = 0; k < arena.numStages(); ++k) {
+    const ocs2::vector_t residual = arena.C(k) * x[k] + arena.D(k) * u[k] + arena.e(k);
+    EXPECT_LT(residual.norm(), 1e-9) << "k = " << k;
+  }
+
+  // The feedback policy is the derivative of the solution w.r.t. the initial state
+  const ocs2::vector_t dx0 = 1e-3 * ocs2::vector_t::Random(problem.x0.size());
+  const ocs2::matrix_t K0 = solver.getRiccatiFeedback(arena).front();
+  ocs2::vector_array_t xPerturbed, uPerturbed;
+  ASSERT_TRUE(solver.solve(problem.x0 + dx0, arena, xPerturbed, uPerturbed));
+  EXPECT_TRUE((uPerturbed[0] - u[0]).isApprox(K0 * dx0, 1e-8));
+}
+
+TEST(RiccatiLqSolver, unsupportedConstraints) {
+  srand(0);
+  auto problem = getRandomProblem(10, 4, 2, [](int k) { return (k == 5) ? 1 : 0; });
+  problem.constraints[5].dfdu.setZero();  // a pure state constraint
+  auto arena = toArena(problem);
+
+  ocs2::RiccatiLqSolver solver;
+  ocs2::vector_array_t x, u;
+  EXPECT_FALSE(solver.solve(problem.x0, arena, x, u));
+}
+
+TEST(LqProblemRecording, saveAndLoad) {
+  srand(0);
+  const auto problem = getRandomProblem(10, 4, 3, [](int k) { return k % 2; });
+  const auto arena = toArena(problem);
+  const std::string filePath = "/tmp/ocs2_testLqProblemRecording.bin";
+  ocs2::lq_solver::saveLqProblem(filePath, problem.x0, arena);
+
+  ocs2::OcpLqArena loadedArena;
+  const ocs2::vector_t x0 = ocs2::lq_solver::loadLqProblem(filePath, loadedArena);
+  EXPECT_TRUE(x0.isApprox(problem.x0));
+  ASSERT_EQ(loadedArena.size(), arena.size());
+  for (int k = 0; k <= arena.numStages(); ++k) {
+    if (k < arena.numStages()) {
+      EXPECT_TRUE(loadedArena.getDynamics(k).dfdx.isApprox(arena.getDynamics(k).dfdx));
+      EXPECT_TRUE(loadedArena.getDynamics(k).f.isApprox(arena.getDynamics(k).f));
+    }
+    EXPECT_DOUBLE_EQ(loadedArena.c(k), arena.c(k));
+    EXPECT_TRUE(loadedArena.getCost(k).dfdxx.isApprox(arena.getCost(k).dfdxx));
+    EXPECT_TRUE(loadedArena.getConstraints(k).dfdu.isApprox(arena.getConstraints(k).dfdu));
+  }
+
+  EXPECT_THROW(ocs2::lq_solver::loadLqProblem("/tmp/ocs2_testLqProblemRecording_missing.bin", loadedArena), std::runtime_error);
+}
+
+TEST(LqSolverType, names) {
+  for (const auto type : {ocs2::LqSolverType::HPIPM, ocs2::LqSolverType::RICCATI, ocs2::LqSolverType::PARALLEL_RICCATI}) {
+    EXPECT_EQ(ocs2::lq_solver::fromString(ocs2::lq_solver::toString(type)), type);
+  }
+  EXPECT_THROW(ocs2::lq_solver::fromString("QPOASES"), std::runtime_error);
+}
@@ -0,0 +1,142 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/dynamics/LinearSystemDynamics.h>
+#include <ocs2_oc/multiple_shooting/MoveBlocking.h>
+
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+using namespace ocs2;
+
+TEST(test_move_blocking, numSubsteps) {
+  ASSERT_EQ(multiple_shooting::numSubsteps(0.05, 0.1), 1);
+  ASSERT_EQ(multiple_shooting::numSubsteps(0.1, 0.1), 1);
+  ASSERT_EQ(multiple_shooting::numSubsteps(0.3, 0.1), 3);  // 0.3 / 0.1 is not exactly 3
+  ASSERT_EQ(multiple_shooting::numSubsteps(0.31, 0.1), 4);
+}
+
+TEST(test_move_blocking, substeppedDiscretization) {
+  constexpr int nx = 3;
+  constexpr int nu = 2;
+  const auto linearDynamics = getRandomDynamics(nx, nu);
+  LinearSystemDynamics system(linearDynamics.dfdx, linearDynamics.dfdu);
+
+  const scalar_t maxStepSize = 0.1;
+  const auto discretizer = selectDynamicsDiscretization(SensitivityIntegratorType::RK4);
+  const auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+  const auto substeppedDiscretizer = multiple_shooting::selectSubsteppedDynamicsDiscretization(SensitivityIntegratorType::RK4, maxStepSize);
+  const auto substeppedSensitivityDiscretizer =
+      multiple_shooting::selectSubsteppedDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4, maxStepSize);
+
+  const scalar_t t = 0.5;
+  const vector_t x = vector_t::Random(nx);
+  const vector_t u = vector_t::Random(nu);
+
+  // Short intervals are integrated in one step
+  ASSERT_TRUE(substeppedDiscretizer(system, t, x, u, 0.05).isApprox(discretizer(system, t, x, u, 0.05)));
+
+  // Long intervals are integrated with the held input in steps of at most maxStepSize
+  const scalar_t dt = 0.25;
+  vector_t xNext = x;
+  matrix_t A = matrix_t::Identity(nx, nx);
+  matrix_t B = matrix_t::Zero(nx, nu);
+  for (int j = 0; j < 3; ++j) {
+    const auto step = sensitivityDiscretizer(system, t + j * dt / 3.0, xNext, u, dt / 3.0);
+    xNext = step.f;
+    A = step.dfdx * A;
+    B = step.dfdx * B + step.dfdu;
+  }
+  const auto blockDynamics = substeppedSensitivityDiscretizer(system, t, x, u, dt);
+  ASSERT_TRUE(substeppedDiscretizer(system, t, x, u, dt).isApprox(xNext, 1e-12));
+  ASSERT_TRUE(blockDynamics.f.isApprox(xNext, 1e-12));
+  ASSERT_TRUE(blockDynamics.dfdx.isApprox(A, 1e-12));
+  ASSERT_TRUE(blockDynamics.dfdu.isApprox(B, 1e-12));
+}
+
+TEST(test_move_blocking, blockTimeDiscretization) {
+  const auto time = timeDiscretizationWithEvents(0.0, 1.0, 0.1, {0.55});
+  //  timeDiscretization = {0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.55, 0.55, 0.65, 0.75, 0.85, 0.95, 1.0}
+  ASSERT_EQ(time.size(), 13);
+
+  // A block length of one does not change the discretization
+  ASSERT_EQ(multiple_shooting::blockTimeDiscretization(time, 0.2, 1).size(), time.size());
+
+  const auto blockedTime = multiple_shooting::blockTimeDiscretization(time, 0.2, 3);
+  //  blockedTime = {0.0, 0.1, 0.2, 0.5, 0.55, 0.55, 0.85, 1.0}
+  ASSERT_EQ(blockedTime.size(), 8);
+  ASSERT_DOUBLE_EQ(blockedTime[1].time, 0.1);
+  ASSERT_DOUBLE_EQ(blockedTime[2].time, 0.2);
+  ASSERT_DOUBLE_EQ(blockedTime[3].time, 0.5);
+  ASSERT_EQ(blockedTime[4].event, AnnotatedTime::Event::PreEvent);
+  ASSERT_EQ(blockedTime[5].event, AnnotatedTime::Event::PostEvent);
+  ASSERT_DOUBLE_EQ(blockedTime[6].time, 0.85);
+  ASSERT_EQ(blockedTime[7].time, 1.0);
+}
+
+TEST(test_move_blocking, expandBlockedSolution) {
+  constexpr int nx = 3;
+  constexpr int nu = 2;
+  const auto linearDynamics = getRandomDynamics(nx, nu);
+  LinearSystemDynamics system(linearDynamics.dfdx, linearDynamics.dfdu);
+
+  // {0.0, 0.1, 0.4, 0.5}, the second interval holds the input over 3 steps
+  const scalar_t dt = 0.1;
+  const auto blockedTime = multiple_shooting::blockTimeDiscretization(timeDiscretizationWithEvents(0.0, 0.5, dt, {}), 0.1, 3);
+  ASSERT_EQ(blockedTime.size(), 4);
+
+  vector_array_t x{vector_t::Random(nx), vector_t::Random(nx), vector_t::Random(nx), vector_t::Random(nx)};
+  vector_array_t u{vector_t::Random(nu), vector_t::Random(nu), vector_t::Random(nu)};
+  matrix_array_t K{matrix_t::Random(nu, nx), matrix_t::Random(nu, nx), matrix_t::Random(nu, nx)};
+  const auto blockedX = x;
+  const auto blockedU = u;
+
+  const auto time = multiple_shooting::expandBlockedSolution(system, SensitivityIntegratorType::RK4, dt, blockedTime, x, u, &K);
+  ASSERT_EQ(time.size(), 6);
+  ASSERT_EQ(x.size(), 6);
+  ASSERT_EQ(u.size(), 5);
+  ASSERT_EQ(K.size(), 5);
+  for (int i = 0; i < time.size(); ++i) {
+    ASSERT_NEAR(time[i].time, i * dt, 1e-12);
+  }
+
+  // The nodes of the blocked solution are kept, the new nodes hold the input and feedback of the block
+  const auto discretizer = selectDynamicsDiscretization(SensitivityIntegratorType::RK4);
+  ASSERT_TRUE(x[1].isApprox(blockedX[1]));
+  ASSERT_TRUE(x[2].isApprox(discretizer(system, 0.1, blockedX[1], blockedU[1], dt), 1e-12));
+  ASSERT_TRUE(x[3].isApprox(discretizer(system, 0.2, x[2], blockedU[1], dt), 1e-12));
+  ASSERT_TRUE(x[4].isApprox(blockedX[2]));
+  ASSERT_TRUE(x[5].isApprox(blockedX[3]));
+  for (int i = 1; i < 4; ++i) {
+    ASSERT_TRUE(u[i].isApprox(blockedU[1]));
+    ASSERT_TRUE(K[i].isApprox(K[1]));
+  }
+  ASSERT_TRUE(u[4].isApprox(blockedU[2]));
+}
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include "ocs2_oc/multiple_shooting/Helpers.h"
 #include "ocs2_oc/oc_data/TimeDiscretization.h"
 
 using namespace ocs2;
@@ -127,4 +128,109 @@ TEST(test_time_discretization, withEvents) {
   ASSERT_EQ(time[12].event, AnnotatedTime::Event::PreEvent);
   ASSERT_EQ(time[13].event, AnnotatedTime::Event::PostEvent);
   ASSERT_EQ(time[14].event, AnnotatedTime::Event::None);
-}
\ No newline at end of file
+}
+TEST(test_time_discretization, geometric) {
+  scalar_t initTime = 0.0;
+  scalar_t finalTime = 1.5;
+  scalar_t dt = 0.1;
+  scalar_t growthRate = 2.0;
+  scalar_t dtMax = 0.4;
+  scalar_array_t eventTimes{};
+
+  auto time = geometricTimeDiscretizationWithEvents(initTime, finalTime, dt, growthRate, dtMax, eventTimes);
+  //  timeDiscretization = {0.0, 0.1, 0.3, 0.7, 1.1, 1.5}
+  ASSERT_EQ(time.size(), 6);
+  ASSERT_EQ(time[0].time, initTime);
+  ASSERT_DOUBLE_EQ(time[1].time, initTime + dt);  // The first interval is the one of the uniform discretization
+  ASSERT_DOUBLE_EQ(time[2].time, 0.3);
+  ASSERT_DOUBLE_EQ(time[3].time, 0.7);
+  ASSERT_DOUBLE_EQ(time[4].time, 1.1);  // Limited by dtMax
+  ASSERT_EQ(time[5].time, finalTime);
+  ASSERT_LT(time.size(), timeDiscretizationWithEvents(initTime, finalTime, dt, eventTimes).size());
+
+  // A growth rate of 1 is the uniform discretization
+  const auto uniformTime = timeDiscretizationWithEvents(initTime, finalTime, dt, eventTimes);
+  const auto geometricTime = geometricTimeDiscretizationWithEvents(initTime, finalTime, dt, 1.0, dtMax, eventTimes);
+  ASSERT_EQ(uniformTime.size(), geometricTime.size());
+  for (size_t i = 0; i < uniformTime.size(); i++) {
+    ASSERT_EQ(uniformTime[i].time, geometricTime[i].time);
+  }
+}
+
+TEST(test_time_discretization, geometricWithEvents) {
+  scalar_t initTime = 0.0;
+  scalar_t finalTime = 1.0;
+  scalar_t dt = 0.1;
+  scalar_t growthRate = 2.0;
+  scalar_t dtMax = 1.0;
+  scalar_array_t eventTimes{0.2};
+
+  auto time = geometricTimeDiscretizationWithEvents(initTime, finalTime, dt, growthRate, dtMax, eventTimes);
+  //  timeDiscretization = {0.0, 0.1, 0.2, 0.2, 0.6, 1.0}
+  ASSERT_EQ(time.size(), 6);
+  ASSERT_DOUBLE_EQ(time[1].time, 0.1);
+  ASSERT_EQ(time[2].time, eventTimes[0]);
+  ASSERT_EQ(time[3].time, eventTimes[0]);
+  ASSERT_DOUBLE_EQ(time[4].time, 0.6);
+  ASSERT_EQ(time[5].time, finalTime);
+
+  // Events
+  ASSERT_EQ(time[2].event, AnnotatedTime::Event::PreEvent);
+  ASSERT_EQ(time[3].event, AnnotatedTime::Event::PostEvent);
+  ASSERT_EQ(time[4].event, AnnotatedTime::Event::None);
+}
+
+TEST(test_time_discretization, refinement) {
+  scalar_t initTime = 0.0;
+  scalar_t finalTime = 1.0;
+  scalar_t dt = 0.25;
+  scalar_array_t eventTimes{0.5};
+
+  // timeDiscretization = {0.0, 0.25, 0.5, 0.5, 0.75, 1.0}
+  const auto time = timeDiscretizationWithEvents(initTime, finalTime, dt, eventTimes);
+  ASSERT_EQ(time.size(), 6);
+
+  // The error estimate is given on a shifted grid, large on [0.3, 0.9)
+  const scalar_array_t errorTime{0.1, 0.3, 0.6, 0.9, 1.1};
+  const scalar_array_t errors{0.0, 1.0, 2.0, 0.0};
+  const auto refinedTime = refineTimeDiscretization(time, errorTime, errors, 0.5);
+
+  // The intervals with midpoints 0.375, 0.625 and 0.875 are split, the event interval is kept
+  ASSERT_EQ(refinedTime.size(), 9);
+  ASSERT_DOUBLE_EQ(refinedTime[2].time, 0.375);
+  ASSERT_EQ(refinedTime[3].event, AnnotatedTime::Event::PreEvent);
+  ASSERT_EQ(refinedTime[4].event, AnnotatedTime::Event::PostEvent);
+  ASSERT_DOUBLE_EQ(refinedTime[5].time, 0.625);
+  ASSERT_DOUBLE_EQ(refinedTime[6].time, 0.75);
+  ASSERT_DOUBLE_EQ(refinedTime[7].time, 0.875);
+  ASSERT_EQ(refinedTime[7].event, AnnotatedTime::Event::None);
+  ASSERT_EQ(refinedTime[8].time, finalTime);
+
+  // Without an error estimate the discretization is not changed
+  ASSERT_EQ(refineTimeDiscretization(time, {}, {}, 0.5).size(), time.size());
+}
+
+TEST(test_time_discretization, refinementWithDynamicsDefects) {
+  const auto time = timeDiscretizationWithEvents(0.0, 1.0, 0.25, {0.5});
+
+  // A previous solution on the same grid with a defect in the last interval
+  PrimalSolution primalSolution;
+  primalSolution.timeTrajectory_ = toTime(time);
+  primalSolution.postEventIndices_ = toPostEventIndices(time);
+  ProblemMetrics problemMetrics;
+  problemMetrics.intermediates.resize(4);
+  for (auto& metrics : problemMetrics.intermediates) {
+    metrics.dynamicsViolation = vector_t::Zero(2);
+  }
+  problemMetrics.intermediates.back().dynamicsViolation << 0.0, 1e-2;
+  problemMetrics.preJumps.resize(1);
+  problemMetrics.preJumps.front().dynamicsViolation = vector_t::Ones(2);  // The jump map defect does not refine the grid
+
+  const auto refinedTime = multiple_shooting::refineTimeDiscretization(time, primalSolution, problemMetrics, 1e-3);
+  ASSERT_EQ(refinedTime.size(), time.size() + 1);
+  ASSERT_DOUBLE_EQ(refinedTime[5].time, 0.875);
+
+  // Metrics that do not match the solution are ignored
+  problemMetrics.intermediates.pop_back();
+  ASSERT_EQ(multiple_shooting::refineTimeDiscretization(time, primalSolution, problemMetrics, 1e-3).size(), time.size());
+}
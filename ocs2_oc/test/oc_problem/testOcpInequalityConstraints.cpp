@@ -0,0 +1,143 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "ocs2_oc/oc_problem/OcpInequalityConstraints.h"
+
+using namespace ocs2;
+
+namespace {
+constexpr scalar_t inf = std::numeric_limits<scalar_t>::infinity();
+
+/** Checks that a split reproduces the original constraints h + dhdx * dx + dhdu * du >= 0 at a given point */
+void checkFeasibilityAgreement(const NodeInequalityConstraints& split, const VectorFunctionLinearApproximation& stateIneq,
+                               const VectorFunctionLinearApproximation& stateInputIneq, const vector_t& dx, const vector_t& du) {
+  bool original = true;
+  if (stateIneq.f.size() > 0) {
+    original = original && ((stateIneq.f + stateIneq.dfdx * dx).array() >= 0.0).all();
+  }
+  if (stateInputIneq.f.size() > 0) {
+    original = original && ((stateInputIneq.f + stateInputIneq.dfdx * dx + stateInputIneq.dfdu * du).array() >= 0.0).all();
+  }
+
+  bool result = ((split.C * dx + split.D * du - split.lg).array() >= 0.0).all();
+  for (int i = 0; i < split.idxbx.size(); ++i) {
+    result = result && split.lbx(i) <= dx(split.idxbx[i]) && dx(split.idxbx[i]) <= split.ubx(i);
+  }
+  for (int i = 0; i < split.idxbu.size(); ++i) {
+    result = result && split.lbu(i) <= du(split.idxbu[i]) && du(split.idxbu[i]) <= split.ubu(i);
+  }
+  ASSERT_EQ(original, result);
+}
+}  // namespace
+
+TEST(testOcpInequalityConstraints, detectSimpleBounds) {
+  const int nx = 3;
+  const int nu = 2;
+
+  // State constraints: -1 <= x1 <= 2, x0 + x2 >= 0
+  VectorFunctionLinearApproximation stateIneq(3, nx, 0);
+  stateIneq.dfdx << 0.0, 1.0, 0.0,  //
+      0.0, -1.0, 0.0,               //
+      1.0, 0.0, 1.0;
+  stateIneq.f << 1.0, 2.0, 0.0;
+
+  // State-input constraints: 2 * u1 >= -1, u1 <= 0.25 (scaled), x2 >= -3, u0 + x0 >= 0
+  VectorFunctionLinearApproximation stateInputIneq(4, nx, nu);
+  stateInputIneq.dfdx << 0.0, 0.0, 0.0,  //
+      0.0, 0.0, 0.0,                     //
+      0.0, 0.0, 1.0,                     //
+      1.0, 0.0, 0.0;
+  stateInputIneq.dfdu << 0.0, 2.0,  //
+      0.0, -4.0,                    //
+      0.0, 0.0,                     //
+      1.0, 0.0;
+  stateInputIneq.f << 1.0, 1.0, 3.0, 0.0;
+
+  NodeInequalityConstraints split;
+  splitInequalityConstraints(nx, nu, stateIneq, stateInputIneq, true, split);
+
+  ASSERT_EQ(split.idxbx, std::vector<int>({1, 2}));
+  EXPECT_DOUBLE_EQ(split.lbx(0), -1.0);
+  EXPECT_DOUBLE_EQ(split.ubx(0), 2.0);
+  EXPECT_DOUBLE_EQ(split.lbx(1), -3.0);
+  EXPECT_EQ(split.ubx(1), inf);
+
+  ASSERT_EQ(split.idxbu, std::vector<int>({1}));
+  EXPECT_DOUBLE_EQ(split.lbu(0), -0.5);
+  EXPECT_DOUBLE_EQ(split.ubu(0), 0.25);
+
+  ASSERT_EQ(split.numGeneralConstraints(), 2);
+  ASSERT_EQ(split.C.cols(), nx);
+  ASSERT_EQ(split.D.cols(), nu);
+
+  // Compare the feasible set on random points
+  for (int i = 0; i < 100; ++i) {
+    const vector_t dx = 3.0 * vector_t::Random(nx);
+    const vector_t du = vector_t::Random(nu);
+    checkFeasibilityAgreement(split, stateIneq, stateInputIneq, dx, du);
+  }
+
+  // Without detection, all constraints are general
+  splitInequalityConstraints(nx, nu, stateIneq, stateInputIneq, false, split);
+  ASSERT_TRUE(split.idxbx.empty());
+  ASSERT_TRUE(split.idxbu.empty());
+  ASSERT_EQ(split.numGeneralConstraints(), 7);
+  for (int i = 0; i < 100; ++i) {
+    const vector_t dx = 3.0 * vector_t::Random(nx);
+    const vector_t du = vector_t::Random(nu);
+    checkFeasibilityAgreement(split, stateIneq, stateInputIneq, dx, du);
+  }
+}
+
+TEST(testOcpInequalityConstraints, emptyConstraints) {
+  const int nx = 3;
+  const int nu = 2;
+  NodeInequalityConstraints split;
+  splitInequalityConstraints(nx, nu, VectorFunctionLinearApproximation(), VectorFunctionLinearApproximation(), true, split);
+  ASSERT_TRUE(split.idxbx.empty());
+  ASSERT_TRUE(split.idxbu.empty());
+  ASSERT_EQ(split.numGeneralConstraints(), 0);
+  ASSERT_EQ(split.C.cols(), nx);
+  ASSERT_EQ(split.D.cols(), nu);
+
+  OcpSize ocpSize(2, nx, nu);
+  ocpSize.numEqConstraints = {1, 1, 0};
+  std::vector<NodeInequalityConstraints> constraints(3, split);
+  constraints[1].idxbu = {0};
+  constraints[1].lg.resize(2);
+  addInequalityConstraintsSize(constraints, ocpSize);
+  ASSERT_EQ(ocpSize.numInputBoxConstraints, std::vector<int>({0, 1, 0}));
+  ASSERT_EQ(ocpSize.numStateBoxConstraints, std::vector<int>({0, 0, 0}));
+  ASSERT_EQ(ocpSize.numIneqConstraints, std::vector<int>({0, 2, 0}));
+  ASSERT_EQ(ocpSize.numEqConstraints, std::vector<int>({1, 1, 0}));
+}
@@ -0,0 +1,153 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "ocs2_oc/oc_problem/OcpLqArena.h"
+
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+class OcpLqArenaTest : public testing::Test {
+ protected:
+  // x_0, x_1, ... x_{N - 1}, X_{N}
+  static constexpr int N_ = 10;  // numStages
+  static constexpr int nx_ = 4;
+  static constexpr int nu_ = 3;
+  static constexpr int nc_ = 2;
+
+  OcpLqArenaTest() {
+    srand(0);
+
+    for (int i = 0; i < N_; i++) {
+      dynamicsArray.push_back(ocs2::getRandomDynamics(nx_, nu_));
+      costArray.push_back(ocs2::getRandomCost(nx_, nu_));
+      constraintsArray.push_back(ocs2::getRandomConstraints(nx_, nu_, nc_));
+    }
+    costArray.push_back(ocs2::getRandomCost(nx_, 0));
+    constraintsArray.push_back(ocs2::getRandomConstraints(nx_, 0, nc_));
+
+    ocpSize_ = ocs2::extractSizesFromProblem(dynamicsArray, costArray, &constraintsArray);
+  }
+
+  void fill(ocs2::OcpLqArena& arena) const {
+    arena.reserve(N_, nx_, nu_, nc_);
+    for (int i = 0; i < N_; i++) {
+      arena.setDynamics(i, dynamicsArray[i]);
+      arena.setCost(i, costArray[i]);
+      arena.setConstraints(i, constraintsArray[i]);
+    }
+    arena.setCost(N_, costArray[N_]);
+    arena.setConstraints(N_, constraintsArray[N_]);
+  }
+
+  ocs2::OcpSize ocpSize_;
+  std::vector<ocs2::VectorFunctionLinearApproximation> dynamicsArray;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> costArray;
+  std::vector<ocs2::VectorFunctionLinearApproximation> constraintsArray;
+};
+
+constexpr int OcpLqArenaTest::N_;
+constexpr int OcpLqArenaTest::nx_;
+constexpr int OcpLqArenaTest::nu_;
+constexpr int OcpLqArenaTest::nc_;
+
+TEST_F(OcpLqArenaTest, roundTrip) {
+  ocs2::OcpLqArena arena;
+  fill(arena);
+
+  EXPECT_TRUE(arena.size() == ocpSize_);
+  for (int i = 0; i < N_; i++) {
+    const auto dynamics = arena.getDynamics(i);
+    EXPECT_TRUE(dynamics.dfdx.isApprox(dynamicsArray[i].dfdx));
+    EXPECT_TRUE(dynamics.dfdu.isApprox(dynamicsArray[i].dfdu));
+    EXPECT_TRUE(dynamics.f.isApprox(dynamicsArray[i].f));
+
+    const auto cost = arena.getCost(i);
+    EXPECT_DOUBLE_EQ(cost.f, costArray[i].f);
+    EXPECT_TRUE(cost.dfdxx.isApprox(costArray[i].dfdxx));
+    EXPECT_TRUE(cost.dfdux.isApprox(costArray[i].dfdux));
+    EXPECT_TRUE(cost.dfduu.isApprox(costArray[i].dfduu));
+    EXPECT_TRUE(cost.dfdx.isApprox(costArray[i].dfdx));
+    EXPECT_TRUE(cost.dfdu.isApprox(costArray[i].dfdu));
+
+    const auto constraints = arena.getConstraints(i);
+    EXPECT_TRUE(constraints.dfdx.isApprox(constraintsArray[i].dfdx));
+    EXPECT_TRUE(constraints.dfdu.isApprox(constraintsArray[i].dfdu));
+    EXPECT_TRUE(constraints.f.isApprox(constraintsArray[i].f));
+  }
+  EXPECT_TRUE(arena.Q(N_).isApprox(costArray[N_].dfdxx));
+  EXPECT_TRUE(arena.C(N_).isApprox(constraintsArray[N_].dfdx));
+  EXPECT_EQ(arena.r(N_).size(), 0);
+}
+
+TEST_F(OcpLqArenaTest, alignment) {
+  ocs2::OcpLqArena arena;
+  fill(arena);
+
+  const auto isAligned = [](const ocs2::scalar_t* ptr) { return reinterpret_cast<std::uintptr_t>(ptr) % ocs2::OcpLqArena::alignment == 0; };
+  for (int i = 0; i < N_; i++) {
+    EXPECT_TRUE(isAligned(arena.A(i).data()));
+    EXPECT_TRUE(isAligned(arena.B(i).data()));
+    EXPECT_TRUE(isAligned(arena.b(i).data()));
+    EXPECT_TRUE(isAligned(arena.Q(i).data()));
+    EXPECT_TRUE(isAligned(arena.S(i).data()));
+    EXPECT_TRUE(isAligned(arena.R(i).data()));
+    EXPECT_TRUE(isAligned(arena.q(i).data()));
+    EXPECT_TRUE(isAligned(arena.r(i).data()));
+    EXPECT_TRUE(isAligned(arena.C(i).data()));
+    EXPECT_TRUE(isAligned(arena.D(i).data()));
+    EXPECT_TRUE(isAligned(arena.e(i).data()));
+  }
+}
+
+TEST_F(OcpLqArenaTest, reuseMemory) {
+  ocs2::OcpLqArena arena(ocpSize_);
+  fill(arena);
+  const auto capacity = arena.capacity();
+  const auto* data = arena.A(0).data();
+
+  // The same and a smaller problem reuse the buffer
+  fill(arena);
+  EXPECT_EQ(arena.capacity(), capacity);
+  EXPECT_EQ(arena.A(0).data(), data);
+  arena.reserve(N_ / 2, nx_, nu_ - 1, 0);
+  EXPECT_EQ(arena.capacity(), capacity);
+  EXPECT_EQ(arena.numStages(), N_ / 2);
+  EXPECT_EQ(arena.size().numEqConstraints, std::vector<int>(N_ / 2 + 1, 0));
+}
+
+TEST_F(OcpLqArenaTest, exceedCapacity) {
+  ocs2::OcpLqArena arena;
+  arena.reserve(N_, nx_, nu_ - 1, 0);
+  EXPECT_THROW(arena.setDynamics(0, dynamicsArray[0]), std::runtime_error);
+  EXPECT_THROW(arena.setConstraints(0, constraintsArray[0]), std::runtime_error);
+  EXPECT_THROW(arena.setCost(N_ + 1, costArray[0]), std::runtime_error);
+}
@@ -27,6 +27,8 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <numeric>
+
 #include <gtest/gtest.h>
 
 #include <ocs2_core/thread_support/ThreadPool.h>
@@ -214,4 +216,119 @@ TEST_F(PreconditionTest, descaleSolution) {
   EXPECT_TRUE(packedSolutionNew.isApprox(packedSolution)) << std::setprecision(6) << "DescaledSolution: \n"
                                                           << packedSolutionNew.transpose() << "\nIt should be \n"
                                                           << packedSolution.transpose();
-}
\ No newline at end of file
+}
+TEST_F(PreconditionTest, warmStartedOcpDataInPlaceInParallel) {
+  ocs2::ThreadPool threadPool(5, 99);
+
+  Eigen::SparseMatrix<ocs2::scalar_t> H_src;
+  ocs2::vector_t h_src;
+  ocs2::getCostMatrixSparse(ocpSize_, x0, costArray, H_src, h_src);
+  Eigen::SparseMatrix<ocs2::scalar_t> G_src;
+  ocs2::vector_t g_src;
+  ocs2::getConstraintMatrixSparse(ocpSize_, x0, dynamicsArray, nullptr, nullptr, G_src, g_src);
+
+  auto stack = [](const ocs2::vector_array_t& array) {
+    ocs2::vector_t stacked(std::accumulate(array.begin(), array.end(), 0, [](int n, const ocs2::vector_t& v) { return n + v.size(); }));
+    int curRow = 0;
+    for (const auto& v : array) {
+      stacked.segment(curRow, v.size()) = v;
+      curRow += v.size();
+    }
+    return stacked;
+  };
+
+  // Reference from scratch
+  auto dynamicsCold = dynamicsArray;
+  auto costCold = costArray;
+  ocs2::vector_array_t DCold, ECold, scalingVectorsCold;
+  ocs2::scalar_t cCold;
+  ocs2::precondition::ocpDataInPlaceInParallel(threadPool, x0, ocpSize_, 5, dynamicsCold, costCold, DCold, ECold, scalingVectorsCold,
+                                               cCold);
+
+  // Warm start with the reference factors and without correction reproduces the reference
+  {
+    auto dynamics = dynamicsArray;
+    auto cost = costArray;
+    ocs2::vector_array_t D, E, scalingVectors;
+    ocs2::scalar_t c;
+    ocs2::precondition::ocpDataInPlaceInParallel(threadPool, x0, ocpSize_, 0, DCold, ECold, cCold, dynamics, cost, D, E, scalingVectors, c);
+    EXPECT_TRUE(stack(D).isApprox(stack(DCold)));
+    EXPECT_TRUE(stack(E).isApprox(stack(ECold)));
+    EXPECT_DOUBLE_EQ(c, cCold);
+    EXPECT_TRUE(stack(scalingVectors).isApprox(stack(scalingVectorsCold)));
+    for (int i = 0; i < N_; i++) {
+      EXPECT_TRUE(dynamics[i].dfdx.isApprox(dynamicsCold[i].dfdx));
+      EXPECT_TRUE(dynamics[i].dfdu.isApprox(dynamicsCold[i].dfdu));
+      EXPECT_TRUE(cost[i].dfduu.isApprox(costCold[i].dfduu));
+    }
+  }
+
+  // Correcting iterations keep the scaled data consistent with the output factors
+  {
+    auto dynamics = dynamicsArray;
+    auto cost = costArray;
+    ocs2::vector_array_t D, E, scalingVectors;
+    ocs2::scalar_t c;
+    ocs2::precondition::ocpDataInPlaceInParallel(threadPool, x0, ocpSize_, 1, DCold, ECold, cCold, dynamics, cost, D, E, scalingVectors, c);
+
+    const ocs2::vector_t DStacked = stack(D);
+    const ocs2::vector_t EStacked = stack(E);
+    const Eigen::SparseMatrix<ocs2::scalar_t> H_ref = c * DStacked.asDiagonal() * H_src * DStacked.asDiagonal();
+    const ocs2::vector_t h_ref = c * DStacked.asDiagonal() * h_src;
+    const Eigen::SparseMatrix<ocs2::scalar_t> G_ref = EStacked.asDiagonal() * G_src * DStacked.asDiagonal();
+    const ocs2::vector_t g_ref = EStacked.asDiagonal() * g_src;
+
+    Eigen::SparseMatrix<ocs2::scalar_t> H_scaledData;
+    ocs2::vector_t h_scaledData;
+    ocs2::getCostMatrixSparse(ocpSize_, x0, cost, H_scaledData, h_scaledData);
+    Eigen::SparseMatrix<ocs2::scalar_t> G_scaledData;
+    ocs2::vector_t g_scaledData;
+    ocs2::getConstraintMatrixSparse(ocpSize_, x0, dynamics, nullptr, &scalingVectors, G_scaledData, g_scaledData);
+    EXPECT_TRUE(H_ref.isApprox(H_scaledData));  // H
+    EXPECT_TRUE(h_ref.isApprox(h_scaledData));  // h
+    EXPECT_TRUE(G_ref.isApprox(G_scaledData));  // G
+    EXPECT_TRUE(g_ref.isApprox(g_scaledData));  // g
+  }
+
+  // Initial factors of the wrong size are ignored
+  {
+    auto dynamics = dynamicsArray;
+    auto cost = costArray;
+    ocs2::vector_array_t D, E, scalingVectors;
+    ocs2::scalar_t c;
+    ocs2::precondition::ocpDataInPlaceInParallel(threadPool, x0, ocpSize_, 5, ocs2::vector_array_t(), ocs2::vector_array_t(), 1.0, dynamics,
+                                                 cost, D, E, scalingVectors, c);
+    EXPECT_TRUE(stack(D).isApprox(stack(DCold)));
+    EXPECT_TRUE(stack(E).isApprox(stack(ECold)));
+    EXPECT_DOUBLE_EQ(c, cCold);
+  }
+}
+
+TEST(PreconditionShiftTest, shiftScalingFactors) {
+  const ocs2::scalar_array_t time{0.0, 0.1, 0.2, 0.3};
+  ocs2::vector_array_t D(6), E(3);
+  for (int k = 0; k < 3; k++) {
+    D[2 * k] = ocs2::vector_t::Constant(1, 10.0 * k + 5.0);
+    D[2 * k + 1] = ocs2::vector_t::Constant(2, 10.0 * k + 1.0);
+    E[k] = ocs2::vector_t::Constant(2, 10.0 * k + 2.0);
+  }
+
+  // Shifted by less than half an interval, then beyond the old horizon
+  const ocs2::scalar_array_t newTime{0.04, 0.14, 0.24, 0.34, 0.44};
+  ocs2::vector_array_t DShifted, EShifted;
+  ocs2::precondition::shiftScalingFactors(time, D, E, newTime, DShifted, EShifted);
+  ASSERT_EQ(DShifted.size(), 8);
+  ASSERT_EQ(EShifted.size(), 4);
+  const std::vector<int> expectedStage{0, 1, 2, 2};
+  for (int k = 0; k < 4; k++) {
+    EXPECT_TRUE(DShifted[2 * k].isApprox(D[2 * expectedStage[k]])) << "stage " << k;
+    EXPECT_TRUE(DShifted[2 * k + 1].isApprox(D[2 * expectedStage[k] + 1])) << "stage " << k;
+    EXPECT_TRUE(EShifted[k].isApprox(E[expectedStage[k]])) << "stage " << k;
+  }
+
+  // Shifted by more than half an interval
+  const ocs2::scalar_array_t laterTime{0.07, 0.17};
+  ocs2::precondition::shiftScalingFactors(time, D, E, laterTime, DShifted, EShifted);
+  ASSERT_EQ(EShifted.size(), 1);
+  EXPECT_TRUE(EShifted[0].isApprox(E[1]));
+}
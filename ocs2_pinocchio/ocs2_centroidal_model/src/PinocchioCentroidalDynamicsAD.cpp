@@ -109,9 +109,21 @@ VectorFunctionLinearApproximation PinocchioCentroidalDynamicsAD::getLinearApprox
   const vector_t stateInput = (vector_t(state.rows() + input.rows()) << state, input).finished();
   VectorFunctionLinearApproximation approx;
   approx.f = systemFlowMapCppAdInterfacePtr_->getFunctionValue(stateInput);
-  const matrix_t dynamicsJacobian = systemFlowMapCppAdInterfacePtr_->getJacobian(stateInput);
-  approx.dfdx = dynamicsJacobian.leftCols(state.rows());
-  approx.dfdu = dynamicsJacobian.rightCols(input.rows());
+
+  // Most of the centroidal Jacobian is structurally zero. Only its nonzeros are evaluated and scattered into the state and input blocks.
+  const auto dynamicsJacobian = systemFlowMapCppAdInterfacePtr_->getSparseJacobian(stateInput);
+  const int stateDim = state.rows();
+  approx.dfdx.setZero(dynamicsJacobian.rows(), stateDim);
+  approx.dfdu.setZero(dynamicsJacobian.rows(), input.rows());
+  for (int row = 0; row < dynamicsJacobian.outerSize(); ++row) {
+    for (CppAdInterface::sparse_matrix_t::InnerIterator it(dynamicsJacobian, row); it; ++it) {
+      if (it.col() < stateDim) {
+        approx.dfdx(row, it.col()) = it.value();
+      } else {
+        approx.dfdu(row, it.col() - stateDim) = it.value();
+      }
+    }
+  }
   return approx;
 }
 
@@ -32,6 +32,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <pinocchio/multibody/data.hpp>
 #include <pinocchio/multibody/model.hpp>
 
+#include <ocs2_core/automatic_differentiation/CppAdInterface.h>
+#include <ocs2_core/misc/Benchmark.h>
+
 #include "ocs2_centroidal_model/CentroidalModelRbdConversions.h"
 #include "ocs2_centroidal_model/FactoryFunctions.h"
 #include "ocs2_centroidal_model/ModelHelperFunctions.h"
@@ -145,6 +148,65 @@ TEST_P(TestAnymalCentroidalModel, rbd_conversion) {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_P(TestAnymalCentroidalModel, sparseFlowMapJacobianBenchmark) {
+  const CentroidalModelType type = GetParam();
+  const auto info = createInfo(type);
+
+  // Generates the flow map library
+  const std::string modelName = "TestAnymal" + toString(type) + "Ad";
+  PinocchioCentroidalDynamicsAD anymalDynamicsAd(*pinocchioInterfacePtr, info, modelName);
+
+  // Second interface on the same library to compare the dense and the sparse Jacobian
+  auto unusedFunction = [](const ad_vector_t& x, ad_vector_t& y) { y = x; };
+  CppAdInterface flowMapInterface(unusedFunction, info.stateDim + info.inputDim, modelName + "_systemFlowMap", "/tmp/ocs2");
+  flowMapInterface.loadModels(false);
+
+  const size_t numRows = info.stateDim;
+  const size_t numCols = info.stateDim + info.inputDim;
+  const size_t nnz = flowMapInterface.getNumberOfJacobianNonZeros();
+  ASSERT_LT(nnz, numRows * numCols);
+
+  benchmark::RepeatedTimer denseTimer;
+  benchmark::RepeatedTimer sparseTimer;
+  benchmark::RepeatedTimer denseProductTimer;
+  benchmark::RepeatedTimer sparseProductTimer;
+  for (size_t i = 0; i < numTests; i++) {
+    const vector_t stateInput = 10.0 * vector_t::Random(numCols);
+    const vector_t direction = vector_t::Random(numCols);
+
+    denseTimer.startTimer();
+    const matrix_t denseJacobian = flowMapInterface.getJacobian(stateInput);
+    denseTimer.endTimer();
+
+    sparseTimer.startTimer();
+    const auto sparseJacobian = flowMapInterface.getSparseJacobian(stateInput);
+    sparseTimer.endTimer();
+
+    // Directional derivative as it appears in the LQ assembly
+    denseProductTimer.startTimer();
+    const vector_t denseProduct = denseJacobian * direction;
+    denseProductTimer.endTimer();
+
+    sparseProductTimer.startTimer();
+    const vector_t sparseProduct = sparseJacobian * direction;
+    sparseProductTimer.endTimer();
+
+    EXPECT_TRUE(matrix_t(sparseJacobian).isApprox(denseJacobian, tol));
+    EXPECT_TRUE(sparseProduct.isApprox(denseProduct, tol));
+  }
+
+  std::cerr << "\n[" << toString(type) << "] flow map Jacobian: " << numRows << " x " << numCols << ", " << nnz << " nonzeros ("
+            << 100.0 * nnz / (numRows * numCols) << "%)\n";
+  std::cerr << "Jacobian-vector product flops, dense: " << 2 * numRows * numCols << ", sparse: " << 2 * nnz << "\n";
+  std::cerr << "Dense Jacobian   [ms]: " << denseTimer.getAverageInMilliseconds() << "\n";
+  std::cerr << "Sparse Jacobian  [ms]: " << sparseTimer.getAverageInMilliseconds() << "\n";
+  std::cerr << "Dense product    [ms]: " << denseProductTimer.getAverageInMilliseconds() << "\n";
+  std::cerr << "Sparse product   [ms]: " << sparseProductTimer.getAverageInMilliseconds() << std::endl;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <pinocchio/fwd.hpp>  // forward declarations must be included first.
 
 #include <ocs2_pinocchio_interface/PinocchioEndEffectorKinematicsCppAd.h>
+#include <ocs2_core/automatic_differentiation/CppAdCodeGenerator.h>
 #include <ocs2_robotic_tools/common/RotationTransforms.h>
 
 #include <pinocchio/algorithm/frames.hpp>
@@ -99,15 +100,12 @@ PinocchioEndEffectorKinematicsCppAd::PinocchioEndEffectorKinematicsCppAd(
   orientationErrorCppAdInterfacePtr_.reset(
       new CppAdInterface(orientationFunc, stateDim, 4 * endEffectorFrameIds_.size(), modelName + "_orientation", modelFolder));
 
-  if (recompileLibraries) {
-    positionCppAdInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    velocityCppAdInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    orientationErrorCppAdInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-  } else {
-    positionCppAdInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    velocityCppAdInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    orientationErrorCppAdInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-  }
+  // The three libraries are independent and compiled in parallel
+  CppAdCodeGenerator codeGenerator;
+  codeGenerator.addModel(*positionCppAdInterfacePtr_, CppAdInterface::ApproximationOrder::First, recompileLibraries);
+  codeGenerator.addModel(*velocityCppAdInterfacePtr_, CppAdInterface::ApproximationOrder::First, recompileLibraries);
+  codeGenerator.addModel(*orientationErrorCppAdInterfacePtr_, CppAdInterface::ApproximationOrder::First, recompileLibraries);
+  codeGenerator.generate(verbose);
 }
 
 /******************************************************************************************************/
@@ -212,6 +212,7 @@ void RaisimRollout::deleteGroundPlane() {
 void RaisimRollout::runSimulation(const std::pair<scalar_t, scalar_t>& timeInterval, ControllerBase* controller,
                                   scalar_array_t& timeTrajectory, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory) {
   const auto numSteps = static_cast<int>(std::ceil((timeInterval.second - timeInterval.first) / this->settings().timeStep));
+  LinearInterpolation::TimeSegmentCursor controllerCursor;
 
   for (int i = 0; i < numSteps; i++) {
     const auto time = timeInterval.first + i * this->settings().timeStep;
@@ -245,7 +246,8 @@ void RaisimRollout::runSimulation(const std::pair<scalar_t, scalar_t>& timeInter
 
       // input might have been computed by initialization already
       if (inputTrajectory.size() < stateTrajectory.size()) {
-        inputTrajectory.emplace_back(controller->computeInput(time, stateTrajectory.back()));
+        inputTrajectory.emplace_back();
+        controller->computeInput(time, stateTrajectory.back(), controllerCursor, inputTrajectory.back());
       }
       Eigen::VectorXd tau = inputToRaisimGeneralizedForce_(time, inputTrajectory.back(), stateTrajectory.back(), raisim_q, raisim_dq);
       assert(tau.rows() == system_->getDOF());
@@ -276,8 +278,8 @@ void RaisimRollout::runSimulation(const std::pair<scalar_t, scalar_t>& timeInter
     dataExtractionCallback_(timeTrajectory.back(), *system_);
   }
 
-  vector_t input = controller->computeInput(timeTrajectory.back(), stateTrajectory.back());
-  inputTrajectory.push_back(input);
+  inputTrajectory.emplace_back();
+  controller->computeInput(timeTrajectory.back(), stateTrajectory.back(), controllerCursor, inputTrajectory.back());
 }
 
 }  // namespace ocs2
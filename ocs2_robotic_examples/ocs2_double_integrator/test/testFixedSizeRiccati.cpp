@@ -0,0 +1,49 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_oc/test/FixedSizeRiccatiBenchmark.h>
+
+#include "ocs2_double_integrator/DoubleIntegratorInterface.h"
+#include "ocs2_double_integrator/package_path.h"
+
+using namespace ocs2;
+using namespace double_integrator;
+
+TEST(DoubleIntegratorFixedSizeRiccati, fixedVersusDynamic) {
+  const std::string taskFile = ocs2::double_integrator::getPath() + "/config/mpc/task.info";
+  const std::string libFolder = ocs2::double_integrator::getPath() + "/auto_generated";
+  DoubleIntegratorInterface interface(taskFile, libFolder, false);
+
+  benchmarkFixedSizeRiccati<static_cast<int>(STATE_DIM), static_cast<int>(INPUT_DIM)>(
+      "DoubleIntegratorFixedSizeRiccati", interface.getOptimalControlProblem(), interface.getInitialState(), interface.getInitialTarget());
+}
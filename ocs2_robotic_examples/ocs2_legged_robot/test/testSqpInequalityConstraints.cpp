@@ -0,0 +1,97 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <string>
+
+#include <ocs2_robotic_assets/package_path.h>
+#include <ocs2_sqp/SqpSolver.h>
+#include <ocs2_sqp/test/ClosedLoopBenchmark.h>
+
+#include "ocs2_legged_robot/LeggedRobotInterface.h"
+#include "ocs2_legged_robot/package_path.h"
+
+using namespace ocs2;
+using namespace legged_robot;
+
+namespace {
+
+/**
+ * Runs the SQP solver in a closed loop on the nominal solution, starting from the initial state and tracking a target that moves the
+ * base forward. Soft constraints use the relaxed barrier penalty in the cost, hard constraints are passed to the QP as inequalities.
+ */
+ClosedLoopBenchmarkResult runClosedLoop(bool useHardConstraints, int numMpcCalls) {
+  const std::string taskFile = legged_robot::getPath() + "/config/mpc/task.info";
+  const std::string urdfFile = robotic_assets::getPath() + "/resources/anymal_c/urdf/anymal.urdf";
+  const std::string referenceFile = legged_robot::getPath() + "/config/command/reference.info";
+  LeggedRobotInterface interface(taskFile, urdfFile, referenceFile, useHardConstraints);
+
+  sqp::Settings settings = interface.sqpSettings();
+  settings.sqpIteration = 5;
+  settings.printSolverStatistics = false;
+  settings.inequalityConstraintsInQp = useHardConstraints;
+
+  constexpr scalar_t timeHorizon = 1.0;
+  constexpr scalar_t mpcTimeStep = 0.01;
+  const vector_t initialState = interface.getInitialState();
+  const size_t inputDim = interface.getCentroidalModelInfo().inputDim;
+
+  vector_t targetState = initialState;
+  targetState(6) += 0.3;  // base position x
+  TargetTrajectories targetTrajectories({0.0, 1.0}, {initialState, targetState}, {vector_t::Zero(inputDim), vector_t::Zero(inputDim)});
+  interface.getReferenceManagerPtr()->setTargetTrajectories(std::move(targetTrajectories));
+
+  SqpSolver solver(settings, interface.getOptimalControlProblem(), interface.getInitializer());
+  solver.setReferenceManager(interface.getReferenceManagerPtr());
+
+  return runClosedLoopBenchmark(solver, initialState, timeHorizon, mpcTimeStep, numMpcCalls);
+}
+
+}  // namespace
+
+TEST(testSqpInequalityConstraints, frictionCone) {
+  const auto result = runClosedLoop(true, 5);
+  EXPECT_LT(result.performance.dynamicsViolationSSE, 1e-3);
+  EXPECT_LT(result.performance.inequalityConstraintsSSE, 1e-3);
+}
+
+// Long closed-loop benchmark, run with --gtest_also_run_disabled_tests
+TEST(testSqpInequalityConstraints, DISABLED_benchmarkFrictionCone) {
+  const auto softResult = runClosedLoop(false, 100);
+  const auto hardResult = runClosedLoop(true, 100);
+
+  std::cerr << "\n######## Friction cone: relaxed barrier penalty vs. QP inequality constraints ########\n";
+  printClosedLoopBenchmarkResult("Soft friction cone", softResult);
+  printClosedLoopBenchmarkResult("Hard friction cone", hardResult);
+
+  EXPECT_LT(hardResult.performance.dynamicsViolationSSE, 1e-3);
+  EXPECT_LT(hardResult.performance.inequalityConstraintsSSE, 1e-3);
+}
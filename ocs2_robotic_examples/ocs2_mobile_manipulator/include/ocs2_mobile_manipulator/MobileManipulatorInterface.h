@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // OCS2
 #include <ocs2_core/Types.h>
 #include <ocs2_core/initialization/Initializer.h>
+#include <ocs2_core/soft_constraint/StateInputSoftBoxConstraint.h>
 #include <ocs2_ddp/DDP_Settings.h>
 #include <ocs2_mpc/MPC_Settings.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
@@ -58,8 +59,10 @@ class MobileManipulatorInterface final : public RobotInterface {
    * @param [in] taskFile: The absolute path to the configuration file for the MPC.
    * @param [in] libraryFolder: The absolute path to the directory to generate CppAD library into.
    * @param [in] urdfFile: The absolute path to the URDF file for the robot.
+   * @param [in] useHardJointLimits: Whether to use hard or soft joint limit constraints.
    */
-  MobileManipulatorInterface(const std::string& taskFile, const std::string& libraryFolder, const std::string& urdfFile);
+  MobileManipulatorInterface(const std::string& taskFile, const std::string& libraryFolder, const std::string& urdfFile,
+                             bool useHardJointLimits = false);
 
   const vector_t& getInitialState() { return initialState_; }
 
@@ -88,6 +91,10 @@ class MobileManipulatorInterface final : public RobotInterface {
                                                         const std::string& urdfFile, const std::string& prefix, bool useCaching,
                                                         const std::string& libraryFolder, bool recompileLibraries);
   std::unique_ptr<StateInputCost> getJointLimitSoftConstraint(const PinocchioInterface& pinocchioInterface, const std::string& taskFile);
+  std::unique_ptr<StateInputConstraint> getJointLimitConstraint(const PinocchioInterface& pinocchioInterface, const std::string& taskFile);
+  /** Loads the joint position (state) and velocity (input) limits */
+  std::pair<std::vector<StateInputSoftBoxConstraint::BoxConstraint>, std::vector<StateInputSoftBoxConstraint::BoxConstraint>>
+  loadJointLimits(const PinocchioInterface& pinocchioInterface, const std::string& taskFile);
 
   ddp::Settings ddpSettings_;
   mpc::Settings mpcSettings_;
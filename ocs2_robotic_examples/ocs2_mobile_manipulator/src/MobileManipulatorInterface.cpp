@@ -36,6 +36,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_mobile_manipulator/MobileManipulatorInterface.h"
 
+#include <ocs2_core/constraint/LinearStateInputConstraint.h>
 #include <ocs2_core/initialization/DefaultInitializer.h>
 #include <ocs2_core/misc/LoadData.h>
 #include <ocs2_core/misc/LoadStdVectorOfPair.h>
@@ -70,7 +71,7 @@ namespace mobile_manipulator {
 /******************************************************************************************************/
 /******************************************************************************************************/
 MobileManipulatorInterface::MobileManipulatorInterface(const std::string& taskFile, const std::string& libraryFolder,
-                                                       const std::string& urdfFile) {
+                                                       const std::string& urdfFile, bool useHardJointLimits) {
   // check that task file exists
   boost::filesystem::path taskFilePath(taskFile);
   if (boost::filesystem::exists(taskFilePath)) {
@@ -164,7 +165,11 @@ MobileManipulatorInterface::MobileManipulatorInterface(const std::string& taskFi
 
   // Constraints
   // joint limits constraint
-  problem_.softConstraintPtr->add("jointLimits", getJointLimitSoftConstraint(*pinocchioInterfacePtr_, taskFile));
+  if (useHardJointLimits) {
+    problem_.inequalityConstraintPtr->add("jointLimits", getJointLimitConstraint(*pinocchioInterfacePtr_, taskFile));
+  } else {
+    problem_.softConstraintPtr->add("jointLimits", getJointLimitSoftConstraint(*pinocchioInterfacePtr_, taskFile));
+  }
   // end-effector state constraint
   problem_.stateSoftConstraintPtr->add("endEffector", getEndEffectorConstraint(*pinocchioInterfacePtr_, taskFile, "endEffector",
                                                                                usePreComputation, libraryFolder, recompileLibraries));
@@ -339,8 +344,8 @@ std::unique_ptr<StateCost> MobileManipulatorInterface::getSelfCollisionConstrain
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-std::unique_ptr<StateInputCost> MobileManipulatorInterface::getJointLimitSoftConstraint(const PinocchioInterface& pinocchioInterface,
-                                                                                        const std::string& taskFile) {
+std::pair<std::vector<StateInputSoftBoxConstraint::BoxConstraint>, std::vector<StateInputSoftBoxConstraint::BoxConstraint>>
+MobileManipulatorInterface::loadJointLimits(const PinocchioInterface& pinocchioInterface, const std::string& taskFile) {
   boost::property_tree::ptree pt;
   boost::property_tree::read_info(taskFile, pt);
 
@@ -431,10 +436,49 @@ std::unique_ptr<StateInputCost> MobileManipulatorInterface::getJointLimitSoftCon
     }
   }
 
-  auto boxConstraints = std::make_unique<StateInputSoftBoxConstraint>(stateLimits, inputLimits);
+  return {std::move(stateLimits), std::move(inputLimits)};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<StateInputCost> MobileManipulatorInterface::getJointLimitSoftConstraint(const PinocchioInterface& pinocchioInterface,
+                                                                                        const std::string& taskFile) {
+  auto limits = loadJointLimits(pinocchioInterface, taskFile);
+  auto boxConstraints = std::make_unique<StateInputSoftBoxConstraint>(std::move(limits.first), std::move(limits.second));
   boxConstraints->initializeOffset(0.0, vector_t::Zero(manipulatorModelInfo_.stateDim), vector_t::Zero(manipulatorModelInfo_.inputDim));
   return boxConstraints;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<StateInputConstraint> MobileManipulatorInterface::getJointLimitConstraint(const PinocchioInterface& pinocchioInterface,
+                                                                                          const std::string& taskFile) {
+  const auto limits = loadJointLimits(pinocchioInterface, taskFile);
+  const auto& stateLimits = limits.first;
+  const auto& inputLimits = limits.second;
+
+  // Each box constraint lowerBound <= z <= upperBound is written as: z - lowerBound >= 0 and upperBound - z >= 0
+  const int numConstraints = 2 * (stateLimits.size() + inputLimits.size());
+  vector_t e(numConstraints);
+  matrix_t C = matrix_t::Zero(numConstraints, manipulatorModelInfo_.stateDim);
+  matrix_t D = matrix_t::Zero(numConstraints, manipulatorModelInfo_.inputDim);
+  int row = 0;
+  for (const auto& limit : stateLimits) {
+    C(row, limit.index) = 1.0;
+    e(row++) = -limit.lowerBound;
+    C(row, limit.index) = -1.0;
+    e(row++) = limit.upperBound;
+  }
+  for (const auto& limit : inputLimits) {
+    D(row, limit.index) = 1.0;
+    e(row++) = -limit.lowerBound;
+    D(row, limit.index) = -1.0;
+    e(row++) = limit.upperBound;
+  }
+  return std::make_unique<LinearStateInputConstraint>(std::move(e), std::move(C), std::move(D));
+}
+
 }  // namespace mobile_manipulator
 }  // namespace ocs2
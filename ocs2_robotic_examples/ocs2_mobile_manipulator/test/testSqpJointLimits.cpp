@@ -0,0 +1,104 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <string>
+
+#include <ocs2_robotic_assets/package_path.h>
+#include <ocs2_sqp/SqpSolver.h>
+#include <ocs2_sqp/test/ClosedLoopBenchmark.h>
+
+#include "ocs2_mobile_manipulator/MobileManipulatorInterface.h"
+#include "ocs2_mobile_manipulator/package_path.h"
+
+using namespace ocs2;
+using namespace mobile_manipulator;
+
+namespace {
+
+sqp::Settings getSqpSettings(bool inequalityConstraintsInQp) {
+  sqp::Settings settings;
+  settings.dt = 0.05;
+  settings.sqpIteration = 5;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useFeedbackPolicy = false;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+  settings.nThreads = 1;
+  settings.inequalityConstraintsInQp = inequalityConstraintsInQp;
+  return settings;
+}
+
+/**
+ * Runs the SQP solver in a closed loop on the nominal solution towards an end-effector target. Soft joint limits use the relaxed barrier
+ * penalty in the cost, hard joint limits are passed to the QP, where they are detected as simple bounds.
+ */
+ClosedLoopBenchmarkResult runClosedLoop(bool useHardJointLimits, int numMpcCalls) {
+  const std::string taskFile = mobile_manipulator::getPath() + "/config/mabi_mobile/task.info";
+  const std::string libFolder = mobile_manipulator::getPath() + "/auto_generated/mabi_mobile";
+  const std::string urdfFile = robotic_assets::getPath() + "/resources/mobile_manipulator/mabi_mobile/urdf/mabi_mobile.urdf";
+  MobileManipulatorInterface interface(taskFile, libFolder, urdfFile, useHardJointLimits);
+  const auto& modelInfo = interface.getManipulatorModelInfo();
+
+  constexpr scalar_t timeHorizon = 1.0;
+  constexpr scalar_t mpcTimeStep = 0.05;
+
+  const vector_t goalPose = (vector_t(7) << -0.5, -0.8, 0.6, 0.0, 0.0, 0.95, 0.33).finished();
+  TargetTrajectories targetTrajectories({0.0}, {goalPose}, {vector_t::Zero(modelInfo.inputDim)});
+  interface.getReferenceManagerPtr()->setTargetTrajectories(std::move(targetTrajectories));
+
+  SqpSolver solver(getSqpSettings(useHardJointLimits), interface.getOptimalControlProblem(), interface.getInitializer());
+  solver.setReferenceManager(interface.getReferenceManagerPtr());
+
+  return runClosedLoopBenchmark(solver, interface.getInitialState(), timeHorizon, mpcTimeStep, numMpcCalls);
+}
+
+}  // namespace
+
+TEST(testSqpJointLimits, jointLimits) {
+  const auto result = runClosedLoop(true, 5);
+  EXPECT_LT(result.performance.dynamicsViolationSSE, 1e-3);
+  EXPECT_LT(result.performance.inequalityConstraintsSSE, 1e-3);
+}
+
+// Long closed-loop benchmark, run with --gtest_also_run_disabled_tests
+TEST(testSqpJointLimits, DISABLED_benchmarkJointLimits) {
+  const auto softResult = runClosedLoop(false, 60);
+  const auto hardResult = runClosedLoop(true, 60);
+
+  std::cerr << "\n######## Joint limits: relaxed barrier penalty vs. QP box constraints ########\n";
+  printClosedLoopBenchmarkResult("Soft joint limits", softResult);
+  printClosedLoopBenchmarkResult("Hard joint limits", hardResult);
+
+  EXPECT_LT(hardResult.performance.dynamicsViolationSSE, 1e-3);
+  EXPECT_LT(hardResult.performance.inequalityConstraintsSSE, 1e-3);
+}
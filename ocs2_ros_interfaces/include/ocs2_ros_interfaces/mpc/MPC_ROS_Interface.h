@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_mpc/CommandData.h>
 #include <ocs2_mpc/MPC_BASE.h>
+#include <ocs2_mpc/SharedMemoryPolicyChannel.h>
 #include <ocs2_mpc/SystemObservation.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 
@@ -45,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_msgs/msg/mode_schedule.hpp>
 #include <ocs2_msgs/msg/mpc_flattened_controller.hpp>
 #include <ocs2_msgs/msg/mpc_observation.hpp>
+#include <ocs2_msgs/msg/mpc_policy_buffer.hpp>
 #include <ocs2_msgs/msg/mpc_target_trajectories.hpp>
 #include <ocs2_msgs/srv/reset.hpp>
 #include <string>
@@ -67,9 +69,13 @@ class MPC_ROS_Interface {
    *
    * @param [in] mpc: The underlying MPC class to be used.
    * @param [in] topicPrefix: The robot's name.
+   * @param [in] useSharedMemory: Whether the policy is sent to the MRT through
+   * shared memory. The policy topics are then only published if they have
+   * subscribers, e.g., for visualization.
    */
   explicit MPC_ROS_Interface(MPC_BASE& mpc,
-                             std::string topicPrefix = "anonymousRobot");
+                             std::string topicPrefix = "anonymousRobot",
+                             bool useSharedMemory = false);
 
   /**
    * Destructor.
@@ -124,6 +130,19 @@ class MPC_ROS_Interface {
       const PrimalSolution& primalSolution, const CommandData& commandData,
       const PerformanceIndex& performanceIndices);
 
+  /**
+   * Publishes the policy in the binary format of PolicySerialization.h, either
+   * to the shared memory or to the ROS topic. The flattened policy message is
+   * only created if it has subscribers, e.g., for visualization.
+   *
+   * @param [in] primalSolution: The policy data of the MPC.
+   * @param [in] commandData: The command data of the MPC.
+   * @param [in] performanceIndices: The performance indices data of the solver.
+   */
+  void publishPolicy(const PrimalSolution& primalSolution,
+                     const CommandData& commandData,
+                     const PerformanceIndex& performanceIndices);
+
   /**
    * Handles ROS publishing thread.
    */
@@ -163,6 +182,8 @@ class MPC_ROS_Interface {
       mpcTargetTrajectoriesSubscriber_;
   rclcpp::Publisher<ocs2_msgs::msg::MpcFlattenedController>::SharedPtr
       mpcPolicyPublisher_;
+  rclcpp::Publisher<ocs2_msgs::msg::MpcPolicyBuffer>::SharedPtr
+      mpcPolicyBufferPublisher_;
   rclcpp::Service<ocs2_msgs::srv::Reset>::SharedPtr mpcResetServiceServer_;
 
   std::unique_ptr<CommandData> bufferCommandPtr_;
@@ -175,6 +196,10 @@ class MPC_ROS_Interface {
   mutable std::mutex
       bufferMutex_;  // for policy variables with prefix (buffer*)
 
+  // serialized policy, its capacity is reused over the publications
+  ocs2_msgs::msg::MpcPolicyBuffer mpcPolicyBufferMsg_;
+  std::unique_ptr<SharedMemoryPolicyChannel> policyChannelPtr_;
+
   // multi-threading for publishers
   std::atomic_bool terminateThread_{false};
   std::atomic_bool readyToPublish_{false};
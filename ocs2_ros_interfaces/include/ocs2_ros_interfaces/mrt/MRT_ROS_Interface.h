@@ -41,8 +41,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // MPC messages
 #include <ocs2_mpc/MRT_BASE.h>
+#include <ocs2_mpc/SharedMemoryPolicyChannel.h>
 
-#include <ocs2_msgs/msg/mpc_flattened_controller.hpp>
+#include <ocs2_msgs/msg/mpc_policy_buffer.hpp>
 #include <ocs2_msgs/srv/reset.hpp>
 
 #include "ocs2_ros_interfaces/common/RosMsgConversions.h"
@@ -62,10 +63,15 @@ class MRT_ROS_Interface : public MRT_BASE {
    *
    * @param [in] topicPrefix: The prefix defines the names for: observation's
    * publishing topic "topicPrefix_mpc_observation", policy's receiving topic
-   * "topicPrefix_mpc_policy", and MPC reset service "topicPrefix_mpc_reset".
+   * "topicPrefix_mpc_policy_binary", and MPC reset service
+   * "topicPrefix_mpc_reset".
    * @param [in] mrtTransportHints: ROS transmission protocol.
+   * @param [in] useSharedMemory: Whether the policy is received through shared
+   * memory instead of the policy topic. The MPC node has to use shared memory
+   * as well.
    */
-  explicit MRT_ROS_Interface(std::string topicPrefix = "anonymousRobot");
+  explicit MRT_ROS_Interface(std::string topicPrefix = "anonymousRobot",
+                             bool useSharedMemory = false);
 
   /**
    * Destructor
@@ -85,7 +91,7 @@ class MRT_ROS_Interface : public MRT_BASE {
   void shutdownPublisher();
 
   /**
-   * spin the MRT callback queue
+   * spin the MRT callback queue and check the shared memory for a new policy
    */
   void spinMRT();
 
@@ -103,24 +109,17 @@ class MRT_ROS_Interface : public MRT_BASE {
   /**
    * Callback method to receive the MPC policy as well as the mode sequence.
    * It only updates the policy variables with suffix (*Buffer_) variables.
+   * The policy is decoded from the binary format of PolicySerialization.h.
    *
    * @param [in] msg: A constant pointer to the message
    */
   void mpcPolicyCallback(
-      const ocs2_msgs::msg::MpcFlattenedController::ConstSharedPtr& msg);
+      const ocs2_msgs::msg::MpcPolicyBuffer::ConstSharedPtr& msg);
 
   /**
-   * Helper function to read a MPC policy message.
-   *
-   * @param [in] msg: A constant pointer to the message
-   * @param [out] commandData: The MPC command data
-   * @param [out] primalSolution: The MPC policy data
-   * @param [out] performanceIndices: The MPC performance indices data
+   * Reads a new policy from the shared memory into the buffer of MRT_BASE.
    */
-  static void readPolicyMsg(const ocs2_msgs::msg::MpcFlattenedController& msg,
-                            CommandData& commandData,
-                            PrimalSolution& primalSolution,
-                            PerformanceIndex& performanceIndices);
+  void readSharedMemoryPolicy();
 
   /**
    * A thread function which sends the current state and checks for a new MPC
@@ -135,10 +134,16 @@ class MRT_ROS_Interface : public MRT_BASE {
   rclcpp::Node::SharedPtr node_;
   rclcpp::Publisher<ocs2_msgs::msg::MpcObservation>::SharedPtr
       mpcObservationPublisher_;
-  rclcpp::Subscription<ocs2_msgs::msg::MpcFlattenedController>::SharedPtr
+  rclcpp::Subscription<ocs2_msgs::msg::MpcPolicyBuffer>::SharedPtr
       mpcPolicySubscriber_;
   rclcpp::Client<ocs2_msgs::srv::Reset>::SharedPtr mpcResetServiceClient_;
 
+  // Shared memory transport of the policy
+  std::unique_ptr<SharedMemoryPolicyChannel> policyChannelPtr_;
+  std::unique_ptr<CommandData> sharedMemoryCommandPtr_;
+  std::unique_ptr<PrimalSolution> sharedMemoryPrimalSolutionPtr_;
+  std::unique_ptr<PerformanceIndex> sharedMemoryPerformanceIndicesPtr_;
+
   // ROS messages
   ocs2_msgs::msg::MpcObservation mpcObservationMsg_;
   ocs2_msgs::msg::MpcObservation mpcObservationMsgBuffer_;
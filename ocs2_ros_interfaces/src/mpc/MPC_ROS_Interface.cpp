@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ros_interfaces/mpc/MPC_ROS_Interface.h"
 
+#include <ocs2_mpc/PolicySerialization.h>
+#include <ocs2_mpc/SharedMemoryPolicyChannel.h>
+
 #include "ocs2_ros_interfaces/common/RosMsgConversions.h"
 
 const rclcpp::Logger LOGGER = rclcpp::get_logger("MPC_ROS_Interface");
@@ -38,7 +41,8 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-MPC_ROS_Interface::MPC_ROS_Interface(MPC_BASE& mpc, std::string topicPrefix)
+MPC_ROS_Interface::MPC_ROS_Interface(MPC_BASE& mpc, std::string topicPrefix,
+                                     bool useSharedMemory)
     : mpc_(mpc),
       topicPrefix_(std::move(topicPrefix)),
       bufferPrimalSolutionPtr_(new PrimalSolution()),
@@ -47,6 +51,11 @@ MPC_ROS_Interface::MPC_ROS_Interface(MPC_BASE& mpc, std::string topicPrefix)
       publisherCommandPtr_(new CommandData()),
       bufferPerformanceIndicesPtr_(new PerformanceIndex),
       publisherPerformanceIndicesPtr_(new PerformanceIndex) {
+  if (useSharedMemory) {
+    policyChannelPtr_.reset(new SharedMemoryPolicyChannel(
+        topicPrefix_ + "_mpc_policy", SharedMemoryPolicyChannel::Role::Writer));
+  }
+
   // start thread for publishing
 #ifdef PUBLISH_THREAD
   publisherWorker_ = std::thread(&MPC_ROS_Interface::publisherWorker, this);
@@ -189,6 +198,30 @@ ocs2_msgs::msg::MpcFlattenedController MPC_ROS_Interface::createMpcPolicyMsg(
   return mpcPolicyMsg;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_ROS_Interface::publishPolicy(
+    const PrimalSolution& primalSolution, const CommandData& commandData,
+    const PerformanceIndex& performanceIndices) {
+  if (policyChannelPtr_ != nullptr) {
+    policyChannelPtr_->write(primalSolution, commandData, performanceIndices);
+  }
+
+  if (policyChannelPtr_ == nullptr ||
+      mpcPolicyBufferPublisher_->get_subscription_count() > 0) {
+    policy_serialization::serialize(primalSolution, commandData,
+                                    performanceIndices,
+                                    mpcPolicyBufferMsg_.data);
+    mpcPolicyBufferPublisher_->publish(mpcPolicyBufferMsg_);
+  }
+
+  if (mpcPolicyPublisher_->get_subscription_count() > 0) {
+    mpcPolicyPublisher_->publish(
+        createMpcPolicyMsg(primalSolution, commandData, performanceIndices));
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -209,12 +242,9 @@ void MPC_ROS_Interface::publisherWorker() {
       publisherPerformanceIndicesPtr_.swap(bufferPerformanceIndicesPtr_);
     }
 
-    ocs2_msgs::msg::MpcFlattenedController mpcPolicyMsg =
-        createMpcPolicyMsg(*publisherPrimalSolutionPtr_, *publisherCommandPtr_,
-                           *publisherPerformanceIndicesPtr_);
-
-    // publish the message
-    mpcPolicyPublisher_->publish(mpcPolicyMsg);
+    // publish the messages
+    publishPolicy(*publisherPrimalSolutionPtr_, *publisherCommandPtr_,
+                  *publisherPerformanceIndicesPtr_);
 
     readyToPublish_ = false;
     lk.unlock();
@@ -309,10 +339,8 @@ void MPC_ROS_Interface::mpcObservationCallback(
   msgReady_.notify_one();
 
 #else
-  ocs2_msgs::msg::MpcFlattenedController mpcPolicyMsg =
-      createMpcPolicyMsg(*bufferPrimalSolutionPtr_, *bufferCommandPtr_,
-                         *bufferPerformanceIndicesPtr_);
-  mpcPolicyPublisher_.publish(mpcPolicyMsg);
+  publishPolicy(*bufferPrimalSolutionPtr_, *bufferCommandPtr_,
+                *bufferPerformanceIndicesPtr_);
 #endif
 }
 
@@ -362,7 +390,10 @@ void MPC_ROS_Interface::launchNodes(const rclcpp::Node::SharedPtr& node) {
           std::bind(&MPC_ROS_Interface::mpcObservationCallback, this,
                     std::placeholders::_1));
 
-  // MPC publisher
+  // MPC publishers, the flattened policy is only used for visualization
+  mpcPolicyBufferPublisher_ =
+      node_->create_publisher<ocs2_msgs::msg::MpcPolicyBuffer>(
+          topicPrefix_ + "_mpc_policy_binary", 1);
   mpcPolicyPublisher_ =
       node_->create_publisher<ocs2_msgs::msg::MpcFlattenedController>(
           topicPrefix_ + "_mpc_policy", 1);
@@ -379,6 +410,10 @@ void MPC_ROS_Interface::launchNodes(const rclcpp::Node::SharedPtr& node) {
 #ifdef PUBLISH_THREAD
   RCLCPP_INFO(LOGGER, "Publishing SLQ-MPC messages on a separate thread.");
 #endif
+  if (policyChannelPtr_ != nullptr) {
+    RCLCPP_INFO_STREAM(LOGGER, "Sending the policy through the shared memory "
+                                   << policyChannelPtr_->name() << ".");
+  }
 
   RCLCPP_INFO(LOGGER, "MPC node is ready.");
 
@@ -29,8 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ros_interfaces/mrt/MRT_ROS_Interface.h"
 
-#include <ocs2_core/control/FeedforwardController.h>
-#include <ocs2_core/control/LinearController.h>
+#include <ocs2_mpc/PolicySerialization.h>
 
 namespace ocs2 {
 
@@ -39,8 +38,14 @@ const rclcpp::Logger LOGGER = rclcpp::get_logger("MRT_ROS_Interface");
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-MRT_ROS_Interface::MRT_ROS_Interface(std::string topicPrefix)
+MRT_ROS_Interface::MRT_ROS_Interface(std::string topicPrefix,
+                                     bool useSharedMemory)
     : topicPrefix_(std::move(topicPrefix)) {
+  if (useSharedMemory) {
+    policyChannelPtr_.reset(new SharedMemoryPolicyChannel(
+        topicPrefix_ + "_mpc_policy", SharedMemoryPolicyChannel::Role::Reader));
+  }
+
 // Start thread for publishing
 #ifdef PUBLISH_THREAD
   // Close old thread if it is already running
@@ -130,102 +135,43 @@ void MRT_ROS_Interface::publisherWorkerThread() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void MRT_ROS_Interface::readPolicyMsg(
-    const ocs2_msgs::msg::MpcFlattenedController& msg, CommandData& commandData,
-    PrimalSolution& primalSolution, PerformanceIndex& performanceIndices) {
-  commandData.mpcInitObservation_ =
-      ros_msg_conversions::readObservationMsg(msg.init_observation);
-  commandData.mpcTargetTrajectories_ =
-      ros_msg_conversions::readTargetTrajectoriesMsg(
-          msg.plan_target_trajectories);
-  performanceIndices =
-      ros_msg_conversions::readPerformanceIndicesMsg(msg.performance_indices);
-
-  const size_t N = msg.time_trajectory.size();
-  if (N == 0) {
-    throw std::runtime_error(
-        "[MRT_ROS_Interface::readPolicyMsg] controller message is empty!");
-  }
-  if (msg.state_trajectory.size() != N && msg.input_trajectory.size() != N) {
-    throw std::runtime_error(
-        "[MRT_ROS_Interface::readPolicyMsg] state and input trajectories must "
-        "have same length!");
-  }
-  if (msg.data.size() != N) {
+void MRT_ROS_Interface::mpcPolicyCallback(
+    const ocs2_msgs::msg::MpcPolicyBuffer::ConstSharedPtr& msg) {
+  // read new policy and command from the serialized buffer
+  auto commandPtr = std::make_unique<CommandData>();
+  auto primalSolutionPtr = std::make_unique<PrimalSolution>();
+  auto performanceIndicesPtr = std::make_unique<PerformanceIndex>();
+  const policy_serialization::PolicyView view(msg->data.data(),
+                                              msg->data.size());
+  if (view.numNodes() == 0 ||
+      view.controllerType() == ControllerType::UNKNOWN) {
     throw std::runtime_error(
-        "[MRT_ROS_Interface::readPolicyMsg] Data has the wrong length!");
+        "[MRT_ROS_Interface::mpcPolicyCallback] controller message is empty!");
   }
+  policy_serialization::deserialize(view, *commandPtr, *primalSolutionPtr,
+                                    *performanceIndicesPtr);
 
-  primalSolution.clear();
-
-  primalSolution.modeSchedule_ =
-      ros_msg_conversions::readModeScheduleMsg(msg.mode_schedule);
-
-  size_array_t stateDim(N);
-  size_array_t inputDim(N);
-  primalSolution.timeTrajectory_.reserve(N);
-  primalSolution.stateTrajectory_.reserve(N);
-  primalSolution.inputTrajectory_.reserve(N);
-  for (size_t i = 0; i < N; i++) {
-    stateDim[i] = msg.state_trajectory[i].value.size();
-    inputDim[i] = msg.input_trajectory[i].value.size();
-    primalSolution.timeTrajectory_.emplace_back(msg.time_trajectory[i]);
-    primalSolution.stateTrajectory_.emplace_back(
-        Eigen::Map<const Eigen::VectorXf>(msg.state_trajectory[i].value.data(),
-                                          stateDim[i])
-            .cast<scalar_t>());
-    primalSolution.inputTrajectory_.emplace_back(
-        Eigen::Map<const Eigen::VectorXf>(msg.input_trajectory[i].value.data(),
-                                          inputDim[i])
-            .cast<scalar_t>());
-  }
-
-  primalSolution.postEventIndices_.reserve(msg.post_event_indices.size());
-  for (auto ind : msg.post_event_indices) {
-    primalSolution.postEventIndices_.emplace_back(static_cast<size_t>(ind));
-  }
-
-  std::vector<std::vector<float> const*> controllerDataPtrArray(N, nullptr);
-  for (int i = 0; i < N; i++) {
-    controllerDataPtrArray[i] = &(msg.data[i].data);
-  }
-
-  // instantiate the correct controller
-  switch (msg.controller_type) {
-    case ocs2_msgs::msg::MpcFlattenedController::CONTROLLER_FEEDFORWARD: {
-      auto controller = FeedforwardController::unFlatten(
-          primalSolution.timeTrajectory_, controllerDataPtrArray);
-      primalSolution.controllerPtr_.reset(
-          new FeedforwardController(std::move(controller)));
-      break;
-    }
-    case ocs2_msgs::msg::MpcFlattenedController::CONTROLLER_LINEAR: {
-      auto controller = LinearController::unFlatten(
-          stateDim, inputDim, primalSolution.timeTrajectory_,
-          controllerDataPtrArray);
-      primalSolution.controllerPtr_.reset(
-          new LinearController(std::move(controller)));
-      break;
-    }
-    default:
-      throw std::runtime_error(
-          "[MRT_ROS_Interface::readPolicyMsg] Unknown controllerType!");
-  }
+  this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr),
+                     std::move(performanceIndicesPtr));
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void MRT_ROS_Interface::mpcPolicyCallback(
-    const ocs2_msgs::msg::MpcFlattenedController::ConstSharedPtr& msg) {
-  // read new policy and command from msg
-  auto commandPtr = std::make_unique<CommandData>();
-  auto primalSolutionPtr = std::make_unique<PrimalSolution>();
-  auto performanceIndicesPtr = std::make_unique<PerformanceIndex>();
-  readPolicyMsg(*msg, *commandPtr, *primalSolutionPtr, *performanceIndicesPtr);
+void MRT_ROS_Interface::readSharedMemoryPolicy() {
+  if (sharedMemoryCommandPtr_ == nullptr) {
+    sharedMemoryCommandPtr_ = std::make_unique<CommandData>();
+    sharedMemoryPrimalSolutionPtr_ = std::make_unique<PrimalSolution>();
+    sharedMemoryPerformanceIndicesPtr_ = std::make_unique<PerformanceIndex>();
+  }
 
-  this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr),
-                     std::move(performanceIndicesPtr));
+  if (policyChannelPtr_->read(*sharedMemoryCommandPtr_,
+                              *sharedMemoryPrimalSolutionPtr_,
+                              *sharedMemoryPerformanceIndicesPtr_)) {
+    this->moveToBuffer(std::move(sharedMemoryCommandPtr_),
+                       std::move(sharedMemoryPrimalSolutionPtr_),
+                       std::move(sharedMemoryPerformanceIndicesPtr_));
+  }
 }
 
 /******************************************************************************************************/
@@ -265,6 +211,10 @@ void MRT_ROS_Interface::shutdownPublisher() {
 void MRT_ROS_Interface::spinMRT() {
   // callback_executor_.spin_once();
   rclcpp::spin_some(node_);
+
+  if (policyChannelPtr_ != nullptr) {
+    readSharedMemoryPolicy();
+  }
 };
 
 /******************************************************************************************************/
@@ -281,13 +231,18 @@ void MRT_ROS_Interface::launchNodes(const rclcpp::Node::SharedPtr& node) {
       node_->create_publisher<ocs2_msgs::msg::MpcObservation>(
           topicPrefix_ + "_mpc_observation", 1);
 
-  // policy subscriber
-  mpcPolicySubscriber_ =
-      node_->create_subscription<ocs2_msgs::msg::MpcFlattenedController>(
-          topicPrefix_ + "_mpc_policy",  // topic name
-          1,                             // queue length
-          std::bind(&MRT_ROS_Interface::mpcPolicyCallback, this,
-                    std::placeholders::_1));
+  // policy subscriber, not needed if the policy is read from shared memory
+  if (policyChannelPtr_ == nullptr) {
+    mpcPolicySubscriber_ =
+        node_->create_subscription<ocs2_msgs::msg::MpcPolicyBuffer>(
+            topicPrefix_ + "_mpc_policy_binary",  // topic name
+            1,                                    // queue length
+            std::bind(&MRT_ROS_Interface::mpcPolicyCallback, this,
+                      std::placeholders::_1));
+  } else {
+    RCLCPP_INFO_STREAM(LOGGER, "Receiving the policy through the shared memory "
+                                   << policyChannelPtr_->name() << ".");
+  }
 
   // MPC reset service client
   mpcResetServiceClient_ =
@@ -41,6 +41,8 @@ namespace slp {
 struct Settings {
   size_t slpIteration = 10;     // Maximum number of SLP iterations
   size_t scalingIteration = 3;  // Number of pre-conditioning iterations
+  bool warmStartScaling = false;         // Seed the pre-conditioning with the factors of the previous LP, shifted to the current time
+  size_t warmStartScalingIteration = 1;  // Number of correcting pre-conditioning iterations if warm-started
   scalar_t deltaTol = 1e-6;     // Termination condition : RMS update of x(t) and u(t) are both below this value
   scalar_t costTol = 1e-4;      // Termination condition : (cost{i+1} - (cost{i}) < costTol AND constraints{i+1} < g_min
 
@@ -55,13 +57,21 @@ struct Settings {
   scalar_t gamma_c = 1e-6;       // (3): ELSE REQUIRE c{i+1} < (c{i} - gamma_c * g{i}) OR g{i+1} < (1-gamma_c) * g{i}
 
   // Discretization method
-  scalar_t dt = 0.01;  // user-defined time discretization
+  scalar_t dt = 0.01;                                // user-defined time discretization
+  scalar_t dtGrowthRate = 1.0;                       // ratio of consecutive time steps, 1.0 results in a uniform discretization
+  scalar_t dtMax = 0.1;                              // maximum time step of the growing discretization
+  scalar_t dynamicsDefectRefinementTolerance = 0.0;  // halves the intervals with a larger dynamics defect in the last solution, 0: off
   SensitivityIntegratorType integratorType = SensitivityIntegratorType::RK2;
 
   // Inequality penalty relaxed barrier parameters
   scalar_t inequalityConstraintMu = 0.0;
   scalar_t inequalityConstraintDelta = 1e-6;
 
+  // Enforce the simple bounds and the state-only or input-only linear inequality constraints in the LP subproblem through the projection
+  // step of PIPG. Constraints coupling the state and the input are rejected. Otherwise, the inequality constraints are not part of the LP
+  // subproblem.
+  bool projectInequalityConstraints = false;
+
   // Extract the Lagrange multiplier of the projected state-input constraint Cx+Du+e
   bool extractProjectionMultiplier = false;
 
@@ -36,6 +36,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
+#include <ocs2_oc/oc_problem/OcpInequalityConstraints.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
 #include <ocs2_oc/search_strategy/FilterLinesearch.h>
@@ -134,7 +135,7 @@ class SlpSolver : public SolverBase {
     vector_array_t deltaUSol;      // delta_u(t)
     scalar_t armijoDescentMetric;  // inner product of the cost gradient and decision variable step
   };
-  OcpSubproblemSolution getOCPSolution(const vector_t& delta_x0);
+  OcpSubproblemSolution getOCPSolution(const std::vector<AnnotatedTime>& time, const vector_t& delta_x0);
 
   /** Constructs the primal solution based on the optimized state and input trajectories */
   PrimalSolution toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u);
@@ -171,6 +172,14 @@ class SlpSolver : public SolverBase {
   std::vector<VectorFunctionLinearApproximation> stateIneqConstraints_;
   std::vector<VectorFunctionLinearApproximation> stateInputIneqConstraints_;
   std::vector<VectorFunctionLinearApproximation> constraintsProjection_;
+  std::vector<NodeInequalityConstraints> inequalityConstraints_;  // split into bounds and general constraints, only if projected
+  pipg::ProjectionSets projectionSets_;
+
+  // Pre-conditioning factors of the last LP subproblem, see slp::Settings::warmStartScaling
+  scalar_array_t scalingTime_;
+  vector_array_t scalingD_;
+  vector_array_t scalingE_;
+  scalar_t scalingC_ = 1.0;
 
   // Lagrange multipliers
   std::vector<multiple_shooting::ProjectionMultiplierCoefficients> projectionMultiplierCoefficients_;
@@ -194,6 +203,7 @@ class SlpSolver : public SolverBase {
   benchmark::RepeatedTimer lambdaEstimation_;
   benchmark::RepeatedTimer sigmaEstimation_;
   benchmark::RepeatedTimer preConditioning_;
+  benchmark::RepeatedTimer warmStartedPreConditioning_;
   benchmark::RepeatedTimer pipgSolverTimer_;
 };
 
@@ -29,8 +29,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <algorithm>
+
 #include <ocs2_core/Types.h>
 
+#include "ocs2_slp/pipg/PipgSettings.h"
+
 namespace ocs2 {
 namespace pipg {
 
@@ -72,5 +76,57 @@ struct PipgBounds {
   scalar_t sigma = 1.0;   // G' G <= sigma I
 };
 
+/**
+ * Step-size schedule of PIPG with optional adaptation. The primal step size shrinks and the dual step size grows with the iteration
+ * counter of the schedule. With a conservative lower bound mu of the hessian, the dual step size grows slowly and the constraints
+ * converge slowly. If Settings::adaptiveStepSize is set, the schedule compares the primal residual ||G z - g|| with the fixed-point
+ * residual of the primal update ||z_{k} - z_{k-1}|| / alpha. If the primal residual dominates by Settings::stepSizeResidualRatio, the
+ * iteration counter of the schedule is doubled, which is equivalent to doubling the estimate of mu. The estimate of mu is capped at lambda,
+ * since mu I <= H <= lambda I, such that the primal step size does not decay towards zero under repeated adaptations.
+ */
+class PipgStepSizeSchedule {
+ public:
+  PipgStepSizeSchedule(const PipgBounds& pipgBounds, const Settings& settings)
+      : pipgBounds_(pipgBounds), adaptiveStepSize_(settings.adaptiveStepSize), residualRatio_(settings.stepSizeResidualRatio) {}
+
+  scalar_t dualStepSize(size_t iteration) const { return pipgBounds_.dualStepSize(iteration + iterationOffset_); }
+
+  scalar_t primalStepSize(size_t iteration) const { return pipgBounds_.primalStepSize(iteration + iterationOffset_); }
+
+  /**
+   * Adapts the schedule to the residuals of the given iteration.
+   *
+   * @param [in] iteration : The iteration of the solver.
+   * @param [in] primalResidualNorm : The 2-norm of the constraint violation, ||G z - g||.
+   * @param [in] fixedPointResidualNorm : The 2-norm of the change of the primal iterate divided by the primal step size.
+   * @return true if the schedule skipped ahead.
+   */
+  bool update(size_t iteration, scalar_t primalResidualNorm, scalar_t fixedPointResidualNorm) {
+    if (!adaptiveStepSize_ || primalResidualNorm <= residualRatio_ * fixedPointResidualNorm) {
+      return false;
+    }
+    // The estimate of mu is (iteration + iterationOffset_ + 1) / (iteration + 1) * mu, at most lambda
+    const scalar_t counter = static_cast<scalar_t>(iteration + 1);
+    const scalar_t maxOffset = counter * std::max(pipgBounds_.lambda / pipgBounds_.mu - 1.0, 0.0);
+    const scalar_t offset = std::min(2.0 * static_cast<scalar_t>(iterationOffset_) + counter, maxOffset);
+    if (offset < static_cast<scalar_t>(iterationOffset_) + 1.0) {
+      return false;
+    }
+    iterationOffset_ = static_cast<size_t>(offset);
+    ++numAdaptations_;
+    return true;
+  }
+
+  /** Number of times the schedule skipped ahead */
+  size_t getNumAdaptations() const { return numAdaptations_; }
+
+ private:
+  const PipgBounds pipgBounds_;
+  const bool adaptiveStepSize_;
+  const scalar_t residualRatio_;
+  size_t iterationOffset_ = 0;
+  size_t numAdaptations_ = 0;
+};
+
 }  // namespace pipg
 }  // namespace ocs2
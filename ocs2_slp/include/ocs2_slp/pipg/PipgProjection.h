@@ -0,0 +1,110 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_oc/oc_problem/OcpInequalityConstraints.h>
+
+namespace ocs2 {
+namespace pipg {
+
+/**
+ * Closed convex set of the state or the input of a node, which is used in the projection step of PIPG:
+ *    lb <= z[idxb] <= ub
+ *    G z >= g
+ *
+ * The halfspaces are meant for a few simple polytopic constraints, e.g., a limit on the sum of some inputs. The set must not be empty.
+ */
+struct ProjectionSet {
+  std::vector<int> idxb;  // indices of the bounded variables
+  vector_t lb;            // lower bounds of the bounded variables
+  vector_t ub;            // upper bounds of the bounded variables
+  matrix_t G;             // normals of the halfspaces
+  vector_t g;             // offsets of the halfspaces
+
+  /** Number of halfspaces */
+  int numHalfspaces() const { return static_cast<int>(g.size()); }
+
+  /** Whether the set is the whole space */
+  bool empty() const { return idxb.empty() && g.size() == 0; }
+};
+
+/**
+ * Projection sets of the decision variables of the PIPG solver. The sets are defined in the variables seen by the solver, i.e., the
+ * pre-conditioned ones if the problem is scaled. The set of the initial state is ignored since x0 is fixed. Nodes without a set can
+ * be left empty.
+ */
+struct ProjectionSets {
+  std::vector<ProjectionSet> state;  // N + 1 state sets
+  std::vector<ProjectionSet> input;  // N input sets
+};
+
+/** Memory of the projection onto the intersection of several sets. It is reused between calls. */
+struct ProjectionWorkspace {
+  matrix_t increments;   // Dykstra's correction terms, one column per halfspace
+  vector_t y;            // iterate before the projection onto one of the sets
+  vector_t breakpoints;  // multipliers of a halfspace at which a bounded variable hits its bound
+};
+
+/**
+ * Projects a vector onto a projection set in place. The bounds alone are projected by clamping. The bounds with a single halfspace are
+ * projected exactly by a search over the multiplier of the halfspace. With several halfspaces, Dykstra's alternating projection method
+ * is applied to the sets "bounds and halfspace j", which converges to the euclidean projection onto their intersection. It stops if a
+ * sweep over all halfspaces does not change Dykstra's increments, or after maxNumSweeps sweeps.
+ *
+ * @param [in] set : The projection set.
+ * @param [in] maxNumSweeps : Maximum number of sweeps of Dykstra's method.
+ * @param [in, out] z : The vector to project.
+ * @param [in, out] workspace : The memory of the projection.
+ */
+void project(const ProjectionSet& set, size_t maxNumSweeps, vector_t& z, ProjectionWorkspace& workspace);
+
+/** Whether z lies in the projection set up to a tolerance */
+bool isInSet(const ProjectionSet& set, const vector_t& z, scalar_t tolerance = 0.0);
+
+/**
+ * Builds the projection sets of the PIPG solver from the inequality constraints of the nodes of an OCP with N stages. The simple bounds
+ * and the general constraints which only depend on either the state or the input of a node become projection sets. General constraints
+ * coupling the state and the input of a node cannot be handled by a node-wise projection; they are skipped.
+ *
+ * If the problem is pre-conditioned, the sets are mapped to the scaled variables: u[k] = D[2k] .* u~[k] and x[k+1] = D[2k+1] .* x~[k+1].
+ *
+ * @param [in] constraints : Inequality constraints of the N + 1 nodes.
+ * @param [in] D : The input and state scaling of the pre-conditioning, see precondition::ocpDataInPlaceInParallel. Pass nullptr if the
+ *                 problem is not scaled.
+ * @param [out] sets : The projection sets. The memory is reused.
+ * @return The number of skipped general constraints.
+ */
+size_t toProjectionSets(const std::vector<NodeInequalityConstraints>& constraints, const vector_array_t* D, ProjectionSets& sets);
+
+}  // namespace pipg
+}  // namespace ocs2
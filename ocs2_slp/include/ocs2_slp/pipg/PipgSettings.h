@@ -42,6 +42,12 @@ struct Settings {
   scalar_t relativeTolerance = 1e-2;
   /** Number of iterations between consecutive calculation of termination conditions. **/
   size_t checkTerminationInterval = 1;
+  /** Adapt the step-size schedule to the ratio of the primal and fixed-point residuals. Evaluated with the termination conditions. **/
+  bool adaptiveStepSize = false;
+  /** The schedule skips ahead if the primal residual is larger than this ratio times the fixed-point residual. **/
+  scalar_t stepSizeResidualRatio = 3.0;
+  /** Maximum number of sweeps of Dykstra's method to project onto the intersection of bounds and halfspaces, see pipg::project. **/
+  size_t maxNumProjectionSweeps = 20;
   /** The static lower bound of the cost hessian H. **/
   scalar_t lowerBoundH = 5e-6;
   /** This value determines to display the a summary log. */
@@ -36,9 +36,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/Types.h>
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_oc/oc_problem/OcpLqArena.h>
 #include <ocs2_oc/oc_problem/OcpSize.h>
 
 #include "ocs2_slp/pipg/PipgBounds.h"
+#include "ocs2_slp/pipg/PipgProjection.h"
 #include "ocs2_slp/pipg/PipgSettings.h"
 #include "ocs2_slp/pipg/PipgSolverStatus.h"
 
@@ -69,6 +71,8 @@ class PipgSolver {
    *                              they become arbitrary diagonal matrices. Pass nullptr to get them filled with identity matrices.
    * @param [in] EInv : Inverse of the scaling factor E. Used to calculate un-sacled termination criteria.
    * @param [in] pipgBounds : The PipgBounds used to define the primal and dual stepsizes.
+   * @param [in] projectionSets : Convex sets of the states and inputs, which are enforced by the projection step. The sets are defined in
+   *                              the scaled variables. Pass nullptr for unbounded decision variables.
    * @param [out] xTrajectory : The optimized state trajectory.
    * @param [out] uTrajectory : The optimized input trajectory.
    * @return The solver status.
@@ -76,11 +80,25 @@ class PipgSolver {
   pipg::SolverStatus solve(ThreadPool& threadPool, const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
                            const std::vector<ScalarFunctionQuadraticApproximation>& cost,
                            const std::vector<VectorFunctionLinearApproximation>* constraints, const vector_array_t& scalingVectors,
-                           const vector_array_t* EInv, const pipg::PipgBounds& pipgBounds, vector_array_t& xTrajectory,
-                           vector_array_t& uTrajectory);
+                           const vector_array_t* EInv, const pipg::PipgBounds& pipgBounds, const pipg::ProjectionSets* projectionSets,
+                           vector_array_t& xTrajectory, vector_array_t& uTrajectory);
+
+  /**
+   * Solve the optimal control problem stored in an OcpLqArena in parallel. The blocks are read directly from the arena, see the
+   * overload above for the remaining arguments. The solver needs to be resized to lq.size() before calling this function.
+   */
+  pipg::SolverStatus solve(ThreadPool& threadPool, const vector_t& x0, const OcpLqArena& lq, const vector_array_t& scalingVectors,
+                           const vector_array_t* EInv, const pipg::PipgBounds& pipgBounds, const pipg::ProjectionSets* projectionSets,
+                           vector_array_t& xTrajectory, vector_array_t& uTrajectory);
 
   void resize(const OcpSize& size);
 
+  /** Number of iterations of the last solve */
+  size_t getNumIterations() const { return numIterations_; }
+
+  /** Number of adaptations of the step-size schedule in the last solve, see pipg::Settings::adaptiveStepSize */
+  size_t getNumStepSizeAdaptations() const { return numStepSizeAdaptations_; }
+
   int getNumDecisionVariables() const { return numDecisionVariables_; }
   int getNumDynamicsConstraints() const { return numDynamicsConstraints_; }
 
@@ -88,12 +106,19 @@ class PipgSolver {
   const pipg::Settings& settings() const { return settings_; }
 
  private:
+  template <typename LqView>
+  pipg::SolverStatus solveImpl(ThreadPool& threadPool, const vector_t& x0, const LqView& lq, const vector_array_t& scalingVectors,
+                               const vector_array_t* EInv, const pipg::PipgBounds& pipgBounds, const pipg::ProjectionSets* projectionSets,
+                               vector_array_t& xTrajectory, vector_array_t& uTrajectory);
+
   void verifySizes(const std::vector<VectorFunctionLinearApproximation>& dynamics,
                    const std::vector<ScalarFunctionQuadraticApproximation>& cost,
                    const std::vector<VectorFunctionLinearApproximation>* constraints) const;
 
   void verifyOcpSize(const OcpSize& ocpSize) const;
 
+  void verifyProjectionSets(const pipg::ProjectionSets& projectionSets) const;
+
   // Settings
   const pipg::Settings settings_;
 
@@ -105,6 +130,11 @@ class PipgSolver {
   // Data buffer for parallelized PIPG
   vector_array_t X_, W_, V_, U_;
   vector_array_t XNew_, UNew_, WNew_;
+  vector_array_t VNext_, primalResidual_;  // per-node buffers of the iteration, preallocated to keep the workers allocation free
+  std::vector<pipg::ProjectionWorkspace> projectionWorkspace_;
+
+  size_t numIterations_ = 0;
+  size_t numStepSizeAdaptations_ = 0;
 };
 
 }  // namespace ocs2
@@ -43,7 +43,7 @@ int getNumDynamicsConstraints(const ocs2::OcpSize& ocpSize) {
 }
 
 int getNumGeneralEqualityConstraints(const ocs2::OcpSize& ocpSize) {
-  return std::accumulate(ocpSize.numIneqConstraints.begin(), ocpSize.numIneqConstraints.end(), (int)0);
+  return std::accumulate(ocpSize.numEqConstraints.begin(), ocpSize.numEqConstraints.end(), (int)0);
 }
 }  // anonymous namespace
 
@@ -52,6 +52,8 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
 
   loadData::loadPtreeValue(pt, settings.slpIteration, fieldName + ".slpIteration", verbose);
   loadData::loadPtreeValue(pt, settings.scalingIteration, fieldName + ".scalingIteration", verbose);
+  loadData::loadPtreeValue(pt, settings.warmStartScaling, fieldName + ".warmStartScaling", verbose);
+  loadData::loadPtreeValue(pt, settings.warmStartScalingIteration, fieldName + ".warmStartScalingIteration", verbose);
   loadData::loadPtreeValue(pt, settings.deltaTol, fieldName + ".deltaTol", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_decay, fieldName + ".alpha_decay", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_min, fieldName + ".alpha_min", verbose);
@@ -61,11 +63,15 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.armijoFactor, fieldName + ".armijoFactor", verbose);
   loadData::loadPtreeValue(pt, settings.costTol, fieldName + ".costTol", verbose);
   loadData::loadPtreeValue(pt, settings.dt, fieldName + ".dt", verbose);
+  loadData::loadPtreeValue(pt, settings.dtGrowthRate, fieldName + ".dtGrowthRate", verbose);
+  loadData::loadPtreeValue(pt, settings.dtMax, fieldName + ".dtMax", verbose);
+  loadData::loadPtreeValue(pt, settings.dynamicsDefectRefinementTolerance, fieldName + ".dynamicsDefectRefinementTolerance", verbose);
   auto integratorName = sensitivity_integrator::toString(settings.integratorType);
   loadData::loadPtreeValue(pt, integratorName, fieldName + ".integratorType", verbose);
   settings.integratorType = sensitivity_integrator::fromString(integratorName);
   loadData::loadPtreeValue(pt, settings.inequalityConstraintMu, fieldName + ".inequalityConstraintMu", verbose);
   loadData::loadPtreeValue(pt, settings.inequalityConstraintDelta, fieldName + ".inequalityConstraintDelta", verbose);
+  loadData::loadPtreeValue(pt, settings.projectInequalityConstraints, fieldName + ".projectInequalityConstraints", verbose);
   loadData::loadPtreeValue(pt, settings.extractProjectionMultiplier, fieldName + ".extractProjectionMultiplier", verbose);
   loadData::loadPtreeValue(pt, settings.printSolverStatus, fieldName + ".printSolverStatus", verbose);
   loadData::loadPtreeValue(pt, settings.printSolverStatistics, fieldName + ".printSolverStatistics", verbose);
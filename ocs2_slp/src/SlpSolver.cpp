@@ -93,7 +93,14 @@ void SlpSolver::reset() {
   lambdaEstimation_.reset();
   sigmaEstimation_.reset();
   preConditioning_.reset();
+  warmStartedPreConditioning_.reset();
   pipgSolverTimer_.reset();
+
+  // clear the warm start of the pre-conditioning
+  scalingTime_.clear();
+  scalingD_.clear();
+  scalingE_.clear();
+  scalingC_ = 1.0;
 }
 
 std::string SlpSolver::getBenchmarkingInformationPIPG() const {
@@ -112,6 +119,16 @@ std::string SlpSolver::getBenchmarkingInformationPIPG() const {
     infoStream << "PIPG Benchmarking\t       :\tAverage time [ms]   (% of total runtime)\n";
     infoStream << "\tpreConditioning        :\t" << std::setw(10) << preConditioning_.getAverageInMilliseconds() << " [ms] \t("
                << preConditioning / benchmarkTotal * inPercent << "%)\n";
+    // Time saved by the warm start, estimated with the average time of the pre-conditioning from scratch
+    const auto numWarmStarted = warmStartedPreConditioning_.getNumTimedIntervals();
+    const auto numColdStarted = preConditioning_.getNumTimedIntervals() - numWarmStarted;
+    if (numWarmStarted > 0 && numColdStarted > 0) {
+      const auto warmStarted = warmStartedPreConditioning_.getTotalInMilliseconds();
+      const auto coldStartedAverage = (preConditioning - warmStarted) / static_cast<scalar_t>(numColdStarted);
+      infoStream << "\t  warm-started         :\t" << std::setw(10) << warmStartedPreConditioning_.getAverageInMilliseconds() << " [ms] \t("
+                 << numWarmStarted << " of " << preConditioning_.getNumTimedIntervals() << " calls, "
+                 << numWarmStarted * coldStartedAverage - warmStarted << " [ms] saved in total)\n";
+    }
     infoStream << "\tlambdaEstimation       :\t" << std::setw(10) << lambdaEstimation_.getAverageInMilliseconds() << " [ms] \t("
                << lambdaEstimation / benchmarkTotal * inPercent << "%)\n";
     infoStream << "\tsigmaEstimation        :\t" << std::setw(10) << sigmaEstimation_.getAverageInMilliseconds() << " [ms] \t("
@@ -165,7 +182,12 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
 
   // Determine time discretization, taking into account event times.
   const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
-  const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
+  auto timeDiscretization = geometricTimeDiscretizationWithEvents(initTime, finalTime, settings_.dt, settings_.dtGrowthRate,
+                                                                   settings_.dtMax, eventTimes);
+  if (settings_.dynamicsDefectRefinementTolerance > 0.0) {
+    timeDiscretization = multiple_shooting::refineTimeDiscretization(timeDiscretization, primalSolution_, problemMetrics_,
+                                                                     settings_.dynamicsDefectRefinementTolerance);
+  }
 
   // Initialize references
   for (auto& ocpDefinition : ocpDefinitions_) {
@@ -200,7 +222,7 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     // Solve LP
     solveQpTimer_.startTimer();
     const vector_t delta_x0 = initState - x[0];
-    const auto deltaSolution = getOCPSolution(delta_x0);
+    const auto deltaSolution = getOCPSolution(timeDiscretization, delta_x0);
     solveQpTimer_.endTimer();
 
     // Apply step
@@ -236,7 +258,7 @@ void SlpSolver::runParallel(std::function<void(int)> taskFunction) {
   threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
 }
 
-SlpSolver::OcpSubproblemSolution SlpSolver::getOCPSolution(const vector_t& delta_x0) {
+SlpSolver::OcpSubproblemSolution SlpSolver::getOCPSolution(const std::vector<AnnotatedTime>& time, const vector_t& delta_x0) {
   // Solve the QP
   OcpSubproblemSolution solution;
   auto& deltaXSol = solution.deltaXSol;
@@ -250,10 +272,39 @@ SlpSolver::OcpSubproblemSolution SlpSolver::getOCPSolution(const vector_t& delta
   scalar_t c;
   vector_array_t D, E;
   vector_array_t scalingVectors;
-  precondition::ocpDataInPlaceInParallel(threadPool_, delta_x0, pipgSolver_.size(), settings_.scalingIteration, dynamics_, cost_, D, E,
-                                         scalingVectors, c);
+  const auto timeTrajectory = toTime(time);
+  if (settings_.warmStartScaling && !scalingTime_.empty()) {
+    // seed with the factors of the last LP, which might be of the previous MPC call
+    warmStartedPreConditioning_.startTimer();
+    vector_array_t DInit, EInit;
+    precondition::shiftScalingFactors(scalingTime_, scalingD_, scalingE_, timeTrajectory, DInit, EInit);
+    precondition::ocpDataInPlaceInParallel(threadPool_, delta_x0, pipgSolver_.size(), settings_.warmStartScalingIteration, DInit, EInit,
+                                           scalingC_, dynamics_, cost_, D, E, scalingVectors, c);
+    warmStartedPreConditioning_.endTimer();
+  } else {
+    precondition::ocpDataInPlaceInParallel(threadPool_, delta_x0, pipgSolver_.size(), settings_.scalingIteration, dynamics_, cost_, D, E,
+                                           scalingVectors, c);
+  }
+  if (settings_.warmStartScaling) {
+    scalingTime_ = timeTrajectory;
+    scalingD_ = D;
+    scalingE_ = E;
+    scalingC_ = c;
+  }
   preConditioning_.endTimer();
 
+  // the inequality constraints are enforced by the projection step of PIPG. The sets are defined in the scaled variables.
+  const pipg::ProjectionSets* projectionSets = nullptr;
+  if (settings_.projectInequalityConstraints) {
+    const size_t numSkippedConstraints = pipg::toProjectionSets(inequalityConstraints_, &D, projectionSets_);
+    if (numSkippedConstraints > 0) {
+      throw std::runtime_error("[SlpSolver] " + std::to_string(numSkippedConstraints) +
+                               " inequality constraints couple the state and the input and cannot be projected by PIPG. Only state-only or "
+                               "input-only constraints are supported with projectInequalityConstraints.");
+    }
+    projectionSets = &projectionSets_;
+  }
+
   // estimate mu and lambda: mu I < H < lambda I
   const auto muEstimated = [&]() {
     scalar_t maxScalingFactor = -1;
@@ -278,8 +329,8 @@ SlpSolver::OcpSubproblemSolution SlpSolver::getOCPSolution(const vector_t& delta
   vector_array_t EInv(E.size());
   std::transform(E.begin(), E.end(), EInv.begin(), [](const vector_t& v) { return v.cwiseInverse(); });
   const pipg::PipgBounds pipgBounds{muEstimated, lambdaScaled, sigmaScaled};
-  const auto pipgStatus =
-      pipgSolver_.solve(threadPool_, delta_x0, dynamics_, cost_, nullptr, scalingVectors, &EInv, pipgBounds, deltaXSol, deltaUSol);
+  const auto pipgStatus = pipgSolver_.solve(threadPool_, delta_x0, dynamics_, cost_, nullptr, scalingVectors, &EInv, pipgBounds,
+                                            projectionSets, deltaXSol, deltaUSol);
   pipgSolverTimer_.endTimer();
 
   // to determine if the solution is a descent direction for the cost: compute gradient(cost)' * [dx; du]
@@ -312,6 +363,10 @@ PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   constraintsProjection_.resize(N);
   projectionMultiplierCoefficients_.resize(N);
   metrics.resize(N + 1);
+  if (settings_.projectInequalityConstraints) {
+    inequalityConstraints_.resize(N + 1);
+  }
+  const VectorFunctionLinearApproximation noConstraints;  // state-input constraints of the terminal node
 
   std::atomic_int timeIndex{0};
   auto parallelTask = [&](int workerId) {
@@ -350,6 +405,11 @@ PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<Annotated
         projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
       }
 
+      if (settings_.projectInequalityConstraints) {
+        splitInequalityConstraints(x[i].size(), dynamics_[i].dfdu.cols(), stateIneqConstraints_[i], stateInputIneqConstraints_[i], true,
+                                   inequalityConstraints_[i]);
+      }
+
       i = timeIndex++;
     }
 
@@ -360,6 +420,9 @@ PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<Annotated
       workerPerformance += multiple_shooting::computePerformanceIndex(result);
       cost_[i] = std::move(result.cost);
       stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+      if (settings_.projectInequalityConstraints) {
+        splitInequalityConstraints(x[i].size(), 0, stateIneqConstraints_[i], noConstraints, true, inequalityConstraints_[i]);
+      }
     }
 
     // Accumulate! Same worker might run multiple tasks
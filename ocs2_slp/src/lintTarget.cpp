@@ -28,6 +28,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include <ocs2_slp/pipg/PipgBounds.h>
+#include <ocs2_slp/pipg/PipgProjection.h>
 #include <ocs2_slp/pipg/PipgSettings.h>
 #include <ocs2_slp/pipg/PipgSolver.h>
 #include <ocs2_slp/pipg/PipgSolverStatus.h>
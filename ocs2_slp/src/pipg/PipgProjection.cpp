@@ -0,0 +1,253 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_slp/pipg/PipgProjection.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ocs2 {
+namespace pipg {
+
+namespace {
+/** Projects z onto the bounds of the set by clamping */
+void clamp(const ProjectionSet& set, vector_t& z) {
+  for (size_t i = 0; i < set.idxb.size(); ++i) {
+    auto& zi = z(set.idxb[i]);
+    zi = std::min(std::max(zi, set.lb(i)), set.ub(i));
+  }
+}
+
+/**
+ * Projects y onto the intersection of the bounds and the halfspace G.row(j) * z >= g(j). The projection is z(nu) = clamp(y + nu * a)
+ * with a = G.row(j)' and the multiplier nu >= 0 of the halfspace. Since a' z(nu) is piecewise linear and non-decreasing in nu, nu is
+ * found exactly by walking along the breakpoints, where a variable hits its bound.
+ */
+void projectOntoBoundedHalfspace(const ProjectionSet& set, int j, const vector_t& y, vector_t& z, vector_t& breakpoints) {
+  const auto a = set.G.row(j).transpose();
+  const auto evaluate = [&](scalar_t nu) {
+    z = y + nu * a;
+    clamp(set, z);
+    return a.dot(z);
+  };
+
+  scalar_t nuLast = 0.0;
+  scalar_t valueLast = evaluate(nuLast);
+  if (valueLast >= set.g(j)) {
+    return;
+  }
+
+  // Multipliers at which a bounded variable becomes clamped or unclamped
+  breakpoints.resize(2 * set.idxb.size());
+  int numBreakpoints = 0;
+  for (size_t i = 0; i < set.idxb.size(); ++i) {
+    const scalar_t ai = a(set.idxb[i]);
+    if (ai != 0.0) {
+      for (const scalar_t bound : {set.lb(i), set.ub(i)}) {
+        const scalar_t nu = (bound - y(set.idxb[i])) / ai;
+        if (nu > 0.0 && std::isfinite(nu)) {
+          breakpoints(numBreakpoints++) = nu;
+        }
+      }
+    }
+  }
+  std::sort(breakpoints.data(), breakpoints.data() + numBreakpoints);
+
+  for (int i = 0; i < numBreakpoints; ++i) {
+    const scalar_t value = evaluate(breakpoints(i));
+    if (value >= set.g(j)) {
+      // a' z(nu) is linear between the last two breakpoints
+      const scalar_t nu = nuLast + (set.g(j) - valueLast) / (value - valueLast) * (breakpoints(i) - nuLast);
+      evaluate(nu);
+      return;
+    }
+    nuLast = breakpoints(i);
+    valueLast = value;
+  }
+
+  // Beyond the last breakpoint, the slope is the squared norm of a over the unclamped variables
+  const scalar_t slope = evaluate(nuLast + 1.0) - valueLast;
+  evaluate(slope > 0.0 ? nuLast + (set.g(j) - valueLast) / slope : nuLast);  // The set is empty if the slope is zero
+}
+}  // namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void project(const ProjectionSet& set, size_t maxNumSweeps, vector_t& z, ProjectionWorkspace& workspace) {
+  const int numHalfspaces = set.numHalfspaces();
+  if (numHalfspaces == 0) {
+    clamp(set, z);
+    return;
+  }
+  if (isInSet(set, z)) {
+    return;
+  }
+  if (numHalfspaces == 1) {
+    workspace.y = z;
+    projectOntoBoundedHalfspace(set, 0, workspace.y, z, workspace.breakpoints);
+    return;
+  }
+
+  // Dykstra's method on the sets "bounds and halfspace j", each of which is projected exactly.
+  workspace.increments.setZero(z.size(), numHalfspaces);
+  for (size_t sweep = 0; sweep < maxNumSweeps; ++sweep) {
+    // Dykstra's method has converged if a sweep does not change the increments.
+    scalar_t incrementChange = 0.0;
+    for (int j = 0; j < numHalfspaces; ++j) {
+      auto increment = workspace.increments.col(j);
+      workspace.y = z + increment;
+      projectOntoBoundedHalfspace(set, j, workspace.y, z, workspace.breakpoints);
+      incrementChange = std::max(incrementChange, (workspace.y - z - increment).lpNorm<Eigen::Infinity>());
+      increment = workspace.y - z;
+    }
+
+    const scalar_t tolerance = 100.0 * std::numeric_limits<scalar_t>::epsilon() * (1.0 + z.lpNorm<Eigen::Infinity>());
+    if (incrementChange <= tolerance) {
+      break;
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool isInSet(const ProjectionSet& set, const vector_t& z, scalar_t tolerance) {
+  for (size_t i = 0; i < set.idxb.size(); ++i) {
+    const scalar_t zi = z(set.idxb[i]);
+    if (zi < set.lb(i) - tolerance || zi > set.ub(i) + tolerance) {
+      return false;
+    }
+  }
+  for (int i = 0; i < set.numHalfspaces(); ++i) {
+    if (set.G.row(i).dot(z) < set.g(i) - tolerance) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t toProjectionSets(const std::vector<NodeInequalityConstraints>& constraints, const vector_array_t* D, ProjectionSets& sets) {
+  if (constraints.empty()) {
+    throw std::runtime_error("[pipg::toProjectionSets] The constraints of at least one node are required.");
+  }
+  const int N = static_cast<int>(constraints.size()) - 1;
+  if (D != nullptr && D->size() != 2 * N) {
+    throw std::runtime_error("[pipg::toProjectionSets] The size of the scaling D doesn't match the number of stages.");
+  }
+
+  sets.state.resize(N + 1);
+  sets.input.resize(N);
+  size_t numSkipped = 0;
+  for (int k = 0; k <= N; ++k) {
+    const auto& nodeConstraints = constraints[k];
+    auto& stateSet = sets.state[k];
+
+    // Simple bounds
+    stateSet.idxb = nodeConstraints.idxbx;
+    stateSet.lb = nodeConstraints.lbx;
+    stateSet.ub = nodeConstraints.ubx;
+    if (k < N) {
+      auto& inputSet = sets.input[k];
+      inputSet.idxb = nodeConstraints.idxbu;
+      inputSet.lb = nodeConstraints.lbu;
+      inputSet.ub = nodeConstraints.ubu;
+    }
+
+    // General constraints on either the state or the input
+    const auto& C = nodeConstraints.C;
+    const auto& Du = nodeConstraints.D;
+    const auto isStateOnly = [&](int i) { return Du.cols() == 0 || Du.row(i).isZero(0.0); };
+    const auto isInputOnly = [&](int i) { return C.cols() == 0 || C.row(i).isZero(0.0); };
+    int numStateRows = 0;
+    int numInputRows = 0;
+    for (int i = 0; i < nodeConstraints.numGeneralConstraints(); ++i) {
+      if (isStateOnly(i) && isInputOnly(i)) {
+        continue;  // constant constraint, nothing to project
+      } else if (isStateOnly(i)) {
+        ++numStateRows;
+      } else if (isInputOnly(i) && k < N) {
+        ++numInputRows;
+      } else {
+        ++numSkipped;
+      }
+    }
+    stateSet.G.resize(numStateRows, C.cols());
+    stateSet.g.resize(numStateRows);
+    if (k < N) {
+      sets.input[k].G.resize(numInputRows, Du.cols());
+      sets.input[k].g.resize(numInputRows);
+    }
+    int stateRow = 0;
+    int inputRow = 0;
+    for (int i = 0; i < nodeConstraints.numGeneralConstraints(); ++i) {
+      if (isStateOnly(i) && isInputOnly(i)) {
+        continue;
+      } else if (isStateOnly(i)) {
+        stateSet.G.row(stateRow) = C.row(i);
+        stateSet.g(stateRow++) = nodeConstraints.lg(i);
+      } else if (isInputOnly(i) && k < N) {
+        sets.input[k].G.row(inputRow) = Du.row(i);
+        sets.input[k].g(inputRow++) = nodeConstraints.lg(i);
+      }
+    }
+
+    // Map to the scaled variables: z = s .* z~  =>  lb / s <= z~ and G diag(s) z~ >= g
+    const auto scaleSet = [](const vector_t& s, ProjectionSet& set) {
+      for (size_t i = 0; i < set.idxb.size(); ++i) {
+        set.lb(i) /= s(set.idxb[i]);
+        set.ub(i) /= s(set.idxb[i]);
+      }
+      set.G.array().rowwise() *= s.transpose().array();
+    };
+    if (D != nullptr && k > 0) {
+      scaleSet((*D)[2 * k - 1], stateSet);
+    }
+    if (D != nullptr && k < N) {
+      scaleSet((*D)[2 * k], sets.input[k]);
+    }
+  }
+
+  // The initial state is fixed
+  auto& initialStateSet = sets.state[0];
+  initialStateSet.idxb.clear();
+  initialStateSet.lb.resize(0);
+  initialStateSet.ub.resize(0);
+  initialStateSet.G.resize(0, 0);
+  initialStateSet.g.resize(0);
+
+  return numSkipped;
+}
+
+}  // namespace pipg
+}  // namespace ocs2
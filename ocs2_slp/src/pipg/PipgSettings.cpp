@@ -56,6 +56,9 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.lowerBoundH, fieldName + ".lowerBoundH", verbose);
 
   loadData::loadPtreeValue(pt, settings.checkTerminationInterval, fieldName + ".checkTerminationInterval", verbose);
+  loadData::loadPtreeValue(pt, settings.adaptiveStepSize, fieldName + ".adaptiveStepSize", verbose);
+  loadData::loadPtreeValue(pt, settings.stepSizeResidualRatio, fieldName + ".stepSizeResidualRatio", verbose);
+  loadData::loadPtreeValue(pt, settings.maxNumProjectionSweeps, fieldName + ".maxNumProjectionSweeps", verbose);
   loadData::loadPtreeValue(pt, settings.displayShortSummary, fieldName + ".displayShortSummary", verbose);
 
   if (verbose) {
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_slp/pipg/PipgSolver.h"
 
+#include <algorithm>
 #include <condition_variable>
 #include <iostream>
 #include <mutex>
@@ -36,6 +37,37 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace ocs2 {
 
+namespace {
+/** Read access to the LQ blocks stored in arrays of OCS2 approximations */
+struct ArrayView {
+  const std::vector<VectorFunctionLinearApproximation>& dynamics;
+  const std::vector<ScalarFunctionQuadraticApproximation>& cost;
+
+  const matrix_t& A(int t) const { return dynamics[t].dfdx; }
+  const matrix_t& B(int t) const { return dynamics[t].dfdu; }
+  const vector_t& b(int t) const { return dynamics[t].f; }
+  const matrix_t& Q(int t) const { return cost[t].dfdxx; }
+  const matrix_t& P(int t) const { return cost[t].dfdux; }
+  const matrix_t& R(int t) const { return cost[t].dfduu; }
+  const vector_t& q(int t) const { return cost[t].dfdx; }
+  const vector_t& r(int t) const { return cost[t].dfdu; }
+};
+
+/** Read access to the LQ blocks stored in an OcpLqArena */
+struct ArenaView {
+  const OcpLqArena& lq;
+
+  OcpLqArena::const_matrix_map_t A(int t) const { return lq.A(t); }
+  OcpLqArena::const_matrix_map_t B(int t) const { return lq.B(t); }
+  OcpLqArena::const_vector_map_t b(int t) const { return lq.b(t); }
+  OcpLqArena::const_matrix_map_t Q(int t) const { return lq.Q(t); }
+  OcpLqArena::const_matrix_map_t P(int t) const { return lq.S(t); }
+  OcpLqArena::const_matrix_map_t R(int t) const { return lq.R(t); }
+  OcpLqArena::const_vector_map_t q(int t) const { return lq.q(t); }
+  OcpLqArena::const_vector_map_t r(int t) const { return lq.r(t); }
+};
+}  // namespace
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -50,8 +82,32 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
                                      const std::vector<ScalarFunctionQuadraticApproximation>& cost,
                                      const std::vector<VectorFunctionLinearApproximation>* constraints,
                                      const vector_array_t& scalingVectors, const vector_array_t* EInv, const pipg::PipgBounds& pipgBounds,
-                                     vector_array_t& xTrajectory, vector_array_t& uTrajectory) {
+                                     const pipg::ProjectionSets* projectionSets, vector_array_t& xTrajectory, vector_array_t& uTrajectory) {
   verifySizes(dynamics, cost, constraints);
+  return solveImpl(threadPool, x0, ArrayView{dynamics, cost}, scalingVectors, EInv, pipgBounds, projectionSets, xTrajectory, uTrajectory);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0, const OcpLqArena& lq, const vector_array_t& scalingVectors,
+                                     const vector_array_t* EInv, const pipg::PipgBounds& pipgBounds,
+                                     const pipg::ProjectionSets* projectionSets, vector_array_t& xTrajectory, vector_array_t& uTrajectory) {
+  if (lq.numStages() != ocpSize_.numStages) {
+    throw std::runtime_error("[PipgSolver::solve] Inconsistent number of stages in the LQ arena: " + std::to_string(lq.numStages()) +
+                             " with " + std::to_string(ocpSize_.numStages) + " number of stages.");
+  }
+  return solveImpl(threadPool, x0, ArenaView{lq}, scalingVectors, EInv, pipgBounds, projectionSets, xTrajectory, uTrajectory);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename LqView>
+pipg::SolverStatus PipgSolver::solveImpl(ThreadPool& threadPool, const vector_t& x0, const LqView& lq, const vector_array_t& scalingVectors,
+                                         const vector_array_t* EInv, const pipg::PipgBounds& pipgBounds,
+                                         const pipg::ProjectionSets* projectionSets, vector_array_t& xTrajectory,
+                                         vector_array_t& uTrajectory) {
   const int N = ocpSize_.numStages;
   if (N < 1) {
     throw std::runtime_error("[PipgSolver::solve] The number of stages cannot be less than 1.");
@@ -59,32 +115,37 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
   if (scalingVectors.size() != N) {
     throw std::runtime_error("[PipgSolver::solve] The size of scalingVectors doesn't match the number of stage.");
   }
+  if (projectionSets != nullptr) {
+    verifyProjectionSets(*projectionSets);
+  }
 
   // Disable Eigen's internal multithreading
   Eigen::setNbThreads(1);
 
-  vector_array_t primalResidualArray(N);
   scalar_array_t constraintsViolationInfNormArray(N);
-  scalar_t constraintsViolationInfNorm;
+  scalar_t constraintsViolationInfNorm = 0.0;
 
-  scalar_t solutionSSE, solutionSquaredNorm;
+  scalar_t solutionSSE = 0.0, solutionSquaredNorm = 0.0;
   scalar_array_t solutionSEArray(N);
   scalar_array_t solutionSquaredNormArray(N);
+  scalar_array_t primalResidualSquaredNormArray(N);
 
   // initial state
   X_[0] = x0;
   XNew_[0] = x0;
   // cold start
   for (int t = 0; t < N; t++) {
-    X_[t + 1].setZero(dynamics[t].dfdx.rows());
-    U_[t].setZero(dynamics[t].dfdu.cols());
-    W_[t].setZero(dynamics[t].dfdx.rows());
+    X_[t + 1].setZero(lq.A(t).rows());
+    U_[t].setZero(lq.B(t).cols());
+    W_[t].setZero(lq.A(t).rows());
     // WNew_ will NOT be filled, but will be swapped to W_ in iteration 0. Thus, initialize WNew_ here.
-    WNew_[t].setZero(dynamics[t].dfdx.rows());
+    WNew_[t].setZero(lq.A(t).rows());
   }
 
-  scalar_t alpha = pipgBounds.primalStepSize(0);
-  scalar_t beta = pipgBounds.primalStepSize(0);
+  pipg::PipgStepSizeSchedule stepSizes(pipgBounds, settings());
+  scalar_t alpha = stepSizes.primalStepSize(0);
+  scalar_t alphaLast = alpha;
+  scalar_t beta = stepSizes.primalStepSize(0);
   scalar_t betaLast = 0;
 
   size_t k = 0;
@@ -112,54 +173,61 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
         // Multi-thread performance analysis
         ++threadsWorkloadCounter[workerId];
 
-        // PIPG algorithm
-        const auto& A = dynamics[t - 1].dfdx;
-        const auto& B = dynamics[t - 1].dfdu;
+        // PIPG algorithm. The termination conditions are only evaluated every checkTerminationInterval iterations.
+        const bool checkTermination = k != 0 && k % settings().checkTerminationInterval == 0;
+        const auto& A = lq.A(t - 1);
+        const auto& B = lq.B(t - 1);
         const auto& C = scalingVectors[t - 1];
-        const auto& b = dynamics[t - 1].f;
-
-        const auto& R = cost[t - 1].dfduu;
-        const auto& Q = cost[t].dfdxx;
-        const auto& P = cost[t - 1].dfdux;
-        const auto& q = cost[t].dfdx;
-        const auto& r = cost[t - 1].dfdu;
+        const auto& b = lq.b(t - 1);
+
+        const auto& R = lq.R(t - 1);
+        const auto& Q = lq.Q(t);
+        const auto& P = lq.P(t - 1);
+        const auto& q = lq.q(t);
+        const auto& r = lq.r(t - 1);
+
+        // The primal residual of the last iterate is shared by the update of W and V.
+        // primalResidual = C * X_[t] - A * X_[t - 1] - B * U_[t - 1] - b
+        auto& primalResidual = primalResidual_[t - 1];
+        primalResidual = -b;
+        primalResidual.array() += C.array() * X_[t].array();
+        primalResidual.noalias() -= A * X_[t - 1];
+        primalResidual.noalias() -= B * U_[t - 1];
 
         if (k != 0) {
           // Update W of the iteration k - 1. Move the update of W to the front of the calculation of V to prevent data race.
-          // vector_t primalResidual = C * X_[t] - A * X_[t - 1] - B * U_[t - 1] - b;
-          primalResidualArray[t - 1] = -b;
-          primalResidualArray[t - 1].array() += C.array() * X_[t].array();
-          primalResidualArray[t - 1].noalias() -= A * X_[t - 1];
-          primalResidualArray[t - 1].noalias() -= B * U_[t - 1];
-          if (EInv != nullptr) {
-            constraintsViolationInfNormArray[t - 1] = (*EInv)[t - 1].cwiseProduct(primalResidualArray[t - 1]).lpNorm<Eigen::Infinity>();
-          } else {
-            constraintsViolationInfNormArray[t - 1] = primalResidualArray[t - 1].lpNorm<Eigen::Infinity>();
+          WNew_[t - 1] = W_[t - 1] + betaLast * primalResidual;
+
+          if (checkTermination) {
+            if (EInv != nullptr) {
+              constraintsViolationInfNormArray[t - 1] = (*EInv)[t - 1].cwiseProduct(primalResidual).lpNorm<Eigen::Infinity>();
+            } else {
+              constraintsViolationInfNormArray[t - 1] = primalResidual.lpNorm<Eigen::Infinity>();
+            }
+
+            // What stored in UNew and XNew is the solution of iteration k - 2 and what stored in U and X is the solution of iteration
+            // k - 1. By convention, iteration starts from 0 and the solution of iteration -1 is the initial value. Reuse UNew and XNew
+            // memory to store the difference between the last solution and the one before last solution.
+            UNew_[t - 1] -= U_[t - 1];
+            XNew_[t] -= X_[t];
+
+            solutionSEArray[t - 1] = UNew_[t - 1].squaredNorm() + XNew_[t].squaredNorm();
+            solutionSquaredNormArray[t - 1] = U_[t - 1].squaredNorm() + X_[t].squaredNorm();
+            primalResidualSquaredNormArray[t - 1] = primalResidual.squaredNorm();
           }
-
-          WNew_[t - 1] = W_[t - 1] + betaLast * primalResidualArray[t - 1];
-
-          // What stored in UNew and XNew is the solution of iteration k - 2 and what stored in U and X is the solution of iteration k
-          // - 1. By convention, iteration starts from 0 and the solution of iteration -1 is the initial value. Reuse UNew and XNew
-          // memory to store the difference between the last solution and the one before last solution.
-          UNew_[t - 1] -= U_[t - 1];
-          XNew_[t] -= X_[t];
-
-          solutionSEArray[t - 1] = UNew_[t - 1].squaredNorm() + XNew_[t].squaredNorm();
-          solutionSquaredNormArray[t - 1] = U_[t - 1].squaredNorm() + X_[t].squaredNorm();
         }
 
         // V_[t - 1] = W_[t - 1] + (beta + betaLast) * (C * X_[t] - A * X_[t - 1] - B * U_[t - 1] - b);
-        V_[t - 1] = W_[t - 1] - (beta + betaLast) * b;
-        V_[t - 1].array() += (beta + betaLast) * C.array() * X_[t].array();
-        V_[t - 1].noalias() -= (beta + betaLast) * (A * X_[t - 1]);
-        V_[t - 1].noalias() -= (beta + betaLast) * (B * U_[t - 1]);
+        V_[t - 1] = W_[t - 1] + (beta + betaLast) * primalResidual;
 
         // UNew_[t - 1] = U_[t - 1] - alpha * (R * U_[t - 1] + P * X_[t - 1] + r - B.transpose() * V_[t - 1]);
         UNew_[t - 1] = U_[t - 1] - alpha * r;
         UNew_[t - 1].noalias() -= alpha * (R * U_[t - 1]);
         UNew_[t - 1].noalias() -= alpha * (P * X_[t - 1]);
         UNew_[t - 1].noalias() += alpha * (B.transpose() * V_[t - 1]);
+        if (projectionSets != nullptr) {
+          pipg::project(projectionSets->input[t - 1], settings().maxNumProjectionSweeps, UNew_[t - 1], projectionWorkspace_[t - 1]);
+        }
 
         // XNew_[t] = X_[t] - alpha * (Q * X_[t] + q + C * V_[t - 1]);
         XNew_[t] = X_[t] - alpha * q;
@@ -167,16 +235,18 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
         XNew_[t].noalias() -= alpha * (Q * X_[t]);
 
         if (t != N) {
-          const auto& ANext = dynamics[t].dfdx;
-          const auto& BNext = dynamics[t].dfdu;
+          const auto& ANext = lq.A(t);
+          const auto& BNext = lq.B(t);
           const auto& CNext = scalingVectors[t];
-          const auto& bNext = dynamics[t].f;
+          const auto& bNext = lq.b(t);
 
           // dfdux
-          const auto& PNext = cost[t].dfdux;
+          const auto& PNext = lq.P(t);
 
-          // vector_t VNext = W_[t] + (beta + betaLast) * (CNext * X_[t + 1] - ANext * X_[t] - BNext * U_[t] - bNext);
-          vector_t VNext = W_[t] - (beta + betaLast) * bNext;
+          // V_[t] is computed by the task of the next node in parallel, hence it is evaluated here again in a preallocated buffer.
+          // VNext = W_[t] + (beta + betaLast) * (CNext * X_[t + 1] - ANext * X_[t] - BNext * U_[t] - bNext);
+          auto& VNext = VNext_[t];
+          VNext = W_[t] - (beta + betaLast) * bNext;
           VNext.array() += (beta + betaLast) * CNext.array() * X_[t + 1].array();
           VNext.noalias() -= (beta + betaLast) * (ANext * X_[t]);
           VNext.noalias() -= (beta + betaLast) * (BNext * U_[t]);
@@ -185,6 +255,9 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
           // Add dfdxu * du if it is not the final state.
           XNew_[t].noalias() -= alpha * (PNext.transpose() * U_[t]);
         }
+        if (projectionSets != nullptr) {
+          pipg::project(projectionSets->state[t], settings().maxNumProjectionSweeps, XNew_[t], projectionWorkspace_[t - 1]);
+        }
 
         workerOrder = ++finishedTaskCounter;
       }
@@ -194,11 +267,6 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
         iterationFinished.wait(lk, [&shouldWait] { return !shouldWait; });
         lk.unlock();
       } else {
-        betaLast = beta;
-        // Adaptive step size
-        beta = pipgBounds.dualStepSize(k);
-        alpha = pipgBounds.primalStepSize(k);
-
         if (k != 0 && k % settings().checkTerminationInterval == 0) {
           constraintsViolationInfNorm =
               *(std::max_element(constraintsViolationInfNormArray.begin(), constraintsViolationInfNormArray.end()));
@@ -210,8 +278,18 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
                         (solutionSSE <= settings().relativeTolerance * settings().relativeTolerance * solutionSquaredNorm ||
                          solutionSSE <= settings().absoluteTolerance);
 
-          keepRunning = k < settings().maxNumIterations && !isConverged;
+          // The residuals are the ones of the last iterate, which was computed with the primal step size of the last iteration.
+          const scalar_t primalResidualSSE =
+              std::accumulate(primalResidualSquaredNormArray.begin(), primalResidualSquaredNormArray.end(), 0.0);
+          stepSizes.update(k, std::sqrt(primalResidualSSE), std::sqrt(solutionSSE) / alphaLast);
         }
+        keepRunning = k < settings().maxNumIterations && !isConverged;
+
+        alphaLast = alpha;
+        betaLast = beta;
+        // Adaptive step size
+        beta = stepSizes.dualStepSize(k);
+        alpha = stepSizes.primalStepSize(k);
 
         XNew_.swap(X_);
         UNew_.swap(U_);
@@ -232,6 +310,8 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
 
   xTrajectory = X_;
   uTrajectory = U_;
+  numIterations_ = k;
+  numStepSizeAdaptations_ = stepSizes.getNumAdaptations();
   const auto status = isConverged ? pipg::SolverStatus::SUCCESS : pipg::SolverStatus::MAX_ITER;
 
   if (settings().displayShortSummary) {
@@ -241,6 +321,7 @@ pipg::SolverStatus PipgSolver::solve(ThreadPool& threadPool, const vector_t& x0,
     std::cerr << "\n+++++++++++++++++++++++++++++++++++++++++++++\n";
     std::cerr << "Solver status: " << pipg::toString(status) << "\n";
     std::cerr << "Number of Iterations: " << k << " out of " << settings().maxNumIterations << "\n";
+    std::cerr << "Number of step-size adaptations: " << numStepSizeAdaptations_ << "\n";
     std::cerr << "Norm of delta primal solution: " << std::sqrt(solutionSSE) << "\n";
     std::cerr << "Constraints violation : " << constraintsViolationInfNorm << "\n";
     std::cerr << "Thread workload(ID: # of finished tasks): ";
@@ -274,6 +355,9 @@ void PipgSolver::resize(const OcpSize& ocpSize) {
   X_.resize(N + 1);
   W_.resize(N);
   V_.resize(N);
+  VNext_.resize(N);
+  primalResidual_.resize(N);
+  projectionWorkspace_.resize(N);
   U_.resize(N);
   XNew_.resize(N + 1);
   UNew_.resize(N);
@@ -325,4 +409,30 @@ void PipgSolver::verifyOcpSize(const OcpSize& ocpSize) const {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void PipgSolver::verifyProjectionSets(const pipg::ProjectionSets& projectionSets) const {
+  const int N = ocpSize_.numStages;
+  if (projectionSets.state.size() != N + 1 || projectionSets.input.size() != N) {
+    throw std::runtime_error("[PipgSolver::verifyProjectionSets] Inconsistent number of projection sets with " + std::to_string(N) +
+                             " number of stages.");
+  }
+
+  const auto verifySet = [](const pipg::ProjectionSet& set, int numVariables, int node) {
+    const bool boundsInRange = std::all_of(set.idxb.cbegin(), set.idxb.cend(), [&](int i) { return i >= 0 && i < numVariables; });
+    const bool consistentBounds = set.lb.size() == set.idxb.size() && set.ub.size() == set.idxb.size();
+    const bool consistentHalfspaces = set.G.rows() == set.g.size() && (set.g.size() == 0 || set.G.cols() == numVariables);
+    if (!boundsInRange || !consistentBounds || !consistentHalfspaces) {
+      throw std::runtime_error("[PipgSolver::verifyProjectionSets] Inconsistent projection set at node " + std::to_string(node) + ".");
+    }
+  };
+  for (int k = 1; k <= N; ++k) {
+    verifySet(projectionSets.state[k], ocpSize_.numStates[k], k);
+  }
+  for (int k = 0; k < N; ++k) {
+    verifySet(projectionSets.input[k], ocpSize_.numInputs[k], k);
+  }
+}
+
 }  // namespace ocs2
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_slp/pipg/SingleThreadPipg.h"
 
+#include <cmath>
 #include <iostream>
 #include <numeric>
 
@@ -46,13 +47,15 @@ SolverStatus singleThreadPipg(const pipg::Settings& settings, const Eigen::Spars
   vector_t w = vector_t::Zero(g.rows());
   vector_t constraintsViolation(g.rows());
 
+  PipgStepSizeSchedule stepSizes(pipgBounds, settings);
+
   // Iteration number
   size_t k = 0;
   bool isConverged = false;
   scalar_t constraintsViolationInfNorm;
   while (k < settings.maxNumIterations && !isConverged) {
-    const auto beta = pipgBounds.dualStepSize(k);
-    const auto alpha = pipgBounds.primalStepSize(k);
+    const auto beta = stepSizes.dualStepSize(k);
+    const auto alpha = stepSizes.primalStepSize(k);
 
     z_old.swap(z);
 
@@ -78,11 +81,10 @@ SolverStatus singleThreadPipg(const pipg::Settings& settings, const Eigen::Spars
 
       constraintsViolation.noalias() = G * z;
       constraintsViolation -= g;
-      constraintsViolation.cwiseProduct(EInv);
-      constraintsViolationInfNorm = constraintsViolation.lpNorm<Eigen::Infinity>();
+      const scalar_t z_deltaNorm = (z - z_old).squaredNorm();
+      stepSizes.update(k, constraintsViolation.norm(), std::sqrt(z_deltaNorm) / alpha);
 
-      const vector_t z_delta = z - z_old;
-      const scalar_t z_deltaNorm = z_delta.squaredNorm();
+      constraintsViolationInfNorm = constraintsViolation.cwiseProduct(EInv).lpNorm<Eigen::Infinity>();
       isConverged =
           constraintsViolationInfNorm <= settings.absoluteTolerance &&
           (z_deltaNorm <= settings.relativeTolerance * settings.relativeTolerance * zNorm || z_deltaNorm <= settings.absoluteTolerance);
@@ -100,6 +102,7 @@ SolverStatus singleThreadPipg(const pipg::Settings& settings, const Eigen::Spars
     std::cerr << "\n+++++++++++++++++++++++++++++++++++++++++++++\n";
     std::cerr << "Solver status: " << pipg::toString(status) << "\n";
     std::cerr << "Number of Iterations: " << k << " out of " << settings.maxNumIterations << "\n";
+    std::cerr << "Number of step-size adaptations: " << stepSizes.getNumAdaptations() << "\n";
     std::cerr << "Norm of delta primal solution: " << (stackedSolution - z_old).norm() << "\n";
     std::cerr << "Constraints violation : " << constraintsViolationInfNorm << "\n";
   }
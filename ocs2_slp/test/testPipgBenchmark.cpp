@@ -0,0 +1,153 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <iomanip>
+#include <iostream>
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_oc/oc_problem/OcpToKkt.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+#include <hpipm_catkin/HpipmInterface.h>
+
+#include "ocs2_slp/pipg/PipgSolver.h"
+#include "ocs2_slp/pipg/SingleThreadPipg.h"
+
+namespace {
+
+struct BenchmarkResult {
+  std::string name;
+  ocs2::benchmark::RepeatedTimer timer;
+  size_t numIterations = 0;
+  ocs2::scalar_t error = 0.0;  // inf-norm of the difference to the HPIPM solution
+};
+
+/** Compares the PIPG variants with HPIPM on a random problem of the kind used in the PIPG tests */
+void runBenchmark(int N, int nx, int nu, size_t numThreads) {
+  constexpr int numRepetitions = 3;
+  srand(10);
+
+  const ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> dynamicsArray;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> costArray;
+  for (int i = 0; i < N; i++) {
+    dynamicsArray.push_back(ocs2::getRandomDynamics(nx, nu));
+    costArray.push_back(ocs2::getRandomCost(nx, nu));
+  }
+  costArray.push_back(ocs2::getRandomCost(nx, 0));
+  const auto ocpSize = ocs2::extractSizesFromProblem(dynamicsArray, costArray, nullptr);
+
+  // Dense problem and the bounds of the step sizes
+  ocs2::ScalarFunctionQuadraticApproximation costApproximation;
+  ocs2::VectorFunctionLinearApproximation constraintsApproximation;
+  ocs2::getCostMatrix(ocpSize, x0, costArray, costApproximation);
+  ocs2::getConstraintMatrix(ocpSize, x0, dynamicsArray, nullptr, nullptr, constraintsApproximation);
+  const Eigen::SparseMatrix<ocs2::scalar_t> H = costApproximation.dfdxx.sparseView();
+  const Eigen::SparseMatrix<ocs2::scalar_t> G = constraintsApproximation.dfdx.sparseView();
+  const Eigen::SelfAdjointEigenSolver<ocs2::matrix_t> eigH(costApproximation.dfdxx);
+  const Eigen::SelfAdjointEigenSolver<ocs2::matrix_t> eigGTG(constraintsApproximation.dfdx.transpose() * constraintsApproximation.dfdx);
+  const ocs2::pipg::PipgBounds pipgBounds{eigH.eigenvalues().minCoeff(), eigH.eigenvalues().maxCoeff(), eigGTG.eigenvalues().maxCoeff()};
+
+  ocs2::pipg::Settings settings;
+  settings.maxNumIterations = 30000;
+  settings.absoluteTolerance = 1e-6;
+  settings.relativeTolerance = 1e-4;
+  settings.checkTerminationInterval = 10;
+  auto adaptiveSettings = settings;
+  adaptiveSettings.adaptiveStepSize = true;
+
+  // Reference
+  BenchmarkResult hpipm{"HPIPM"};
+  ocs2::HpipmInterface hpipmInterface(ocpSize);
+  ocs2::vector_array_t X, U;
+  ocs2::vector_t hpipmSolution;
+  for (int i = 0; i < numRepetitions; ++i) {
+    hpipm.timer.startTimer();
+    ASSERT_EQ(hpipmInterface.solve(x0, dynamicsArray, costArray, nullptr, X, U), hpipm_status::SUCCESS);
+    hpipm.timer.endTimer();
+  }
+  hpipm.numIterations = hpipmInterface.getNumIterations();
+  ocs2::toKktSolution(X, U, hpipmSolution);
+
+  // Single-thread PIPG on the stacked problem
+  std::vector<BenchmarkResult> results;
+  for (const auto* s : {&settings, &adaptiveSettings}) {
+    results.push_back({s->adaptiveStepSize ? "singleThreadPipg adaptive" : "singleThreadPipg"});
+    ocs2::vector_t solution;
+    for (int i = 0; i < numRepetitions; ++i) {
+      results.back().timer.startTimer();
+      ocs2::pipg::singleThreadPipg(*s, H, costApproximation.dfdx, G, constraintsApproximation.f,
+                                   ocs2::vector_t::Ones(constraintsApproximation.f.size()), pipgBounds, solution);
+      results.back().timer.endTimer();
+    }
+    results.back().error = (solution - hpipmSolution).lpNorm<Eigen::Infinity>();
+  }
+
+  // Parallel PIPG on the stage-wise problem
+  ocs2::ThreadPool threadPool(numThreads - 1);
+  const ocs2::vector_array_t scalingVectors(N, ocs2::vector_t::Ones(nx));
+  for (const auto* s : {&settings, &adaptiveSettings}) {
+    results.push_back({s->adaptiveStepSize ? "PipgSolver adaptive" : "PipgSolver"});
+    ocs2::PipgSolver solver(*s);
+    solver.resize(ocpSize);
+    for (int i = 0; i < numRepetitions; ++i) {
+      results.back().timer.startTimer();
+      solver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, nullptr, X, U);
+      results.back().timer.endTimer();
+    }
+    ocs2::vector_t solution;
+    ocs2::toKktSolution(X, U, solution);
+    results.back().numIterations = solver.getNumIterations();
+    results.back().error = (solution - hpipmSolution).lpNorm<Eigen::Infinity>();
+  }
+
+  std::cerr << "\n#### PIPG benchmark: N = " << N << ", nx = " << nx << ", nu = " << nu << ", threads = " << numThreads << "\n";
+  std::cerr << std::setw(28) << hpipm.name << " : " << std::setw(10) << hpipm.timer.getAverageInMilliseconds() << " [ms], "
+            << hpipm.numIterations << " iterations\n";
+  for (const auto& result : results) {
+    std::cerr << std::setw(28) << result.name << " : " << std::setw(10) << result.timer.getAverageInMilliseconds() << " [ms], ";
+    if (result.numIterations > 0) {
+      std::cerr << result.numIterations << " iterations, ";
+    }
+    std::cerr << "error to HPIPM " << result.error << "\n";
+    EXPECT_LT(result.error, 1e-3) << result.name;
+  }
+}
+
+}  // namespace
+
+TEST(test_pipg_benchmark, smallProblem) {
+  runBenchmark(20, 4, 3, 1);
+}
+
+TEST(test_pipg_benchmark, largeProblem) {
+  runBenchmark(50, 12, 4, 4);
+}
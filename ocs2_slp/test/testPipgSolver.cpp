@@ -30,10 +30,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <gtest/gtest.h>
 #include <Eigen/Sparse>
 
+#include <cmath>
+
 #include <ocs2_oc/oc_problem/OcpToKkt.h>
 #include <ocs2_oc/test/testProblemsGeneration.h>
 #include <ocs2_qp_solver/QpSolver.h>
 
+#include "ocs2_slp/pipg/PipgProjection.h"
 #include "ocs2_slp/pipg/PipgSolver.h"
 #include "ocs2_slp/pipg/SingleThreadPipg.h"
 
@@ -122,7 +125,7 @@ TEST_F(PIPGSolverTest, correctness) {
 
   ocs2::vector_array_t scalingVectors(N_, ocs2::vector_t::Ones(nx_));
   ocs2::vector_array_t X, U;
-  std::ignore = solver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, X, U);
+  std::ignore = solver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, nullptr, X, U);
 
   ocs2::vector_t primalSolutionPIPGParallel;
   ocs2::toKktSolution(X, U, primalSolutionPIPGParallel);
@@ -183,4 +186,269 @@ TEST_F(PIPGSolverTest, correctness) {
   ASSERT_TRUE(std::abs(PIPGConstraintViolation) < solver.settings().absoluteTolerance);
   EXPECT_TRUE(std::abs(QPConstraintViolation - PIPGConstraintViolation) < solver.settings().absoluteTolerance * 10.0);
   EXPECT_TRUE(std::abs(PIPGParallelCConstraintViolation - PIPGConstraintViolation) < solver.settings().absoluteTolerance * 10.0);
-}
\ No newline at end of file
+}
+TEST_F(PIPGSolverTest, lqArena) {
+  Eigen::JacobiSVD<ocs2::matrix_t> svd(costApproximation.dfdxx);
+  ocs2::vector_t s = svd.singularValues();
+  const ocs2::scalar_t lambda = s(0);
+  const ocs2::scalar_t mu = s(svd.rank() - 1);
+  Eigen::JacobiSVD<ocs2::matrix_t> svdGTG(constraintsApproximation.dfdx.transpose() * constraintsApproximation.dfdx);
+  const ocs2::scalar_t sigma = svdGTG.singularValues()(0);
+  const ocs2::pipg::PipgBounds pipgBounds{mu, lambda, sigma};
+
+  ocs2::vector_array_t scalingVectors(N_, ocs2::vector_t::Ones(nx_));
+
+  ocs2::OcpLqArena lqArena(solver.size());
+  for (int i = 0; i < N_; i++) {
+    lqArena.setDynamics(i, dynamicsArray[i]);
+    lqArena.setCost(i, costArray[i]);
+  }
+  lqArena.setCost(N_, costArray[N_]);
+
+  ocs2::vector_array_t X, U;
+  std::ignore = solver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, nullptr, X, U);
+
+  ocs2::vector_array_t XArena, UArena;
+  std::ignore = solver.solve(threadPool, x0, lqArena, scalingVectors, nullptr, pipgBounds, nullptr, XArena, UArena);
+
+  for (int i = 0; i < N_; i++) {
+    EXPECT_TRUE(X[i + 1].isApprox(XArena[i + 1]));
+    EXPECT_TRUE(U[i].isApprox(UArena[i]));
+  }
+}
+
+TEST_F(PIPGSolverTest, adaptiveStepSize) {
+  // ocs2::qp_solver::SolveDenseQP use  Gz + g = 0 for constraints
+  auto QPconstraints = constraintsApproximation;
+  QPconstraints.f = -QPconstraints.f;
+  ocs2::vector_t primalSolutionQP;
+  std::tie(primalSolutionQP, std::ignore) = ocs2::qp_solver::solveDenseQp(costApproximation, QPconstraints);
+
+  Eigen::JacobiSVD<ocs2::matrix_t> svd(costApproximation.dfdxx);
+  ocs2::vector_t s = svd.singularValues();
+  const ocs2::scalar_t lambda = s(0);
+  const ocs2::scalar_t mu = s(svd.rank() - 1);
+  Eigen::JacobiSVD<ocs2::matrix_t> svdGTG(constraintsApproximation.dfdx.transpose() * constraintsApproximation.dfdx);
+  const ocs2::scalar_t sigma = svdGTG.singularValues()(0);
+  const ocs2::pipg::PipgBounds pipgBounds{mu, lambda, sigma};
+  ocs2::vector_array_t scalingVectors(N_, ocs2::vector_t::Ones(nx_));
+
+  auto adaptiveSettings = solver.settings();
+  adaptiveSettings.adaptiveStepSize = true;
+  adaptiveSettings.checkTerminationInterval = 10;
+  ocs2::PipgSolver adaptiveSolver(adaptiveSettings);
+  adaptiveSolver.resize(solver.size());
+
+  ocs2::vector_array_t X, U;
+  ASSERT_EQ(solver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, nullptr, X, U),
+            ocs2::pipg::SolverStatus::SUCCESS);
+  ASSERT_EQ(adaptiveSolver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, nullptr, X, U),
+            ocs2::pipg::SolverStatus::SUCCESS);
+  EXPECT_GT(adaptiveSolver.getNumStepSizeAdaptations(), 0);
+  EXPECT_LT(adaptiveSolver.getNumIterations(), solver.getNumIterations());
+
+  ocs2::vector_t primalSolutionPIPGParallel;
+  ocs2::toKktSolution(X, U, primalSolutionPIPGParallel);
+  EXPECT_TRUE(primalSolutionQP.isApprox(primalSolutionPIPGParallel, adaptiveSettings.absoluteTolerance * 10.0))
+      << "Inf-norm of (QP - PIPGParallel): " << (primalSolutionQP - primalSolutionPIPGParallel).cwiseAbs().maxCoeff();
+
+  ocs2::vector_t primalSolutionPIPG;
+  ASSERT_EQ(ocs2::pipg::singleThreadPipg(adaptiveSettings, costApproximation.dfdxx.sparseView(), costApproximation.dfdx,
+                                         constraintsApproximation.dfdx.sparseView(), constraintsApproximation.f,
+                                         ocs2::vector_t::Ones(solver.getNumDynamicsConstraints()), pipgBounds, primalSolutionPIPG),
+            ocs2::pipg::SolverStatus::SUCCESS);
+  EXPECT_TRUE(primalSolutionQP.isApprox(primalSolutionPIPG, adaptiveSettings.absoluteTolerance * 10.0))
+      << "Inf-norm of (QP - PIPG): " << (primalSolutionQP - primalSolutionPIPG).cwiseAbs().maxCoeff();
+}
+
+TEST(PIPGStepSizeScheduleTest, cappedAdaptation) {
+  const ocs2::scalar_t mu = 1e-3;
+  const ocs2::scalar_t lambda = 1.0;
+  ocs2::pipg::Settings settings;
+  settings.adaptiveStepSize = true;
+  ocs2::pipg::PipgStepSizeSchedule stepSizes(ocs2::pipg::PipgBounds{mu, lambda, 1.0}, settings);
+
+  // The primal residual always dominates, such that every update asks to skip ahead
+  for (size_t k = 0; k < 10000; k += 10) {
+    stepSizes.update(k, 1.0, 0.0);
+    // The estimate of mu does not exceed lambda
+    const ocs2::scalar_t minPrimalStepSize = 2.0 / ((static_cast<ocs2::scalar_t>(k) + 1.0) * lambda + 2.0 * lambda);
+    ASSERT_GE(stepSizes.primalStepSize(k), minPrimalStepSize * (1.0 - 1e-12)) << "k = " << k;
+    ASSERT_TRUE(std::isfinite(stepSizes.dualStepSize(k))) << "k = " << k;
+  }
+  EXPECT_GT(stepSizes.getNumAdaptations(), 0);
+}
+
+TEST_F(PIPGSolverTest, projection) {
+  // Reference solution of the unconstrained problem to place the bounds
+  auto QPconstraints = constraintsApproximation;
+  QPconstraints.f = -QPconstraints.f;
+  ocs2::vector_t primalSolutionQP;
+  std::tie(primalSolutionQP, std::ignore) = ocs2::qp_solver::solveDenseQp(costApproximation, QPconstraints);
+  ocs2::vector_array_t XQP(N_ + 1), UQP(N_);
+  for (int i = 0; i < N_; i++) {
+    UQP[i] = primalSolutionQP.segment(i * (nx_ + nu_), nu_);
+    XQP[i + 1] = primalSolutionQP.segment(i * (nx_ + nu_) + nu_, nx_);
+  }
+
+  // Input box on u(0), input halfspace u(1) + u(2) >= g, and an upper bound on x(0). All of them are violated by the reference.
+  ocs2::scalar_t maxInput = 0.0, minInputSum = 1e10, maxState = -1e10;
+  for (int i = 0; i < N_; i++) {
+    maxInput = std::max(maxInput, std::abs(UQP[i](0)));
+    minInputSum = std::min(minInputSum, UQP[i](1) + UQP[i](2));
+    maxState = std::max(maxState, XQP[i + 1](0));
+  }
+  ocs2::pipg::ProjectionSets projectionSets;
+  projectionSets.state.resize(N_ + 1);
+  projectionSets.input.resize(N_);
+  for (int i = 0; i < N_; i++) {
+    auto& inputSet = projectionSets.input[i];
+    inputSet.idxb = {0};
+    inputSet.lb = ocs2::vector_t::Constant(1, -0.5 * maxInput);
+    inputSet.ub = ocs2::vector_t::Constant(1, 0.5 * maxInput);
+    inputSet.G = (ocs2::matrix_t(1, nu_) << 0.0, 1.0, 1.0).finished();
+    inputSet.g = ocs2::vector_t::Constant(1, minInputSum + 0.1);
+
+    auto& stateSet = projectionSets.state[i + 1];
+    stateSet.idxb = {0};
+    stateSet.lb = ocs2::vector_t::Constant(1, -1e10);
+    stateSet.ub = ocs2::vector_t::Constant(1, maxState - 0.1);
+  }
+
+  Eigen::JacobiSVD<ocs2::matrix_t> svd(costApproximation.dfdxx);
+  ocs2::vector_t s = svd.singularValues();
+  const ocs2::scalar_t lambda = s(0);
+  const ocs2::scalar_t mu = s(svd.rank() - 1);
+  Eigen::JacobiSVD<ocs2::matrix_t> svdGTG(constraintsApproximation.dfdx.transpose() * constraintsApproximation.dfdx);
+  const ocs2::scalar_t sigma = svdGTG.singularValues()(0);
+  const ocs2::pipg::PipgBounds pipgBounds{mu, lambda, sigma};
+  ocs2::vector_array_t scalingVectors(N_, ocs2::vector_t::Ones(nx_));
+
+  ocs2::vector_array_t X, U;
+  ASSERT_EQ(solver.solve(threadPool, x0, dynamicsArray, costArray, nullptr, scalingVectors, nullptr, pipgBounds, &projectionSets, X, U),
+            ocs2::pipg::SolverStatus::SUCCESS);
+
+  // Feasibility
+  const ocs2::scalar_t tol = 1e-6;
+  for (int i = 0; i < N_; i++) {
+    EXPECT_TRUE(ocs2::pipg::isInSet(projectionSets.input[i], U[i], tol)) << "input at node " << i << ": " << U[i].transpose();
+    EXPECT_TRUE(ocs2::pipg::isInSet(projectionSets.state[i + 1], X[i + 1], tol))
+        << "state at node " << i + 1 << ": " << X[i + 1].transpose();
+  }
+
+  // Reference: the equality constrained QP with the active constraints of the PIPG solution, written as a' z >= b.
+  const int numDecisionVariables = constraintsApproximation.dfdx.cols();
+  std::vector<std::pair<ocs2::vector_t, ocs2::scalar_t>> activeConstraints;
+  for (int i = 0; i < N_; i++) {
+    const int inputOffset = i * (nx_ + nu_);
+    const int stateOffset = inputOffset + nu_;
+    ocs2::vector_t a = ocs2::vector_t::Zero(numDecisionVariables);
+    if (U[i](0) < projectionSets.input[i].lb(0) + tol) {
+      a(inputOffset) = 1.0;
+      activeConstraints.emplace_back(a, projectionSets.input[i].lb(0));
+    } else if (U[i](0) > projectionSets.input[i].ub(0) - tol) {
+      a(inputOffset) = -1.0;
+      activeConstraints.emplace_back(a, -projectionSets.input[i].ub(0));
+    }
+    if (projectionSets.input[i].G.row(0).dot(U[i]) < projectionSets.input[i].g(0) + tol) {
+      a.setZero();
+      a.segment(inputOffset, nu_) = projectionSets.input[i].G.row(0).transpose();
+      activeConstraints.emplace_back(a, projectionSets.input[i].g(0));
+    }
+    if (X[i + 1](0) > projectionSets.state[i + 1].ub(0) - tol) {
+      a.setZero();
+      a(stateOffset) = -1.0;
+      activeConstraints.emplace_back(a, -projectionSets.state[i + 1].ub(0));
+    }
+  }
+  ASSERT_FALSE(activeConstraints.empty());
+
+  const int numDynamicsConstraints = QPconstraints.dfdx.rows();
+  auto activeSetConstraints = QPconstraints;
+  activeSetConstraints.dfdx.conservativeResize(numDynamicsConstraints + activeConstraints.size(), Eigen::NoChange);
+  activeSetConstraints.f.conservativeResize(numDynamicsConstraints + activeConstraints.size());
+  for (int j = 0; j < activeConstraints.size(); j++) {
+    activeSetConstraints.dfdx.row(numDynamicsConstraints + j) = activeConstraints[j].first.transpose();
+    activeSetConstraints.f(numDynamicsConstraints + j) = -activeConstraints[j].second;
+  }
+  ocs2::vector_t primalSolutionActiveSet, dualSolutionActiveSet;
+  std::tie(primalSolutionActiveSet, dualSolutionActiveSet) = ocs2::qp_solver::solveDenseQp(costApproximation, activeSetConstraints);
+
+  // With H z + h + G' lambda = 0, the multipliers of the active inequality constraints a' z >= b are non-positive at the optimum.
+  EXPECT_LE(dualSolutionActiveSet.tail(activeConstraints.size()).maxCoeff(), tol);
+
+  ocs2::vector_t primalSolutionPIPGParallel;
+  ocs2::toKktSolution(X, U, primalSolutionPIPGParallel);
+  EXPECT_TRUE(primalSolutionActiveSet.isApprox(primalSolutionPIPGParallel, 1e-6))
+      << "Inf-norm of (QP - PIPGParallel): " << (primalSolutionActiveSet - primalSolutionPIPGParallel).cwiseAbs().maxCoeff();
+}
+
+TEST(PIPGProjectionTest, boxAndHalfspace) {
+  // The intersection of the box [0, 1]^2 and the halfspace z0 + z1 >= 1.5 is the triangle (0.5, 1), (1, 0.5), (1, 1).
+  ocs2::pipg::ProjectionSet set;
+  set.idxb = {0, 1};
+  set.lb = ocs2::vector_t::Zero(2);
+  set.ub = ocs2::vector_t::Ones(2);
+  set.G = ocs2::matrix_t::Ones(1, 2);
+  set.g = ocs2::vector_t::Constant(1, 1.5);
+
+  ocs2::pipg::ProjectionWorkspace workspace;
+  const auto projection = [&](ocs2::scalar_t z0, ocs2::scalar_t z1) {
+    ocs2::vector_t z = (ocs2::vector_t(2) << z0, z1).finished();
+    ocs2::pipg::project(set, ocs2::pipg::Settings().maxNumProjectionSweeps, z, workspace);
+    return z;
+  };
+
+  // Vertex
+  EXPECT_TRUE(projection(2.0, -1.0).isApprox((ocs2::vector_t(2) << 1.0, 0.5).finished(), 1e-9)) << projection(2.0, -1.0).transpose();
+  // Edge of the halfspace
+  EXPECT_TRUE(projection(0.5, 0.5).isApprox((ocs2::vector_t(2) << 0.75, 0.75).finished(), 1e-9)) << projection(0.5, 0.5).transpose();
+  // Edge of the box
+  EXPECT_TRUE(projection(2.0, 0.8).isApprox((ocs2::vector_t(2) << 1.0, 0.8).finished(), 1e-9)) << projection(2.0, 0.8).transpose();
+  // Interior
+  EXPECT_TRUE(projection(0.9, 0.9).isApprox((ocs2::vector_t(2) << 0.9, 0.9).finished()));
+  EXPECT_TRUE(projection(-3.0, 7.0).isApprox((ocs2::vector_t(2) << 0.5, 1.0).finished(), 1e-9)) << projection(-3.0, 7.0).transpose();
+
+  // Intersection with z0 - z1 >= 0 is the triangle (0.75, 0.75), (1, 0.5), (1, 1). Projected by Dykstra's method.
+  set.G = (ocs2::matrix_t(2, 2) << 1.0, 1.0, 1.0, -1.0).finished();
+  set.g = (ocs2::vector_t(2) << 1.5, 0.0).finished();
+  ocs2::vector_t z = (ocs2::vector_t(2) << 0.0, 2.0).finished();
+  ocs2::pipg::project(set, 100, z, workspace);
+  EXPECT_TRUE(z.isApprox((ocs2::vector_t(2) << 1.0, 1.0).finished(), 1e-9)) << z.transpose();
+  EXPECT_TRUE(projection(0.5, 0.2).isApprox((ocs2::vector_t(2) << 0.9, 0.6).finished(), 1e-9)) << projection(0.5, 0.2).transpose();
+}
+
+TEST(PIPGProjectionTest, scaledSets) {
+  // Two stages with 2 states and 2 inputs. Node 1 has a bound on x(1), a bound on u(0), an input-only and a state-input constraint.
+  std::vector<ocs2::NodeInequalityConstraints> constraints(3);
+  auto& node = constraints[1];
+  node.idxbx = {1};
+  node.lbx = ocs2::vector_t::Constant(1, -2.0);
+  node.ubx = ocs2::vector_t::Constant(1, 4.0);
+  node.idxbu = {0};
+  node.lbu = ocs2::vector_t::Constant(1, -1.0);
+  node.ubu = ocs2::vector_t::Constant(1, 1.0);
+  node.C = (ocs2::matrix_t(2, 2) << 0.0, 0.0, 1.0, 0.0).finished();
+  node.D = (ocs2::matrix_t(2, 2) << 1.0, 1.0, 0.0, 1.0).finished();
+  node.lg = (ocs2::vector_t(2) << 0.5, 0.0).finished();
+
+  const ocs2::vector_array_t D{ocs2::vector_t::Constant(2, 2.0), ocs2::vector_t::Constant(2, 2.0),
+                               (ocs2::vector_t(2) << 0.5, 4.0).finished(), ocs2::vector_t::Constant(2, 2.0)};
+  ocs2::pipg::ProjectionSets sets;
+  EXPECT_EQ(ocs2::pipg::toProjectionSets(constraints, &D, sets), 1);
+  ASSERT_EQ(sets.state.size(), 3);
+  ASSERT_EQ(sets.input.size(), 2);
+  EXPECT_TRUE(sets.state[0].empty());
+  EXPECT_TRUE(sets.input[0].empty());
+
+  // x(1) = 2 x~(1)
+  EXPECT_DOUBLE_EQ(sets.state[1].lb(0), -1.0);
+  EXPECT_DOUBLE_EQ(sets.state[1].ub(0), 2.0);
+  EXPECT_EQ(sets.state[1].numHalfspaces(), 0);
+  // u = [0.5, 4] .* u~
+  EXPECT_DOUBLE_EQ(sets.input[1].lb(0), -2.0);
+  EXPECT_DOUBLE_EQ(sets.input[1].ub(0), 2.0);
+  ASSERT_EQ(sets.input[1].numHalfspaces(), 1);
+  EXPECT_TRUE(sets.input[1].G.isApprox((ocs2::matrix_t(1, 2) << 0.5, 4.0).finished()));
+  EXPECT_DOUBLE_EQ(sets.input[1].g(0), 0.5);
+}
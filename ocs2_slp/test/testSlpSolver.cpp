@@ -40,7 +40,9 @@ namespace {
 
 std::pair<PrimalSolution, std::vector<PerformanceIndex>> solve(const VectorFunctionLinearApproximation& dynamicsMatrices,
                                                                const ScalarFunctionQuadraticApproximation& costMatrices,
-                                                               const ocs2::scalar_t tol) {
+                                                               const ocs2::scalar_t tol,
+                                                               const VectorFunctionLinearApproximation* inequalityConstraints = nullptr,
+                                                               bool warmStartScaling = false) {
   int n = dynamicsMatrices.dfdu.rows();
   int m = dynamicsMatrices.dfdu.cols();
 
@@ -60,6 +62,9 @@ std::pair<PrimalSolution, std::vector<PerformanceIndex>> solve(const VectorFunct
   problem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
 
   problem.equalityConstraintPtr->add("intermediateCost", ocs2::getOcs2Constraints(getRandomConstraints(n, m, 0)));
+  if (inequalityConstraints != nullptr) {
+    problem.inequalityConstraintPtr->add("inequalityConstraints", ocs2::getOcs2Constraints(*inequalityConstraints));
+  }
 
   ocs2::DefaultInitializer zeroInitializer(m);
 
@@ -84,6 +89,8 @@ std::pair<PrimalSolution, std::vector<PerformanceIndex>> solve(const VectorFunct
     settings.printSolverStatus = true;
     settings.printLinesearch = true;
     settings.nThreads = 100;
+    settings.projectInequalityConstraints = inequalityConstraints != nullptr;
+    settings.warmStartScaling = warmStartScaling;
     settings.pipgSettings = getPipgSettings();
     return settings;
   }();
@@ -98,6 +105,10 @@ std::pair<PrimalSolution, std::vector<PerformanceIndex>> solve(const VectorFunct
   solver.setReferenceManager(referenceManagerPtr);
 
   // Solve
+  if (warmStartScaling) {
+    // A first MPC call on a shifted horizon to seed the pre-conditioning
+    solver.run(startTime - 0.1, initState, finalTime - 0.1);
+  }
   solver.run(startTime, initState, finalTime);
   return {solver.primalSolution(finalTime), solver.getIterationsLog()};
 }
@@ -121,3 +132,75 @@ TEST(testSlpSolver, test_unconstrained) {
   ASSERT_LE(result.second.size(), 2);
   ASSERT_LT(result.second.back().dynamicsViolationSSE, tol);
 }
+
+TEST(testSlpSolver, test_input_bounds) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-9;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+  const auto unconstrainedResult = ocs2::solve(dynamics, costs, tol);
+
+  // Limit the inputs to half of the unconstrained solution: -uMax <= u <= uMax, i.e., [uMax; uMax] + [I; -I] u >= 0
+  ocs2::scalar_t uMax = 0.0;
+  for (const auto& u : unconstrainedResult.first.inputTrajectory_) {
+    uMax = std::max(uMax, 0.5 * u.lpNorm<Eigen::Infinity>());
+  }
+  ocs2::VectorFunctionLinearApproximation inputBounds;
+  inputBounds.f = ocs2::vector_t::Constant(2 * m, uMax);
+  inputBounds.dfdx = ocs2::matrix_t::Zero(2 * m, n);
+  inputBounds.dfdu.resize(2 * m, m);
+  inputBounds.dfdu << ocs2::matrix_t::Identity(m, m), -ocs2::matrix_t::Identity(m, m);
+  const auto result = ocs2::solve(dynamics, costs, tol, &inputBounds);
+
+  /*
+   * Assert performance
+   * - The bounds are part of the LP subproblem: The linear problem is solved in one iteration as the unconstrained one.
+   * - Linear dynamics should be satisfied after the step.
+   * - The inputs satisfy the bounds, which are active.
+   */
+  ASSERT_LE(result.second.size(), unconstrainedResult.second.size());
+  ASSERT_LT(result.second.back().dynamicsViolationSSE, tol);
+  ocs2::scalar_t maxInput = 0.0;
+  for (int i = 0; i + 1 < result.first.inputTrajectory_.size(); i++) {
+    maxInput = std::max(maxInput, result.first.inputTrajectory_[i].lpNorm<Eigen::Infinity>());
+  }
+  EXPECT_LT(maxInput, uMax + 1e-6);
+  EXPECT_GT(maxInput, uMax - 1e-6);
+}
+
+TEST(testSlpSolver, test_coupled_constraints) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-9;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+
+  // A constraint on the state and the input cannot be projected by PIPG
+  ocs2::VectorFunctionLinearApproximation coupledConstraint;
+  coupledConstraint.f = ocs2::vector_t::Constant(1, 1.0);
+  coupledConstraint.dfdx = ocs2::matrix_t::Ones(1, n);
+  coupledConstraint.dfdu = ocs2::matrix_t::Ones(1, m);
+  EXPECT_THROW(ocs2::solve(dynamics, costs, tol, &coupledConstraint), std::runtime_error);
+}
+
+TEST(testSlpSolver, test_warm_started_scaling) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-9;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+  const auto coldResult = ocs2::solve(dynamics, costs, tol);
+  const auto warmResult = ocs2::solve(dynamics, costs, tol, nullptr, true);
+
+  /*
+   * Assert performance
+   * - The pre-conditioning does not change the solution of the LP subproblem, up to the relative tolerance of PIPG.
+   * - Linear dynamics should be satisfied after the step.
+   */
+  ASSERT_LT(warmResult.second.back().dynamicsViolationSSE, tol);
+  ASSERT_EQ(warmResult.first.inputTrajectory_.size(), coldResult.first.inputTrajectory_.size());
+  for (int i = 0; i + 1 < warmResult.first.inputTrajectory_.size(); i++) {
+    EXPECT_TRUE(warmResult.first.inputTrajectory_[i].isApprox(coldResult.first.inputTrajectory_[i], 1e-2));
+  }
+}
@@ -36,6 +36,8 @@ extern "C" {
 }
 
 #include <ocs2_core/Types.h>
+#include <ocs2_oc/oc_problem/OcpInequalityConstraints.h>
+#include <ocs2_oc/oc_problem/OcpLqArena.h>
 #include <ocs2_oc/oc_problem/OcpSize.h>
 
 #include "hpipm_catkin/HpipmInterfaceSettings.h"
@@ -59,8 +61,8 @@ class HpipmInterface {
   /** Destructor */
   ~HpipmInterface();
 
-  /** Resize the problem */
-  void resize(OcpSize ocpSize);
+  /** Resize the problem. Does not allocate if the size did not change. */
+  void resize(const OcpSize& ocpSize);
 
   /**
    * Solves a discrete linear quadratic optimal control problem. The interface needs to be resized to a consistent OcpSize before calling
@@ -86,6 +88,88 @@ class HpipmInterface {
                      std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
                      vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose = false);
 
+  /**
+   * Solves the discrete linear quadratic optimal control problem stored in an OcpLqArena. The blocks are written directly from the
+   * arena into the HPIPM memory. The interface needs to be resized to lq.size() before calling this function.
+   *
+   * @param x0 : Initial state (deviation).
+   * @param lq : The LQ approximation. The state-input equality constraints are mapped to general constraints with equal bounds.
+   * @param [out] stateTrajectory : Solution state (deviation) trajectory.
+   * @param [out] inputTrajectory : Solution input (deviation) trajectory.
+   * @param verbose : Prints the HPIPM iteration statistics if true.
+   * @return HPIPM returned with flag hpipm_status, see above.
+   */
+  hpipm_status solve(const vector_t& x0, OcpLqArena& lq, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory,
+                     bool verbose = false);
+
+  /**
+   * Solves the discrete linear quadratic optimal control problem stored in an OcpLqArena, with additional inequality constraints.
+   * The simple bounds are passed to HPIPM as box constraints, the general inequality constraints are appended to the equality
+   * constraints of the arena. The interface needs to be resized to the size of lq.size() extended with addInequalityConstraintsSize.
+   * State bounds at the initial node are ignored, since the initial state is not a decision variable.
+   *
+   * @param x0 : Initial state (deviation).
+   * @param lq : The LQ approximation.
+   * @param inequalityConstraints : Linearized inequality constraints of all nodes.
+   * @param [out] stateTrajectory : Solution state (deviation) trajectory.
+   * @param [out] inputTrajectory : Solution input (deviation) trajectory.
+   * @param verbose : Prints the HPIPM iteration statistics if true.
+   * @return HPIPM returned with flag hpipm_status, see above.
+   */
+  hpipm_status solve(const vector_t& x0, OcpLqArena& lq, const std::vector<NodeInequalityConstraints>& inequalityConstraints,
+                     vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose = false);
+
+  /**
+   * Checks if node k of an OcpLqArena, with optional inequality constraints, matches the current size of the interface.
+   */
+  bool isNodeSizeConsistent(int k, const OcpLqArena& lq, const NodeInequalityConstraints* inequalityConstraints = nullptr) const;
+
+  /**
+   * Writes node k of an OcpLqArena directly into the HPIPM memory, without intermediate copies. Different nodes can be written
+   * concurrently, for example by the worker that has just filled the node. After all nodes have been written, call solveInPlace.
+   *
+   * @param k : Node index.
+   * @param x0 : Initial state (deviation). Only used for k = 0, where the initial state is eliminated from the decision variables.
+   * @param lq : The LQ approximation.
+   * @param inequalityConstraints : Optional inequality constraints of the node, see the solve function with inequality constraints.
+   * @return false if the node does not match the current size of the interface, in which case nothing is written.
+   */
+  bool setNode(int k, const vector_t& x0, OcpLqArena& lq, const NodeInequalityConstraints* inequalityConstraints = nullptr);
+
+  /**
+   * Solves the QP previously written with setNode for all nodes.
+   *
+   * @param x0 : Initial state (deviation), the same as passed to setNode.
+   * @param [out] stateTrajectory : Solution state (deviation) trajectory.
+   * @param [out] inputTrajectory : Solution input (deviation) trajectory.
+   * @param verbose : Prints the HPIPM iteration statistics if true.
+   * @return HPIPM returned with flag hpipm_status, see above.
+   */
+  hpipm_status solveInPlace(const vector_t& x0, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose = false);
+
+  /** Number of stages of the current size */
+  int getNumStages() const;
+
+  /**
+   * Prepares the solution of the last solve as initial guess for the next one. Only has an effect if Settings::warm_start > 0.
+   * The solution is kept as long as the size does not change, and the first solve after a change of size starts cold.
+   *
+   * @param numStages : Number of stages the solution moves towards the start of the horizon, e.g. between two MPC calls. The stages at
+   * the end of the horizon keep their values. If the shifted stages do not have the same dimensions, the next solve starts cold.
+   * @param primalScaling : Scaling of the primal variables. In a sequential QP, the remaining step after a step of size alpha is
+   * (1 - alpha) times the last solution, while the multipliers are not affected.
+   */
+  void shiftSolution(int numStages, scalar_t primalScaling = 1.0);
+
+  /** Starts the next solve cold. */
+  void resetWarmStart();
+
+  /** Number of IPM iterations of the last solve */
+  int getNumIterations() const;
+
+  /** Whether the last solve was started from the solution of a previous one */
+  bool isWarmStarted() const;
+
   /**
    * Return the Riccati cost-to-go for the previously solved problem.
    * Extra information about the initial stage is needed to complete calculation.
@@ -54,6 +54,9 @@ struct Settings {
   int warm_start = 0;
   int pred_corr = 1;
   int ric_alg = 0;  // square root ricatti recursion
+
+  // Partial condensing: the stages are condensed into blocks of this many stages before the IPM is run. 1 = no condensing.
+  int condensingBlockSize = 1;
 };
 
 std::ostream& operator<<(std::ostream& stream, const Settings& settings);
@@ -0,0 +1,65 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_oc/lq_solver/LqSolverInterface.h>
+
+#include "hpipm_catkin/HpipmInterface.h"
+
+namespace ocs2 {
+
+/** LqSolverInterface backend of HPIPM. Maps the state-input equality constraints to general constraints with equal bounds. */
+class HpipmLqSolver final : public LqSolverInterface {
+ public:
+  explicit HpipmLqSolver(const hpipm_interface::Settings& settings = hpipm_interface::Settings()) : hpipmInterface_(OcpSize(), settings) {}
+  ~HpipmLqSolver() override = default;
+
+  std::string getName() const override { return "HPIPM"; }
+
+  bool supportsEqualityConstraints() const override { return true; }
+
+  void resize(const OcpSize& ocpSize) override { hpipmInterface_.resize(ocpSize); }
+
+  bool solve(const vector_t& x0, OcpLqArena& lq, vector_array_t& deltaXSol, vector_array_t& deltaUSol) override;
+
+  std::vector<ScalarFunctionQuadraticApproximation> getRiccatiCostToGo(const OcpLqArena& lq) override;
+
+  matrix_array_t getRiccatiFeedback(const OcpLqArena& lq) override;
+
+  int getNumIterations() const override { return hpipmInterface_.getNumIterations(); }
+
+  /** The wrapped interface, e.g. to configure warm starting */
+  HpipmInterface& getInterface() { return hpipmInterface_; }
+
+ private:
+  HpipmInterface hpipmInterface_;
+};
+
+}  // namespace ocs2
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "hpipm_catkin/HpipmInterface.h"
 
+#include <algorithm>
+
 #include <ocs2_core/misc/LinearAlgebra.h>
 
 extern "C" {
@@ -36,6 +38,7 @@ extern "C" {
 #include <hpipm_d_ocp_qp_dim.h>
 #include <hpipm_d_ocp_qp_ipm.h>
 #include <hpipm_d_ocp_qp_sol.h>
+#include <hpipm_d_part_cond.h>
 #include <hpipm_timing.h>
 }
 
@@ -87,25 +90,32 @@ namespace ocs2 {
 
 class HpipmInterface::Impl {
  public:
-  Impl(OcpSize ocpSize, Settings settings) : settings_(std::move(settings)) { initializeMemory(std::move(ocpSize), true); }
-
-  void initializeMemory(OcpSize ocpSize, bool forceInitialization = false) {
-    // We will remove the initial state from the decision variables before passing the data to HPIPM.
-    // This removes the need for adding constraints to enforce x[0] = x_init
-    ocpSize.numStates[0] = 0;
+  Impl(OcpSize ocpSize, Settings settings) : settings_(std::move(settings)) { initializeMemory(ocpSize, true); }
 
+  void initializeMemory(const OcpSize& ocpSize, bool forceInitialization = false) {
     // Skip memory initialization if problem size didn't change.
-    if (!forceInitialization && ocpSize_ == ocpSize) {
+    if (!forceInitialization && isSameSize(ocpSize)) {
       return;
     }
 
-    ocpSize_ = std::move(ocpSize);
+    ocpSize_ = ocpSize;
+
+    // We will remove the initial state from the decision variables before passing the data to HPIPM.
+    // This removes the need for adding constraints to enforce x[0] = x_init
+    ocpSize_.numStates[0] = 0;
+    ocpSize_.numStateBoxConstraints[0] = 0;
+
+    // HPIPM has no equality constraints, they are passed as general constraints with equal bounds, stacked before the inequalities.
+    numGeneralConstraints_.resize(ocpSize_.numStages + 1);
+    for (int k = 0; k <= ocpSize_.numStages; ++k) {
+      numGeneralConstraints_[k] = ocpSize_.numEqConstraints[k] + ocpSize_.numIneqConstraints[k];
+    }
 
     const int dim_size = d_ocp_qp_dim_memsize(ocpSize_.numStages);
     dimMem_.reserve(dim_size);
     d_ocp_qp_dim_create(ocpSize_.numStages, &dim_, dimMem_.get());
     d_ocp_qp_dim_set_all(ocpSize_.numStates.data(), ocpSize_.numInputs.data(), ocpSize_.numStateBoxConstraints.data(),
-                         ocpSize_.numInputBoxConstraints.data(), ocpSize_.numIneqConstraints.data(), ocpSize_.numStateBoxSlack.data(),
+                         ocpSize_.numInputBoxConstraints.data(), numGeneralConstraints_.data(), ocpSize_.numStateBoxSlack.data(),
                          ocpSize_.numInputBoxSlack.data(), ocpSize_.numIneqSlack.data(), &dim_);
 
     const int qp_size = d_ocp_qp_memsize(&dim_);
@@ -120,27 +130,113 @@ class HpipmInterface::Impl {
     ipmArgMem_.reserve(ipm_arg_size);
     d_ocp_qp_ipm_arg_create(&dim_, &arg_, ipmArgMem_.get());
 
-    applySettings(settings_);
+    applySettings(settings_, arg_);
 
     // Setup workspace after applying the settings
     const int ipm_size = d_ocp_qp_ipm_ws_memsize(&dim_, &arg_);
     ipmMem_.reserve(ipm_size);
     d_ocp_qp_ipm_ws_create(&dim_, &arg_, &workspace_, ipmMem_.get());
+
+    initializeCondensing();
+
+    // Sized here such that the nodes can be set concurrently
+    constraintData_.resize(ocpSize_.numStages + 1);
+
+    // The new solution memory does not hold an iterate to start from
+    hasWarmStart_ = false;
+  }
+
+  /** Compares with the current size, ignoring the initial state that is removed from the decision variables */
+  bool isSameSize(const OcpSize& ocpSize) const {
+    if (ocpSize.numStages != ocpSize_.numStages || ocpSize.numStates.size() != ocpSize_.numStates.size()) {
+      return false;
+    }
+    // use && instead of &= to enable short-circuit evaluation
+    bool same = std::equal(std::next(ocpSize.numStates.cbegin()), ocpSize.numStates.cend(), std::next(ocpSize_.numStates.cbegin()));
+    same = same && (ocpSize.numInputs == ocpSize_.numInputs);
+    same = same && (ocpSize.numInputBoxConstraints == ocpSize_.numInputBoxConstraints);
+    same = same && std::equal(std::next(ocpSize.numStateBoxConstraints.cbegin()), ocpSize.numStateBoxConstraints.cend(),
+                              std::next(ocpSize_.numStateBoxConstraints.cbegin()));
+    same = same && (ocpSize.numIneqConstraints == ocpSize_.numIneqConstraints);
+    same = same && (ocpSize.numEqConstraints == ocpSize_.numEqConstraints);
+    same = same && (ocpSize.numInputBoxSlack == ocpSize_.numInputBoxSlack);
+    same = same && (ocpSize.numStateBoxSlack == ocpSize_.numStateBoxSlack);
+    same = same && (ocpSize.numIneqSlack == ocpSize_.numIneqSlack);
+    return same;
   }
 
-  void applySettings(Settings& settings) {
-    d_ocp_qp_ipm_arg_set_default(settings.hpipmMode, &arg_);
-    d_ocp_qp_ipm_arg_set_iter_max(&settings.iter_max, &arg_);
-    d_ocp_qp_ipm_arg_set_alpha_min(&settings.alpha_min, &arg_);
-    d_ocp_qp_ipm_arg_set_mu0(&settings.mu0, &arg_);
-    d_ocp_qp_ipm_arg_set_tol_stat(&settings.tol_stat, &arg_);
-    d_ocp_qp_ipm_arg_set_tol_eq(&settings.tol_eq, &arg_);
-    d_ocp_qp_ipm_arg_set_tol_ineq(&settings.tol_ineq, &arg_);
-    d_ocp_qp_ipm_arg_set_tol_comp(&settings.tol_comp, &arg_);
-    d_ocp_qp_ipm_arg_set_reg_prim(&settings.reg_prim, &arg_);
-    d_ocp_qp_ipm_arg_set_warm_start(&settings.warm_start, &arg_);
-    d_ocp_qp_ipm_arg_set_pred_corr(&settings.pred_corr, &arg_);
-    d_ocp_qp_ipm_arg_set_ric_alg(&settings.ric_alg, &arg_);
+  /**
+   * Sets up the partially condensed QP if the block size of the settings reduces the number of stages. The stages [blockStarts_[j],
+   * blockStarts_[j + 1]) of the original QP become stage j of the condensed QP, on which the IPM is run.
+   */
+  void initializeCondensing() {
+    const int N = ocpSize_.numStages;
+    const int blockSize = std::max(settings_.condensingBlockSize, 1);
+    const int numBlocks = (N + blockSize - 1) / blockSize;
+    isCondensed_ = numBlocks < N;
+    riccatiExpanded_ = false;
+    if (!isCondensed_) {
+      return;
+    }
+
+    blockSizes_.resize(numBlocks + 1);
+    d_part_cond_qp_compute_block_size(N, numBlocks, blockSizes_.data());
+    blockStarts_.resize(numBlocks + 1);
+    blockStarts_[0] = 0;
+    for (int j = 0; j < numBlocks; ++j) {
+      blockStarts_[j + 1] = blockStarts_[j] + blockSizes_[j];
+    }
+
+    const int dim_size = d_ocp_qp_dim_memsize(numBlocks);
+    condensedDimMem_.reserve(dim_size);
+    d_ocp_qp_dim_create(numBlocks, &condensedDim_, condensedDimMem_.get());
+    d_part_cond_qp_compute_dim(&dim_, blockSizes_.data(), &condensedDim_);
+
+    const int qp_size = d_ocp_qp_memsize(&condensedDim_);
+    condensedQpMem_.reserve(qp_size);
+    d_ocp_qp_create(&condensedDim_, &condensedQp_, condensedQpMem_.get());
+
+    const int qp_sol_size = d_ocp_qp_sol_memsize(&condensedDim_);
+    condensedQpSolMem_.reserve(qp_sol_size);
+    d_ocp_qp_sol_create(&condensedDim_, &condensedQpSol_, condensedQpSolMem_.get());
+
+    const int ipm_arg_size = d_ocp_qp_ipm_arg_memsize(&condensedDim_);
+    condensedIpmArgMem_.reserve(ipm_arg_size);
+    d_ocp_qp_ipm_arg_create(&condensedDim_, &condensedArg_, condensedIpmArgMem_.get());
+    applySettings(settings_, condensedArg_);
+
+    const int ipm_size = d_ocp_qp_ipm_ws_memsize(&condensedDim_, &condensedArg_);
+    condensedIpmMem_.reserve(ipm_size);
+    d_ocp_qp_ipm_ws_create(&condensedDim_, &condensedArg_, &condensedWorkspace_, condensedIpmMem_.get());
+
+    const int cond_arg_size = d_part_cond_qp_arg_memsize(numBlocks);
+    condArgMem_.reserve(cond_arg_size);
+    d_part_cond_qp_arg_create(numBlocks, &condArg_, condArgMem_.get());
+    d_part_cond_qp_arg_set_default(&condArg_);
+    d_part_cond_qp_arg_set_ric_alg(settings_.ric_alg, &condArg_);
+
+    const int cond_ws_size = d_part_cond_qp_ws_memsize(&dim_, blockSizes_.data(), &condensedDim_, &condArg_);
+    condWorkspaceMem_.reserve(cond_ws_size);
+    d_part_cond_qp_ws_create(&dim_, blockSizes_.data(), &condensedDim_, &condArg_, &condWorkspace_, condWorkspaceMem_.get());
+  }
+
+  /** IPM arguments and workspace of the QP the IPM is run on */
+  d_ocp_qp_ipm_arg* ipmArg() { return isCondensed_ ? &condensedArg_ : &arg_; }
+  d_ocp_qp_ipm_ws* ipmWorkspace() { return isCondensed_ ? &condensedWorkspace_ : &workspace_; }
+
+  void applySettings(Settings& settings, d_ocp_qp_ipm_arg& arg) {
+    d_ocp_qp_ipm_arg_set_default(settings.hpipmMode, &arg);
+    d_ocp_qp_ipm_arg_set_iter_max(&settings.iter_max, &arg);
+    d_ocp_qp_ipm_arg_set_alpha_min(&settings.alpha_min, &arg);
+    d_ocp_qp_ipm_arg_set_mu0(&settings.mu0, &arg);
+    d_ocp_qp_ipm_arg_set_tol_stat(&settings.tol_stat, &arg);
+    d_ocp_qp_ipm_arg_set_tol_eq(&settings.tol_eq, &arg);
+    d_ocp_qp_ipm_arg_set_tol_ineq(&settings.tol_ineq, &arg);
+    d_ocp_qp_ipm_arg_set_tol_comp(&settings.tol_comp, &arg);
+    d_ocp_qp_ipm_arg_set_reg_prim(&settings.reg_prim, &arg);
+    d_ocp_qp_ipm_arg_set_warm_start(&settings.warm_start, &arg);
+    d_ocp_qp_ipm_arg_set_pred_corr(&settings.pred_corr, &arg);
+    d_ocp_qp_ipm_arg_set_ric_alg(&settings.ric_alg, &arg);
   }
 
   void verifySizes(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
@@ -281,7 +377,7 @@ class HpipmInterface::Impl {
     // === Set and solve ===
     d_ocp_qp_set_all(AA.data(), BB.data(), bb.data(), QQ.data(), SS.data(), RR.data(), qq.data(), rr.data(), hidxbx, hlbx, hubx, hidxbu,
                      hlbu, hubu, CC.data(), DD.data(), llg.data(), uug.data(), hZl, hZu, hzl, hzu, hidxs, hlls, hlus, &qp_);
-    d_ocp_qp_ipm_solve(&qp_, &qpSol_, &arg_, &workspace_);
+    ipmSolve();
 
     if (verbose) {
       printStatus();
@@ -296,10 +392,326 @@ class HpipmInterface::Impl {
 
     // Return solver status
     int hpipmStatus = -1;
-    d_ocp_qp_ipm_get_status(&workspace_, &hpipmStatus);
+    d_ocp_qp_ipm_get_status(ipmWorkspace(), &hpipmStatus);
     return hpipm_status(hpipmStatus);
   }
 
+  hpipm_status solve(const vector_t& x0, OcpLqArena& lq, const std::vector<NodeInequalityConstraints>* inequalityConstraints,
+                     vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose) {
+    const int N = ocpSize_.numStages;
+    if (lq.numStages() != N) {
+      throw std::runtime_error("[HpipmInterface] Inconsistent number of stages in the LQ arena: " + std::to_string(lq.numStages()) +
+                               " with " + std::to_string(N) + " number of stages.");
+    }
+    if (inequalityConstraints != nullptr && inequalityConstraints->size() != N + 1) {
+      throw std::runtime_error("[HpipmInterface] Inconsistent number of inequality constraints: " +
+                               std::to_string(inequalityConstraints->size()) + " with " + std::to_string(N) + " number of stages.");
+    }
+
+    for (int k = 0; k <= N; k++) {
+      const NodeInequalityConstraints* nodeConstraints = (inequalityConstraints != nullptr) ? &(*inequalityConstraints)[k] : nullptr;
+      if (!setNode(k, x0, lq, nodeConstraints)) {
+        throw std::runtime_error("[HpipmInterface] Inconsistent size of node " + std::to_string(k) + " in the LQ arena.");
+      }
+    }
+
+    return solveInPlace(x0, stateTrajectory, inputTrajectory, verbose);
+  }
+
+  bool isNodeSizeConsistent(int k, const OcpLqArena& lq, const NodeInequalityConstraints* inequalityConstraints) const {
+    const int N = ocpSize_.numStages;
+    const auto& lqSize = lq.size();
+    if (lq.numStages() != N || k < 0 || k > N) {
+      return false;
+    }
+    const int numStateBounds = (inequalityConstraints != nullptr && k > 0) ? inequalityConstraints->idxbx.size() : 0;
+    const int numInputBounds = (inequalityConstraints != nullptr) ? inequalityConstraints->idxbu.size() : 0;
+    const int numGeneral = (inequalityConstraints != nullptr) ? inequalityConstraints->numGeneralConstraints() : 0;
+
+    // The initial state is not a decision variable
+    bool consistent = (k == 0 || lqSize.numStates[k] == ocpSize_.numStates[k]);
+    consistent = consistent && lqSize.numInputs[k] == ocpSize_.numInputs[k];
+    consistent = consistent && lqSize.numEqConstraints[k] == ocpSize_.numEqConstraints[k];
+    consistent = consistent && numGeneral == ocpSize_.numIneqConstraints[k];
+    consistent = consistent && (k == N || lq.A(k).rows() == ocpSize_.numStates[k + 1]);
+    consistent = consistent && ocpSize_.numStateBoxConstraints[k] == numStateBounds;
+    consistent = consistent && ocpSize_.numInputBoxConstraints[k] == numInputBounds;
+    consistent = consistent && ocpSize_.numStateBoxSlack[k] == 0 && ocpSize_.numInputBoxSlack[k] == 0 && ocpSize_.numIneqSlack[k] == 0;
+    return consistent;
+  }
+
+  bool setNode(int k, const vector_t& x0, OcpLqArena& lq, const NodeInequalityConstraints* inequalityConstraints) {
+    if (!isNodeSizeConsistent(k, lq, inequalityConstraints)) {
+      return false;
+    }
+
+    const int N = ocpSize_.numStages;
+    if (k == 0) {
+      // Absorb initial state into dynamics and cost, see the solve function above.
+      // numState[0] = 0 --> No need to specify A[0], Q[0], S[0], q[0], C[0] here
+      b0_ = lq.b(0);
+      b0_.noalias() += lq.A(0) * x0;
+      r0_ = lq.r(0);
+      r0_.noalias() += lq.S(0) * x0;
+      d_ocp_qp_set_B(0, lq.B(0).data(), &qp_);
+      d_ocp_qp_set_b(0, b0_.data(), &qp_);
+      d_ocp_qp_set_R(0, lq.R(0).data(), &qp_);
+      d_ocp_qp_set_r(0, r0_.data(), &qp_);
+    } else {
+      if (k < N) {
+        d_ocp_qp_set_A(k, lq.A(k).data(), &qp_);
+        d_ocp_qp_set_B(k, lq.B(k).data(), &qp_);
+        d_ocp_qp_set_b(k, lq.b(k).data(), &qp_);
+        d_ocp_qp_set_S(k, lq.S(k).data(), &qp_);
+        d_ocp_qp_set_R(k, lq.R(k).data(), &qp_);
+        d_ocp_qp_set_r(k, lq.r(k).data(), &qp_);
+      }
+      d_ocp_qp_set_Q(k, lq.Q(k).data(), &qp_);
+      d_ocp_qp_set_q(k, lq.q(k).data(), &qp_);
+    }
+
+    const bool hasInequalityConstraints = inequalityConstraints != nullptr && inequalityConstraints->numGeneralConstraints() > 0;
+    if (hasInequalityConstraints) {
+      setGeneralConstraints(k, x0, lq, *inequalityConstraints);
+    } else if (ocpSize_.numEqConstraints[k] > 0) {
+      setEqualityConstraints(k, x0, lq);
+    }
+    if (inequalityConstraints != nullptr) {
+      setBoxConstraints(k, *inequalityConstraints);
+    }
+    return true;
+  }
+
+  /** Equality constraints only: the blocks are read directly from the arena */
+  void setEqualityConstraints(int k, const vector_t& x0, OcpLqArena& lq) {
+    auto& data = constraintData_[k];
+    // for ocs2 --> C*dx + D*du + e = 0
+    // for hpipm --> ug >= C*dx + D*du >= lg
+    data.lg = -lq.e(k);
+    if (k == 0) {
+      data.lg.noalias() -= lq.C(0) * x0;
+    } else {
+      d_ocp_qp_set_C(k, lq.C(k).data(), &qp_);
+    }
+    if (k < ocpSize_.numStages) {
+      d_ocp_qp_set_D(k, lq.D(k).data(), &qp_);
+    }
+    d_ocp_qp_set_lg(k, data.lg.data(), &qp_);
+    d_ocp_qp_set_ug(k, data.lg.data(), &qp_);
+    setMask(data.lgMask, ocpSize_.numEqConstraints[k], 0, d_ocp_qp_set_lg_mask, k);
+    setMask(data.ugMask, ocpSize_.numEqConstraints[k], 0, d_ocp_qp_set_ug_mask, k);
+  }
+
+  /** Equality and inequality constraints: stacked as [equalities; inequalities], the inequalities have no upper bound */
+  void setGeneralConstraints(int k, const vector_t& x0, OcpLqArena& lq, const NodeInequalityConstraints& inequalityConstraints) {
+    auto& data = constraintData_[k];
+    const int numEq = lq.size().numEqConstraints[k];
+    const int numIneq = inequalityConstraints.numGeneralConstraints();
+    const int ng = numEq + numIneq;
+
+    data.C.resize(ng, lq.size().numStates[k]);
+    data.C.topRows(numEq) = lq.C(k);
+    data.C.bottomRows(numIneq) = inequalityConstraints.C;
+    data.D.resize(ng, lq.size().numInputs[k]);
+    data.D.topRows(numEq) = lq.D(k);
+    data.D.bottomRows(numIneq) = inequalityConstraints.D;
+    data.lg.resize(ng);
+    data.lg.head(numEq) = -lq.e(k);
+    data.lg.tail(numIneq) = inequalityConstraints.lg;
+    data.ug.resize(ng);
+    data.ug.head(numEq) = -lq.e(k);
+    data.ug.tail(numIneq).setZero();  // masked
+
+    if (k == 0) {
+      data.lg.noalias() -= data.C * x0;
+      data.ug.head(numEq).noalias() -= lq.C(0) * x0;
+    } else {
+      d_ocp_qp_set_C(k, data.C.data(), &qp_);
+    }
+    if (k < ocpSize_.numStages) {
+      d_ocp_qp_set_D(k, data.D.data(), &qp_);
+    }
+    d_ocp_qp_set_lg(k, data.lg.data(), &qp_);
+    d_ocp_qp_set_ug(k, data.ug.data(), &qp_);
+    setMask(data.lgMask, ng, 0, d_ocp_qp_set_lg_mask, k);
+    setMask(data.ugMask, numEq, numIneq, d_ocp_qp_set_ug_mask, k);
+  }
+
+  /** Simple bounds, infinite bounds are masked. State bounds of the initial node are ignored, the initial state is fixed */
+  void setBoxConstraints(int k, const NodeInequalityConstraints& inequalityConstraints) {
+    auto& data = constraintData_[k];
+    if (k > 0 && !inequalityConstraints.idxbx.empty()) {
+      data.idxbx = inequalityConstraints.idxbx;
+      d_ocp_qp_set_idxbx(k, data.idxbx.data(), &qp_);
+      setBounds(data.lbx, data.lbxMask, inequalityConstraints.lbx, d_ocp_qp_set_lbx, d_ocp_qp_set_lbx_mask, k);
+      setBounds(data.ubx, data.ubxMask, inequalityConstraints.ubx, d_ocp_qp_set_ubx, d_ocp_qp_set_ubx_mask, k);
+    }
+    if (!inequalityConstraints.idxbu.empty()) {
+      data.idxbu = inequalityConstraints.idxbu;
+      d_ocp_qp_set_idxbu(k, data.idxbu.data(), &qp_);
+      setBounds(data.lbu, data.lbuMask, inequalityConstraints.lbu, d_ocp_qp_set_lbu, d_ocp_qp_set_lbu_mask, k);
+      setBounds(data.ubu, data.ubuMask, inequalityConstraints.ubu, d_ocp_qp_set_ubu, d_ocp_qp_set_ubu_mask, k);
+    }
+  }
+
+  /** Sets a mask of numActive ones followed by numInactive zeros */
+  template <typename Setter>
+  void setMask(vector_t& mask, int numActive, int numInactive, Setter setter, int k) {
+    mask.resize(numActive + numInactive);
+    mask.head(numActive).setOnes();
+    mask.tail(numInactive).setZero();
+    setter(k, mask.data(), &qp_);
+  }
+
+  /** Sets the finite bounds and masks the infinite ones */
+  template <typename Setter, typename MaskSetter>
+  void setBounds(vector_t& bound, vector_t& mask, const vector_t& inputBound, Setter setter, MaskSetter maskSetter, int k) {
+    const auto isFinite = inputBound.array().isFinite();
+    bound = isFinite.select(inputBound, 0.0);
+    mask = isFinite.cast<scalar_t>();
+    setter(k, bound.data(), &qp_);
+    maskSetter(k, mask.data(), &qp_);
+  }
+
+  hpipm_status solveInPlace(const vector_t& x0, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose) {
+    ipmSolve();
+
+    if (verbose) {
+      printStatus();
+    }
+
+    if (!getStateSolution(x0, stateTrajectory)) {
+      return hpipm_status::NAN_SOL;
+    }
+    if (!getInputSolution(inputTrajectory)) {
+      return hpipm_status::NAN_SOL;
+    }
+
+    // Return solver status
+    int hpipmStatus = -1;
+    d_ocp_qp_ipm_get_status(ipmWorkspace(), &hpipmStatus);
+    return hpipm_status(hpipmStatus);
+  }
+
+  int getNumStages() const { return ocpSize_.numStages; }
+
+  /** Runs the IPM on the current QP. Starts cold if no previous iterate is available, even if warm starting is enabled. */
+  void ipmSolve() {
+    const bool warmStart = settings_.warm_start > 0 && hasWarmStart_;
+    if (!warmStart && settings_.warm_start > 0) {
+      int coldStart = 0;
+      d_ocp_qp_ipm_arg_set_warm_start(&coldStart, ipmArg());
+    }
+
+    if (isCondensed_) {
+      d_part_cond_qp_cond(&qp_, &condensedQp_, &condArg_, &condWorkspace_);
+      d_ocp_qp_ipm_solve(&condensedQp_, &condensedQpSol_, &condensedArg_, &condensedWorkspace_);
+      d_part_cond_qp_expand_sol(&qp_, &condensedQp_, &condensedQpSol_, &qpSol_, &condArg_, &condWorkspace_);
+    } else {
+      d_ocp_qp_ipm_solve(&qp_, &qpSol_, &arg_, &workspace_);
+    }
+    riccatiExpanded_ = false;
+
+    if (!warmStart && settings_.warm_start > 0) {
+      d_ocp_qp_ipm_arg_set_warm_start(&settings_.warm_start, ipmArg());
+    }
+    int hpipmStatus = -1;
+    d_ocp_qp_ipm_get_status(ipmWorkspace(), &hpipmStatus);
+    lastSolveWarmStarted_ = warmStart;
+    hasWarmStart_ = (hpipmStatus != hpipm_status::NAN_SOL);
+  }
+
+  int getNumIterations() {
+    int iter = 0;
+    d_ocp_qp_ipm_get_iter(ipmWorkspace(), &iter);
+    return iter;
+  }
+
+  bool isWarmStarted() const { return lastSolveWarmStarted_; }
+
+  void shiftSolution(int numStages, scalar_t primalScaling) {
+    const int N = ocpSize_.numStages;
+    if (!hasWarmStart_ || numStages < 0 || numStages > N) {
+      hasWarmStart_ = false;
+      return;
+    }
+
+    // The IPM starts from the condensed solution. It can be scaled, but moving stages would require to condense the moved solution.
+    if (isCondensed_) {
+      if (numStages > 0) {
+        hasWarmStart_ = false;
+      } else if (primalScaling != 1.0) {
+        scaleCondensedPrimalSolution(primalScaling);
+      }
+      return;
+    }
+
+    // The stages can only be moved if they have the same dimensions. The initial state is not a decision variable, the state
+    // dimension of the stage that moves to k = 0 is therefore irrelevant.
+    for (int k = 0; k + numStages <= N; ++k) {
+      const int j = k + numStages;
+      bool consistent = (k == 0 || ocpSize_.numStates[k] == ocpSize_.numStates[j]);
+      consistent = consistent && ocpSize_.numInputs[k] == ocpSize_.numInputs[j];
+      consistent = consistent && ocpSize_.numEqConstraints[k] == ocpSize_.numEqConstraints[j];
+      consistent = consistent && ocpSize_.numIneqConstraints[k] == ocpSize_.numIneqConstraints[j];
+      consistent = consistent && (k == 0 || ocpSize_.numStateBoxConstraints[k] == ocpSize_.numStateBoxConstraints[j]);
+      consistent = consistent && ocpSize_.numInputBoxConstraints[k] == ocpSize_.numInputBoxConstraints[j];
+      consistent = consistent && (k == N || j == N || ocpSize_.numStates[k + 1] == ocpSize_.numStates[j + 1]);
+      if (!consistent) {
+        hasWarmStart_ = false;
+        return;
+      }
+    }
+
+    // Moves stage k + numStages to stage k. Stages at the end of the horizon keep their values.
+    for (int k = 0; k + numStages <= N; ++k) {
+      const int j = k + numStages;
+      if (k > 0) {
+        moveStageData(ocpSize_.numStates[k], d_ocp_qp_sol_get_x, j, d_ocp_qp_sol_set_x, k, primalScaling);
+      }
+      moveStageData(ocpSize_.numInputs[k], d_ocp_qp_sol_get_u, j, d_ocp_qp_sol_set_u, k, primalScaling);
+      if (k < N && j < N) {
+        moveStageData(ocpSize_.numStates[k + 1], d_ocp_qp_sol_get_pi, j, d_ocp_qp_sol_set_pi, k, 1.0);
+      }
+      // HPIPM orders the input bounds first, stage 0 only reads the input bounds of the moved stage.
+      const int nb = ocpSize_.numStateBoxConstraints[j] + ocpSize_.numInputBoxConstraints[j];
+      moveStageData(nb, d_ocp_qp_sol_get_lam_lb, j, d_ocp_qp_sol_set_lam_lb, k, 1.0);
+      moveStageData(nb, d_ocp_qp_sol_get_lam_ub, j, d_ocp_qp_sol_set_lam_ub, k, 1.0);
+      moveStageData(nb, d_ocp_qp_sol_get_t_lb, j, d_ocp_qp_sol_set_t_lb, k, 1.0);
+      moveStageData(nb, d_ocp_qp_sol_get_t_ub, j, d_ocp_qp_sol_set_t_ub, k, 1.0);
+      const int ng = numGeneralConstraints_[k];
+      moveStageData(ng, d_ocp_qp_sol_get_lam_lg, j, d_ocp_qp_sol_set_lam_lg, k, 1.0);
+      moveStageData(ng, d_ocp_qp_sol_get_lam_ug, j, d_ocp_qp_sol_set_lam_ug, k, 1.0);
+      moveStageData(ng, d_ocp_qp_sol_get_t_lg, j, d_ocp_qp_sol_set_t_lg, k, 1.0);
+      moveStageData(ng, d_ocp_qp_sol_get_t_ug, j, d_ocp_qp_sol_set_t_ug, k, 1.0);
+    }
+
+    // Only the primal part of the tail is scaled
+    if (primalScaling != 1.0) {
+      for (int k = std::max(N - numStages + 1, 1); k <= N; ++k) {
+        moveStageData(ocpSize_.numStates[k], d_ocp_qp_sol_get_x, k, d_ocp_qp_sol_set_x, k, primalScaling);
+        if (k < N) {
+          moveStageData(ocpSize_.numInputs[k], d_ocp_qp_sol_get_u, k, d_ocp_qp_sol_set_u, k, primalScaling);
+        }
+      }
+    }
+  }
+
+  void resetWarmStart() { hasWarmStart_ = false; }
+
+  /** Scales the primal variables of the condensed solution, which is the initial guess of the next solve */
+  void scaleCondensedPrimalSolution(scalar_t scaling) {
+    const int numBlocks = static_cast<int>(blockSizes_.size()) - 1;
+    for (int j = 0; j <= numBlocks; ++j) {
+      int nx = 0;
+      int nu = 0;
+      d_ocp_qp_dim_get_nx(&condensedDim_, j, &nx);
+      d_ocp_qp_dim_get_nu(&condensedDim_, j, &nu);
+      moveStageData(condensedQpSol_, nx, d_ocp_qp_sol_get_x, j, d_ocp_qp_sol_set_x, j, scaling);
+      moveStageData(condensedQpSol_, nu, d_ocp_qp_sol_get_u, j, d_ocp_qp_sol_set_u, j, scaling);
+    }
+  }
+
   bool getStateSolution(const vector_t& x0, vector_array_t& stateTrajectory) {
     stateTrajectory.resize(ocpSize_.numStages + 1);
     stateTrajectory.front() = x0;
@@ -332,11 +744,11 @@ class HpipmInterface::Impl {
     matrix_array_t RiccatiFeedback(N);
 
     // k = 0, state is not a decision variable. Reconstruct backward pass from k = 1
-    matrix_t P1(ocpSize_.numStates[1], ocpSize_.numStates[1]);
-    d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, 1, P1.data());
+    matrix_t P1;
+    getRicP(1, P1);
 
-    matrix_t Lr(ocpSize_.numInputs[0], ocpSize_.numInputs[0]);
-    d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, 0, Lr.data());  // Lr matrix is lower triangular
+    matrix_t Lr;
+    getRicLr(0, Lr);  // Lr matrix is lower triangular
     LinearAlgebra::setTriangularMinimumEigenvalues(Lr);
 
     // RiccatiFeedback[0] = - (inv(Lr)^T * inv(Lr)) * (S0 + B0^T * P1 * A0)
@@ -352,12 +764,10 @@ class HpipmInterface::Impl {
       const auto numInput = ocpSize_.numInputs[k];
       if (numInput > 0) {
         // RiccatiFeedback[k] = -(Ls * Lr.inverse()).transpose();
-        Lr.resize(numInput, numInput);
-        d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, k, Lr.data());  // Lr matrix is lower triangular
+        getRicLr(k, Lr);  // Lr matrix is lower triangular
         LinearAlgebra::setTriangularMinimumEigenvalues(Lr);
 
-        Ls.resize(ocpSize_.numStates[k], numInput);
-        d_ocp_qp_ipm_get_ric_Ls(&qp_, &arg_, &workspace_, k, Ls.data());
+        getRicLs(k, Ls);
         RiccatiFeedback[k].noalias() = -Lr.triangularView<Eigen::Lower>().transpose().solve(Ls.transpose());
       }
     }
@@ -371,15 +781,15 @@ class HpipmInterface::Impl {
     vector_array_t RiccatiFeedforward(N);
 
     // k = 0, state is not a decision variable. Reconstruct backward pass from k = 1
-    matrix_t P1(ocpSize_.numStates[1], ocpSize_.numStates[1]);
-    d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, 1, P1.data());
+    matrix_t P1;
+    getRicP(1, P1);
 
-    matrix_t Lr(ocpSize_.numInputs[0], ocpSize_.numInputs[0]);
-    d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, 0, Lr.data());
+    matrix_t Lr;
+    getRicLr(0, Lr);
     LinearAlgebra::setTriangularMinimumEigenvalues(Lr);
 
-    vector_t p1(ocpSize_.numStates[1]);
-    d_ocp_qp_ipm_get_ric_p(&qp_, &arg_, &workspace_, 1, p1.data());
+    vector_t p1;
+    getRicp(1, p1);
 
     // RiccatiFeedforward[0] = -(inv(Lr)^T * inv(Lr)) * (r0 + B0.transpose() * p1 + B0.transpose() * P1 * b0);
     RiccatiFeedforward[0] = -cost0.dfdu;
@@ -390,8 +800,7 @@ class HpipmInterface::Impl {
 
     // k > 0
     for (int k = 1; k < N; ++k) {
-      RiccatiFeedforward[k].resize(ocpSize_.numInputs[k]);
-      d_ocp_qp_ipm_get_ric_k(&qp_, &arg_, &workspace_, k, RiccatiFeedforward[k].data());
+      getRick(k, RiccatiFeedforward[k]);
     }
 
     return RiccatiFeedforward;
@@ -407,15 +816,13 @@ class HpipmInterface::Impl {
 
     // k > 0, this first so we have P[1] ready for P[0].
     for (int k = 1; k <= N; k++) {
-      RiccatiCostToGo[k].dfdxx.resize(ocpSize_.numStates[k], ocpSize_.numStates[k]);
-      RiccatiCostToGo[k].dfdx.resize(ocpSize_.numStates[k]);
-      d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, k, RiccatiCostToGo[k].dfdxx.data());
-      d_ocp_qp_ipm_get_ric_p(&qp_, &arg_, &workspace_, k, RiccatiCostToGo[k].dfdx.data());
+      getRicP(k, RiccatiCostToGo[k].dfdxx);
+      getRicp(k, RiccatiCostToGo[k].dfdx);
     }
 
     // k = 0
-    matrix_t Lr0(ocpSize_.numInputs[0], ocpSize_.numInputs[0]);
-    d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, 0, Lr0.data());
+    matrix_t Lr0;
+    getRicLr(0, Lr0);
     LinearAlgebra::setTriangularMinimumEigenvalues(Lr0);
 
     // Shorthand notation
@@ -454,9 +861,228 @@ class HpipmInterface::Impl {
     return RiccatiCostToGo;
   }
 
+  /**
+   * Riccati factorization of the original QP at stage k. With partial condensing, the IPM only factorizes the condensed QP, see
+   * prepareRiccati for how the factorization of the original QP is obtained.
+   */
+  void getRicP(int k, matrix_t& P) {
+    if (prepareRiccati()) {
+      P = ricP_[k];
+    } else {
+      P.resize(ocpSize_.numStates[k], ocpSize_.numStates[k]);
+      d_ocp_qp_ipm_get_ric_P(&qp_, &arg_, &workspace_, k, P.data());
+    }
+  }
+
+  void getRicp(int k, vector_t& p) {
+    if (prepareRiccati()) {
+      p = ricp_[k];
+    } else {
+      p.resize(ocpSize_.numStates[k]);
+      d_ocp_qp_ipm_get_ric_p(&qp_, &arg_, &workspace_, k, p.data());
+    }
+  }
+
+  void getRicLr(int k, matrix_t& Lr) {
+    if (prepareRiccati()) {
+      Lr = ricLr_[k];
+    } else {
+      Lr.resize(ocpSize_.numInputs[k], ocpSize_.numInputs[k]);
+      d_ocp_qp_ipm_get_ric_Lr(&qp_, &arg_, &workspace_, k, Lr.data());
+    }
+  }
+
+  void getRicLs(int k, matrix_t& Ls) {
+    if (prepareRiccati()) {
+      Ls = ricLs_[k];
+    } else {
+      Ls.resize(ocpSize_.numStates[k], ocpSize_.numInputs[k]);
+      d_ocp_qp_ipm_get_ric_Ls(&qp_, &arg_, &workspace_, k, Ls.data());
+    }
+  }
+
+  void getRick(int k, vector_t& kff) {
+    if (prepareRiccati()) {
+      kff = rick_[k];
+    } else {
+      kff.resize(ocpSize_.numInputs[k]);
+      d_ocp_qp_ipm_get_ric_k(&qp_, &arg_, &workspace_, k, kff.data());
+    }
+  }
+
+  /**
+   * Prepares the Riccati factorization of the original QP after a condensed solve, see expandRiccati.
+   *
+   * @return true if the factorization is in the expanded arrays, false if it is in the workspace of the original QP.
+   */
+  bool prepareRiccati() {
+    if (!isCondensed_) {
+      return false;
+    }
+    expandRiccati();
+    return true;
+  }
+
+  /**
+   * Runs the Riccati recursion of the original QP inside every block, starting from the cost-to-go of the condensed QP at the end of
+   * the block. The IPM solution of the condensed QP is expanded to the original QP by HPIPM, which is used for the constraints: as in
+   * the factorization of the IPM, every constraint adds a curvature of lam / t to the Hessian, and the gradient is chosen such that the
+   * recursion reproduces the solution. The linear term of the cost-to-go at the block ends is recovered from the costates.
+   */
+  void expandRiccati() {
+    if (riccatiExpanded_) {
+      return;
+    }
+    const int N = ocpSize_.numStages;
+    const int numBlocks = static_cast<int>(blockSizes_.size()) - 1;
+    ricP_.resize(N + 1);
+    ricp_.resize(N + 1);
+    ricLr_.resize(N);
+    ricLs_.resize(N);
+    rick_.resize(N);
+
+    // Cost-to-go at the block boundaries: stage j of the condensed QP is stage blockStarts_[j] of the original QP. The costate of the
+    // preceding dynamics is pi[k-1] = P[k] x[k] + p[k].
+    vector_t x, pi;
+    for (int j = 1; j <= numBlocks; ++j) {
+      const int k = blockStarts_[j];
+      ricP_[k].resize(ocpSize_.numStates[k], ocpSize_.numStates[k]);
+      d_ocp_qp_ipm_get_ric_P(&condensedQp_, &condensedArg_, &condensedWorkspace_, j, ricP_[k].data());
+      x.resize(ocpSize_.numStates[k]);
+      pi.resize(ocpSize_.numStates[k]);
+      d_ocp_qp_sol_get_x(k, &qpSol_, x.data());
+      d_ocp_qp_sol_get_pi(k - 1, &qpSol_, pi.data());
+      ricp_[k] = pi;
+      ricp_[k].noalias() -= ricP_[k] * x;
+    }
+
+    matrix_t A, B, Q, S, R, PA, G;
+    vector_t b, q, r, u, Pbp, g;
+    for (int j = numBlocks - 1; j >= 0; --j) {
+      for (int k = blockStarts_[j + 1] - 1; k >= blockStarts_[j]; --k) {
+        const int nx = ocpSize_.numStates[k];
+        const int nu = ocpSize_.numInputs[k];
+        const int nxNext = ocpSize_.numStates[k + 1];
+        const matrix_t& P = ricP_[k + 1];
+        const vector_t& p = ricp_[k + 1];
+
+        // Stage data, the initial state is not a decision variable (nx = 0 at k = 0)
+        A.resize(nxNext, nx);
+        B.resize(nxNext, nu);
+        b.resize(nxNext);
+        Q.resize(nx, nx);
+        S.resize(nu, nx);
+        R.resize(nu, nu);
+        q.resize(nx);
+        r.resize(nu);
+        d_ocp_qp_get_A(k, &qp_, A.data());
+        d_ocp_qp_get_B(k, &qp_, B.data());
+        d_ocp_qp_get_b(k, &qp_, b.data());
+        d_ocp_qp_get_Q(k, &qp_, Q.data());
+        d_ocp_qp_get_S(k, &qp_, S.data());
+        d_ocp_qp_get_R(k, &qp_, R.data());
+        d_ocp_qp_get_q(k, &qp_, q.data());
+        d_ocp_qp_get_r(k, &qp_, r.data());
+        x.resize(nx);
+        u.resize(nu);
+        d_ocp_qp_sol_get_x(k, &qpSol_, x.data());
+        d_ocp_qp_sol_get_u(k, &qpSol_, u.data());
+        addConstraintCurvature(k, x, u, Q, S, R, q, r);
+
+        // Hessian of the input: R + B' P B = Lr Lr'
+        R.noalias() += B.transpose() * P * B;
+        const Eigen::LLT<matrix_t> llt(R);
+        ricLr_[k] = llt.matrixL();
+
+        // Gradient of the input: r + B' (P b + p)
+        Pbp = p;
+        Pbp.noalias() += P * b;
+        g = r;
+        g.noalias() += B.transpose() * Pbp;
+        rick_[k] = -llt.solve(g);
+
+        // The stages at the start of the other blocks come from the condensed QP
+        if (k == 0) {
+          continue;
+        }
+        PA.noalias() = P * A;
+        G = S;
+        G.noalias() += B.transpose() * PA;
+        ricLs_[k] = ricLr_[k].triangularView<Eigen::Lower>().solve(G).transpose();
+        if (k == blockStarts_[j]) {
+          continue;
+        }
+        ricP_[k] = Q;
+        ricP_[k].noalias() += A.transpose() * PA;
+        ricP_[k].noalias() -= ricLs_[k] * ricLs_[k].transpose();
+        ricp_[k] = q;
+        ricp_[k].noalias() += A.transpose() * Pbp;
+        ricp_[k].noalias() += G.transpose() * rick_[k];
+      }
+    }
+    riccatiExpanded_ = true;
+  }
+
+  /**
+   * Adds the constraints of stage k to its cost as in the last factorization of the IPM: each bound with multiplier lam and slack t adds
+   * the curvature w = lam / t, the gradient is such that the stationarity condition of the solution (x, u) holds for the extended cost.
+   */
+  void addConstraintCurvature(int k, const vector_t& x, const vector_t& u, matrix_t& Q, matrix_t& S, matrix_t& R, vector_t& q,
+                              vector_t& r) {
+    const auto getCurvature = [&](int n, auto getLamL, auto getLamU, auto getTL, auto getTU, vector_t& w, vector_t& v) {
+      vector_t lamL(n), lamU(n), tL(n), tU(n);
+      getLamL(k, &qpSol_, lamL.data());
+      getLamU(k, &qpSol_, lamU.data());
+      getTL(k, &qpSol_, tL.data());
+      getTU(k, &qpSol_, tU.data());
+      const auto ratio = [](const vector_t& lam, const vector_t& t) { return (t.array() > 0.0).select(lam.array() / t.array(), 0.0); };
+      w = ratio(lamL, tL) + ratio(lamU, tU);
+      v = lamU - lamL;
+    };
+
+    // Simple bounds, HPIPM orders the input bounds first
+    const int nbu = ocpSize_.numInputBoxConstraints[k];
+    const int nbx = ocpSize_.numStateBoxConstraints[k];
+    if (nbu + nbx > 0) {
+      std::vector<int> idxbu(nbu), idxbx(nbx);
+      d_ocp_qp_get_idxbu(k, &qp_, idxbu.data());
+      d_ocp_qp_get_idxbx(k, &qp_, idxbx.data());
+      vector_t w, v;
+      getCurvature(nbu + nbx, d_ocp_qp_sol_get_lam_lb, d_ocp_qp_sol_get_lam_ub, d_ocp_qp_sol_get_t_lb, d_ocp_qp_sol_get_t_ub, w, v);
+      for (int i = 0; i < nbu; ++i) {
+        const int iu = idxbu[i];
+        R(iu, iu) += w(i);
+        r(iu) += v(i) - w(i) * u(iu);
+      }
+      for (int i = 0; i < nbx; ++i) {
+        const int ix = idxbx[i];
+        Q(ix, ix) += w(nbu + i);
+        q(ix) += v(nbu + i) - w(nbu + i) * x(ix);
+      }
+    }
+
+    // General constraints lg <= C x + D u <= ug
+    const int ng = numGeneralConstraints_[k];
+    if (ng > 0) {
+      matrix_t C(ng, x.size()), D(ng, u.size());
+      d_ocp_qp_get_C(k, &qp_, C.data());
+      d_ocp_qp_get_D(k, &qp_, D.data());
+      vector_t w, v;
+      getCurvature(ng, d_ocp_qp_sol_get_lam_lg, d_ocp_qp_sol_get_lam_ug, d_ocp_qp_sol_get_t_lg, d_ocp_qp_sol_get_t_ug, w, v);
+      v.noalias() -= w.asDiagonal() * (C * x + D * u);
+      const matrix_t WC = w.asDiagonal() * C;
+      const matrix_t WD = w.asDiagonal() * D;
+      Q.noalias() += C.transpose() * WC;
+      S.noalias() += D.transpose() * WC;
+      R.noalias() += D.transpose() * WD;
+      q.noalias() += C.transpose() * v;
+      r.noalias() += D.transpose() * v;
+    }
+  }
+
   void printStatus() {
     int hpipmStatus = -1;
-    d_ocp_qp_ipm_get_status(&workspace_, &hpipmStatus);
+    d_ocp_qp_ipm_get_status(ipmWorkspace(), &hpipmStatus);
     fprintf(stderr, "\n=== HPIPM ===\n");
     fprintf(stderr, "HPIPM returned with flag %i. -> ", hpipmStatus);
     if (hpipmStatus == hpipm_status::SUCCESS) {
@@ -474,19 +1100,19 @@ class HpipmInterface::Impl {
     }
 
     int iter;
-    d_ocp_qp_ipm_get_iter(&workspace_, &iter);
+    d_ocp_qp_ipm_get_iter(ipmWorkspace(), &iter);
     scalar_t res_stat;
-    d_ocp_qp_ipm_get_max_res_stat(&workspace_, &res_stat);
+    d_ocp_qp_ipm_get_max_res_stat(ipmWorkspace(), &res_stat);
     scalar_t res_eq;
-    d_ocp_qp_ipm_get_max_res_eq(&workspace_, &res_eq);
+    d_ocp_qp_ipm_get_max_res_eq(ipmWorkspace(), &res_eq);
     scalar_t res_ineq;
-    d_ocp_qp_ipm_get_max_res_ineq(&workspace_, &res_ineq);
+    d_ocp_qp_ipm_get_max_res_ineq(ipmWorkspace(), &res_ineq);
     scalar_t res_comp;
-    d_ocp_qp_ipm_get_max_res_comp(&workspace_, &res_comp);
+    d_ocp_qp_ipm_get_max_res_comp(ipmWorkspace(), &res_comp);
     scalar_t* stat;
-    d_ocp_qp_ipm_get_stat(&workspace_, &stat);
+    d_ocp_qp_ipm_get_stat(ipmWorkspace(), &stat);
     int stat_m;
-    d_ocp_qp_ipm_get_stat_m(&workspace_, &stat_m);
+    d_ocp_qp_ipm_get_stat_m(ipmWorkspace(), &stat_m);
     fprintf(stderr, "ipm iter = %d\n", iter);
     fprintf(stderr, "ipm residuals max: res_g = %e, res_b = %e, res_d = %e, res_m = %e\n", res_stat, res_eq, res_ineq, res_comp);
     fprintf(stderr,
@@ -505,6 +1131,7 @@ class HpipmInterface::Impl {
  private:
   Settings settings_;
   OcpSize ocpSize_;
+  std::vector<int> numGeneralConstraints_;  // equality and inequality constraints per node, the general constraints of HPIPM
 
   MemoryBlock dimMem_;
   d_ocp_qp_dim dim_;
@@ -520,6 +1147,74 @@ class HpipmInterface::Impl {
 
   MemoryBlock ipmMem_;
   d_ocp_qp_ipm_ws workspace_;
+
+  // Initial stage data and constraint data for setting the QP per node
+  struct NodeConstraintData {
+    matrix_t C, D;
+    vector_t lg, ug, lgMask, ugMask;
+    std::vector<int> idxbx, idxbu;
+    vector_t lbx, ubx, lbu, ubu, lbxMask, ubxMask, lbuMask, ubuMask;
+  };
+  vector_t b0_, r0_;
+  std::vector<NodeConstraintData> constraintData_;
+
+  // Partial condensing
+  bool isCondensed_ = false;
+  std::vector<int> blockSizes_;   // number of stages of each block, as computed by HPIPM
+  std::vector<int> blockStarts_;  // first stage of each block in the original QP, blockStarts_.back() = N
+
+  MemoryBlock condensedDimMem_;
+  d_ocp_qp_dim condensedDim_;
+
+  MemoryBlock condensedQpMem_;
+  d_ocp_qp condensedQp_;
+
+  MemoryBlock condensedQpSolMem_;
+  d_ocp_qp_sol condensedQpSol_;
+
+  MemoryBlock condensedIpmArgMem_;
+  d_ocp_qp_ipm_arg condensedArg_;
+
+  MemoryBlock condensedIpmMem_;
+  d_ocp_qp_ipm_ws condensedWorkspace_;
+
+  MemoryBlock condArgMem_;
+  d_part_cond_qp_arg condArg_;
+
+  MemoryBlock condWorkspaceMem_;
+  d_part_cond_qp_ws condWorkspace_;
+
+  // Riccati factorization of the original QP when condensing, computed on demand
+  bool riccatiExpanded_ = false;  // the factorization of the last solve is available
+  matrix_array_t ricP_, ricLr_, ricLs_;
+  vector_array_t ricp_, rick_;
+
+  // Warm start
+  bool hasWarmStart_ = false;          // qpSol_ holds the iterate of a previous solve
+  bool lastSolveWarmStarted_ = false;  // the last solve started from a previous iterate
+  vector_t shiftBuffer_;
+
+  /** Copies and scales stage data between stages of the solution through the given HPIPM getter and setter. Size is the one of the
+   * source stage. */
+  template <typename Getter, typename Setter>
+  void moveStageData(int size, Getter getter, int from, Setter setter, int to, scalar_t scaling) {
+    moveStageData(qpSol_, size, getter, from, setter, to, scaling);
+  }
+
+  template <typename Getter, typename Setter>
+  void moveStageData(d_ocp_qp_sol& solution, int size, Getter getter, int from, Setter setter, int to, scalar_t scaling) {
+    if (size == 0) {
+      return;
+    }
+    if (shiftBuffer_.size() < size) {
+      shiftBuffer_.resize(size);
+    }
+    getter(from, &solution, shiftBuffer_.data());
+    if (scaling != 1.0) {
+      shiftBuffer_.head(size) *= scaling;
+    }
+    setter(to, shiftBuffer_.data(), &solution);
+  }
 };
 
 HpipmInterface::HpipmInterface(OcpSize ocpSize, const Settings& settings)
@@ -527,8 +1222,8 @@ HpipmInterface::HpipmInterface(OcpSize ocpSize, const Settings& settings)
 
 HpipmInterface::~HpipmInterface() = default;
 
-void HpipmInterface::resize(OcpSize ocpSize) {
-  pImpl_->initializeMemory(std::move(ocpSize));
+void HpipmInterface::resize(const OcpSize& ocpSize) {
+  pImpl_->initializeMemory(ocpSize);
 }
 
 hpipm_status HpipmInterface::solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
@@ -538,6 +1233,49 @@ hpipm_status HpipmInterface::solve(const vector_t& x0, std::vector<VectorFunctio
   return pImpl_->solve(x0, dynamics, cost, constraints, stateTrajectory, inputTrajectory, verbose);
 }
 
+hpipm_status HpipmInterface::solve(const vector_t& x0, OcpLqArena& lq, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory,
+                                   bool verbose) {
+  return pImpl_->solve(x0, lq, nullptr, stateTrajectory, inputTrajectory, verbose);
+}
+
+hpipm_status HpipmInterface::solve(const vector_t& x0, OcpLqArena& lq, const std::vector<NodeInequalityConstraints>& inequalityConstraints,
+                                   vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose) {
+  return pImpl_->solve(x0, lq, &inequalityConstraints, stateTrajectory, inputTrajectory, verbose);
+}
+
+bool HpipmInterface::isNodeSizeConsistent(int k, const OcpLqArena& lq, const NodeInequalityConstraints* inequalityConstraints) const {
+  return pImpl_->isNodeSizeConsistent(k, lq, inequalityConstraints);
+}
+
+bool HpipmInterface::setNode(int k, const vector_t& x0, OcpLqArena& lq, const NodeInequalityConstraints* inequalityConstraints) {
+  return pImpl_->setNode(k, x0, lq, inequalityConstraints);
+}
+
+hpipm_status HpipmInterface::solveInPlace(const vector_t& x0, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory,
+                                          bool verbose) {
+  return pImpl_->solveInPlace(x0, stateTrajectory, inputTrajectory, verbose);
+}
+
+int HpipmInterface::getNumStages() const {
+  return pImpl_->getNumStages();
+}
+
+void HpipmInterface::shiftSolution(int numStages, scalar_t primalScaling) {
+  pImpl_->shiftSolution(numStages, primalScaling);
+}
+
+void HpipmInterface::resetWarmStart() {
+  pImpl_->resetWarmStart();
+}
+
+int HpipmInterface::getNumIterations() const {
+  return pImpl_->getNumIterations();
+}
+
+bool HpipmInterface::isWarmStarted() const {
+  return pImpl_->isWarmStarted();
+}
+
 std::vector<ScalarFunctionQuadraticApproximation> HpipmInterface::getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0,
                                                                                      const ScalarFunctionQuadraticApproximation& cost0) {
   return pImpl_->getRiccatiCostToGo(dynamics0, cost0);
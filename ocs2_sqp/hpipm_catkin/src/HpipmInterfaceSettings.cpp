@@ -51,6 +51,8 @@ std::ostream& operator<<(std::ostream& stream, const Settings& settings) {
   loadData::printValue(stream, settings.warm_start, "warm_start", settings.warm_start != defaultSettings.warm_start);
   loadData::printValue(stream, settings.pred_corr, "pred_corr", settings.pred_corr != defaultSettings.pred_corr);
   loadData::printValue(stream, settings.ric_alg, "ric_alg", settings.ric_alg != defaultSettings.ric_alg);
+  loadData::printValue(stream, settings.condensingBlockSize, "condensingBlockSize",
+                       settings.condensingBlockSize != defaultSettings.condensingBlockSize);
   stream << " #### =============================================================================" << std::endl;
   return stream;
 }
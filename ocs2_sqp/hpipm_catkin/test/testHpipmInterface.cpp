@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "hpipm_catkin/HpipmInterface.h"
 
+#include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/test/testTools.h>
 #include <ocs2_oc/test/testProblemsGeneration.h>
 
@@ -175,11 +176,11 @@ TEST(test_hpiphm_interface, with_constraints) {
 
   // Resize Interface
   ocs2::OcpSize ocpSize(N, nx, nu);
-  std::fill(ocpSize.numIneqConstraints.begin(), ocpSize.numIneqConstraints.end(), nc);
+  std::fill(ocpSize.numEqConstraints.begin(), ocpSize.numEqConstraints.end(), nc);
 
   // Set one of the constraints to empty
   constraints[1] = ocs2::VectorFunctionLinearApproximation();
-  ocpSize.numIneqConstraints[1] = 0;
+  ocpSize.numEqConstraints[1] = 0;
 
   hpipmInterface.resize(ocpSize);
 
@@ -205,6 +206,81 @@ TEST(test_hpiphm_interface, with_constraints) {
   }
 }
 
+TEST(test_hpiphm_interface, with_inequality_constraints) {
+  ocs2::HpipmInterface hpipmInterface;
+
+  const int nx = 3;
+  const int nu = 2;
+  const int nc = 1;
+  const int N = 5;
+  const ocs2::scalar_t inputBound = 0.1;
+
+  // Problem setup: equality constraints in the arena, input bounds, a state bound, and a general state constraint. All constraints
+  // are built around the trajectory with zero input, such that the problem is feasible and the bounds are likely active.
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  ocs2::OcpLqArena lqArena;
+  lqArena.reserve(N, nx, nu, nc);
+  std::vector<ocs2::NodeInequalityConstraints> inequalityConstraints(N + 1);
+  ocs2::vector_t xZeroInput = x0;
+  for (int k = 0; k <= N; k++) {
+    const int nuk = (k < N) ? nu : 0;
+    lqArena.setCost(k, ocs2::getRandomCost(nx, nuk));
+    auto constraints = ocs2::getRandomConstraints(nx, nuk, nc);
+    constraints.f = -constraints.dfdx * xZeroInput;
+    lqArena.setConstraints(k, constraints);
+
+    ocs2::VectorFunctionLinearApproximation stateIneq(2, nx, 0);
+    stateIneq.dfdx.setZero();
+    stateIneq.dfdx(0, 1) = -1.0;  // x1 <= xZeroInput1 + 0.05
+    stateIneq.dfdx.row(1).setOnes();  // sum(x) >= sum(xZeroInput) - 0.05
+    stateIneq.f << xZeroInput(1) + 0.05, 0.05 - xZeroInput.sum();
+    ocs2::VectorFunctionLinearApproximation inputIneq(2 * nuk, nx, nuk);
+    inputIneq.dfdx.setZero();
+    inputIneq.dfdu << ocs2::matrix_t::Identity(nuk, nuk), -ocs2::matrix_t::Identity(nuk, nuk);
+    inputIneq.f.setConstant(inputBound);
+    ocs2::splitInequalityConstraints(nx, nuk, (k > 0) ? stateIneq : ocs2::VectorFunctionLinearApproximation(), inputIneq, true,
+                                     inequalityConstraints[k]);
+
+    if (k < N) {
+      lqArena.setDynamics(k, ocs2::getRandomDynamics(nx, nu));
+      xZeroInput = lqArena.A(k) * xZeroInput + lqArena.b(k);
+    }
+  }
+  ASSERT_EQ(inequalityConstraints[1].idxbx.size(), 1);
+  ASSERT_EQ(inequalityConstraints[1].idxbu.size(), nu);
+  ASSERT_EQ(inequalityConstraints[1].numGeneralConstraints(), 1);
+
+  ocs2::OcpSize ocpSize = lqArena.size();
+  ocs2::addInequalityConstraintsSize(inequalityConstraints, ocpSize);
+  hpipmInterface.resize(ocpSize);
+
+  // Solve!
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  const auto status = hpipmInterface.solve(x0, lqArena, inequalityConstraints, xSol, uSol, true);
+  ASSERT_EQ(status, hpipm_status::SUCCESS);
+  ASSERT_TRUE(xSol[0].isApprox(x0));
+
+  // Dynamics and equality constraints
+  for (int k = 0; k < N; k++) {
+    ASSERT_TRUE(xSol[k + 1].isApprox(lqArena.A(k) * xSol[k] + lqArena.B(k) * uSol[k] + lqArena.b(k), 1e-9));
+    ASSERT_LT((lqArena.C(k) * xSol[k] + lqArena.D(k) * uSol[k] + lqArena.e(k)).norm(), 1e-6);
+  }
+
+  // Inequality constraints
+  const ocs2::scalar_t tol = 1e-6;
+  for (int k = 0; k <= N; k++) {
+    const auto& ineq = inequalityConstraints[k];
+    if (k < N) {
+      ASSERT_LE(uSol[k].cwiseAbs().maxCoeff(), inputBound + tol);
+    }
+    for (int i = 0; i < ineq.idxbx.size(); i++) {
+      ASSERT_LE(xSol[k](ineq.idxbx[i]), ineq.ubx(i) + tol);
+    }
+    ASSERT_TRUE(((ineq.C * xSol[k] - ineq.lg).array() >= -tol).all());
+  }
+}
+
 TEST(test_hpiphm_interface, noInputs) {
   // Initialize without size
   ocs2::HpipmInterface hpipmInterface;
@@ -338,3 +414,152 @@ TEST(test_hpiphm_interface, retrieveRiccati) {
     ASSERT_TRUE(uSol[k].isApprox(KSol[k] * xSol[k] + kSol[k]));
   }
 }
+
+namespace {
+/** Random stable problem resembling a discretized mechanical system */
+void getRandomDiscretizedProblem(int nx, int nu, int N, std::vector<ocs2::VectorFunctionLinearApproximation>& system,
+                                 std::vector<ocs2::ScalarFunctionQuadraticApproximation>& cost) {
+  const ocs2::scalar_t dt = 0.02;
+  system.clear();
+  cost.clear();
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    system[k].dfdx = ocs2::matrix_t::Identity(nx, nx) + dt * system[k].dfdx;
+    system[k].dfdu *= dt;
+    system[k].f *= dt;
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+}
+}  // namespace
+
+TEST(test_hpiphm_interface, partialCondensing) {
+  int nx = 4;
+  int nu = 2;
+  int N = 20;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  getRandomDiscretizedProblem(nx, nu, N, system, cost);
+  ocs2::OcpSize ocpSize(N, nx, nu);
+
+  // Reference without condensing
+  ocs2::HpipmInterface hpipmInterface(ocpSize);
+  std::vector<ocs2::vector_t> xSolGiven;
+  std::vector<ocs2::vector_t> uSolGiven;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, nullptr, xSolGiven, uSolGiven), hpipm_status::SUCCESS);
+  const auto KSolGiven = hpipmInterface.getRiccatiFeedback(system[0], cost[0]);
+  const auto kSolGiven = hpipmInterface.getRiccatiFeedforward(system[0], cost[0]);
+  const auto costToGoGiven = hpipmInterface.getRiccatiCostToGo(system[0], cost[0]);
+
+  for (int blockSize : {2, 3, 7, N}) {
+    ocs2::HpipmInterface::Settings settings;
+    settings.condensingBlockSize = blockSize;
+    ocs2::HpipmInterface condensedInterface(ocpSize, settings);
+
+    std::vector<ocs2::vector_t> xSol;
+    std::vector<ocs2::vector_t> uSol;
+    ASSERT_EQ(condensedInterface.solve(x0, system, cost, nullptr, xSol, uSol), hpipm_status::SUCCESS);
+    ASSERT_TRUE(ocs2::isEqual(xSolGiven, xSol, 1e-8)) << "blockSize: " << blockSize;
+    ASSERT_TRUE(ocs2::isEqual(uSolGiven, uSol, 1e-8)) << "blockSize: " << blockSize;
+
+    // The Riccati quantities are expanded to all stages of the original problem
+    const auto KSol = condensedInterface.getRiccatiFeedback(system[0], cost[0]);
+    const auto kSol = condensedInterface.getRiccatiFeedforward(system[0], cost[0]);
+    const auto costToGo = condensedInterface.getRiccatiCostToGo(system[0], cost[0]);
+    ASSERT_TRUE(ocs2::isEqual(KSolGiven, KSol, 1e-8)) << "blockSize: " << blockSize;
+    ASSERT_TRUE(ocs2::isEqual(kSolGiven, kSol, 1e-8)) << "blockSize: " << blockSize;
+    for (int k = 0; k <= N; k++) {
+      ASSERT_TRUE(costToGoGiven[k].dfdxx.isApprox(costToGo[k].dfdxx, 1e-8)) << "blockSize: " << blockSize << ", k: " << k;
+      ASSERT_TRUE(costToGoGiven[k].dfdx.isApprox(costToGo[k].dfdx, 1e-8)) << "blockSize: " << blockSize << ", k: " << k;
+    }
+  }
+}
+
+TEST(test_hpiphm_interface, partialCondensingWithConstraints) {
+  int nx = 4;
+  int nu = 2;
+  int nc = 1;
+  int N = 20;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  std::vector<ocs2::VectorFunctionLinearApproximation> constraints;
+  getRandomDiscretizedProblem(nx, nu, N, system, cost);
+  for (int k = 0; k < N; k++) {
+    constraints.emplace_back(ocs2::getRandomConstraints(nx, nu, nc));
+  }
+  constraints.emplace_back();
+  ocs2::OcpSize ocpSize(N, nx, nu);
+  std::fill(ocpSize.numEqConstraints.begin(), std::prev(ocpSize.numEqConstraints.end()), nc);
+
+  // Reference without condensing
+  ocs2::HpipmInterface hpipmInterface(ocpSize);
+  std::vector<ocs2::vector_t> xSolGiven;
+  std::vector<ocs2::vector_t> uSolGiven;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, &constraints, xSolGiven, uSolGiven), hpipm_status::SUCCESS);
+  const auto KSolGiven = hpipmInterface.getRiccatiFeedback(system[0], cost[0]);
+  const auto kSolGiven = hpipmInterface.getRiccatiFeedforward(system[0], cost[0]);
+  const auto costToGoGiven = hpipmInterface.getRiccatiCostToGo(system[0], cost[0]);
+
+  for (int blockSize : {2, 7}) {
+    ocs2::HpipmInterface::Settings settings;
+    settings.condensingBlockSize = blockSize;
+    ocs2::HpipmInterface condensedInterface(ocpSize, settings);
+
+    std::vector<ocs2::vector_t> xSol;
+    std::vector<ocs2::vector_t> uSol;
+    ASSERT_EQ(condensedInterface.solve(x0, system, cost, &constraints, xSol, uSol), hpipm_status::SUCCESS);
+    ASSERT_TRUE(ocs2::isEqual(xSolGiven, xSol, 1e-6)) << "blockSize: " << blockSize;
+    ASSERT_TRUE(ocs2::isEqual(uSolGiven, uSol, 1e-6)) << "blockSize: " << blockSize;
+
+    // The constraints enter the expanded gains through the curvature of the IPM, which is only the one of the uncondensed solve up to
+    // the tolerance of the IPM
+    const auto KSol = condensedInterface.getRiccatiFeedback(system[0], cost[0]);
+    const auto kSol = condensedInterface.getRiccatiFeedforward(system[0], cost[0]);
+    const auto costToGo = condensedInterface.getRiccatiCostToGo(system[0], cost[0]);
+    ASSERT_TRUE(ocs2::isEqual(KSolGiven, KSol, 1e-5)) << "blockSize: " << blockSize;
+    ASSERT_TRUE(ocs2::isEqual(kSolGiven, kSol, 1e-5)) << "blockSize: " << blockSize;
+    for (int k = 0; k <= N; k++) {
+      ASSERT_TRUE(costToGoGiven[k].dfdxx.isApprox(costToGo[k].dfdxx, 1e-5)) << "blockSize: " << blockSize << ", k: " << k;
+      ASSERT_TRUE(costToGoGiven[k].dfdx.isApprox(costToGo[k].dfdx, 1e-5)) << "blockSize: " << blockSize << ", k: " << k;
+    }
+  }
+}
+
+TEST(test_hpiphm_interface, partialCondensingBenchmark) {
+  // Size of a 7 dof arm
+  int nx = 14;
+  int nu = 7;
+  int N = 50;
+  int numRepeats = 100;
+
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  getRandomDiscretizedProblem(nx, nu, N, system, cost);
+  ocs2::OcpSize ocpSize(N, nx, nu);
+
+  std::cerr << "\n[HpipmInterface] Partial condensing, N = " << N << ", nx = " << nx << ", nu = " << nu << "\n";
+  for (int blockSize : {1, 2, 5, 10, 25, 50}) {
+    ocs2::HpipmInterface::Settings settings;
+    settings.condensingBlockSize = blockSize;
+    ocs2::HpipmInterface hpipmInterface(ocpSize, settings);
+
+    std::vector<ocs2::vector_t> xSol;
+    std::vector<ocs2::vector_t> uSol;
+    ocs2::benchmark::RepeatedTimer timer;
+    for (int i = 0; i < numRepeats; i++) {
+      timer.startTimer();
+      const auto status = hpipmInterface.solve(x0, system, cost, nullptr, xSol, uSol);
+      timer.endTimer();
+      ASSERT_EQ(status, hpipm_status::SUCCESS);
+    }
+    std::cerr << "  N_c: " << blockSize << "\taverage [ms]: " << timer.getAverageInMilliseconds()
+              << "\tmax [ms]: " << timer.getMaxIntervalInMilliseconds() << "\n";
+  }
+}
@@ -54,6 +54,10 @@ struct LogEntry {
   scalar_t solveQpTime = 0.0;
   scalar_t linesearchTime = 0.0;
 
+  // QP solver
+  int qpIterations = 0;        // HPIPM iterations of the QP subproblem
+  bool qpWarmStarted = false;  // QP subproblem started from the (shifted) previous QP solution
+
   // Line search
   PerformanceIndex baselinePerformanceIndex;  // before taking the step
   scalar_t totalConstraintViolationBaseline;  // constraint metric used in the line search
@@ -62,7 +62,14 @@ class SqpMpc final : public MPC_BASE {
     if (settings().coldStart_) {
       solverPtr_->reset();
     }
-    solverPtr_->run(initTime, initState, finalTime);
+    // Complete a prepared real-time iteration, otherwise solve the full problem
+    if (!solverPtr_->feedbackRealTimeIteration(initTime, initState)) {
+      solverPtr_->run(initTime, initState, finalTime);
+    }
+  }
+
+  bool prepareController(scalar_t initTime, scalar_t finalTime) override {
+    return !settings().coldStart_ && solverPtr_->prepareRealTimeIteration(initTime, finalTime);
   }
 
  private:
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_oc/lq_solver/LqSolverInterface.h>
 
 #include <hpipm_catkin/HpipmInterfaceSettings.h>
 
@@ -59,9 +60,20 @@ struct Settings {
 
   // QP subproblem solver settings
   hpipm_interface::Settings hpipmSettings = hpipm_interface::Settings();
+  bool setupQpInPlace = true;        // Write each node into the QP solver as soon as it is approximated, instead of after the approximation
+  LqSolverType lqSolverType = LqSolverType::HPIPM;  // QP solver backend. The Riccati backends solve QPs without inequality constraints,
+                                                   // otherwise HPIPM is used. If the package is built with OCS2_FIXED_SIZE_STATE_DIM/
+                                                   // INPUT_DIM, matching unconstrained QPs use the fixed-size Riccati solver.
+  std::string lqRecordingFolder = "";  // If not empty, every QP is written to this folder, e.g. to benchmark the backends offline
 
   // Discretization method
-  scalar_t dt = 0.01;  // user-defined time discretization
+  scalar_t dt = 0.01;                                // user-defined time discretization
+  scalar_t dtGrowthRate = 1.0;                       // ratio of consecutive time steps, 1.0 results in a uniform discretization
+  scalar_t dtMax = 0.1;                              // maximum time step of the growing discretization
+  scalar_t dynamicsDefectRefinementTolerance = 0.0;  // halves the intervals with a larger dynamics defect in the last solution, 0: off.
+                                                     // Not applied together with move blocking.
+  size_t moveBlockingLength = 1;                     // number of dt intervals over which the input is held constant, 1: off
+  scalar_t moveBlockingStartTime = 0.0;              // time after the start of the horizon from which on the input is blocked
   SensitivityIntegratorType integratorType = SensitivityIntegratorType::RK2;
 
   // Inequality penalty relaxed barrier parameters
@@ -71,6 +83,10 @@ struct Settings {
   bool projectStateInputEqualityConstraints = true;  // Use a projection method to resolve the state-input constraint Cx+Du+e
   bool extractProjectionMultiplier = false;          // Extract the Lagrange multiplier of the projected state-input constraint Cx+Du+e
 
+  // Inequality constraints
+  bool inequalityConstraintsInQp = false;  // Pass the state and state-input inequality constraints to the QP as hard constraints
+  bool detectSimpleBounds = true;          // Pass inequality constraints on a single variable to the QP as box constraints
+
   // Printing
   bool printSolverStatus = false;      // Print HPIPM status after solving the QP subproblem
   bool printSolverStatistics = false;  // Print benchmarking of the multiple shooting method
@@ -84,6 +100,7 @@ struct Settings {
   // Threading
   size_t nThreads = 4;
   int threadPriority = 50;
+  bool threadHotMode = false;  // Keep the idle worker threads spinning while the solver runs, trading CPU load for dispatch latency
 };
 
 /**
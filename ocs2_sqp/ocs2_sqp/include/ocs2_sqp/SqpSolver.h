@@ -34,8 +34,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
+#include <ocs2_oc/lq_solver/FixedSizeRiccatiSolverInterface.h>
+#include <ocs2_oc/lq_solver/LqSolverInterface.h>
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
+#include <ocs2_oc/oc_problem/OcpInequalityConstraints.h>
+#include <ocs2_oc/oc_problem/OcpLqArena.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
 #include <ocs2_oc/search_strategy/FilterLinesearch.h>
@@ -91,6 +95,30 @@ class SqpSolver : public SolverBase {
     throw std::runtime_error("[SqpSolver] getIntermediateDualSolution() not available yet.");
   }
 
+  /**
+   * Preparation phase of a real-time iteration (RTI). Approximates the problem on [initTime, finalTime] around the previous solution and
+   * loads the QP into the solver before the initial state is known. The iteration is completed by feedbackRealTimeIteration().
+   *
+   * @param [in] initTime: The expected initial time of the next problem.
+   * @param [in] finalTime: The final time.
+   * @return false if no previous solution covers initTime. Nothing is prepared in that case.
+   */
+  bool prepareRealTimeIteration(scalar_t initTime, scalar_t finalTime);
+
+  /**
+   * Feedback phase of a real-time iteration. Injects the initial state into the prepared QP, solves it and takes a full step. The problem
+   * is not approximated again, such that the work is a single QP solve. The performance and metrics of the solution are the ones of the
+   * prepared linearization point.
+   *
+   * @param [in] initTime: The initial time. It has to be within half a time step of the prepared initial time.
+   * @param [in] initState: The initial state.
+   * @return false if no real-time iteration was prepared for initTime. Nothing is solved in that case.
+   */
+  bool feedbackRealTimeIteration(scalar_t initTime, const vector_t& initState);
+
+  /** Whether a prepared real-time iteration waits for its feedback phase */
+  bool isRealTimeIterationPrepared() const { return realTimeIteration_.prepared; }
+
  private:
   void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override;
 
@@ -112,9 +140,16 @@ class SqpSolver : public SolverBase {
     runImpl(initTime, initState, finalTime);
   }
 
+  /** Determines the time discretization and initializes the trajectories and the QP warm start for a new problem */
+  std::vector<AnnotatedTime> initializeProblem(scalar_t initTime, const vector_t& initState, scalar_t finalTime, vector_array_t& x,
+                                               vector_array_t& u);
+
   /** Run a task in parallel with settings.nThreads */
   void runParallel(std::function<void(int)> taskFunction);
 
+  /** Aligns the last QP solution with a new time discretization, to warm start the first QP of the problem */
+  void shiftQpWarmStart(const std::vector<AnnotatedTime>& timeDiscretization);
+
   /** Get profiling information as a string */
   std::string getBenchmarkingInformation() const;
 
@@ -134,6 +169,9 @@ class SqpSolver : public SolverBase {
   };
   OcpSubproblemSolution getOCPSolution(const vector_t& delta_x0);
 
+  /** Solves the QP stored in lqArena_ with the selected LQ solver, or with the fixed-size Riccati solver if it matches the problem */
+  bool solveLqProblem(const vector_t& delta_x0, vector_array_t& deltaXSol, vector_array_t& deltaUSol);
+
   /** Extract the value function based on the last solved QP */
   void extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x);
 
@@ -158,6 +196,14 @@ class SqpSolver : public SolverBase {
 
   // Solver interface
   HpipmInterface hpipmInterface_;
+  std::unique_ptr<LqSolverInterface> lqSolverPtr_;  // the backend selected with Settings::lqSolverType, nullptr for HPIPM
+  bool qpSolvedByLqSolver_ = false;                 // true if the QP of the current iteration is solved by lqSolverPtr_
+  // Selected at compile time with OCS2_FIXED_SIZE_STATE_DIM and OCS2_FIXED_SIZE_INPUT_DIM, nullptr otherwise. Replaces lqSolverPtr_
+  // for matching QPs.
+  std::unique_ptr<FixedSizeRiccatiSolverInterface> fixedSizeRiccatiSolverPtr_;
+  bool qpSolvedByFixedSizeRiccati_ = false;  // true if the QP of the current iteration is solved by fixedSizeRiccatiSolverPtr_
+  size_t numRecordedQps_ = 0;                        // number of QPs written to Settings::lqRecordingFolder
+  std::vector<AnnotatedTime> qpTimeDiscretization_;  // time discretization of the last QP, to shift the warm start between problems
 
   // Threading
   ThreadPool threadPool_;
@@ -169,12 +215,23 @@ class SqpSolver : public SolverBase {
   std::vector<ScalarFunctionQuadraticApproximation> valueFunction_;
 
   // LQ approximation
-  std::vector<ScalarFunctionQuadraticApproximation> cost_;
-  std::vector<VectorFunctionLinearApproximation> dynamics_;
-  std::vector<VectorFunctionLinearApproximation> stateInputEqConstraints_;
+  OcpLqArena lqArena_;         // dynamics, cost, and state-input equality constraints of the QP
+  bool qpSetInPlace_ = false;  // true if all nodes of lqArena_ were already written into hpipmInterface_ during the setup
   std::vector<VectorFunctionLinearApproximation> stateIneqConstraints_;
   std::vector<VectorFunctionLinearApproximation> stateInputIneqConstraints_;
   std::vector<VectorFunctionLinearApproximation> constraintsProjection_;
+  std::vector<NodeInequalityConstraints> inequalityConstraints_;  // inequality constraints of the QP, if passed to the QP
+
+  // Real-time iteration: the problem approximated in the preparation phase, waiting for the initial state
+  struct RealTimeIteration {
+    bool prepared = false;
+    std::vector<AnnotatedTime> timeDiscretization;
+    vector_array_t x;
+    vector_array_t u;
+    std::vector<Metrics> metrics;
+    PerformanceIndex performance;
+  };
+  RealTimeIteration realTimeIteration_;
 
   // Lagrange multipliers
   std::vector<multiple_shooting::ProjectionMultiplierCoefficients> projectionMultiplierCoefficients_;
@@ -188,12 +245,18 @@ class SqpSolver : public SolverBase {
   // Benchmarking
   size_t numProblems_{0};
   size_t totalNumIterations_{0};
+  size_t numWarmQpSolves_{0};
+  size_t numWarmQpIterations_{0};
+  size_t numColdQpSolves_{0};
+  size_t numColdQpIterations_{0};
   sqp::Logger<sqp::LogEntry> logger_;
   benchmark::RepeatedTimer initializationTimer_;
   benchmark::RepeatedTimer linearQuadraticApproximationTimer_;
   benchmark::RepeatedTimer solveQpTimer_;
   benchmark::RepeatedTimer linesearchTimer_;
   benchmark::RepeatedTimer computeControllerTimer_;
+  benchmark::RepeatedTimer preparationTimer_;
+  benchmark::RepeatedTimer feedbackTimer_;
 };
 
 }  // namespace ocs2
@@ -45,6 +45,8 @@ std::ostream& operator<<(std::ostream& stream, const LogEntry& logEntry) {
           << logEntry.linearQuadraticApproximationTime << delim
           << logEntry.solveQpTime << delim
           << logEntry.linesearchTime << delim
+          << logEntry.qpIterations << delim
+          << logEntry.qpWarmStarted << delim
           << logEntry.baselinePerformanceIndex.merit << delim
           << logEntry.baselinePerformanceIndex.dynamicsViolationSSE << delim
           << logEntry.baselinePerformanceIndex.equalityConstraintsSSE << delim
@@ -73,6 +75,8 @@ std::string logHeader() {
           << "linearQuadraticApproximationTime" << delim
           << "solveQpTime" << delim
           << "linesearchTime" << delim
+          << "qpIterations" << delim
+          << "qpWarmStarted" << delim
           << "baselinePerformanceIndex/merit" << delim
           << "baselinePerformanceIndex/dynamicsViolationSSE" << delim
           << "baselinePerformanceIndex/equalityConstraintsSSE" << delim
@@ -58,6 +58,11 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.armijoFactor, fieldName + ".armijoFactor", verbose);
   loadData::loadPtreeValue(pt, settings.costTol, fieldName + ".costTol", verbose);
   loadData::loadPtreeValue(pt, settings.dt, fieldName + ".dt", verbose);
+  loadData::loadPtreeValue(pt, settings.dtGrowthRate, fieldName + ".dtGrowthRate", verbose);
+  loadData::loadPtreeValue(pt, settings.dtMax, fieldName + ".dtMax", verbose);
+  loadData::loadPtreeValue(pt, settings.dynamicsDefectRefinementTolerance, fieldName + ".dynamicsDefectRefinementTolerance", verbose);
+  loadData::loadPtreeValue(pt, settings.moveBlockingLength, fieldName + ".moveBlockingLength", verbose);
+  loadData::loadPtreeValue(pt, settings.moveBlockingStartTime, fieldName + ".moveBlockingStartTime", verbose);
   loadData::loadPtreeValue(pt, settings.useFeedbackPolicy, fieldName + ".useFeedbackPolicy", verbose);
   loadData::loadPtreeValue(pt, settings.createValueFunction, fieldName + ".createValueFunction", verbose);
   auto integratorName = sensitivity_integrator::toString(settings.integratorType);
@@ -65,8 +70,16 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   settings.integratorType = sensitivity_integrator::fromString(integratorName);
   loadData::loadPtreeValue(pt, settings.inequalityConstraintMu, fieldName + ".inequalityConstraintMu", verbose);
   loadData::loadPtreeValue(pt, settings.inequalityConstraintDelta, fieldName + ".inequalityConstraintDelta", verbose);
+  loadData::loadPtreeValue(pt, settings.setupQpInPlace, fieldName + ".setupQpInPlace", verbose);
+  auto lqSolverName = lq_solver::toString(settings.lqSolverType);
+  loadData::loadPtreeValue(pt, lqSolverName, fieldName + ".lqSolverType", verbose);
+  settings.lqSolverType = lq_solver::fromString(lqSolverName);
+  loadData::loadPtreeValue(pt, settings.lqRecordingFolder, fieldName + ".lqRecordingFolder", verbose);
+  loadData::loadPtreeValue(pt, settings.hpipmSettings.condensingBlockSize, fieldName + ".hpipmCondensingBlockSize", verbose);
   loadData::loadPtreeValue(pt, settings.projectStateInputEqualityConstraints, fieldName + ".projectStateInputEqualityConstraints", verbose);
   loadData::loadPtreeValue(pt, settings.extractProjectionMultiplier, fieldName + ".extractProjectionMultiplier", verbose);
+  loadData::loadPtreeValue(pt, settings.inequalityConstraintsInQp, fieldName + ".inequalityConstraintsInQp", verbose);
+  loadData::loadPtreeValue(pt, settings.detectSimpleBounds, fieldName + ".detectSimpleBounds", verbose);
   loadData::loadPtreeValue(pt, settings.printSolverStatus, fieldName + ".printSolverStatus", verbose);
   loadData::loadPtreeValue(pt, settings.printSolverStatistics, fieldName + ".printSolverStatistics", verbose);
   loadData::loadPtreeValue(pt, settings.printLinesearch, fieldName + ".printLinesearch", verbose);
@@ -75,6 +88,7 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.logFilePath, fieldName + ".logFilePath", verbose);
   loadData::loadPtreeValue(pt, settings.nThreads, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority, fieldName + ".threadPriority", verbose);
+  loadData::loadPtreeValue(pt, settings.threadHotMode, fieldName + ".threadHotMode", verbose);
 
   if (verbose) {
     std::cerr << settings.hpipmSettings;
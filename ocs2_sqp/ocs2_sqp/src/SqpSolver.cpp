@@ -29,15 +29,22 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/SqpSolver.h"
 
+#include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <numeric>
 
 #include <boost/filesystem.hpp>
 
+#include <ocs2_oc/lq_solver/FixedSizeRiccatiSolver.h>
+#include <ocs2_oc/lq_solver/LqProblemRecording.h>
+#include <ocs2_oc/lq_solver/ParallelRiccatiLqSolver.h>
+#include <ocs2_oc/lq_solver/RiccatiLqSolver.h>
 #include <ocs2_oc/multiple_shooting/Helpers.h>
 #include <ocs2_oc/multiple_shooting/Initialization.h>
 #include <ocs2_oc/multiple_shooting/MetricsComputation.h>
+#include <ocs2_oc/multiple_shooting/MoveBlocking.h>
 #include <ocs2_oc/multiple_shooting/PerformanceIndexComputation.h>
 #include <ocs2_oc/multiple_shooting/Transcription.h>
 #include <ocs2_oc/oc_problem/OcpSize.h>
@@ -64,8 +71,14 @@ SqpSolver::SqpSolver(sqp::Settings settings, const OptimalControlProblem& optima
   Eigen::initParallel();
 
   // Dynamics discretization
-  discretizer_ = selectDynamicsDiscretization(settings_.integratorType);
-  sensitivityDiscretizer_ = selectDynamicsSensitivityDiscretization(settings_.integratorType);
+  if (settings_.moveBlockingLength > 1) {
+    // The blocks are integrated with steps of dt
+    discretizer_ = multiple_shooting::selectSubsteppedDynamicsDiscretization(settings_.integratorType, settings_.dt);
+    sensitivityDiscretizer_ = multiple_shooting::selectSubsteppedDynamicsSensitivityDiscretization(settings_.integratorType, settings_.dt);
+  } else {
+    discretizer_ = selectDynamicsDiscretization(settings_.integratorType);
+    sensitivityDiscretizer_ = selectDynamicsSensitivityDiscretization(settings_.integratorType);
+  }
 
   // Clone objects to have one for each worker
   for (int w = 0; w < settings_.nThreads; w++) {
@@ -80,6 +93,25 @@ SqpSolver::SqpSolver(sqp::Settings settings, const OptimalControlProblem& optima
   filterLinesearch_.g_min = settings_.g_min;
   filterLinesearch_.gamma_c = settings_.gamma_c;
   filterLinesearch_.armijoFactor = settings_.armijoFactor;
+
+  // QP solver backend. HPIPM is used through hpipmInterface_, which also solves the QPs the other backends do not support.
+  switch (settings_.lqSolverType) {
+    case LqSolverType::HPIPM:
+      break;
+    case LqSolverType::RICCATI:
+      lqSolverPtr_ = std::make_unique<RiccatiLqSolver>();
+      break;
+    case LqSolverType::PARALLEL_RICCATI:
+      lqSolverPtr_ = std::make_unique<ParallelRiccatiLqSolver>(threadPool_, settings_.nThreads);
+      break;
+  }
+#ifdef OCS2_FIXED_SIZE_STATE_DIM
+  fixedSizeRiccatiSolverPtr_ = std::make_unique<FixedSizeRiccatiSolverAdapter<OCS2_FIXED_SIZE_STATE_DIM, OCS2_FIXED_SIZE_INPUT_DIM>>();
+#endif
+
+  if (!settings_.lqRecordingFolder.empty()) {
+    boost::filesystem::create_directories(settings_.lqRecordingFolder);
+  }
 }
 
 SqpSolver::~SqpSolver() {
@@ -118,11 +150,20 @@ void SqpSolver::reset() {
   // reset timers
   numProblems_ = 0;
   totalNumIterations_ = 0;
+  numWarmQpSolves_ = 0;
+  numWarmQpIterations_ = 0;
+  numColdQpSolves_ = 0;
+  numColdQpIterations_ = 0;
+  qpTimeDiscretization_.clear();
+  hpipmInterface_.resetWarmStart();
+  realTimeIteration_ = RealTimeIteration();
   logger_ = sqp::Logger<sqp::LogEntry>(settings_.logSize);
   linearQuadraticApproximationTimer_.reset();
   solveQpTimer_.reset();
   linesearchTimer_.reset();
   computeControllerTimer_.reset();
+  preparationTimer_.reset();
+  feedbackTimer_.reset();
 }
 
 std::string SqpSolver::getBenchmarkingInformation() const {
@@ -147,6 +188,17 @@ std::string SqpSolver::getBenchmarkingInformation() const {
                << linesearchTotal / benchmarkTotal * inPercent << "%)\n";
     infoStream << "\tCompute Controller :\t" << computeControllerTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << computeControllerTotal / benchmarkTotal * inPercent << "%)\n";
+    const auto average = [](size_t total, size_t count) { return (count > 0) ? static_cast<scalar_t>(total) / count : 0.0; };
+    infoStream << "QP iterations\t\t   :\tAverage iterations  (number of QPs)\n";
+    infoStream << "\tCold start         :\t" << average(numColdQpIterations_, numColdQpSolves_) << " \t\t\t(" << numColdQpSolves_ << ")\n";
+    infoStream << "\tWarm start         :\t" << average(numWarmQpIterations_, numWarmQpSolves_) << " \t\t\t(" << numWarmQpSolves_ << ")\n";
+    if (feedbackTimer_.getNumTimedIntervals() > 0) {
+      infoStream << "Real-time iterations\t   :\tAverage time [ms]   (number of iterations)\n";
+      infoStream << "\tPreparation        :\t" << preparationTimer_.getAverageInMilliseconds() << " [ms] \t\t("
+                 << preparationTimer_.getNumTimedIntervals() << ")\n";
+      infoStream << "\tFeedback           :\t" << feedbackTimer_.getAverageInMilliseconds() << " [ms] \t\t("
+                 << feedbackTimer_.getNumTimedIntervals() << ")\n";
+    }
   }
   return infoStream.str();
 }
@@ -187,24 +239,14 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
   }
 
-  // Determine time discretization, taking into account event times.
-  const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
-  const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
-
-  // Initialize references
-  for (auto& ocpDefinition : ocpDefinitions_) {
-    const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
-    ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
-  }
+  // Keep the workers spinning while the solver runs
+  const ThreadPool::HotModeScope hotModeScope(threadPool_, settings_.threadHotMode);
 
-  // Trajectory spread of primalSolution_
-  if (!primalSolution_.timeTrajectory_.empty()) {
-    std::ignore = trajectorySpread(primalSolution_.modeSchedule_, this->getReferenceManager().getModeSchedule(), primalSolution_);
-  }
+  // A full solve replaces a prepared real-time iteration
+  realTimeIteration_.prepared = false;
 
-  // Initialize the state and input
   vector_array_t x, u;
-  multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  const auto timeDiscretization = initializeProblem(initTime, initState, finalTime, x, u);
 
   // Bookkeeping
   performanceIndeces_.clear();
@@ -234,6 +276,11 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     performanceIndeces_.push_back(stepInfo.performanceAfterStep);
     linesearchTimer_.endTimer();
 
+    // After a step of size alpha, (1 - alpha) of the last QP solution remains as step for the next QP. The multipliers stay.
+    if (settings_.hpipmSettings.warm_start > 0) {
+      hpipmInterface_.shiftSolution(0, 1.0 - stepInfo.stepSize);
+    }
+
     // Check convergence
     convergence = checkConvergence(iter, baselinePerformance, stepInfo);
 
@@ -246,6 +293,8 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
       logEntry.linearQuadraticApproximationTime = linearQuadraticApproximationTimer_.getLastIntervalInMilliseconds();
       logEntry.solveQpTime = solveQpTimer_.getLastIntervalInMilliseconds();
       logEntry.linesearchTime = linesearchTimer_.getLastIntervalInMilliseconds();
+      logEntry.qpIterations = qpSolvedByLqSolver_ ? lqSolverPtr_->getNumIterations() : hpipmInterface_.getNumIterations();
+      logEntry.qpWarmStarted = !qpSolvedByLqSolver_ && hpipmInterface_.isWarmStarted();
       logEntry.baselinePerformanceIndex = baselinePerformance;
       logEntry.totalConstraintViolationBaseline = FilterLinesearch::totalConstraintViolation(baselinePerformance);
       logEntry.stepInfo = stepInfo;
@@ -273,6 +322,133 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   }
 }
 
+std::vector<AnnotatedTime> SqpSolver::initializeProblem(scalar_t initTime, const vector_t& initState, scalar_t finalTime, vector_array_t& x,
+                                                        vector_array_t& u) {
+  // Determine time discretization, taking into account event times.
+  const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
+  auto timeDiscretization = geometricTimeDiscretizationWithEvents(initTime, finalTime, settings_.dt, settings_.dtGrowthRate,
+                                                                   settings_.dtMax, eventTimes);
+  // Under move blocking, the metrics of the last solution belong to the blocks, while its primal solution is expanded to the dt grid.
+  // The defects can not be assigned to intervals of the new discretization, so the refinement is skipped.
+  const bool moveBlocking = settings_.moveBlockingLength > 1;
+  if (settings_.dynamicsDefectRefinementTolerance > 0.0 && !moveBlocking) {
+    timeDiscretization = multiple_shooting::refineTimeDiscretization(timeDiscretization, primalSolution_, problemMetrics_,
+                                                                     settings_.dynamicsDefectRefinementTolerance);
+  }
+  if (moveBlocking) {
+    timeDiscretization = multiple_shooting::blockTimeDiscretization(timeDiscretization, initTime + settings_.moveBlockingStartTime,
+                                                                    settings_.moveBlockingLength);
+  }
+
+  // Initialize references
+  for (auto& ocpDefinition : ocpDefinitions_) {
+    const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
+    ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
+  }
+
+  // Trajectory spread of primalSolution_
+  if (!primalSolution_.timeTrajectory_.empty()) {
+    std::ignore = trajectorySpread(primalSolution_.modeSchedule_, this->getReferenceManager().getModeSchedule(), primalSolution_);
+  }
+
+  // Initialize the state and input
+  multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+
+  // Move the last QP solution along with the horizon, such that it is aligned with the new problem
+  if (settings_.hpipmSettings.warm_start > 0) {
+    shiftQpWarmStart(timeDiscretization);
+  }
+
+  return timeDiscretization;
+}
+
+bool SqpSolver::prepareRealTimeIteration(scalar_t initTime, scalar_t finalTime) {
+  realTimeIteration_.prepared = false;
+  const auto& timeTrajectory = primalSolution_.timeTrajectory_;
+  if (timeTrajectory.size() < 2 || initTime < timeTrajectory.front() || initTime >= timeTrajectory.back()) {
+    return false;
+  }
+
+  preparationTimer_.startTimer();
+  const ThreadPool::HotModeScope hotModeScope(threadPool_, settings_.threadHotMode);
+
+  // The initial state is not known yet: linearize around the state predicted by the previous solution
+  const vector_t predictedState = LinearInterpolation::interpolate(initTime, timeTrajectory, primalSolution_.stateTrajectory_);
+  preRun(initTime, predictedState, finalTime);
+
+  auto& rti = realTimeIteration_;
+  rti.timeDiscretization = initializeProblem(initTime, predictedState, finalTime, rti.x, rti.u);
+
+  linearQuadraticApproximationTimer_.startTimer();
+  rti.performance = setupQuadraticSubproblem(rti.timeDiscretization, rti.x[0], rti.x, rti.u, rti.metrics);
+  linearQuadraticApproximationTimer_.endTimer();
+
+  rti.prepared = true;
+  preparationTimer_.endTimer();
+  return true;
+}
+
+bool SqpSolver::feedbackRealTimeIteration(scalar_t initTime, const vector_t& initState) {
+  auto& rti = realTimeIteration_;
+  if (!rti.prepared || std::abs(initTime - getIntervalStart(rti.timeDiscretization.front())) > 0.5 * settings_.dt) {
+    return false;
+  }
+  rti.prepared = false;
+
+  feedbackTimer_.startTimer();
+
+  // Only the initial node of the QP depends on the initial state
+  solveQpTimer_.startTimer();
+  const vector_t delta_x0 = initState - rti.x[0];
+  if (qpSetInPlace_) {
+    const NodeInequalityConstraints* initialInequalityConstraints = settings_.inequalityConstraintsInQp ? &inequalityConstraints_[0] : nullptr;
+    qpSetInPlace_ = hpipmInterface_.setNode(0, delta_x0, lqArena_, initialInequalityConstraints);
+  }
+  const auto deltaSolution = getOCPSolution(delta_x0);
+  extractValueFunction(rti.timeDiscretization, rti.x);
+  solveQpTimer_.endTimer();
+
+  // Full step, the globalization is left to the following iterations
+  multiple_shooting::incrementTrajectory(rti.x, deltaSolution.deltaXSol, 1.0, rti.x);
+  multiple_shooting::incrementTrajectory(rti.u, deltaSolution.deltaUSol, 1.0, rti.u);
+  if (settings_.hpipmSettings.warm_start > 0) {
+    hpipmInterface_.shiftSolution(0, 0.0);
+  }
+  performanceIndeces_.assign(1, rti.performance);
+  ++totalNumIterations_;
+  ++numProblems_;
+
+  computeControllerTimer_.startTimer();
+  primalSolution_ = toPrimalSolution(rti.timeDiscretization, std::move(rti.x), std::move(rti.u));
+  problemMetrics_ = multiple_shooting::toProblemMetrics(rti.timeDiscretization, std::move(rti.metrics));
+  computeControllerTimer_.endTimer();
+  feedbackTimer_.endTimer();
+
+  postRun();
+  return true;
+}
+
+void SqpSolver::shiftQpWarmStart(const std::vector<AnnotatedTime>& timeDiscretization) {
+  // The new horizon starts at the node of the last QP that is closest to the new initial time
+  const scalar_t initTime = getIntervalStart(timeDiscretization.front());
+  int shift = 0;
+  scalar_t minDistance = std::numeric_limits<scalar_t>::max();
+  for (int k = 0; k < static_cast<int>(qpTimeDiscretization_.size()); ++k) {
+    const scalar_t distance = std::abs(getIntervalStart(qpTimeDiscretization_[k]) - initTime);
+    if (distance < minDistance) {
+      minDistance = distance;
+      shift = k;
+    }
+  }
+
+  if (qpTimeDiscretization_.size() == timeDiscretization.size()) {
+    hpipmInterface_.shiftSolution(shift);
+  } else {
+    hpipmInterface_.resetWarmStart();
+  }
+  qpTimeDiscretization_ = timeDiscretization;
+}
+
 void SqpSolver::runParallel(std::function<void(int)> taskFunction) {
   threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
 }
@@ -282,23 +458,44 @@ SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta
   OcpSubproblemSolution solution;
   auto& deltaXSol = solution.deltaXSol;
   auto& deltaUSol = solution.deltaUSol;
-  hpipm_status status;
-  const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
-  if (hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints) {
-    hpipmInterface_.resize(extractSizesFromProblem(dynamics_, cost_, &stateInputEqConstraints_));
-    status =
-        hpipmInterface_.solve(delta_x0, dynamics_, cost_, &stateInputEqConstraints_, deltaXSol, deltaUSol, settings_.printSolverStatus);
-  } else {  // without constraints, or when using projection, we have an unconstrained QP.
-    hpipmInterface_.resize(extractSizesFromProblem(dynamics_, cost_, nullptr));
-    status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+  if (!settings_.lqRecordingFolder.empty()) {
+    const auto filePath = boost::filesystem::path(settings_.lqRecordingFolder) / ("lq_" + std::to_string(numRecordedQps_++) + ".bin");
+    lq_solver::saveLqProblem(filePath.string(), delta_x0, lqArena_);
   }
 
-  if (status != hpipm_status::SUCCESS) {
-    throw std::runtime_error("[SqpSolver] Failed to solve QP");
+  if (qpSolvedByLqSolver_) {
+    if (!solveLqProblem(delta_x0, deltaXSol, deltaUSol)) {
+      throw std::runtime_error("[SqpSolver] Failed to solve QP");
+    }
+  } else {
+    hpipm_status status;
+    if (qpSetInPlace_) {
+      status = hpipmInterface_.solveInPlace(delta_x0, deltaXSol, deltaUSol, settings_.printSolverStatus);
+    } else if (settings_.inequalityConstraintsInQp) {
+      OcpSize ocpSize = lqArena_.size();
+      addInequalityConstraintsSize(inequalityConstraints_, ocpSize);
+      hpipmInterface_.resize(ocpSize);
+      status = hpipmInterface_.solve(delta_x0, lqArena_, inequalityConstraints_, deltaXSol, deltaUSol, settings_.printSolverStatus);
+    } else {
+      hpipmInterface_.resize(lqArena_.size());
+      status = hpipmInterface_.solve(delta_x0, lqArena_, deltaXSol, deltaUSol, settings_.printSolverStatus);
+    }
+
+    if (status != hpipm_status::SUCCESS) {
+      throw std::runtime_error("[SqpSolver] Failed to solve QP");
+    }
+
+    if (hpipmInterface_.isWarmStarted()) {
+      ++numWarmQpSolves_;
+      numWarmQpIterations_ += hpipmInterface_.getNumIterations();
+    } else {
+      ++numColdQpSolves_;
+      numColdQpIterations_ += hpipmInterface_.getNumIterations();
+    }
   }
 
   // to determine if the solution is a descent direction for the cost: compute gradient(cost)' * [dx; du]
-  solution.armijoDescentMetric = armijoDescentMetric(cost_, deltaXSol, deltaUSol);
+  solution.armijoDescentMetric = armijoDescentMetric(lqArena_, deltaXSol, deltaUSol);
 
   // remap the tilde delta u to real delta u
   if (settings_.projectStateInputEqualityConstraints) {
@@ -308,9 +505,23 @@ SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta
   return solution;
 }
 
+bool SqpSolver::solveLqProblem(const vector_t& delta_x0, vector_array_t& deltaXSol, vector_array_t& deltaUSol) {
+  qpSolvedByFixedSizeRiccati_ = fixedSizeRiccatiSolverPtr_ != nullptr && fixedSizeRiccatiSolverPtr_->isCompatible(lqArena_.size());
+  if (qpSolvedByFixedSizeRiccati_) {
+    return fixedSizeRiccatiSolverPtr_->solve(delta_x0, lqArena_, deltaXSol, deltaUSol);
+  }
+  lqSolverPtr_->resize(lqArena_.size());
+  return lqSolverPtr_->solve(delta_x0, lqArena_, deltaXSol, deltaUSol);
+}
+
 void SqpSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x) {
   if (settings_.createValueFunction) {
-    valueFunction_ = hpipmInterface_.getRiccatiCostToGo(dynamics_[0], cost_[0]);
+    if (qpSolvedByFixedSizeRiccati_) {
+      valueFunction_ = fixedSizeRiccatiSolverPtr_->getRiccatiCostToGo();
+    } else {
+      valueFunction_ = qpSolvedByLqSolver_ ? lqSolverPtr_->getRiccatiCostToGo(lqArena_)
+                                           : hpipmInterface_.getRiccatiCostToGo(lqArena_.getDynamics(0), lqArena_.getCost(0));
+    }
     // Correct for linearization state
     for (int i = 0; i < time.size(); ++i) {
       valueFunction_[i].dfdx.noalias() -= valueFunction_[i].dfdxx * x[i];
@@ -321,14 +532,30 @@ void SqpSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, con
 PrimalSolution SqpSolver::toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u) {
   if (settings_.useFeedbackPolicy) {
     ModeSchedule modeSchedule = this->getReferenceManager().getModeSchedule();
-    matrix_array_t KMatrices = hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
+    matrix_array_t KMatrices;
+    if (qpSolvedByFixedSizeRiccati_) {
+      KMatrices = fixedSizeRiccatiSolverPtr_->getRiccatiFeedback();
+    } else {
+      KMatrices = qpSolvedByLqSolver_ ? lqSolverPtr_->getRiccatiFeedback(lqArena_)
+                                      : hpipmInterface_.getRiccatiFeedback(lqArena_.getDynamics(0), lqArena_.getCost(0));
+    }
     if (settings_.projectStateInputEqualityConstraints) {
       multiple_shooting::remapProjectedGain(constraintsProjection_, KMatrices);
     }
+    if (settings_.moveBlockingLength > 1) {
+      const auto expandedTime = multiple_shooting::expandBlockedSolution(*ocpDefinitions_.front().dynamicsPtr, settings_.integratorType,
+                                                                         settings_.dt, time, x, u, &KMatrices);
+      return multiple_shooting::toPrimalSolution(expandedTime, std::move(modeSchedule), std::move(x), std::move(u), std::move(KMatrices));
+    }
     return multiple_shooting::toPrimalSolution(time, std::move(modeSchedule), std::move(x), std::move(u), std::move(KMatrices));
 
   } else {
     ModeSchedule modeSchedule = this->getReferenceManager().getModeSchedule();
+    if (settings_.moveBlockingLength > 1) {
+      const auto expandedTime = multiple_shooting::expandBlockedSolution(*ocpDefinitions_.front().dynamicsPtr, settings_.integratorType,
+                                                                         settings_.dt, time, x, u);
+      return multiple_shooting::toPrimalSolution(expandedTime, std::move(modeSchedule), std::move(x), std::move(u));
+    }
     return multiple_shooting::toPrimalSolution(time, std::move(modeSchedule), std::move(x), std::move(u));
   }
 }
@@ -339,15 +566,54 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   const int N = static_cast<int>(time.size()) - 1;
 
   std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
-  cost_.resize(N + 1);
-  dynamics_.resize(N);
-  stateInputEqConstraints_.resize(N + 1);  // +1 because of HpipmInterface size check
+  // The LQ blocks are written into preallocated memory. The capacity is bounded by the trajectories: the states are not projected,
+  // and neither the projected inputs nor the independent state-input equality constraints exceed the decision variables of a node.
+  const auto maxSize = [](const vector_array_t& v) {
+    size_t s = 0;
+    for (const auto& vi : v) {
+      s = std::max(s, static_cast<size_t>(vi.size()));
+    }
+    return static_cast<int>(s);
+  };
+  const int maxNumStates = maxSize(x);
+  const int maxNumInputs = maxSize(u);
+  const bool hasStateInputConstraints =
+      !ocpDefinitions_.front().equalityConstraintPtr->empty() && !settings_.projectStateInputEqualityConstraints;
+  lqArena_.reserve(N, maxNumStates, maxNumInputs, hasStateInputConstraints ? maxNumStates + maxNumInputs : 0);
   stateIneqConstraints_.resize(N + 1);
   stateInputIneqConstraints_.resize(N);
   constraintsProjection_.resize(N);
   projectionMultiplierCoefficients_.resize(N);
+  if (settings_.inequalityConstraintsInQp) {
+    inequalityConstraints_.resize(N + 1);
+  }
   metrics.resize(N + 1);
 
+  // Each node is passed to the QP solver by the worker that approximated it. This is only possible if the QP solver already has the
+  // right size, which is the case from the second iteration on. Otherwise, the QP is set up from the arena in getOCPSolution.
+  // The selected LQ solver reads the QP from the arena. QPs it does not support are solved by HPIPM.
+  qpSolvedByLqSolver_ = lqSolverPtr_ != nullptr && !settings_.inequalityConstraintsInQp &&
+                        (!hasStateInputConstraints || lqSolverPtr_->supportsEqualityConstraints());
+  qpSolvedByFixedSizeRiccati_ = false;
+  const vector_t delta_x0 = initState - x[0];
+  std::atomic_bool qpSetInPlace{settings_.setupQpInPlace && !qpSolvedByLqSolver_ && hpipmInterface_.getNumStages() == N};
+  const auto setQpNode = [&](int k) {
+    const NodeInequalityConstraints* nodeInequalityConstraints = settings_.inequalityConstraintsInQp ? &inequalityConstraints_[k] : nullptr;
+    if (qpSetInPlace && !hpipmInterface_.setNode(k, delta_x0, lqArena_, nodeInequalityConstraints)) {
+      qpSetInPlace = false;
+    }
+  };
+
+  // The state at the initial node is fixed, its state-only inequality constraints cannot be influenced by the QP
+  const VectorFunctionLinearApproximation noConstraints;
+  const auto setInequalityConstraints = [&](int k, const VectorFunctionLinearApproximation& stateIneq,
+                                            const VectorFunctionLinearApproximation& stateInputIneq) {
+    if (settings_.inequalityConstraintsInQp) {
+      splitInequalityConstraints(x[k].size(), lqArena_.size().numInputs[k], (k > 0) ? stateIneq : noConstraints, stateInputIneq,
+                                 settings_.detectSimpleBounds, inequalityConstraints_[k]);
+    }
+  };
+
   std::atomic_int timeIndex{0};
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
@@ -361,13 +627,14 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
         auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
         metrics[i] = multiple_shooting::computeMetrics(result);
         workerPerformance += multiple_shooting::computePerformanceIndex(result);
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i].resize(0, x[i].size());
+        lqArena_.setCost(i, result.cost);
+        lqArena_.setDynamics(i, result.dynamics);
         stateIneqConstraints_[i] = std::move(result.ineqConstraints);
         stateInputIneqConstraints_[i].resize(0, x[i].size());
         constraintsProjection_[i].resize(0, x[i].size());
         projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
+        setInequalityConstraints(i, stateIneqConstraints_[i], stateInputIneqConstraints_[i]);
+        setQpNode(i);
       } else {
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
@@ -378,13 +645,17 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
         if (settings_.projectStateInputEqualityConstraints) {
           multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier);
         }
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
+        lqArena_.setCost(i, result.cost);
+        lqArena_.setDynamics(i, result.dynamics);
+        if (!settings_.projectStateInputEqualityConstraints) {
+          lqArena_.setConstraints(i, result.stateInputEqConstraints);
+        }
         stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
         stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
         constraintsProjection_[i] = std::move(result.constraintsProjection);
         projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
+        setInequalityConstraints(i, stateIneqConstraints_[i], stateInputIneqConstraints_[i]);
+        setQpNode(i);
       }
 
       i = timeIndex++;
@@ -395,15 +666,17 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
       auto result = multiple_shooting::setupTerminalNode(ocpDefinition, tN, x[N]);
       metrics[i] = multiple_shooting::computeMetrics(result);
       workerPerformance += multiple_shooting::computePerformanceIndex(result);
-      cost_[i] = std::move(result.cost);
-      stateInputEqConstraints_[i].resize(0, x[i].size());
+      lqArena_.setCost(i, result.cost);
       stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+      setInequalityConstraints(i, stateIneqConstraints_[i], noConstraints);
+      setQpNode(i);
     }
 
     // Accumulate! Same worker might run multiple tasks
     performance[workerId] += workerPerformance;
   };
   runParallel(std::move(parallelTask));
+  qpSetInPlace_ = qpSetInPlace;
 
   // Account for initial state in performance
   const vector_t initDynamicsViolation = initState - x.front();
@@ -0,0 +1,97 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <string>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+#include <ocs2_oc/oc_data/PerformanceIndex.h>
+#include <ocs2_oc/oc_data/PrimalSolution.h>
+#include <ocs2_oc/oc_solver/SolverBase.h>
+
+namespace ocs2 {
+
+/** Timing, iteration count and final performance of a closed-loop run */
+struct ClosedLoopBenchmarkResult {
+  scalar_t averageSolveTimeInMilliseconds = 0.0;
+  scalar_t maxSolveTimeInMilliseconds = 0.0;
+  scalar_t averageNumIterations = 0.0;
+  PerformanceIndex performance;
+};
+
+/**
+ * Runs a solver in a closed loop on its own nominal solution: after every call, the state is advanced by mpcTimeStep along the
+ * optimized state trajectory. The reference manager of the solver has to be set.
+ *
+ * @param [in] solver : The solver.
+ * @param [in] initialState : The initial state.
+ * @param [in] timeHorizon : The horizon of every call.
+ * @param [in] mpcTimeStep : The time between two calls.
+ * @param [in] numMpcCalls : The number of calls.
+ * @return The solve times and iterations per call, and the performance of the last call.
+ */
+inline ClosedLoopBenchmarkResult runClosedLoopBenchmark(SolverBase& solver, const vector_t& initialState, scalar_t timeHorizon,
+                                                        scalar_t mpcTimeStep, int numMpcCalls) {
+  ClosedLoopBenchmarkResult result;
+  benchmark::RepeatedTimer timer;
+  scalar_t time = 0.0;
+  vector_t state = initialState;
+  for (int i = 0; i < numMpcCalls; ++i) {
+    const size_t numIterationsBefore = solver.getNumIterations();
+    timer.startTimer();
+    solver.run(time, state, time + timeHorizon);
+    timer.endTimer();
+    result.averageNumIterations += static_cast<scalar_t>(solver.getNumIterations() - numIterationsBefore) / numMpcCalls;
+
+    // Follow the nominal solution
+    PrimalSolution primalSolution;
+    solver.getPrimalSolution(time + timeHorizon, &primalSolution);
+    time += mpcTimeStep;
+    state = LinearInterpolation::interpolate(time, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_);
+  }
+
+  result.averageSolveTimeInMilliseconds = timer.getAverageInMilliseconds();
+  result.maxSolveTimeInMilliseconds = timer.getMaxIntervalInMilliseconds();
+  result.performance = solver.getPerformanceIndeces();
+  return result;
+}
+
+/** Prints a closed-loop result in one line */
+inline void printClosedLoopBenchmarkResult(const std::string& name, const ClosedLoopBenchmarkResult& result) {
+  std::cerr << name << ": average solve time [ms]: " << result.averageSolveTimeInMilliseconds
+            << "\tmax solve time [ms]: " << result.maxSolveTimeInMilliseconds << "\taverage iterations: " << result.averageNumIterations
+            << "\tinequality constraints SSE: " << result.performance.inequalityConstraintsSSE << '\n';
+}
+
+}  // namespace ocs2
@@ -141,3 +141,135 @@ TEST(test_circular_kinematics, solve_EqConstraints_inQPSubproblem) {
     ASSERT_TRUE(u.isApprox(primalSolution.controllerPtr_->computeInput(t, x)));
   }
 }
+
+TEST(test_circular_kinematics, solve_setupQpInPlace) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Solve with and without writing the QP nodes during the setup, with constraints in the QP to cover all blocks
+  const auto solve = [&](bool setupQpInPlace) {
+    ocs2::sqp::Settings settings;
+    settings.dt = 0.01;
+    settings.sqpIteration = 20;
+    settings.projectStateInputEqualityConstraints = false;
+    settings.setupQpInPlace = setupQpInPlace;
+    settings.nThreads = 4;
+    ocs2::SqpSolver solver(settings, problem, zeroInitializer);
+    solver.run(startTime, initState, finalTime);
+    return solver.primalSolution(finalTime);
+  };
+  const auto inPlaceSolution = solve(true);
+  const auto referenceSolution = solve(false);
+
+  ASSERT_EQ(inPlaceSolution.timeTrajectory_.size(), referenceSolution.timeTrajectory_.size());
+  for (int i = 0; i < referenceSolution.timeTrajectory_.size(); i++) {
+    ASSERT_TRUE(inPlaceSolution.stateTrajectory_[i].isApprox(referenceSolution.stateTrajectory_[i], 1e-9));
+    ASSERT_TRUE(inPlaceSolution.inputTrajectory_[i].isApprox(referenceSolution.inputTrajectory_[i], 1e-9));
+  }
+}
+
+TEST(test_circular_kinematics, solve_warmStartedQp) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Additional problem definitions
+  const ocs2::scalar_t horizon = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Solve a sequence of shifted problems, with constraints in the QP such that HPIPM needs several iterations
+  const auto solveSequence = [&](int warmStart) {
+    ocs2::sqp::Settings settings;
+    settings.dt = 0.01;
+    settings.sqpIteration = 20;
+    settings.projectStateInputEqualityConstraints = false;
+    settings.hpipmSettings.warm_start = warmStart;
+    ocs2::SqpSolver solver(settings, problem, zeroInitializer);
+    for (int i = 0; i < 3; ++i) {
+      const ocs2::scalar_t startTime = 0.02 * i;
+      solver.run(startTime, initState, startTime + horizon);
+    }
+    return solver.primalSolution(horizon);
+  };
+  const auto coldSolution = solveSequence(0);
+  for (int warmStart : {1, 2}) {
+    const auto warmSolution = solveSequence(warmStart);
+    ASSERT_EQ(warmSolution.timeTrajectory_.size(), coldSolution.timeTrajectory_.size());
+    for (int i = 0; i < coldSolution.timeTrajectory_.size(); i++) {
+      ASSERT_TRUE(warmSolution.stateTrajectory_[i].isApprox(coldSolution.stateTrajectory_[i], 1e-6));
+      ASSERT_TRUE(warmSolution.inputTrajectory_[i].isApprox(coldSolution.inputTrajectory_[i], 1e-6));
+    }
+  }
+}
+
+TEST(test_circular_kinematics, solve_realTimeIteration) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useFeedbackPolicy = true;
+  settings.nThreads = 1;
+
+  // Additional problem definitions
+  const ocs2::scalar_t horizon = 1.0;
+  const ocs2::scalar_t nextTime = 0.05;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Nothing to prepare from without a previous solution
+  ocs2::SqpSolver solver(settings, problem, zeroInitializer);
+  ASSERT_FALSE(solver.prepareRealTimeIteration(0.0, horizon));
+  ASSERT_FALSE(solver.feedbackRealTimeIteration(0.0, initState));
+  solver.run(0.0, initState, horizon);
+
+  // Prepare the next problem, then inject a state that differs from the predicted one
+  ASSERT_TRUE(solver.prepareRealTimeIteration(nextTime, nextTime + horizon));
+  ASSERT_TRUE(solver.isRealTimeIterationPrepared());
+  ASSERT_FALSE(solver.feedbackRealTimeIteration(nextTime + horizon, initState));  // not prepared for this time
+  const ocs2::vector_t nextState = (ocs2::vector_t(2) << 0.95, 0.1).finished();
+  ASSERT_TRUE(solver.feedbackRealTimeIteration(nextTime, nextState));
+  ASSERT_FALSE(solver.isRealTimeIterationPrepared());
+
+  // The full step satisfies the initial state and the linear dynamics
+  const auto primalSolution = solver.primalSolution(nextTime + horizon);
+  ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.front(), nextTime);
+  ASSERT_TRUE(primalSolution.stateTrajectory_.front().isApprox(nextState));
+  for (int i = 0; i + 1 < primalSolution.timeTrajectory_.size(); i++) {
+    const ocs2::scalar_t dt = primalSolution.timeTrajectory_[i + 1] - primalSolution.timeTrajectory_[i];
+    const ocs2::vector_t xNext = primalSolution.stateTrajectory_[i] + dt * primalSolution.inputTrajectory_[i];
+    ASSERT_TRUE(primalSolution.stateTrajectory_[i + 1].isApprox(xNext, 1e-9));
+  }
+
+  // The real-time iterations track the solution of the fully converged problem
+  const ocs2::vector_t closedLoopState = nextState;
+  ocs2::scalar_t time = nextTime;
+  for (int i = 0; i < 20; ++i) {
+    time += settings.dt;
+    ASSERT_TRUE(solver.prepareRealTimeIteration(time, time + horizon));
+    ASSERT_TRUE(solver.feedbackRealTimeIteration(time, closedLoopState));
+  }
+  ocs2::SqpSolver referenceSolver(settings, problem, zeroInitializer);
+  referenceSolver.run(time, closedLoopState, time + horizon);
+  const auto rtiSolution = solver.primalSolution(time + horizon);
+  const auto referenceSolution = referenceSolver.primalSolution(time + horizon);
+  ASSERT_EQ(rtiSolution.timeTrajectory_.size(), referenceSolution.timeTrajectory_.size());
+  for (int i = 0; i + 1 < referenceSolution.timeTrajectory_.size(); i++) {
+    ASSERT_TRUE(rtiSolution.inputTrajectory_[i].isApprox(referenceSolution.inputTrajectory_[i], 1e-2));
+  }
+}
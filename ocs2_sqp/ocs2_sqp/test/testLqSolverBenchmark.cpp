@@ -0,0 +1,158 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include <boost/filesystem.hpp>
+
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_oc/lq_solver/LqProblemRecording.h>
+#include <ocs2_oc/lq_solver/ParallelRiccatiLqSolver.h>
+#include <ocs2_oc/lq_solver/RiccatiLqSolver.h>
+
+#include <hpipm_catkin/HpipmLqSolver.h>
+
+#include "ocs2_sqp/SqpSolver.h"
+
+#include <ocs2_oc/test/circular_kinematics.h>
+
+namespace {
+
+/** Runs the SQP solver on the circular kinematics problem and returns the files of the recorded QPs */
+std::vector<std::string> recordQps(const std::string& folder, bool projectStateInputEqualityConstraints) {
+  boost::filesystem::remove_all(folder);
+
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = projectStateInputEqualityConstraints;
+  settings.nThreads = 1;
+  settings.enableLogging = false;
+  settings.lqRecordingFolder = folder;
+
+  ocs2::SqpSolver solver(settings, problem, zeroInitializer);
+  solver.run(0.0, (ocs2::vector_t(2) << 1.0, 0.0).finished(), 1.0);
+
+  std::vector<std::string> files;
+  for (const auto& entry : boost::filesystem::directory_iterator(folder)) {
+    files.push_back(entry.path().string());
+  }
+  std::sort(files.begin(), files.end());
+  return files;
+}
+
+/** Solves every recorded QP with all backends that support it, compares the solutions to HPIPM and prints the timings */
+void benchmarkRecordedQps(const std::vector<std::string>& files) {
+  constexpr int numRepetitions = 20;
+  constexpr ocs2::scalar_t tol = 1e-6;
+
+  ocs2::ThreadPool threadPool(3);
+  std::vector<std::unique_ptr<ocs2::LqSolverInterface>> solvers;
+  solvers.emplace_back(new ocs2::HpipmLqSolver());
+  solvers.emplace_back(new ocs2::RiccatiLqSolver());
+  solvers.emplace_back(new ocs2::ParallelRiccatiLqSolver(threadPool, 4));
+  std::vector<ocs2::benchmark::RepeatedTimer> timers(solvers.size());
+
+  ocs2::OcpLqArena lq;
+  ocs2::vector_array_t xRef, uRef, x, u;
+  for (const auto& file : files) {
+    const ocs2::vector_t x0 = ocs2::lq_solver::loadLqProblem(file, lq);
+    const auto& numConstraints = lq.size().numEqConstraints;
+    const bool hasConstraints = std::any_of(numConstraints.cbegin(), numConstraints.cend(), [](int nc) { return nc > 0; });
+
+    for (size_t s = 0; s < solvers.size(); ++s) {
+      if (hasConstraints && !solvers[s]->supportsEqualityConstraints()) {
+        continue;
+      }
+      solvers[s]->resize(lq.size());
+      for (int i = 0; i < numRepetitions; ++i) {
+        timers[s].startTimer();
+        ASSERT_TRUE(solvers[s]->solve(x0, lq, x, u)) << solvers[s]->getName() << " failed on " << file;
+        timers[s].endTimer();
+      }
+
+      if (s == 0) {
+        xRef = x;
+        uRef = u;
+      } else {
+        for (size_t k = 0; k < u.size(); ++k) {
+          EXPECT_TRUE(u[k].isApprox(uRef[k], tol)) << solvers[s]->getName() << ", " << file << ", k = " << k;
+          EXPECT_TRUE(x[k + 1].isApprox(xRef[k + 1], tol)) << solvers[s]->getName() << ", " << file << ", k = " << k;
+        }
+      }
+    }
+  }
+
+  std::cerr << "\n#### LQ solver benchmark over " << files.size() << " recorded QPs\n";
+  for (size_t s = 0; s < solvers.size(); ++s) {
+    if (timers[s].getNumTimedIntervals() > 0) {
+      std::cerr << std::setw(18) << solvers[s]->getName() << " : " << timers[s].getAverageInMilliseconds() << " [ms] average, "
+                << timers[s].getMaxIntervalInMilliseconds() << " [ms] max.\n";
+    }
+  }
+}
+
+}  // namespace
+
+TEST(test_lq_solver_benchmark, projectedEqualityConstraints) {
+  const auto files = recordQps("/tmp/ocs2/lq_recording/projected", true);
+  ASSERT_FALSE(files.empty());
+  benchmarkRecordedQps(files);
+}
+
+TEST(test_lq_solver_benchmark, equalityConstraintsInQp) {
+  const auto files = recordQps("/tmp/ocs2/lq_recording/constrained", false);
+  ASSERT_FALSE(files.empty());
+  benchmarkRecordedQps(files);
+}
+
+/** Benchmarks the QPs of another application, recorded with sqp::Settings::lqRecordingFolder */
+TEST(test_lq_solver_benchmark, recordingFolder) {
+  const char* folder = std::getenv("OCS2_LQ_RECORDING_FOLDER");
+  if (folder == nullptr) {
+    GTEST_SKIP() << "Set OCS2_LQ_RECORDING_FOLDER to benchmark a folder of recorded QPs.";
+  }
+
+  std::vector<std::string> files;
+  for (const auto& entry : boost::filesystem::directory_iterator(folder)) {
+    files.push_back(entry.path().string());
+  }
+  std::sort(files.begin(), files.end());
+  benchmarkRecordedQps(files);
+}
@@ -0,0 +1,114 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "ocs2_sqp/SqpSolver.h"
+
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_oc/test/EXP1.h>
+
+namespace ocs2 {
+namespace {
+
+ocs2::sqp::Settings getSettings() {
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.useFeedbackPolicy = true;
+  settings.nThreads = 1;
+  return settings;
+}
+
+/** Solves EXP1 on [0, 3] numRuns times with the same solver and returns the last solution */
+PrimalSolution solveExp1(const ocs2::sqp::Settings& settings, size_t numRuns = 1) {
+  const scalar_array_t initEventTimes{0.2262, 1.0176};
+  const size_array_t modeSequence{0, 1, 2};
+  auto referenceManagerPtr = getExp1ReferenceManager(initEventTimes, modeSequence);
+  const auto problem = createExp1Problem(referenceManagerPtr);
+  DefaultInitializer zeroInitializer(1);
+
+  SqpSolver solver(settings, problem, zeroInitializer);
+  solver.setReferenceManager(referenceManagerPtr);
+  for (size_t i = 0; i < numRuns; i++) {
+    solver.run(0.0, (vector_t(2) << 2.0, 3.0).finished(), 3.0);
+  }
+  return solver.primalSolution(3.0);
+}
+
+}  // namespace
+}  // namespace ocs2
+
+TEST(test_time_discretization, geometricGrowth) {
+  const auto settings = ocs2::getSettings();
+  auto geometricSettings = settings;
+  geometricSettings.dtGrowthRate = 1.1;
+  geometricSettings.dtMax = 0.1;
+
+  const auto uniformSolution = ocs2::solveExp1(settings);
+  const auto geometricSolution = ocs2::solveExp1(geometricSettings);
+
+  // Fewer nodes, while the first interval keeps the requested dt
+  const auto& time = geometricSolution.timeTrajectory_;
+  EXPECT_LT(time.size(), uniformSolution.timeTrajectory_.size());
+  ASSERT_GE(time.size(), 2);
+  EXPECT_NEAR(time[1] - time[0], settings.dt, 1e-9);
+  EXPECT_DOUBLE_EQ(time.back(), 3.0);
+  for (size_t i = 0; i + 1 < time.size(); i++) {
+    EXPECT_LE(time[i + 1] - time[i], geometricSettings.dtMax + 1e-9) << "i = " << i;
+  }
+
+  // The first input hardly depends on the coarser discretization at the end of the horizon
+  EXPECT_TRUE(geometricSolution.inputTrajectory_.front().isApprox(uniformSolution.inputTrajectory_.front(), 1e-1));
+}
+
+TEST(test_time_discretization, defectRefinement) {
+  // A single SQP iteration on the nonlinear dynamics leaves dynamics defects, which refine the discretization of the next run
+  auto settings = ocs2::getSettings();
+  settings.dt = 0.05;
+  settings.sqpIteration = 1;
+  settings.dynamicsDefectRefinementTolerance = 1e-8;
+
+  const auto firstSolution = ocs2::solveExp1(settings, 1);
+  const auto refinedSolution = ocs2::solveExp1(settings, 2);
+
+  // Nodes are only added: every node of the first discretization is part of the refined one
+  const auto& time = refinedSolution.timeTrajectory_;
+  EXPECT_GT(time.size(), firstSolution.timeTrajectory_.size());
+  for (const auto t : firstSolution.timeTrajectory_) {
+    EXPECT_TRUE(std::any_of(time.cbegin(), time.cend(), [t](ocs2::scalar_t ti) { return std::abs(ti - t) < 1e-9; })) << "t = " << t;
+  }
+
+  // Without refinement, the discretization stays the same
+  settings.dynamicsDefectRefinementTolerance = 0.0;
+  EXPECT_EQ(ocs2::solveExp1(settings, 2).timeTrajectory_.size(), firstSolution.timeTrajectory_.size());
+}
@@ -41,7 +41,7 @@ namespace {
 
 std::pair<PrimalSolution, std::vector<PerformanceIndex>> solveWithFeedbackSetting(
     bool feedback, bool emptyConstraint, const VectorFunctionLinearApproximation& dynamicsMatrices,
-    const ScalarFunctionQuadraticApproximation& costMatrices) {
+    const ScalarFunctionQuadraticApproximation& costMatrices, LqSolverType lqSolverType = LqSolverType::HPIPM) {
   int n = dynamicsMatrices.dfdu.rows();
   int m = dynamicsMatrices.dfdu.cols();
 
@@ -76,6 +76,7 @@ std::pair<PrimalSolution, std::vector<PerformanceIndex>> solveWithFeedbackSettin
   settings.printSolverStatus = true;
   settings.printLinesearch = true;
   settings.nThreads = 100;
+  settings.lqSolverType = lqSolverType;
 
   // Additional problem definitions
   const ocs2::scalar_t startTime = 0.0;
@@ -160,3 +161,35 @@ TEST(test_unconstrained, noFeedback) {
         withEmptyConstraint.controllerPtr_->computeInput(t, x).isApprox(withNullConstraint.controllerPtr_->computeInput(t, x), tol));
   }
 }
+
+class test_unconstrained_lq_solver : public testing::TestWithParam<ocs2::LqSolverType> {};
+
+TEST_P(test_unconstrained_lq_solver, compareToHpipm) {
+  int n = 3;
+  int m = 2;
+  const double tol = 1e-8;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto costs = ocs2::getRandomCost(n, m);
+  const auto solWithHpipm = ocs2::solveWithFeedbackSetting(true, false, dynamics, costs);
+  const auto solWithRiccati = ocs2::solveWithFeedbackSetting(true, false, dynamics, costs, GetParam());
+
+  ASSERT_LE(solWithRiccati.second.size(), 2);
+  ASSERT_LT(solWithRiccati.second.back().dynamicsViolationSSE, tol);
+
+  // Compare
+  const auto& withHpipm = solWithHpipm.first;
+  const auto& withRiccati = solWithRiccati.first;
+  for (int i = 0; i < withHpipm.timeTrajectory_.size(); i++) {
+    ASSERT_DOUBLE_EQ(withHpipm.timeTrajectory_[i], withRiccati.timeTrajectory_[i]);
+    ASSERT_TRUE(withHpipm.stateTrajectory_[i].isApprox(withRiccati.stateTrajectory_[i], tol));
+    ASSERT_TRUE(withHpipm.inputTrajectory_[i].isApprox(withRiccati.inputTrajectory_[i], tol));
+
+    const auto t = withHpipm.timeTrajectory_[i];
+    const auto& x = withHpipm.stateTrajectory_[i];
+    ASSERT_TRUE(withHpipm.controllerPtr_->computeInput(t, x).isApprox(withRiccati.controllerPtr_->computeInput(t, x), tol));
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(LqSolverType, test_unconstrained_lq_solver,
+                        testing::Values(ocs2::LqSolverType::RICCATI, ocs2::LqSolverType::PARALLEL_RICCATI),
+                        [](const testing::TestParamInfo<ocs2::LqSolverType>& info) { return ocs2::lq_solver::toString(info.param); });